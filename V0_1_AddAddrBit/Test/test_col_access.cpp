@@ -0,0 +1,108 @@
+// Benchmark of the column gather kernel of AbstractMemory against the
+// per-word memcpy loop it replaced, for 64B column blocks of a 512 block
+// row (stride 32kB), over a 64MB backing store where the accesses miss
+// the host caches and a 1MB one where they hit.
+// Build: g++ -std=c++11 -O2 -I../gem5/src test_col_access.cpp ../gem5/src/mem/col_access.cc -o test_col_access-bin
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "mem/col_access.hh"
+
+typedef uint64_t Addr;
+
+// Former AbstractMemory::access column read
+static void gatherLoop(uint8_t *dst, const uint8_t *hostAddr, Addr incColOff, unsigned size) {
+    Addr colOff = 0;
+    for (Addr offset = 0; offset < size; offset = offset + sizeof(uint64_t)) {
+        memcpy(dst + offset, hostAddr + colOff, std::min((Addr)sizeof(uint64_t), size - offset));
+        colOff = colOff + incColOff;
+    }
+}
+
+// Former AbstractMemory::access column write
+static void scatterLoop(uint8_t *hostAddr, const uint8_t *src, Addr incColOff, unsigned size) {
+    Addr colOff = 0;
+    for (Addr offset = 0; offset < size; offset = offset + sizeof(uint64_t)) {
+        memcpy(hostAddr + colOff, src + offset, std::min((Addr)sizeof(uint64_t), size - offset));
+        colOff = colOff + incColOff;
+    }
+}
+
+static void run(Addr memSize) {
+    const Addr stride = Addr(1) << 15;
+    const unsigned blkSize = 64;
+    const int numAccesses = 4000000;
+    std::mt19937_64 gen(1);
+    std::vector<uint8_t> mem(memSize);
+    for (Addr i = 0; i < memSize; i += sizeof(uint64_t)) {
+        uint64_t v = gen();
+        memcpy(&mem[i], &v, sizeof(v));
+    }
+    // Column block starts, the column has to fit in the store
+    std::vector<Addr> qAddr(numAccesses);
+    for (int i = 0; i < numAccesses; ++i) {
+        qAddr[i] = (gen() % (memSize - stride * (blkSize / sizeof(uint64_t)))) & ~Addr(sizeof(uint64_t) - 1);
+    }
+
+    // Kernels have to agree with the loops, including partial last words
+    for (unsigned size = 1; size <= blkSize; ++size) {
+        uint8_t a[blkSize], b[blkSize], c[blkSize];
+        Addr addr = qAddr[size];
+        gatherLoop(a, &mem[addr], stride, size);
+        MJL_gatherColumn(b, &mem[addr], stride, size);
+        MJL_gatherColumnScalar(c, &mem[addr], stride, size);
+        assert(!memcmp(a, b, size) && !memcmp(a, c, size));
+        std::vector<uint8_t> m1(mem.begin() + addr, mem.begin() + addr + stride * 8);
+        std::vector<uint8_t> m2(m1);
+        for (unsigned i = 0; i < size; ++i) a[i] = gen();
+        scatterLoop(&m1[0], a, stride, size);
+        MJL_scatterColumn(&m2[0], a, stride, size);
+        assert(m1 == m2);
+    }
+
+    // Packet sizes are only known at run time in AbstractMemory
+    volatile unsigned volatileSize = blkSize;
+    const unsigned size = volatileSize;
+    uint8_t buf[blkSize];
+    uint64_t sumLoop = 0, sumKernel = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < numAccesses; ++i) {
+        gatherLoop(buf, &mem[qAddr[i]], stride, size);
+        sumLoop += buf[i % blkSize];
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < numAccesses; ++i) {
+        MJL_gatherColumn(buf, &mem[qAddr[i]], stride, size);
+        sumKernel += buf[i % blkSize];
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    assert(sumLoop == sumKernel);
+    for (int i = 0; i < numAccesses; ++i) {
+        scatterLoop(&mem[qAddr[i]], buf, stride, size);
+    }
+    auto t3 = std::chrono::steady_clock::now();
+    for (int i = 0; i < numAccesses; ++i) {
+        MJL_scatterColumn(&mem[qAddr[i]], buf, stride, size);
+    }
+    auto t4 = std::chrono::steady_clock::now();
+
+    double ns[4] = {
+        std::chrono::duration<double, std::nano>(t1 - t0).count() / numAccesses,
+        std::chrono::duration<double, std::nano>(t2 - t1).count() / numAccesses,
+        std::chrono::duration<double, std::nano>(t3 - t2).count() / numAccesses,
+        std::chrono::duration<double, std::nano>(t4 - t3).count() / numAccesses };
+    std::cout << (memSize >> 20) << "MB read: loop " << ns[0] << " ns, kernel " << ns[1] << " ns, speedup " << ns[0] / ns[1] << std::endl;
+    std::cout << (memSize >> 20) << "MB write: loop " << ns[2] << " ns, kernel " << ns[3] << " ns, speedup " << ns[2] / ns[3] << std::endl;
+}
+
+int main() {
+    std::cout << "Kernel: " << MJL_colAccessKernel() << std::endl;
+    run(Addr(64) << 20);
+    run(Addr(1) << 20);
+    return 0;
+}
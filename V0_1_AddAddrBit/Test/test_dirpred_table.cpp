@@ -0,0 +1,106 @@
+// Benchmark of the packed PC table of the direction predictor against the
+// old table of full entries, from the default 16x4 table up to thousands of
+// entries.
+// Build: g++ -std=c++11 -O2 [-mavx2] -I../gem5/src test_dirpred_table.cpp -o test_dirpred_table-bin
+#include <cassert>
+#include <chrono>
+#include <cinttypes>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "mem/cache/dirpred/pc_table_entry.hh"
+#include "mem/cache/tags/tag_match.hh"
+
+enum MJL_DirAttribute { MJL_IsInvalid, MJL_IsRow, MJL_IsColumn };
+
+// Layout of the old StrideEntry
+struct OldEntry {
+    Addr instAddr;
+    Addr lastAddr;
+    bool isSecure;
+    int stride;
+    int confidence;
+    MJL_DirAttribute lastPredDir;
+    bool blkHits[8];
+    bool crossBlkHits[8];
+    int lastRowOff;
+    int lastColOff;
+    int predictLevel;
+    int resetLevel;
+    MJL_DirAttribute pfLastPredDir;
+    int pfPredictLevel;
+};
+
+static Addr pcHash(Addr pc, int sets) {
+    Addr hash1 = pc >> 1;
+    Addr hash2 = hash1 >> __builtin_ctz(sets);
+    return (hash1 ^ hash2) & (Addr)(sets - 1);
+}
+
+static void run(int sets, int assoc) {
+    const int numLookups = 4000000;
+    const int tagWays = (assoc + 7) / 8 * 8;
+    std::mt19937_64 gen(sets * assoc);
+    std::vector<OldEntry *> oldTable(sets);
+    for (int s = 0; s < sets; ++s) oldTable[s] = new OldEntry[assoc]();
+    std::vector<MJL_PCTableEntry> entries(sets * assoc);
+    std::vector<uint16_t> tags(sets * tagWays, 0);
+
+    // Fill with PCs of a text segment, then look up a mix of them and others
+    std::vector<Addr> pcs(sets * assoc * 2);
+    for (Addr &pc : pcs) pc = 0x400000 + (gen() % (1 << 20)) * 4;
+    for (int i = 0; i < sets * assoc; ++i) {
+        Addr pc = pcs[i];
+        int set = pcHash(pc, sets);
+        int way = gen() % assoc;
+        oldTable[set][way].instAddr = pc;
+        entries[set * assoc + way].instAddr = pc;
+        tags[set * tagWays + way] = MJL_pcPartialTag(pc, false);
+    }
+    std::vector<Addr> qPc(numLookups);
+    for (Addr &pc : qPc) pc = pcs[gen() % pcs.size()];
+
+    uint64_t hitsOld = 0, hitsNew = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < numLookups; ++i) {
+        OldEntry *set_entries = oldTable[pcHash(qPc[i], sets)];
+        for (int way = 0; way < assoc; ++way) {
+            if (set_entries[way].instAddr == qPc[i] && !set_entries[way].isSecure) {
+                set_entries[way].confidence++;
+                hitsOld++;
+                break;
+            }
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < numLookups; ++i) {
+        int set = pcHash(qPc[i], sets);
+        uint64_t matches = MJL_matchTags16(&tags[set * tagWays], tagWays, MJL_pcPartialTag(qPc[i], false));
+        while (matches) {
+            int way = __builtin_ctzll(matches);
+            matches &= matches - 1;
+            if (entries[set * assoc + way].instAddr == qPc[i]) {
+                entries[set * assoc + way].confidence++;
+                hitsNew++;
+                break;
+            }
+        }
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    assert(hitsOld == hitsNew);
+
+    double nsOld = std::chrono::duration<double, std::nano>(t1 - t0).count() / numLookups;
+    double nsNew = std::chrono::duration<double, std::nano>(t2 - t1).count() / numLookups;
+    std::cout << sets << "x" << assoc << ": full entries " << nsOld << " ns, packed " << nsNew << " ns, speedup " << nsOld / nsNew << std::endl;
+    for (int s = 0; s < sets; ++s) delete[] oldTable[s];
+}
+
+int main() {
+    std::cout << "Entry: full " << sizeof(OldEntry) << " B, packed " << sizeof(MJL_PCTableEntry) << " B" << std::endl;
+    run(16, 4);
+    run(256, 4);
+    run(1024, 8);
+    run(4096, 16);
+    return 0;
+}
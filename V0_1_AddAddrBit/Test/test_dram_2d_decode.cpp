@@ -0,0 +1,121 @@
+// Check of the 2D DRAMCtrl::decodeAddr: with the RoRaBaChCo and RoRaBaCoCh
+// mappings on a range that is not interleaved, the row and column blocks of
+// a tile share rank, bank and row, and distinct blocks keep distinct
+// bursts. Under RoCoRaBaCh the blocks of a tile spread over the banks,
+// which is why the controller rejects it.
+// Build: g++ -std=c++11 -O2 -I../gem5/src test_dram_2d_decode.cpp -o test_dram_2d_decode-bin
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <set>
+#include <tuple>
+
+#include "mem/addr_geometry.hh"
+
+enum Mapping { RoRaBaChCo, RoRaBaCoCh, RoCoRaBaCh };
+
+// DDR3_1600_x64 with one channel, as DRAMCtrl sets it up
+struct Dram {
+    unsigned burstSize = 64;
+    unsigned columnsPerRowBuffer = 8192 / 64;
+    unsigned columnsPerStripe = 1;
+    unsigned channels = 1;
+    unsigned banksPerRank = 8;
+    unsigned ranksPerChannel = 2;
+    uint64_t rowsPerBank = 1 << 16;
+};
+
+struct Decoded {
+    unsigned rank, bank;
+    uint64_t row;
+    // The burst within the row, decodeAddr does not need it
+    Addr column;
+    bool operator<(const Decoded &o) const {
+        return std::tie(rank, bank, row, column) < std::tie(o.rank, o.bank, o.row, o.column);
+    }
+};
+
+// The address arithmetic of DRAMCtrl::decodeAddr
+static Decoded decode(const Dram &d, const MJL_AddrGeometry &g, Mapping mapping, Addr dramPktAddr) {
+    Decoded r;
+    Addr addr = g.MJL_movColRight(dramPktAddr) / d.burstSize;
+    r.column = addr % d.columnsPerRowBuffer;
+    if (mapping == RoRaBaChCo) {
+        addr = addr / d.columnsPerRowBuffer;
+        addr = addr / d.channels;
+        r.bank = addr % d.banksPerRank;
+        addr = addr / d.banksPerRank;
+        r.rank = addr % d.ranksPerChannel;
+        addr = addr / d.ranksPerChannel;
+        r.row = addr % d.rowsPerBank;
+    } else if (mapping == RoRaBaCoCh) {
+        addr = addr / d.columnsPerStripe;
+        addr = addr / d.channels;
+        addr = addr / (d.columnsPerRowBuffer / d.columnsPerStripe);
+        r.bank = addr % d.banksPerRank;
+        addr = addr / d.banksPerRank;
+        r.rank = addr % d.ranksPerChannel;
+        addr = addr / d.ranksPerChannel;
+        r.row = addr % d.rowsPerBank;
+    } else {
+        addr = addr / d.columnsPerStripe;
+        addr = addr / d.channels;
+        r.bank = addr % d.banksPerRank;
+        addr = addr / d.banksPerRank;
+        r.rank = addr % d.ranksPerChannel;
+        addr = addr / d.ranksPerChannel;
+        addr = addr / (d.columnsPerRowBuffer / d.columnsPerStripe);
+        r.row = addr % d.rowsPerBank;
+    }
+    return r;
+}
+
+static bool sameRow(const Decoded &a, const Decoded &b) {
+    return a.rank == b.rank && a.bank == b.bank && a.row == b.row;
+}
+
+static void run(unsigned rowWidth) {
+    const Dram d;
+    const MJL_AddrGeometry g(64, rowWidth);
+    const int words = g.MJL_wordMask + 1;
+    const Addr tileSize = Addr(64) * rowWidth * words;
+    std::mt19937_64 gen(rowWidth);
+
+    int spreadTiles = 0;
+    for (int i = 0; i < 10000; ++i) {
+        // A tile starts at a block of the first row of its rows
+        Addr base = (gen() % (Addr(1) << 30)) / tileSize * tileSize + (gen() % rowWidth) * 64;
+        for (Mapping mapping : {RoRaBaChCo, RoRaBaCoCh}) {
+            Decoded first = decode(d, g, mapping, base);
+            for (int k = 0; k < words; ++k) {
+                Addr rowBlk = base + (Addr(k) << g.MJL_colShift);
+                Addr colBlk = base + (Addr(k) << g.MJL_rowShift);
+                assert(g.MJL_movColLeft(g.MJL_movColRight(rowBlk)) == rowBlk);
+                assert(sameRow(first, decode(d, g, mapping, rowBlk)));
+                assert(sameRow(first, decode(d, g, mapping, colBlk)));
+            }
+        }
+        std::set<unsigned> banks;
+        for (int k = 0; k < words; ++k) {
+            banks.insert(decode(d, g, RoCoRaBaCh, base + (Addr(k) << g.MJL_colShift)).bank);
+        }
+        spreadTiles += banks.size() > 1;
+    }
+    assert(spreadTiles > 0);
+
+    // Every row block of a stretch of memory has its own burst
+    for (Mapping mapping : {RoRaBaChCo, RoRaBaCoCh}) {
+        std::set<Decoded> seen;
+        for (Addr blk = 0; blk < 16 * tileSize; blk += 64) {
+            assert(seen.insert(decode(d, g, mapping, blk)).second);
+        }
+    }
+    std::cout << rowWidth << " block rows: tiles share rank, bank and row, " << spreadTiles << " of 10000 tiles spread over banks under RoCoRaBaCh" << std::endl;
+}
+
+int main() {
+    run(8);
+    run(64);
+    run(512);
+    return 0;
+}
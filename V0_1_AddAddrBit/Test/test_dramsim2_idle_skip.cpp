@@ -0,0 +1,84 @@
+// Check that fast-forwarding DRAMSim2 over idle cycles with MJL_skipIdle
+// gives the same completions as ticking every cycle, and time both. Bursts
+// of random row and column transactions are separated by idle gaps of up
+// to 200k cycles. Run it once per mode and compare the .vis stats files.
+// Build: make -C ../gem5/ext/dramsim2/DRAMSim2 libdramsim.so && g++ -std=c++11 -O2 -DNO_STORAGE -I../gem5/ext/dramsim2/DRAMSim2 test_dramsim2_idle_skip.cpp -L../gem5/ext/dramsim2/DRAMSim2 -ldramsim -o test_dramsim2_idle_skip-bin
+// Run: LD_LIBRARY_PATH=../gem5/ext/dramsim2/DRAMSim2 ./test_dramsim2_idle_skip-bin 0|1
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include "MultiChannelMemorySystem.h"
+
+using namespace DRAMSim;
+
+struct Completions {
+    std::vector<std::pair<uint64_t, uint64_t> > done;
+    void read(unsigned, uint64_t addr, uint64_t cycle, unsigned dir) {
+        done.push_back(std::make_pair(addr * 4 + dir, cycle));
+    }
+    void write(unsigned, uint64_t addr, uint64_t cycle, unsigned dir) {
+        done.push_back(std::make_pair(addr * 4 + dir + 2, cycle));
+    }
+};
+
+int main(int argc, char **argv) {
+    bool skip = argc > 1 && atoi(argv[1]);
+    MultiChannelMemorySystem mem("ini/DDR3_micron_32M_8B_x8_sg15.ini",
+                                 "system.ini.example",
+                                 "../gem5/ext/dramsim2/DRAMSim2", "idle_skip",
+                                 2048, NULL, NULL);
+    mem.MJL_setColSize(512);
+    mem.setCPUClockSpeed(0);
+    Completions c;
+    mem.RegisterCallbacks(
+        new MJL_Callback<Completions, void, unsigned, uint64_t, uint64_t, unsigned>(&c, &Completions::read),
+        new MJL_Callback<Completions, void, unsigned, uint64_t, uint64_t, unsigned>(&c, &Completions::write),
+        NULL);
+
+    srand(1);
+    uint64_t cycle = 0, skipped = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int burst = 0; burst < 400; ++burst) {
+        int n = rand() % 20;
+        for (int i = 0; i < n; ++i) {
+            uint64_t addr = (uint64_t(rand()) % (1u << 30)) & ~63ULL;
+            while (!mem.willAcceptTransaction()) {
+                mem.update();
+                ++cycle;
+            }
+            mem.MJL_addTransaction(rand() % 3 == 0, addr, 1 + rand() % 2);
+            mem.update();
+            ++cycle;
+        }
+        uint64_t end = cycle + rand() % 200000;
+        while (cycle < end) {
+            if (skip) {
+                uint64_t k = mem.MJL_skipIdle(end - cycle);
+                if (k) {
+                    cycle += k;
+                    skipped += k;
+                    continue;
+                }
+            }
+            mem.update();
+            ++cycle;
+        }
+    }
+    double secs = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    mem.printStats(true);
+
+    // FNV-1a over the completion order and cycles
+    unsigned long long hash = 1469598103934665603ULL;
+    for (auto &d : c.done) {
+        hash = (hash ^ d.first) * 1099511628211ULL;
+        hash = (hash ^ d.second) * 1099511628211ULL;
+    }
+    printf("completions %zu hash %llx cycles %llu skipped %llu time %.3fs\n",
+           c.done.size(), hash, (unsigned long long)cycle,
+           (unsigned long long)skipped, secs);
+    return 0;
+}
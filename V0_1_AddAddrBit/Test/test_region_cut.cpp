@@ -0,0 +1,64 @@
+// Test of AddrRangeMap::MJL_cut, which drops a range from the direction
+// regions of MJL_RegionDirTable and keeps the parts of the older regions
+// outside of it.
+// Build: g++ -std=c++11 -O2 -I../gem5/src test_region_cut.cpp ../gem5/src/base/cprintf.cc -o test_region_cut-bin
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "base/addr_range_map.hh"
+
+// A failing AddrRange assertion ends here instead of in the rest of gem5
+void __exit_epilogue(int, const char *, const char *, int, const char *) {
+    std::abort();
+}
+
+typedef AddrRangeMap<int> Regions;
+
+// The regions as (start, end, value), in address order
+static std::vector<std::vector<Addr>> dump(const Regions &regions) {
+    std::vector<std::vector<Addr>> out;
+    for (const auto &region : regions) {
+        out.push_back({region.first.start(), region.first.end(), (Addr)region.second});
+    }
+    return out;
+}
+
+int main() {
+    // Cut the middle of a region, both ends stay
+    Regions middle;
+    middle.insert(AddrRange(0x1000, 0x1fff), 1);
+    middle.MJL_cut(AddrRange(0x1400, 0x17ff));
+    assert(dump(middle) == (std::vector<std::vector<Addr>>{{0x1000, 0x13ff, 1}, {0x1800, 0x1fff, 1}}));
+    // Cutting again where nothing is left changes nothing
+    middle.MJL_cut(AddrRange(0x1400, 0x17ff));
+    assert(middle.size() == 2);
+
+    // Cut across two regions and the gap between them, a region only
+    // touched by its last byte keeps the rest
+    Regions across;
+    across.insert(AddrRange(0x1000, 0x1fff), 1);
+    across.insert(AddrRange(0x3000, 0x3fff), 2);
+    across.insert(AddrRange(0x5000, 0x5fff), 3);
+    across.MJL_cut(AddrRange(0x1800, 0x3fff));
+    assert(dump(across) == (std::vector<std::vector<Addr>>{{0x1000, 0x17ff, 1}, {0x5000, 0x5fff, 3}}));
+    across.MJL_cut(AddrRange(0x0, 0x1000));
+    assert(dump(across) == (std::vector<std::vector<Addr>>{{0x1001, 0x17ff, 1}, {0x5000, 0x5fff, 3}}));
+
+    // Cut a range ending at MaxAddr, end + 1 must not wrap around
+    Regions top;
+    top.insert(AddrRange(MaxAddr - 0xfff, MaxAddr), 1);
+    top.insert(AddrRange(0x0, 0xfff), 2);
+    top.MJL_cut(AddrRange(MaxAddr - 0x7ff, MaxAddr));
+    assert(dump(top) == (std::vector<std::vector<Addr>>{{0x0, 0xfff, 2}, {MaxAddr - 0xfff, MaxAddr - 0x800, 1}}));
+    top.MJL_cut(AddrRange(0x800, MaxAddr));
+    assert(dump(top) == (std::vector<std::vector<Addr>>{{0x0, 0x7ff, 2}}));
+
+    // A cut region can be registered again and found
+    top.insert(AddrRange(0x800, 0xfff), 3);
+    assert(top.find(0x900)->second == 3 && top.find(0x7ff)->second == 2);
+
+    std::cout << "MJL_cut tests passed" << std::endl;
+    return 0;
+}
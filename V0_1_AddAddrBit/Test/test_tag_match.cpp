@@ -0,0 +1,148 @@
+// Benchmark of the packed key tag match of CacheSet against the pointer
+// chasing lookup, for 8, 16 and 32 way sets, and a check of the 16-bit
+// partial tag kernel against its scalar reference.
+// Build: g++ -std=c++11 -O2 [-mavx2] test_tag_match.cpp -o test_tag_match-bin
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cinttypes>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../gem5/src/mem/cache/tags/tag_match.hh"
+
+typedef uint64_t Addr;
+
+enum MJL_CacheBlkDir { MJL_IsInvalid, MJL_IsRow, MJL_IsColumn };
+
+struct Blk {
+    Addr tag;
+    MJL_CacheBlkDir MJL_blkDir;
+    unsigned status;
+    bool secure;
+    // Pad to about the size of a CacheBlk so the pointers chase real lines
+    uint8_t pad[200];
+    bool isValid() const { return status & 1; }
+    bool isSecure() const { return secure; }
+};
+
+static uint64_t makeKey(Addr tag, MJL_CacheBlkDir dir) { return (tag << 2) | dir; }
+
+// Current CacheSet::MJL_findBlk
+static int findPtr(Blk **blks, int assoc, Addr tag, MJL_CacheBlkDir dir, bool is_secure) {
+    for (int i = 0; i < assoc; ++i) {
+        if (blks[i]->tag == tag && blks[i]->MJL_blkDir == dir && blks[i]->isValid() && blks[i]->isSecure() == is_secure) {
+            return i;
+        }
+    }
+    return assoc;
+}
+
+// Packed key lookup
+static int findKeys(Blk **blks, const uint64_t *keys, int assoc, Addr tag, MJL_CacheBlkDir dir, bool is_secure) {
+    uint64_t matches = MJL_matchKeys(keys, assoc, makeKey(tag, dir), ~(uint64_t)0);
+    while (matches) {
+        int i = __builtin_ctzll(matches);
+        matches &= matches - 1;
+        if (blks[i]->isValid() && blks[i]->isSecure() == is_secure) {
+            return i;
+        }
+    }
+    return assoc;
+}
+
+static void run(int assoc) {
+    const int numSets = 1024;
+    const int numLookups = 4000000;
+    std::mt19937_64 gen(assoc);
+    std::vector<Blk> storage(numSets * assoc);
+    std::vector<Blk *> ptrs(numSets * assoc);
+    std::vector<uint64_t> keys(numSets * assoc);
+    std::vector<int> order(numSets * assoc);
+    for (int i = 0; i < numSets * assoc; ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), gen);
+    for (int i = 0; i < numSets * assoc; ++i) {
+        Blk *b = &storage[order[i]];
+        b->tag = gen() % (4 * assoc);
+        b->MJL_blkDir = (gen() & 1) ? MJL_IsRow : MJL_IsColumn;
+        b->status = (gen() % 8) != 0;
+        b->secure = false;
+        ptrs[i] = b;
+        keys[i] = makeKey(b->tag, b->MJL_blkDir);
+    }
+    std::vector<Addr> qTag(numLookups);
+    std::vector<int> qSet(numLookups);
+    std::vector<MJL_CacheBlkDir> qDir(numLookups);
+    for (int i = 0; i < numLookups; ++i) {
+        qTag[i] = gen() % (4 * assoc);
+        qSet[i] = gen() % numSets;
+        qDir[i] = (gen() & 1) ? MJL_IsRow : MJL_IsColumn;
+    }
+
+    uint64_t sumPtr = 0, sumKeys = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < numLookups; ++i) {
+        sumPtr += findPtr(&ptrs[qSet[i] * assoc], assoc, qTag[i], qDir[i], false);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < numLookups; ++i) {
+        sumKeys += findKeys(&ptrs[qSet[i] * assoc], &keys[qSet[i] * assoc], assoc, qTag[i], qDir[i], false);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    assert(sumPtr == sumKeys);
+
+    // The kernel has to agree with the scalar reference
+    for (int i = 0; i < numSets; ++i) {
+        uint64_t key = makeKey(qTag[i], qDir[i]);
+        assert(MJL_matchKeys(&keys[i * assoc], assoc, key, ~(uint64_t)0) == MJL_matchKeysScalar(&keys[i * assoc], assoc, key, ~(uint64_t)0));
+        assert(MJL_matchKeys(&keys[i * assoc], assoc, qTag[i] << 2, ~(uint64_t)3) == MJL_matchKeysScalar(&keys[i * assoc], assoc, qTag[i] << 2, ~(uint64_t)3));
+    }
+
+    double nsPtr = std::chrono::duration<double, std::nano>(t1 - t0).count() / numLookups;
+    double nsKeys = std::chrono::duration<double, std::nano>(t2 - t1).count() / numLookups;
+    std::cout << assoc << "-way: pointer " << nsPtr << " ns, packed keys " << nsKeys << " ns, speedup " << nsPtr / nsKeys << std::endl;
+}
+
+// Random partial tag sets against the scalar reference, for every length and
+// start offset. Tags come from a small pool so sets repeat tags, and 0, the
+// tag of a way never used, is both in the sets and looked up.
+static void checkTags16() {
+    const int numRounds = 20000;
+    std::mt19937_64 gen(16);
+    std::vector<uint16_t> tags(64 + 16);
+    for (int r = 0; r < numRounds; ++r) {
+        uint16_t pool[4];
+        for (uint16_t &t : pool) t = gen();
+        pool[0] = 0;
+        for (uint16_t &t : tags) t = (gen() % 3) ? pool[gen() % 4] : (uint16_t)gen();
+        int n = gen() % 65;
+        int off = gen() % 16;
+        uint16_t tag = (r % 4 == 0) ? 0 : pool[gen() % 4];
+        assert(MJL_matchTags16(&tags[off], n, tag) == MJL_matchTags16Scalar(&tags[off], n, tag));
+        // A tag not in the set matches no way
+        assert(MJL_matchTags16(&tags[off], n, 0x1234) == MJL_matchTags16Scalar(&tags[off], n, 0x1234));
+    }
+    // All ways the same tag, so every lane of every vector matches
+    std::fill(tags.begin(), tags.end(), 0x8001);
+    for (int n = 0; n <= 64; ++n) {
+        assert(MJL_matchTags16(tags.data(), n, 0x8001) == (n == 64 ? ~(uint64_t)0 : ((uint64_t)1 << n) - 1));
+        assert(MJL_matchTags16(tags.data(), n, 0) == 0);
+    }
+    std::cout << "MJL_matchTags16 agrees with the scalar reference" << std::endl;
+}
+
+int main() {
+#if defined(__AVX2__)
+    std::cout << "Kernel: AVX2" << std::endl;
+#elif defined(__SSE2__)
+    std::cout << "Kernel: SSE2" << std::endl;
+#else
+    std::cout << "Kernel: scalar" << std::endl;
+#endif
+    checkTags16();
+    run(8);
+    run(16);
+    run(32);
+    return 0;
+}
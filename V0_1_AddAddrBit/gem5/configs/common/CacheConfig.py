@@ -102,7 +102,6 @@ def config_cache(options, system):
                                    , tag_latency=l2_tag_latency
                                    , data_latency=l2_data_latency
                                    , MJL_2D_Cache=options.MJL_2DL2Cache\
-                                   , MJL_timeStep=options.MJL_timeStep\
                                    , MJL_2D_Transfer_Type=options.MJL_2DL2TransferType\
                                    , MJL_extra2DWrite_latency=options.MJL_extra2DWrite_latency\
                                    , MJL_has2DLLC=options.MJL_2DL2Cache\
@@ -143,7 +142,6 @@ def config_cache(options, system):
                                    # MJL_Begin
                                    , tag_latency=6
                                    , data_latency=9
-                                   , MJL_timeStep=options.MJL_timeStep\
                                    , MJL_has2DLLC=options.MJL_2DL2Cache\
                                    , sequential_access=True\
                                    , MJL_sameSetMapping=options.MJL_L2sameSetMapping\
@@ -171,7 +169,6 @@ def config_cache(options, system):
                                    , tgts_per_mshr=12
                                    , write_buffers=8
                                    , MJL_2D_Cache=options.MJL_2DL2Cache\
-                                   , MJL_timeStep=options.MJL_timeStep\
                                    , MJL_2D_Transfer_Type=options.MJL_2DL2TransferType\
                                    , MJL_extra2DWrite_latency=options.MJL_extra2DWrite_latency\
                                    , MJL_has2DLLC=options.MJL_2DL2Cache\
@@ -217,7 +214,6 @@ def config_cache(options, system):
                                    , tgts_per_mshr=12
                                    , write_buffers=8
                                    , MJL_2D_Cache=options.MJL_2DL2Cache\
-                                   , MJL_timeStep=options.MJL_timeStep\
                                    , MJL_2D_Transfer_Type=options.MJL_2DL2TransferType\
                                    , MJL_extra2DWrite_latency=options.MJL_extra2DWrite_latency\
                                    , MJL_has2DLLC=options.MJL_2DL2Cache\
@@ -244,12 +240,24 @@ def config_cache(options, system):
     if options.memchecker:
         system.memchecker = MemChecker()
 
+    # MJL_Begin
+    # Load the PC to direction table once for all the L1 data caches, the
+    # oracle proxy replay input (PCAddr2Dir) is still read by each cache
+    if options.caches and options.MJL_PC2DirFile.find("PCAddr2Dir") == -1 \
+       and not options.MJL_oracleProxyReplay:
+        system.MJL_pc2DirTable = MJL_PC2DirTable(file=options.MJL_PC2DirFile,
+                                     vec_list_file=options.MJL_VecListFile)
+    # Keep the direction regions registered by the workload for all the L1
+    # data caches
+    if options.caches and options.MJL_regionDir:
+        system.MJL_regionDirTable = MJL_RegionDirTable()
+    # MJL_End
+
     for i in xrange(options.num_cpus):
         if options.caches:
             icache = icache_class(size=options.l1i_size,
                                   assoc=options.l1i_assoc\
                                   # MJL_Begin
-                                  , MJL_timeStep=options.MJL_timeStep\
                                   # MJL_End
                                   )
             # MJL_Begin
@@ -263,11 +271,7 @@ def config_cache(options, system):
                                   # MJL_Begin
                                   , MJL_PC2DirFile=options.MJL_PC2DirFile\
                                   , MJL_VecListFile=options.MJL_VecListFile\
-                                  , MJL_timeStep=options.MJL_timeStep\
                                   , MJL_has2DLLC=options.MJL_2DL2Cache\
-                                  , MJL_predictDir=options.MJL_predictDir\
-                                  , MJL_mshrPredictDir=options.MJL_mshrPredictDir\
-                                  , MJL_pfBasedPredictDir=options.MJL_pfBasedPredictDir\
                                   , MJL_sameSetMapping=options.MJL_L1sameSetMapping\
                                   , MJL_oracleProxy=options.MJL_oracleProxy\
                                   , MJL_oracleProxyReplay=options.MJL_oracleProxyReplay\
@@ -277,6 +281,15 @@ def config_cache(options, system):
                                   # MJL_End
                                   )
             # MJL_Begin
+            if hasattr(system, 'MJL_pc2DirTable'):
+                dcache.MJL_pc2DirTable = system.MJL_pc2DirTable
+            if hasattr(system, 'MJL_regionDirTable'):
+                dcache.MJL_regionDirTable = system.MJL_regionDirTable
+            MJL_dir_predictor = MJL_makeDirPredictor(options)
+            if MJL_dir_predictor:
+                dcache.MJL_dirPredictor = MJL_dir_predictor
+            if options.MJL_shadowPredictDir and not options.MJL_predictDir:
+                fatal("Cannot shadow the direction predictor when prediction is not enabled")
             if options.MJL_mshrPredictDir and not options.MJL_predictDir:
                 fatal("Cannot use mshr scheme for prediction when prediction is not enabled")
             if options.MJL_pfBasedPredictDir and not options.MJL_predictDir:
@@ -323,7 +336,6 @@ def config_cache(options, system):
                                    # MJL_Begin
                                    , tag_latency=6
                                    , data_latency=9
-                                   , MJL_timeStep=options.MJL_timeStep\
                                    , MJL_has2DLLC=options.MJL_2DL2Cache\
                                    , sequential_access=True\
                                    , MJL_sameSetMapping=options.MJL_L2sameSetMapping\
@@ -379,6 +391,20 @@ def config_cache(options, system):
         else:
             system.cpu[i].connectAllPorts(system.membus)
 
+    # MJL_Begin
+    # Row, column and duplicate utilization of every tag array over time
+    if options.MJL_timeStep > 0:
+        system.MJL_utilSampler = MJL_StatSampler(
+            clk_domain=system.cpu_clk_domain,
+            period=options.MJL_timeStep,
+            file="MJL_utilization.bin",
+            stats=["*.tags.MJL_rowInUse", "*.tags.MJL_colInUse",
+                   "*.tags.MJL_rowUtilization", "*.tags.MJL_colUtilization",
+                   "*.tags.MJL_utilization", "*.tags.MJL_Duplicates",
+                   "*.tags.MJL_DuplicatePercentage",
+                   "*.tags.MJL_tilesInUse"])
+    # MJL_End
+
     return system
 
 # ExternalSlave provides a "port", but when that port connects to a cache,
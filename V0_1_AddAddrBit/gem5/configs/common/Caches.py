@@ -104,4 +104,45 @@ class L1StridePrefetcher(StridePrefetcher):
 
 class L2StridePrefetcher(StridePrefetcher):
     type = 'StridePrefetcher'
+
+# Direction predictor schemes by the names of --MJL_shadowPredictDir
+MJL_dirPredictorSchemes = {
+    'stride' : MJL_StrideDirPredictor,
+    '1stream' : lambda: MJL_StrideDirPredictor(one_stream=True),
+    'util' : MJL_UtilDirPredictor,
+    'mshr' : MJL_MshrDirPredictor,
+    'pf' : MJL_PfDirPredictor,
+    'combine' : MJL_CombineDirPredictor,
+}
+
+def MJL_makeDirPredictor(options):
+    """Direction predictor of the L1 data caches picked by the options, or
+    None when the direction is not predicted"""
+    if not options.MJL_predictDir:
+        return None
+    # The schemes the flags pick, at most one may be set
+    schemes = [name for name, picked in [
+        ('util', options.MJL_utilPredictDir),
+        ('mshr', options.MJL_mshrPredictDir),
+        ('pf', options.MJL_pfBasedPredictDir or
+               options.MJL_L1DpfBasedPredictDir),
+        ('combine', options.MJL_combinePredictDir or
+                    options.MJL_L1DcombinePredictDir)] if picked]
+    if len(schemes) > 1:
+        fatal("Cannot use the %s schemes for prediction at the same time" %
+              ' and '.join(schemes))
+    scheme = schemes[0] if schemes else 'stride'
+    predictor = MJL_dirPredictorSchemes[scheme]()
+    predictor.one_stream = options.MJL_1streamPredictDir
+    if not options.MJL_shadowPredictDir:
+        return predictor
+
+    # The chosen scheme steers the misses, the others only shadow it
+    shadows = options.MJL_shadowPredictDir.split(',')
+    for name in shadows:
+        if name not in MJL_dirPredictorSchemes:
+            fatal("Unknown direction predictor scheme '%s', pick from %s" %
+                  (name, ', '.join(sorted(MJL_dirPredictorSchemes))))
+    return MJL_ShadowDirPredictor(predictors=[predictor] +
+        [MJL_dirPredictorSchemes[name]() for name in shadows], steer=0)
 # MJL_End
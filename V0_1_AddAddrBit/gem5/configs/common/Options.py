@@ -117,6 +117,8 @@ def addNoISAOptions(parser):
     # MJL_Begin
     parser.add_option("--MJL_row_width", type="int", default=512, help="Specify the size of a row (how many cachelines)")
     parser.add_option("--MJL_PC2DirFile", type="string", default="PC2Dir.txt", help="Specify the filename of the input file with mapping of PC to access direction")
+    parser.add_option("--MJL_regionDir", action="store_true", default=False, help="Direct the L1D accesses to the address regions the workload registered through the m5_mjl_region_dir pseudo-op, at lower precedence than the PC and oracle annotations")
+    parser.add_option("--MJL_profilePC2Dir", type="string", default="", help="Profile the row and column locality of the data access PCs with the atomic CPU and write a PC to direction file of this name to the output directory, binary if it ends with .bin, for --MJL_PC2DirFile")
     parser.add_option("--MJL_VecListFile", type="string", default="", help="The filename of the input file with the list PC of vector instructions")
     parser.add_option("--MJL_default_column", action="store_true", help="Set default preference of all data accesses to column")
     parser.add_option("--MJL_Prefetcher", action="store_true", help="Set Prefetcher")
@@ -126,7 +128,7 @@ def addNoISAOptions(parser):
     parser.add_option("--MJL_BOPrefetcher", action="store_true", help="Set Prefetcher")
     parser.add_option("--MJL_VLDPrefetcher", action="store_true", help="Set Prefetcher")
     parser.add_option("--MJL_2DL2Cache", action="store_true", help="Set L2 cache to physically 2D")
-    parser.add_option("--MJL_timeStep", action="store", type="int", default=0, help="Set the time step for intermediate outputs, default no intermediate output")
+    parser.add_option("--MJL_timeStep", action="store", type="int", default=0, help="Set the time step in CPU cycles of the utilization samples written to MJL_utilization.bin (util/mjl_stat_sample_read.py), default no samples")
     parser.add_option("--MJL_2DL2TransferType", action="store", type="int", default=0, help="Set the type of transfer method from memory to L2 cache in physically 2D cache, 0 for per line on demand, 1 for whole tile")
     parser.add_option("--MJL_extra2DWrite_latency", action="store", type="int", default=0, help="Set the additional cycles needed for a physically 2D write access")
     parser.add_option("--MJL_predictDir", action="store_true", help="Let direction predictor decide whether to generate miss in column or row (in L1Dcache)")
@@ -137,6 +139,7 @@ def addNoISAOptions(parser):
     parser.add_option("--MJL_L1DpfBasedPredictDir", action="store_true", help="Use the L1D prefetcher prefetch scheme for direction predictor (in L1Dcache)")
     parser.add_option("--MJL_combinePredictDir", action="store_true", help="Use the combine scheme for direction predictor (in L1Dcache)")
     parser.add_option("--MJL_L1DcombinePredictDir", action="store_true", help="Use the L1D prefetcher combine scheme for direction predictor (in L1Dcache)")
+    parser.add_option("--MJL_shadowPredictDir", action="store", type="string", default="", help="Comma separated direction predictor schemes (stride, 1stream, util, mshr, pf, combine) to run in shadow of the chosen one, reporting the accuracy and coverage of each (in L1Dcache). pf and combine need the prefetcher hints enabled by --MJL_pfBasedPredictDir or --MJL_combinePredictDir")
     parser.add_option("--MJL_colPf", action="store_true", help="Let prefetcher prefetch in column")
     parser.add_option("--MJL_L1sameSetMapping", action="store_true", help="Use same set mapping for L1 dcaches")
     parser.add_option("--MJL_L2sameSetMapping", action="store_true", help="Use same set mapping for L2 caches")
@@ -235,6 +235,11 @@ if options.simpoint_profile:
     if np > 1:
         fatal("SimPoint generation not supported with more than one CPUs")
 
+# MJL_Begin
+if options.MJL_profilePC2Dir and CPUClass != AtomicSimpleCPU:
+    fatal("PC to direction profiling should be done with atomic cpu")
+# MJL_End
+
 for i in xrange(np):
     if options.smt:
         system.cpu[i].workload = multiprocesses
@@ -249,6 +254,14 @@ for i in xrange(np):
     if options.simpoint_profile:
         system.cpu[i].addSimPointProbe(options.simpoint_interval)
 
+    # MJL_Begin
+    if options.MJL_profilePC2Dir:
+        profile_file = options.MJL_profilePC2Dir
+        if np > 1:
+            profile_file = "cpu%d.%s" % (i, profile_file)
+        system.cpu[i].MJL_addPC2DirProfiler(profile_file)
+    # MJL_End
+
     if options.checker:
         system.cpu[i].addCheckerCpu()
 
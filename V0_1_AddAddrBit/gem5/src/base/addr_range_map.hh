@@ -46,6 +46,9 @@
 
 #include <map>
 #include <utility>
+/* MJL_Begin */
+#include <vector>
+/* MJL_End */
 
 #include "base/addr_range.hh"
 
@@ -182,6 +185,36 @@ class AddrRangeMap
     {
         return tree.empty();
     }
+
+    /* MJL_Begin */
+    /**
+     * Remove r from the ranges of the map, the parts of a range outside
+     * of r stay with the value of the range. Not for interleaved ranges.
+     */
+    void
+    MJL_cut(const AddrRange &r)
+    {
+        std::vector<std::pair<AddrRange, V>> kept;
+        for (auto i = tree.begin(); i != tree.end();) {
+            if (!i->first.intersects(r)) {
+                ++i;
+                continue;
+            }
+            if (i->first.start() < r.start()) {
+                kept.emplace_back(AddrRange(i->first.start(), r.start() - 1),
+                                  i->second);
+            }
+            if (i->first.end() > r.end()) {
+                kept.emplace_back(AddrRange(r.end() + 1, i->first.end()),
+                                  i->second);
+            }
+            tree.erase(i++);
+        }
+        for (const auto &range : kept) {
+            tree.insert(range);
+        }
+    }
+    /* MJL_End */
 };
 
 #endif //__BASE_ADDR_RANGE_MAP_HH__
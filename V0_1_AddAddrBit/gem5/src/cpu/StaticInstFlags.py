@@ -108,5 +108,13 @@ class StaticInstFlags(Enum):
         'IsMicroBranch',    # This microop branches within the microcode for
                             # a macroop
         'IsDspOp',
-        'IsSquashAfter'     # Squash all uncommitted state after executed
+        'IsSquashAfter',    # Squash all uncommitted state after executed
+
+        # MJL_Begin
+        # Flags for 2D memory accesses, set by the decoder so that CPU
+        # models do not need to inspect the disassembly
+        'IsMJLVec',         # Is a vector (multi-word) 2D memory access
+        'IsMJLRowHint',     # Prefers the row view of memory
+        'IsMJLColumnHint'   # Prefers the column view of memory
+        # MJL_End
         ]
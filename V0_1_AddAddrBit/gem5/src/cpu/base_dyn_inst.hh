@@ -893,12 +893,15 @@ BaseDynInst<Impl>::initiateMemRead(Addr addr, unsigned size,
         req->taskId(cpu->taskId());
 
         /* MJL_Begin */
+        this->staticInst->MJL_annotateReq(req);
+        /* MJL_End */
+        /* MJL_Comment
         std::string MJL_inst_dump;
         this->dump(MJL_inst_dump);
         if ((MJL_inst_dump.find("mjl") != std::string::npos) && (MJL_inst_dump.find("vec") != std::string::npos)) {
             req->MJL_setVec();
         }
-        /* MJL_End */
+        */
         // Only split the request if the ISA supports unaligned accesses.
         if (TheISA::HasUnalignedMemAcc) {
             splitRequest(req, sreqLow, sreqHigh);
@@ -956,12 +959,15 @@ BaseDynInst<Impl>::writeMem(uint8_t *data, unsigned size, Addr addr,
         req->taskId(cpu->taskId());
 
         /* MJL_Begin */
+        this->staticInst->MJL_annotateReq(req);
+        /* MJL_End */
+        /* MJL_Comment
         std::string MJL_inst_dump;
         this->dump(MJL_inst_dump);
         if ((MJL_inst_dump.find("mjl") != std::string::npos) && (MJL_inst_dump.find("vec") != std::string::npos)) {
             req->MJL_setVec();
         }
-        /* MJL_End */
+        */
         // Only split the request if the ISA supports unaligned accesses.
         if (TheISA::HasUnalignedMemAcc) {
             splitRequest(req, sreqLow, sreqHigh);
@@ -362,6 +362,11 @@ KvmVM::delayedStartup()
                 panic("Tried to map an interleaved memory range into "
                       "a KVM VM.\n");
             }
+            /* MJL_Begin */
+            if (memories[slot].MJL_tileGeometry) {
+                panic("Tried to map a tiled backing store into a KVM VM.\n");
+            }
+            /* MJL_End */
 
             const MemSlot slot = allocMemSlot(range.size());
             setupMemSlot(slot, pmem, range.start(), 0/* flags */);
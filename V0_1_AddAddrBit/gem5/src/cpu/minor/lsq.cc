@@ -428,6 +428,10 @@ LSQ::SplitDataRequest::makeFragmentRequests()
             fragment_addr, fragment_size, request.getFlags(),
             request.masterId(),
             request.getPC());
+        /* MJL_Begin */
+        fragment->MJL_setVec(request.MJL_isVec());
+        fragment->MJL_setDirHint(request.MJL_getDirHint());
+        /* MJL_End */
 
         DPRINTFS(MinorMem, (&port), "Generating fragment addr: 0x%x size: %d"
             " (whole request addr: 0x%x size: %d) %s\n",
@@ -1515,6 +1519,9 @@ LSQ::pushRequest(MinorDynInstPtr inst, bool isLoad, uint8_t *data,
         addr, size, flags, cpu.dataMasterId(),
         /* I've no idea why we need the PC, but give it */
         inst->pc.instAddr());
+    /* MJL_Begin */
+    inst->staticInst->MJL_annotateReq(&request->request);
+    /* MJL_End */
 
     requests.push(request);
     request->startAddrTranslation();
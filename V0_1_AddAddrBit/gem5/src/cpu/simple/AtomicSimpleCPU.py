@@ -41,6 +41,9 @@
 from m5.params import *
 from BaseSimpleCPU import BaseSimpleCPU
 from SimPoint import SimPoint
+# MJL_Begin
+from PC2DirProfiler import MJL_PC2DirProfiler
+# MJL_End
 
 class AtomicSimpleCPU(BaseSimpleCPU):
     """Simple CPU model executing a configurable number of
@@ -67,3 +70,11 @@ class AtomicSimpleCPU(BaseSimpleCPU):
         simpoint = SimPoint()
         simpoint.interval = interval
         self.probeListener = simpoint
+
+    # MJL_Begin
+    def MJL_addPC2DirProfiler(self, profile_file):
+        profiler = MJL_PC2DirProfiler()
+        profiler.profile_file = profile_file
+        profiler.binary = profile_file.endswith('.bin')
+        self.MJL_pc2DirProfiler = profiler
+    # MJL_End
@@ -99,7 +99,8 @@ AtomicSimpleCPU::AtomicSimpleCPU(AtomicSimpleCPUParams *p)
       icachePort(name() + ".icache_port", this),
       dcachePort(name() + ".dcache_port", this),
       fastmem(p->fastmem), dcache_access(false), dcache_latency(0),
-      ppCommit(nullptr)
+      ppCommit(nullptr)/* MJL_Begin */,
+      MJL_ppMemAccess(nullptr)/* MJL_End */
 {
     _status = Idle;
 }
@@ -353,8 +354,7 @@ AtomicSimpleCPU::readMem(Addr addr, uint8_t * data, unsigned size,
     //across a cache line boundary.
     /* MJL_Begin */
     Addr secondAddr;
-    std::string MJL_inst_mnemonic(curStaticInst->disassemble(thread->pcState().instAddr()));
-    if ((MJL_inst_mnemonic.find("mjl") != std::string::npos) && (MJL_inst_mnemonic.find("vec") != std::string::npos)) {
+    if (curStaticInst->MJL_isVec()) {
         secondAddr = roundDown(addr + size - 1, cacheLineSize());
     } else {
         secondAddr = roundDown(addr + size - 1, sizeof(uint64_t));
@@ -394,12 +394,7 @@ AtomicSimpleCPU::readMem(Addr addr, uint8_t * data, unsigned size,
                     //pkt.cmd.MJL_setCmdDir(MemCmd::MJL_DirAttribute::MJL_IsColumn);
                     //pkt.req->MJL_setReqDir(MemCmd::MJL_DirAttribute::MJL_IsColumn);
                     //pkt.MJL_setDataDir(MemCmd::MJL_DirAttribute::MJL_IsColumn);
-                    pkt.req->MJL_cachelineSize = 64;
-                    pkt.req->MJL_rowWidth = 8;
-                    std::string MJL_inst_mnemonic(curStaticInst->disassemble(thread->pcState().instAddr()));
-                    if ((MJL_inst_mnemonic.find("mjl") != std::string::npos) && (MJL_inst_mnemonic.find("vec") != std::string::npos)) {
-                        pkt.req->MJL_setVec();
-                    }
+                    curStaticInst->MJL_annotateReq(pkt.req);
                     /* MJL_Test 
                     // test for movdqa to vec 
                     if (MJL_inst_mnemonic.find("MOVDQA_XMM_M") != std::string::npos) {
@@ -418,6 +413,11 @@ AtomicSimpleCPU::readMem(Addr addr, uint8_t * data, unsigned size,
                     dcache_latency += dcachePort.sendAtomic(&pkt);
                     */
             }
+            /* MJL_Begin */
+            if (!req->isMmappedIpr()) {
+                MJL_ppMemAccess->notify(&pkt);
+            }
+            /* MJL_End */
             dcache_access = true;
 
             assert(!pkt.isError());
@@ -496,8 +496,7 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
     //across a cache line boundary.
     /* MJL_Begin */
     Addr secondAddr;
-    std::string MJL_inst_mnemonic(curStaticInst->disassemble(thread->pcState().instAddr()));
-    if ((MJL_inst_mnemonic.find("mjl") != std::string::npos) && (MJL_inst_mnemonic.find("vec") != std::string::npos)) {
+    if (curStaticInst->MJL_isVec()) {
         secondAddr = roundDown(addr + size - 1, cacheLineSize());
     } else {
         secondAddr = roundDown(addr + size - 1, sizeof(uint64_t));
@@ -552,12 +551,7 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
                     //pkt.cmd.MJL_setCmdDir(MemCmd::MJL_DirAttribute::MJL_IsColumn);
                     //pkt.req->MJL_setReqDir(MemCmd::MJL_DirAttribute::MJL_IsColumn);
                     //pkt.MJL_setDataDir(MemCmd::MJL_DirAttribute::MJL_IsColumn);
-                    pkt.req->MJL_cachelineSize = 64;
-                    pkt.req->MJL_rowWidth = 8;
-                    std::string MJL_inst_mnemonic(curStaticInst->disassemble(thread->pcState().instAddr()));
-                    if ((MJL_inst_mnemonic.find("mjl") != std::string::npos) && (MJL_inst_mnemonic.find("vec") != std::string::npos)) {
-                        pkt.req->MJL_setVec();
-                    }
+                    curStaticInst->MJL_annotateReq(pkt.req);
                     /* MJL_Test 
                     // test for conv MOVDQA problem
                     if (pkt.getAddr() == 0x123a88 && pkt.isWrite()) {
@@ -574,6 +568,11 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
                     // Notify other threads on this CPU of write
                     threadSnoop(&pkt, curThread);
                 }
+                /* MJL_Begin */
+                if (!req->isMmappedIpr()) {
+                    MJL_ppMemAccess->notify(&pkt);
+                }
+                /* MJL_End */
                 dcache_access = true;
                 assert(!pkt.isError());
 
@@ -764,6 +763,10 @@ AtomicSimpleCPU::regProbePoints()
 
     ppCommit = new ProbePointArg<pair<SimpleThread*, const StaticInstPtr>>
                                 (getProbeManager(), "Commit");
+    /* MJL_Begin */
+    MJL_ppMemAccess = new ProbePointArg<PacketPtr>(getProbeManager(),
+                                                   "MJL_MemAccess");
+    /* MJL_End */
 }
 
 void
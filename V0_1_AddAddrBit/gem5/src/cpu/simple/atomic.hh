@@ -177,6 +177,10 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
     /** Probe Points. */
     ProbePointArg<std::pair<SimpleThread*, const StaticInstPtr>> *ppCommit;
+    /* MJL_Begin */
+    /** Every data access made, after it is done */
+    ProbePointArg<PacketPtr> *MJL_ppMemAccess;
+    /* MJL_End */
 
   protected:
 
@@ -0,0 +1,19 @@
+# MJL_Begin
+from m5.params import *
+from Probe import ProbeListenerObject
+
+class MJL_PC2DirProfiler(ProbeListenerObject):
+    """Profile the row and column locality of every data access PC of an
+    AtomicSimpleCPU and write a PC to direction file for MJL_PC2DirTable."""
+
+    type = 'MJL_PC2DirProfiler'
+    cxx_header = "cpu/simple/probes/pc2dir_profiler.hh"
+
+    profile_file = Param.String("PC2Dir.txt", "PC to direction (output) file")
+    binary = Param.Bool(False, "Write the binary table instead of text")
+    window = Param.Unsigned(4, "Blocks remembered per PC and direction "
+        "(at most 8), accesses to them count as hits")
+    min_accesses = Param.UInt64(16, "Accesses a PC needs to be annotated")
+    min_confidence = Param.Float(0.0, "Confidence a PC needs to be "
+        "annotated, the fraction of misses its direction saves")
+# MJL_End
@@ -0,0 +1,170 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Definition of the PC to direction profiler.
+ */
+
+#include "cpu/simple/probes/pc2dir_profiler.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "base/callback.hh"
+#include "base/misc.hh"
+#include "base/output.hh"
+#include "mem/addr_geometry.hh"
+#include "mem/cache/pc2dir_table.hh"
+#include "sim/core.hh"
+
+MJL_PC2DirProfiler::MJL_PC2DirProfiler(const MJL_PC2DirProfilerParams *p)
+    : ProbeListenerObject(p), profileFile(p->profile_file),
+      binary(p->binary), window(p->window), minAccesses(p->min_accesses),
+      minConfidence(p->min_confidence)
+{
+    fatal_if(window == 0 || window > MJL_maxWindow,
+             "%s: window must be 1 to %d blocks\n", name(), MJL_maxWindow);
+    fatal_if(minConfidence < 0 || minConfidence > 1,
+             "%s: min_confidence must be within [0, 1]\n", name());
+    registerExitCallback(
+        new MakeCallback<MJL_PC2DirProfiler, &MJL_PC2DirProfiler::MJL_dump>(
+            this));
+}
+
+void
+MJL_PC2DirProfiler::regProbeListeners()
+{
+    typedef ProbeListenerArg<MJL_PC2DirProfiler, PacketPtr>
+        MJL_PC2DirListener;
+    listeners.push_back(new MJL_PC2DirListener(
+        this, "MJL_MemAccess", &MJL_PC2DirProfiler::MJL_profile));
+}
+
+void
+MJL_PC2DirProfiler::MJL_ViewProfile::MJL_access(Addr addr, Addr blk,
+                                                unsigned window)
+{
+    int64_t delta = addr - lastAddr;
+    if (delta != 0 && delta == stride) {
+        strideHits++;
+    }
+    stride = delta;
+    lastAddr = addr;
+
+    // Move blk to the front, dropping the least recent block on a miss
+    unsigned pos = std::find(blks, blks + numBlks, blk) - blks;
+    if (pos < numBlks) {
+        hits++;
+    } else if (numBlks < window) {
+        pos = numBlks++;
+    } else {
+        pos = numBlks - 1;
+    }
+    std::copy_backward(blks, blks + pos, blks + pos + 1);
+    blks[0] = blk;
+}
+
+void
+MJL_PC2DirProfiler::MJL_profile(const PacketPtr &pkt)
+{
+    if (!pkt->req->hasPC() || pkt->req->isUncacheable()) {
+        return;
+    }
+    const MJL_AddrGeometry &geometry =
+        MJL_AddrGeometry::MJL_getSystemGeometry();
+    Addr addr = pkt->getAddr();
+    MJL_PCProfile &profile = pcProfiles[pkt->req->getPC()];
+    profile.accesses++;
+    profile.row.MJL_access(addr, addr & ~Addr(geometry.MJL_blkSize - 1),
+                           window);
+    // Consecutive words of a column are consecutive in the swapped address
+    profile.col.MJL_access(geometry.MJL_swapRowColBits(addr),
+                           geometry.MJL_colBlockAlign(addr), window);
+}
+
+void
+MJL_PC2DirProfiler::MJL_dump()
+{
+    std::vector<MJL_PC2DirEntry> sorted;
+    std::vector<std::pair<Addr, const MJL_PCProfile *>> pcs;
+    for (const auto &it : pcProfiles) {
+        pcs.emplace_back(it.first, &it.second);
+    }
+    std::sort(pcs.begin(), pcs.end());
+
+    OutputStream *os = simout.create(profileFile, binary);
+    if (!os) {
+        fatal("%s: unable to open profile_file %s\n", name(), profileFile);
+    }
+    std::ostream &out = *os->stream();
+    uint64_t num_annotated = 0;
+    uint64_t num_undecided = 0;
+    for (const auto &it : pcs) {
+        Addr pc = it.first;
+        const MJL_PCProfile &profile = *it.second;
+        if (profile.accesses < minAccesses) {
+            continue;
+        }
+        // The view fetching fewer blocks wins, by the fraction it saves
+        uint64_t row_misses = profile.accesses - profile.row.hits;
+        uint64_t col_misses = profile.accesses - profile.col.hits;
+        if (row_misses == col_misses) {
+            num_undecided++;
+            continue;
+        }
+        bool is_row = row_misses < col_misses;
+        double confidence = is_row ?
+            double(col_misses - row_misses) / col_misses :
+            double(row_misses - col_misses) / row_misses;
+        if (confidence < minConfidence) {
+            continue;
+        }
+
+        num_annotated++;
+        if (binary) {
+            MJL_PC2DirEntry entry;
+            entry.pc = pc;
+            entry.otherPC = 0;
+            entry.dir = is_row ? MemCmd::MJL_DirAttribute::MJL_IsRow :
+                                 MemCmd::MJL_DirAttribute::MJL_IsColumn;
+            entry.pos = 0;
+            entry.flags = 0;
+            entry.confidence = std::max(1L, std::lround(confidence * 255));
+            std::fill(entry.pad, entry.pad + sizeof(entry.pad), 0);
+            sorted.push_back(entry);
+        } else {
+            // "PC Dir Pos OtherPC" then the profile, see MJL_PC2DirTable
+            ccprintf(out, "%x %c 0 0 %.3f %d %d %d %d %d\n", pc,
+                     is_row ? 'R' : 'C', confidence, profile.accesses,
+                     profile.row.hits, profile.col.hits,
+                     profile.row.strideHits, profile.col.strideHits);
+        }
+    }
+
+    if (binary) {
+        MJL_PC2DirHeader header;
+        std::copy(MJL_PC2DirIndex::MJL_magic,
+                  MJL_PC2DirIndex::MJL_magic + sizeof(header.magic),
+                  header.magic);
+        header.version = MJL_PC2DirIndex::MJL_version;
+        header.entrySize = sizeof(MJL_PC2DirEntry);
+        header.numEntries = sorted.size();
+        out.write((const char *)&header, sizeof(header));
+        std::vector<MJL_PC2DirEntry> entries =
+            MJL_PC2DirIndex::MJL_toEytzinger(sorted);
+        out.write((const char *)entries.data(),
+                  entries.size() * sizeof(MJL_PC2DirEntry));
+    }
+    simout.close(os);
+    inform("%s: %d of %d PCs annotated in %s, %d undecided\n", name(),
+           num_annotated, pcs.size(), profileFile, num_undecided);
+}
+
+MJL_PC2DirProfiler*
+MJL_PC2DirProfilerParams::create()
+{
+    return new MJL_PC2DirProfiler(this);
+}
+
+/* MJL_End */
@@ -0,0 +1,82 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Declaration of the PC to direction profiler. It listens to the data
+ * accesses of an AtomicSimpleCPU, measures for every PC how well a row
+ * and a column cache would serve it, and writes a PC to direction file
+ * at the end of the run that MJL_PC2DirTable loads as is.
+ */
+
+#ifndef __CPU_SIMPLE_PROBES_PC2DIR_PROFILER_HH__
+#define __CPU_SIMPLE_PROBES_PC2DIR_PROFILER_HH__
+
+#include <string>
+#include <unordered_map>
+
+#include "base/types.hh"
+#include "mem/packet.hh"
+#include "params/MJL_PC2DirProfiler.hh"
+#include "sim/probe/probe.hh"
+
+class MJL_PC2DirProfiler : public ProbeListenerObject
+{
+  public:
+    MJL_PC2DirProfiler(const MJL_PC2DirProfilerParams *params);
+
+    void regProbeListeners() override;
+
+    /** Account a data access to its PC, in both views */
+    void MJL_profile(const PacketPtr &pkt);
+
+    /** Write the profile, called on exit */
+    void MJL_dump();
+
+    /** Most blocks remembered per PC and view */
+    static const unsigned MJL_maxWindow = 8;
+
+  private:
+    /**
+     * Locality of one view of a PC: the last blocks it touched, most
+     * recent first, and the stride between its last accesses.
+     */
+    struct MJL_ViewProfile {
+        Addr blks[MJL_maxWindow];
+        unsigned numBlks;
+        /** Accesses to one of the remembered blocks */
+        uint64_t hits;
+        /** Accesses repeating the previous stride of the view */
+        uint64_t strideHits;
+        Addr lastAddr;
+        int64_t stride;
+
+        MJL_ViewProfile() : numBlks(0), hits(0), strideHits(0), lastAddr(0),
+                            stride(0) {}
+        /** Account an access at addr of block blk */
+        void MJL_access(Addr addr, Addr blk, unsigned window);
+    };
+
+    struct MJL_PCProfile {
+        uint64_t accesses;
+        MJL_ViewProfile row;
+        MJL_ViewProfile col;
+
+        MJL_PCProfile() : accesses(0) {}
+    };
+
+    /** Output file, relative to the output directory */
+    const std::string profileFile;
+    /** Write the binary table instead of text */
+    const bool binary;
+    const unsigned window;
+    /** PCs with fewer accesses are left out */
+    const uint64_t minAccesses;
+    /** PCs with a lower confidence are left out */
+    const double minConfidence;
+
+    std::unordered_map<Addr, MJL_PCProfile> pcProfiles;
+};
+
+#endif // __CPU_SIMPLE_PROBES_PC2DIR_PROFILER_HH__
+
+/* MJL_End */
@@ -435,6 +435,9 @@ TimingSimpleCPU::initiateMemRead(Addr addr, unsigned size,
                                  thread->contextId());
 
     req->taskId(taskId());
+    /* MJL_Begin */
+    curStaticInst->MJL_annotateReq(req);
+    /* MJL_End */
 
     Addr split_addr = roundDown(addr + size - 1, block_size);
     assert(split_addr <= addr || split_addr - addr < block_size);
@@ -516,6 +519,9 @@ TimingSimpleCPU::writeMem(uint8_t *data, unsigned size,
                                  thread->contextId());
 
     req->taskId(taskId());
+    /* MJL_Begin */
+    curStaticInst->MJL_annotateReq(req);
+    /* MJL_End */
 
     Addr split_addr = roundDown(addr + size - 1, block_size);
     assert(split_addr <= addr || split_addr - addr < block_size);
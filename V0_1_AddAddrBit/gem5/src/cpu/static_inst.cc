@@ -32,6 +32,9 @@
 #include <iostream>
 
 #include "cpu/static_inst.hh"
+/* MJL_Begin */
+#include "mem/request.hh"
+/* MJL_End */
 #include "sim/core.hh"
 
 StaticInstPtr StaticInst::nullStaticInstPtr;
@@ -109,3 +112,18 @@ StaticInst::printFlags(std::ostream &outs,
         }
     }
 }
+
+/* MJL_Begin */
+void
+StaticInst::MJL_annotateReq(Request *req) const
+{
+    req->MJL_setVec(MJL_isVec());
+    if (MJL_isColumnHint()) {
+        req->MJL_setDirHint(Request::MJL_IsColumn);
+    } else if (MJL_isRowHint()) {
+        req->MJL_setDirHint(Request::MJL_IsRow);
+    } else {
+        req->MJL_setDirHint(Request::MJL_IsInvalid);
+    }
+}
+/* MJL_End */
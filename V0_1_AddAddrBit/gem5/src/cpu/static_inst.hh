@@ -48,6 +48,9 @@
 
 // forward declarations
 class Packet;
+/* MJL_Begin */
+class Request;
+/* MJL_End */
 
 class ExecContext;
 
@@ -172,6 +175,13 @@ class StaticInst : public RefCounted, public StaticInstFlags
     bool isFirstMicroop() const { return flags[IsFirstMicroop]; }
     //This flag doesn't do anything yet
     bool isMicroBranch() const { return flags[IsMicroBranch]; }
+    /* MJL_Begin */
+    bool MJL_isVec() const { return flags[IsMJLVec]; }
+    bool MJL_isRowHint() const { return flags[IsMJLRowHint]; }
+    bool MJL_isColumnHint() const { return flags[IsMJLColumnHint]; }
+    bool MJL_hasDirHint() const
+    { return flags[IsMJLRowHint] || flags[IsMJLColumnHint]; }
+    /* MJL_End */
     //@}
 
     void setFirstMicroop() { flags[IsFirstMicroop] = true; }
@@ -325,6 +335,15 @@ class StaticInst : public RefCounted, public StaticInstFlags
      */
     void printFlags(std::ostream &outs, const std::string &separator) const;
 
+    /* MJL_Begin */
+    /**
+     * Copy the decoded 2D access attributes (vector access, direction
+     * hint) of this instruction onto a memory request. Called by the
+     * CPU models when a data request is set up.
+     */
+    void MJL_annotateReq(Request *req) const;
+    /* MJL_End */
+
     /// Return name of machine instruction
     std::string getName() { return mnemonic; }
 };
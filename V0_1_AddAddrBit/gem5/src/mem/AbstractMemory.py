@@ -40,6 +40,9 @@
 #          Andreas Hansson
 
 from m5.params import *
+# MJL_Begin
+from m5.proxy import *
+# MJL_End
 from MemObject import MemObject
 
 class AbstractMemory(MemObject):
@@ -54,6 +57,12 @@ class AbstractMemory(MemObject):
 
     # MJL_Begin
     MJL_row_width = Param.Int(512, "The size of a row in cachelines")
+    MJL_tiled_store = Param.Bool(False, "Keep each tile of the backing "
+                                 "store contiguous, so row and column "
+                                 "accesses both touch one region")
+    MJL_tile_blk_size = Param.Unsigned(Parent.cache_line_size,
+                                       "Block size of the tiles of the "
+                                       "backing store")
     # MJL_End
     # All memories are passed to the global physical memory, and
     # certain memories may be excluded from the global address map,
@@ -45,6 +45,9 @@
 #          Erfan Azarkhish
 
 from m5.params import *
+# MJL_Begin
+from m5.proxy import *
+# MJL_End
 from AbstractMemory import *
 
 # Enum for memory scheduling algorithms, currently First-Come
@@ -226,6 +229,35 @@ class DRAMCtrl(AbstractMemory):
     # time to exit self-refresh mode with locked DLL
     tXSDLL = Param.Latency("0ns", "Self-refresh exit latency DLL")
 
+    # MJL_Begin
+    # multi-view DRAM: the blocks of a tile, MJL_tile_blk_size bytes each,
+    # are kept in one row, which can be opened as a row view or a column
+    # view, so a column block is a single burst. Changing the view of an
+    # open row needs a precharge and an activate. It needs the RoRaBaChCo or
+    # RoRaBaCoCh mapping and a range that is not channel interleaved.
+    MJL_2D = Param.Bool(False, "Serve column packets as native column "
+                        "bursts with a tile aligned address mapping")
+    MJL_tRCD_column = Param.Latency(Self.tRCD, "RAS to CAS delay of a "
+                                    "column view")
+    MJL_tCL_column = Param.Latency(Self.tCL, "CAS latency of a column burst")
+    MJL_tBURST_column = Param.Latency(Self.tBURST, "Burst duration of a "
+                                      "column burst")
+
+    # batching of row and column bursts by the FR-FCFS scheduler, in the
+    # same way reads and writes are batched: a batch ends when its own
+    # bursts drop to the low threshold, or the bursts of the other
+    # direction reach the high threshold
+    MJL_dir_batching = Param.Bool(False, "Batch row and column bursts")
+    MJL_dir_high_thresh_perc = Param.Percent(50, "Bursts of the other "
+                                             "direction that force a switch")
+    MJL_dir_low_thresh_perc = Param.Percent(0, "Bursts of the current "
+                                            "direction that end a batch")
+    MJL_min_bursts_per_dir_switch = Param.Unsigned(8, "Minimum bursts "
+                                                   "before a direction switch")
+    # bus turnaround between a row and a column burst
+    MJL_tDS = Param.Latency("0ns", "Row to column switching time")
+    # MJL_End
+
     # Currently rolled into other params
     ######################################################################
 
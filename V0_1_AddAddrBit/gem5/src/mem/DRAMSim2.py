@@ -54,3 +54,8 @@ class DRAMSim2(AbstractMemory):
                             "Directory to prepend to file names")
     traceFile = Param.String("", "Output file for trace generation")
     enableDebug = Param.Bool(False, "Enable DRAMSim2 debug output")
+    # MJL_Begin
+    # stop ticking DRAMSim2 when nothing is outstanding, and fast-forward
+    # it over the missed cycles when the next request arrives
+    MJL_idle_skip = Param.Bool(True, "Skip the DRAMSim2 idle cycles")
+    # MJL_End
@@ -49,6 +49,9 @@
 #include "debug/LLSC.hh"
 #include "debug/MemoryAccess.hh"
 #include "mem/abstract_mem.hh"
+/* MJL_Begin */
+#include "mem/col_access.hh"
+/* MJL_End */
 #include "mem/packet_access.hh"
 #include "sim/system.hh"
 
@@ -57,7 +60,11 @@ using namespace std;
 AbstractMemory::AbstractMemory(const Params *p) :
     MemObject(p), range(params()->range), pmemAddr(NULL),
     confTableReported(p->conf_table_reported), inAddrMap(p->in_addr_map),
-    kvmMap(p->kvm_map)/* MJL_Begin */, MJL_Debug_Out(false)/* MJL_End */, _system(NULL)
+    kvmMap(p->kvm_map)/* MJL_Begin */,
+    MJL_tileGeometry(p->MJL_tiled_store ?
+                     &MJL_AddrGeometry::MJL_get(p->MJL_tile_blk_size,
+                                                p->MJL_row_width) : nullptr),
+    MJL_Debug_Out(false)/* MJL_End */, _system(NULL)
 {
 }
 
@@ -76,6 +83,77 @@ AbstractMemory::setBackingStore(uint8_t* pmem_addr)
     pmemAddr = pmem_addr;
 }
 
+/* MJL_Begin */
+void
+AbstractMemory::MJL_readStore(uint8_t *dst, const PacketPtr pkt) const
+{
+    if (pkt->MJL_isTile()) {
+        // Each line of a tile is in its own place in the store
+        for (unsigned k = 0; k < pkt->MJL_tileLineCount(); ++k) {
+            PacketPtr line = pkt->MJL_getTileLine(k);
+            MJL_readStore(dst + k * line->getSize(), line);
+        }
+        return;
+    }
+    Addr addr = pkt->getAddr();
+    unsigned size = pkt->getSize();
+    if (pkt->MJL_getDataDir() == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
+        // The words of a column are a row apart, or a block apart in a tile
+        assert(!MJL_tileGeometry || pkt->req->MJL_geometry == MJL_tileGeometry);
+        MJL_gatherColumn(dst, MJL_hostAddr(addr),
+                         MJL_tileGeometry ? MJL_tileGeometry->MJL_blkSize :
+                         (Addr)1 << pkt->req->MJL_geometry->MJL_colShift,
+                         size);
+    } else if (!MJL_tileGeometry) {
+        memcpy(dst, MJL_hostAddr(addr), size);
+    } else {
+        // A tiled store only keeps the bytes of a block together
+        while (size > 0) {
+            unsigned blk_left = MJL_tileGeometry->MJL_blkSize -
+                (addr & (MJL_tileGeometry->MJL_blkSize - 1));
+            unsigned n = std::min(size, blk_left);
+            memcpy(dst, MJL_hostAddr(addr), n);
+            dst += n;
+            addr += n;
+            size -= n;
+        }
+    }
+}
+
+void
+AbstractMemory::MJL_writeStore(const uint8_t *src, const PacketPtr pkt)
+{
+    if (pkt->MJL_isTile()) {
+        for (unsigned k = 0; k < pkt->MJL_tileLineCount(); ++k) {
+            PacketPtr line = pkt->MJL_getTileLine(k);
+            MJL_writeStore(src + k * line->getSize(), line);
+        }
+        return;
+    }
+    Addr addr = pkt->getAddr();
+    unsigned size = pkt->getSize();
+    if (pkt->MJL_getDataDir() == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
+        assert(!MJL_tileGeometry || pkt->req->MJL_geometry == MJL_tileGeometry);
+        MJL_scatterColumn(MJL_hostAddr(addr), src,
+                          MJL_tileGeometry ? MJL_tileGeometry->MJL_blkSize :
+                          (Addr)1 << pkt->req->MJL_geometry->MJL_colShift,
+                          size);
+    } else if (!MJL_tileGeometry) {
+        memcpy(MJL_hostAddr(addr), src, size);
+    } else {
+        while (size > 0) {
+            unsigned blk_left = MJL_tileGeometry->MJL_blkSize -
+                (addr & (MJL_tileGeometry->MJL_blkSize - 1));
+            unsigned n = std::min(size, blk_left);
+            memcpy(MJL_hostAddr(addr), src, n);
+            src += n;
+            addr += n;
+            size -= n;
+        }
+    }
+}
+/* MJL_End */
+
 void
 AbstractMemory::regStats()
 {
@@ -394,7 +472,12 @@ AbstractMemory::access(PacketPtr pkt)
     assert(AddrRange(pkt->getAddr(),
                      pkt->getAddr() + (pkt->getSize() - 1)).isSubset(range));
 
+    /* MJL_Begin */
+    uint8_t *hostAddr = MJL_hostAddr(pkt->getAddr());
+    /* MJL_End */
+    /* MJL_Comment
     uint8_t *hostAddr = pmemAddr + pkt->getAddr() - range.start();
+    */
 
     /* MJL_Begin */
     /* MJL_Test: Packet information output  
@@ -439,18 +522,7 @@ AbstractMemory::access(PacketPtr pkt)
             if (pmemAddr) {
                 // MJL_TODO: Can we just copy?
                 /* MJL_Begin */
-                if (pkt->MJL_getDataDir() == MemCmd::MJL_DirAttribute::MJL_IsRow){
-                    memcpy(pkt->getPtr<uint8_t>(), hostAddr, pkt->getSize());
-                } else if (pkt->MJL_getDataDir() == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                    Addr MJL_incColOff = (Addr)(1 << (floorLog2(pkt->req->MJL_rowWidth) + floorLog2(pkt->req->MJL_cachelineSize)));
-                    Addr MJL_colOff = 0;
-                    for (Addr MJL_Offset = 0; MJL_Offset < pkt->getSize(); MJL_Offset = MJL_Offset + sizeof(uint64_t)) {
-                        memcpy(pkt->getPtr<uint8_t>() + MJL_Offset, hostAddr + MJL_colOff, std::min(sizeof(uint64_t), pkt->getSize() - MJL_Offset));
-                        MJL_colOff = MJL_colOff + MJL_incColOff;
-                    }
-                } else {
-                    memcpy(pkt->getPtr<uint8_t>(), hostAddr, pkt->getSize());
-                }
+                MJL_readStore(pkt->getPtr<uint8_t>(), pkt);
                 /* MJL_End */
                 /* MJL_Comment
                 memcpy(pkt->getPtr<uint8_t>(), hostAddr, pkt->getSize());
@@ -471,18 +543,7 @@ AbstractMemory::access(PacketPtr pkt)
             std::memcpy(&overwrite_val[0], pkt->getConstPtr<uint8_t>(),
                         pkt->getSize());
             /* MJL_Begin */
-            if (pkt->MJL_getDataDir() == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                std::memcpy(pkt->getPtr<uint8_t>(), hostAddr, pkt->getSize());
-            } else if (pkt->MJL_getDataDir() == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                Addr MJL_incColOff = (Addr)(1 << (floorLog2(pkt->req->MJL_rowWidth) + floorLog2(pkt->req->MJL_cachelineSize)));
-                Addr MJL_colOff = 0;
-                for (Addr MJL_Offset = 0; MJL_Offset < pkt->getSize(); MJL_Offset = MJL_Offset + sizeof(uint64_t)) {
-                    std::memcpy(pkt->getPtr<uint8_t>() + MJL_Offset, hostAddr + MJL_colOff, std::min(sizeof(uint64_t), pkt->getSize() - MJL_Offset));
-                    MJL_colOff = MJL_colOff + MJL_incColOff;
-                }
-            } else {
-                std::memcpy(pkt->getPtr<uint8_t>(), hostAddr, pkt->getSize());
-            }
+            MJL_readStore(pkt->getPtr<uint8_t>(), pkt);
             /* MJL_End */
             /* MJL_Comment
             std::memcpy(pkt->getPtr<uint8_t>(), hostAddr, pkt->getSize());
@@ -504,18 +565,7 @@ AbstractMemory::access(PacketPtr pkt)
             if (overwrite_mem)
                 /* MJL_Begin */
             {
-                if (pkt->MJL_getDataDir() == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                    std::memcpy(hostAddr, &overwrite_val[0], pkt->getSize());
-                } else if (pkt->MJL_getDataDir() == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                    Addr MJL_incColOff = (Addr)(1 << (floorLog2(pkt->req->MJL_rowWidth) + floorLog2(pkt->req->MJL_cachelineSize)));
-                    Addr MJL_colOff = 0;
-                    for (Addr MJL_Offset = 0; MJL_Offset < pkt->getSize(); MJL_Offset = MJL_Offset + sizeof(uint64_t)) {
-                        std::memcpy(hostAddr + MJL_colOff, &overwrite_val[0] + MJL_Offset, std::min(sizeof(uint64_t), pkt->getSize() - MJL_Offset));
-                        MJL_colOff = MJL_colOff + MJL_incColOff;
-                    }
-                } else {
-                    std::memcpy(hostAddr, &overwrite_val[0], pkt->getSize());
-                }
+                MJL_writeStore(&overwrite_val[0], pkt);
             }
                 /* MJL_End */
                 /* MJL_Comment
@@ -534,18 +584,7 @@ AbstractMemory::access(PacketPtr pkt)
         if (pmemAddr)
             /* MJL_Begin */
         {
-            if (pkt->MJL_getDataDir() == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                memcpy(pkt->getPtr<uint8_t>(), hostAddr, pkt->getSize());
-            } else if (pkt->MJL_getDataDir() == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                Addr MJL_incColOff = (Addr)(1 << (floorLog2(pkt->req->MJL_rowWidth) + floorLog2(pkt->req->MJL_cachelineSize)));
-                Addr MJL_colOff = 0;
-                for (Addr MJL_Offset = 0; MJL_Offset < pkt->getSize(); MJL_Offset = MJL_Offset + sizeof(uint64_t)) {
-                    memcpy(pkt->getPtr<uint8_t>() + MJL_Offset, hostAddr + MJL_colOff, std::min(sizeof(uint64_t), pkt->getSize() - MJL_Offset));
-                    MJL_colOff = MJL_colOff + MJL_incColOff;
-                }
-            } else {
-                memcpy(pkt->getPtr<uint8_t>(), hostAddr, pkt->getSize());
-            }
+            MJL_readStore(pkt->getPtr<uint8_t>(), pkt);
         }
             /* MJL_End */
             /* MJL_Comment
@@ -576,18 +615,7 @@ AbstractMemory::access(PacketPtr pkt)
         if (writeOK(pkt)) {
             if (pmemAddr) {
                 /* MJL_Begin */
-                if (pkt->MJL_getDataDir() == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                    memcpy(hostAddr, pkt->getPtr<uint8_t>(), pkt->getSize());
-                } else if (pkt->MJL_getDataDir() == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                    Addr MJL_incColOff = (Addr)(1 << (floorLog2(pkt->req->MJL_rowWidth) + floorLog2(pkt->req->MJL_cachelineSize)));
-                    Addr MJL_colOff = 0;
-                    for (Addr MJL_Offset = 0; MJL_Offset < pkt->getSize(); MJL_Offset = MJL_Offset + sizeof(uint64_t)) {
-                        memcpy(hostAddr + MJL_colOff, pkt->getPtr<uint8_t>() + MJL_Offset, std::min(sizeof(uint64_t), pkt->getSize() - MJL_Offset));
-                        MJL_colOff = MJL_colOff + MJL_incColOff;
-                    }
-                } else {
-                    memcpy(hostAddr, pkt->getPtr<uint8_t>(), pkt->getSize());
-                }
+                MJL_writeStore(pkt->getConstPtr<uint8_t>(), pkt);
                 /* MJL_End */
                 /* MJL_Comment
                 memcpy(hostAddr, pkt->getConstPtr<uint8_t>(), pkt->getSize());
@@ -671,33 +699,26 @@ AbstractMemory::functionalAccess(PacketPtr pkt)
     assert(AddrRange(pkt->getAddr(),
                      pkt->getAddr() + pkt->getSize() - 1).isSubset(range));
 
+    /* MJL_Begin */
+    uint8_t *hostAddr = MJL_hostAddr(pkt->getAddr());
+    /* MJL_End */
+    /* MJL_Comment
     uint8_t *hostAddr = pmemAddr + pkt->getAddr() - range.start();
+    */
 
     if (pkt->isRead()) {
         if (pmemAddr)
         /* MJL_Begin */
         {
-            if (pkt->MJL_getDataDir() == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                for (int i = 0; i < pkt->getSize(); ++i) {
-                    if (!pkt->MJL_hasDirty(i)) {
-                        memcpy(pkt->getPtr<uint8_t>() + i, hostAddr + i, 1);
-                    }
-                }
-            } else if (pkt->MJL_getDataDir() == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                Addr MJL_incColOff = (Addr)(1 << (floorLog2(pkt->req->MJL_rowWidth) + floorLog2(pkt->req->MJL_cachelineSize)));
-                Addr MJL_colOff = 0;
-                for (Addr MJL_Offset = 0; MJL_Offset < pkt->getSize(); MJL_Offset = MJL_Offset + sizeof(uint64_t)) {
-                    for (int i = 0; i < std::min(sizeof(uint64_t), pkt->getSize() - MJL_Offset); ++i) {
-                        if (!pkt->MJL_hasDirty(MJL_Offset + i)) {
-                            memcpy(pkt->getPtr<uint8_t>() + MJL_Offset + i, hostAddr + MJL_colOff + i, 1);
-                        }
-                    }
-                    MJL_colOff = MJL_colOff + MJL_incColOff;
-                }
+            if (!pkt->MJL_hasAnyDirty()) {
+                MJL_readStore(pkt->getPtr<uint8_t>(), pkt);
             } else {
-                for (int i = 0; i < pkt->getSize(); ++i) {
+                // Keep the bytes the packet already holds dirty
+                std::vector<uint8_t> MJL_storeData(pkt->getSize());
+                MJL_readStore(MJL_storeData.data(), pkt);
+                for (unsigned i = 0; i < pkt->getSize(); ++i) {
                     if (!pkt->MJL_hasDirty(i)) {
-                        memcpy(pkt->getPtr<uint8_t>() + i, hostAddr + i, 1);
+                        pkt->getPtr<uint8_t>()[i] = MJL_storeData[i];
                     }
                 }
             }
@@ -712,18 +733,7 @@ AbstractMemory::functionalAccess(PacketPtr pkt)
         if (pmemAddr)
         /* MJL_Begin */
         {
-            if (pkt->MJL_getDataDir() == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                memcpy(hostAddr, pkt->getConstPtr<uint8_t>(), pkt->getSize());
-            } else if (pkt->MJL_getDataDir() == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                Addr MJL_incColOff = (Addr)(1 << (floorLog2(pkt->req->MJL_rowWidth) + floorLog2(pkt->req->MJL_cachelineSize)));
-                Addr MJL_colOff = 0;
-                for (Addr MJL_Offset = 0; MJL_Offset < pkt->getSize(); MJL_Offset = MJL_Offset + sizeof(uint64_t)) {
-                    memcpy(hostAddr + MJL_colOff, pkt->getPtr<uint8_t>() + MJL_Offset, std::min(sizeof(uint64_t), pkt->getSize() - MJL_Offset));
-                    MJL_colOff = MJL_colOff + MJL_incColOff;
-                }
-            } else {
-                memcpy(hostAddr, pkt->getConstPtr<uint8_t>(), pkt->getSize());
-            }
+            MJL_writeStore(pkt->getConstPtr<uint8_t>(), pkt);
         }
         /* MJL_End */
         /* MJL_Comment
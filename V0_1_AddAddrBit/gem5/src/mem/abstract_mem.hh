@@ -49,6 +49,9 @@
 #ifndef __ABSTRACT_MEMORY_HH__
 #define __ABSTRACT_MEMORY_HH__
 
+/* MJL_Begin */
+#include "mem/addr_geometry.hh"
+/* MJL_End */
 #include "mem/mem_object.hh"
 #include "params/AbstractMemory.hh"
 #include "sim/stats.hh"
@@ -119,6 +122,36 @@ class AbstractMemory : public MemObject
     // Should KVM map this memory for the guest
     const bool kvmMap;
 
+    /* MJL_Begin */
+    /**
+     * Geometry of the tiles when the backing store keeps each tile
+     * contiguous (see MJL_AddrGeometry::MJL_movColRight), nullptr when the
+     * store is in address order.
+     */
+    const MJL_AddrGeometry *const MJL_tileGeometry;
+
+    /**
+     * @return The host address of addr. In a tiled store only the bytes
+     *         of the same block follow it.
+     */
+    uint8_t *MJL_hostAddr(Addr addr) const
+    {
+        Addr offset = addr - range.start();
+        return pmemAddr + (MJL_tileGeometry ?
+                           MJL_tileGeometry->MJL_movColRight(offset) :
+                           offset);
+    }
+
+    /**
+     * Copy the data the packet addresses from the store to dst. A tile
+     * packet addresses the lines it carries, one after the other in dst.
+     */
+    void MJL_readStore(uint8_t *dst, const PacketPtr pkt) const;
+
+    /** Copy src to the data the packet addresses in the store */
+    void MJL_writeStore(const uint8_t *src, const PacketPtr pkt);
+    /* MJL_End */
+
     std::list<LockedAddr> lockedAddrList;
 
     // helper function for checkLockedAddrs(): we really want to
@@ -302,6 +335,17 @@ class AbstractMemory : public MemObject
      */
     bool isKvmMap() const { return kvmMap; }
 
+    /* MJL_Begin */
+    /**
+     * @return The tile geometry of a tiled backing store, nullptr if the
+     *         store is in address order
+     */
+    const MJL_AddrGeometry *MJL_getTileGeometry() const
+    {
+        return MJL_tileGeometry;
+    }
+    /* MJL_End */
+
     /**
      * Perform an untimed memory access and update all the state
      * (e.g. locked addresses) and statistics accordingly. The packet
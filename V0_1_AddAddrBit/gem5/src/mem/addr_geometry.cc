@@ -0,0 +1,38 @@
+/* MJL_Begin */
+
+#include "mem/addr_geometry.hh"
+
+#include <map>
+#include <utility>
+
+#include "base/intmath.hh"
+#include "base/misc.hh"
+
+const MJL_AddrGeometry &
+MJL_AddrGeometry::MJL_get(unsigned blk_size, unsigned row_width)
+{
+    // Map nodes never move, so the references handed out stay valid
+    static std::map<std::pair<unsigned, unsigned>, MJL_AddrGeometry> geometries;
+
+    fatal_if(!isPowerOf2(blk_size) || blk_size < sizeof(uint64_t),
+             "Block size %d is not a power of 2 number of words\n", blk_size);
+    fatal_if(!isPowerOf2(row_width),
+             "Row width %d is not a power of 2\n", row_width);
+    auto it = geometries.find(std::make_pair(blk_size, row_width));
+    if (it == geometries.end()) {
+        it = geometries.emplace(std::make_pair(blk_size, row_width),
+                                MJL_AddrGeometry(blk_size, row_width)).first;
+    }
+    return it->second;
+}
+
+const MJL_AddrGeometry *MJL_AddrGeometry::MJL_systemGeometry =
+    &MJL_defaultAddrGeometry;
+
+void
+MJL_AddrGeometry::MJL_setSystemGeometry(const MJL_AddrGeometry &geometry)
+{
+    MJL_systemGeometry = &geometry;
+}
+
+/* MJL_End */
@@ -0,0 +1,165 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Row/column address geometry shared by the packets, caches, snoop
+ * filters and prefetchers, with the shifts and masks worked out once.
+ */
+
+#ifndef __MEM_ADDR_GEOMETRY_HH__
+#define __MEM_ADDR_GEOMETRY_HH__
+
+#include <cstdint>
+
+#include "base/types.hh"
+
+/**
+ * A block holds blkSize/8 words. A row block is the words at consecutive
+ * addresses, a column block is the same word position of blkSize/8 blocks
+ * that are rowWidth blocks apart. So the word index of a row block is at
+ * MJL_rowShift and the word index of a column block is at MJL_colShift,
+ * and swapping the two fields maps an address between the directions.
+ *
+ * Objects are immutable and interned by MJL_get, so a pointer to one can
+ * be kept in every request without copying.
+ */
+class MJL_AddrGeometry
+{
+  private:
+    static constexpr int MJL_log2(unsigned x)
+    {
+        return x <= 1 ? 0 : 1 + MJL_log2(x >> 1);
+    }
+
+  public:
+    /** Block size in bytes */
+    const unsigned MJL_blkSize;
+    /** Row size in blocks */
+    const unsigned MJL_rowWidth;
+    /** Shift of the word index in a row block */
+    const int MJL_rowShift;
+    /** Shift of the word index in a column block */
+    const int MJL_colShift;
+    /** log2 of the words per block */
+    const int MJL_wordShift;
+    /** Word index mask, unshifted */
+    const Addr MJL_wordMask;
+    /** Bits that are the offset within a column block */
+    const Addr MJL_blkMaskColumn;
+    /** Bits that differ between the blocks of a tile */
+    const Addr MJL_commonMask;
+
+    constexpr MJL_AddrGeometry(unsigned blk_size, unsigned row_width)
+        : MJL_blkSize(blk_size), MJL_rowWidth(row_width),
+          MJL_rowShift(MJL_log2(sizeof(uint64_t))),
+          MJL_colShift(MJL_log2(row_width) + MJL_log2(blk_size)),
+          MJL_wordShift(MJL_log2(blk_size/sizeof(uint64_t))),
+          MJL_wordMask(blk_size/sizeof(uint64_t) - 1),
+          MJL_blkMaskColumn(((Addr)(blk_size/sizeof(uint64_t) - 1) <<
+                             (MJL_log2(row_width) + MJL_log2(blk_size))) |
+                            (sizeof(uint64_t) - 1)),
+          MJL_commonMask(((Addr)(blk_size/sizeof(uint64_t) - 1) <<
+                          (MJL_log2(row_width) + MJL_log2(blk_size))) |
+                         ((Addr)(blk_size/sizeof(uint64_t) - 1) <<
+                          MJL_log2(sizeof(uint64_t))))
+    {}
+
+    /** @return The address with the row and column word indices swapped */
+    constexpr Addr MJL_swapRowColBits(Addr addr) const
+    {
+        return (addr & ~MJL_commonMask) |
+               (((addr >> MJL_colShift) & MJL_wordMask) << MJL_rowShift) |
+               (((addr >> MJL_rowShift) & MJL_wordMask) << MJL_colShift);
+    }
+
+    /** @return The address without the bits that differ within a tile */
+    constexpr Addr MJL_commonBits(Addr addr) const
+    {
+        return addr & ~MJL_commonMask;
+    }
+
+    /** @return The address of the column block holding addr */
+    constexpr Addr MJL_colBlockAlign(Addr addr) const
+    {
+        return addr & ~MJL_blkMaskColumn;
+    }
+
+    /** @return The address offset bytes down the column from base */
+    constexpr Addr MJL_addColOffset(Addr MJL_baseAddr, unsigned offset) const
+    {
+        return MJL_swapRowColBits(MJL_swapRowColBits(MJL_baseAddr) +
+                                  Addr(offset));
+    }
+
+    /**
+     * @return The index of a block within its tile, rows are told apart
+     *         by the column word index and columns by the row word index
+     */
+    constexpr int MJL_tileLine(Addr blk_addr, bool column) const
+    {
+        return (blk_addr >> (column ? MJL_rowShift : MJL_colShift)) &
+               MJL_wordMask;
+    }
+
+    /**
+     * Move the column word index right next to the row word index, so
+     * the blocks of a tile are contiguous.
+     */
+    Addr MJL_movColRight(Addr addr) const
+    {
+        Addr high_mask = ~((Addr(1) << (MJL_colShift + MJL_wordShift)) - 1);
+        Addr middle_mask = Addr(MJL_rowWidth - 1) << MJL_log2(MJL_blkSize);
+        Addr same = addr & (high_mask | Addr(sizeof(uint64_t) - 1));
+        Addr middle = addr & middle_mask;
+        Addr col = (addr >> MJL_colShift) & MJL_wordMask;
+        Addr row = (addr >> MJL_rowShift) & MJL_wordMask;
+        return same | (middle << MJL_wordShift) |
+               (col << (MJL_wordShift + MJL_rowShift)) |
+               (row << MJL_rowShift);
+    }
+
+    /** Inverse of MJL_movColRight */
+    Addr MJL_movColLeft(Addr addr) const
+    {
+        Addr high_mask = ~((Addr(1) << (MJL_colShift + MJL_wordShift)) - 1);
+        Addr middle_mask = Addr(MJL_rowWidth - 1) << MJL_log2(MJL_blkSize);
+        Addr same = addr & (high_mask | Addr(sizeof(uint64_t) - 1));
+        Addr middle = addr & (middle_mask << MJL_wordShift);
+        Addr row = (addr >> MJL_rowShift) & MJL_wordMask;
+        Addr col = (addr >> (MJL_rowShift + MJL_wordShift)) & MJL_wordMask;
+        return same | (col << MJL_colShift) | (middle >> MJL_wordShift) |
+               (row << MJL_rowShift);
+    }
+
+    /**
+     * @return The interned geometry for the configuration, so the same
+     *         configuration always gives the same object
+     */
+    static const MJL_AddrGeometry &MJL_get(unsigned blk_size,
+                                           unsigned row_width);
+
+    /**
+     * Geometry requests start with, set by the System from its cache line
+     * size and row width
+     */
+    static const MJL_AddrGeometry &MJL_getSystemGeometry()
+    {
+        return *MJL_systemGeometry;
+    }
+    static void MJL_setSystemGeometry(const MJL_AddrGeometry &geometry);
+
+  private:
+    static const MJL_AddrGeometry *MJL_systemGeometry;
+};
+
+/** The 64B block, 512 block row configuration, fully known at compile time */
+constexpr MJL_AddrGeometry MJL_defaultAddrGeometry(64, 512);
+static_assert(MJL_defaultAddrGeometry.MJL_swapRowColBits(0x8) == 0x8000,
+              "Word 1 of a row block is word 1 of a column block");
+static_assert(MJL_defaultAddrGeometry.MJL_tileLine(0x18000, false) == 3 &&
+              MJL_defaultAddrGeometry.MJL_tileLine(0x18, true) == 3,
+              "Row 3 and column 3 of a tile are line 3");
+
+#endif // __MEM_ADDR_GEOMETRY_HH__
+
+/* MJL_End */
@@ -41,10 +41,41 @@
 
 from m5.params import *
 from m5.proxy import *
+from m5.SimObject import SimObject
 from MemObject import MemObject
 from Prefetcher import BasePrefetcher
+# MJL_Begin
+from DirPredictor import MJL_BaseDirPredictor
+# MJL_End
 from Tags import *
 
+# MJL_Begin
+# Enum for the role of a cache in the hierarchy. MJL_AutoLevel derives the
+# role from the SimObject name (dcache, icache, l2, l3) for the existing
+# configs, any other value overrides the name.
+class MJL_CacheLevel(Enum): vals = ['MJL_AutoLevel', 'MJL_L1I', 'MJL_L1D',
+                                    'MJL_L2', 'MJL_LLC', 'MJL_OtherLevel']
+
+# System-wide PC to direction table, loaded once and shared by every L1 data
+# cache. The file is either the text PC2Dir format or a binary table made by
+# util/mjl_pc2dir_convert.py, which is mmapped read-only.
+class MJL_PC2DirTable(SimObject):
+    type = 'MJL_PC2DirTable'
+    cxx_header = "mem/cache/pc2dir_table.hh"
+
+    file = Param.String("PC2Dir.txt", "File with PC to direction mapping")
+    vec_list_file = Param.String("", "File with list of PC numbers of vector instructions, only used for text input")
+
+# System-wide table of the address regions the workload registered with a
+# preferred direction through the m5_mjl_region_dir pseudo-op. The L1 data
+# caches look the virtual address of every request up in it.
+class MJL_RegionDirTable(SimObject):
+    type = 'MJL_RegionDirTable'
+    cxx_header = "mem/cache/region_dir_table.hh"
+
+    system = Param.System(Parent.any, "System the workload registers the regions in")
+# MJL_End
+
 class BaseCache(MemObject):
     type = 'BaseCache'
     abstract = True
@@ -57,14 +88,15 @@ class BaseCache(MemObject):
     MJL_default_column = Param.Bool(Parent.MJL_default_column, "Set default preference of all data accesses to column")
     MJL_2D_Cache = Param.Bool(False, "Set the corresponding cache to physically 2D cache")
     MJL_has2DLLC = Param.Bool(False, "There is a physically 2D LLC in the memory system")
-    MJL_timeStep = Param.Cycles(0, "Time step of intermediate output in cycles")
     MJL_2D_Transfer_Type = Param.Int(0, "Set the type of transfer method from memory to L2 cache in physically 2D cache, 0 for per line on demand, 1 for whole tile")
+    MJL_tile_packets = Param.Bool(True, "Send the lines of a tile below as one tile packet in whole tile transfer mode")
     MJL_extra2DWrite_latency = Param.Cycles(0,"Additional data write access latency for physically 2D caches")
     MJL_sameSetMapping = Param.Bool(False, "The flag to get same set mapping for row and column in the cache")
     MJL_oracleProxy = Param.Bool(False, "The flag to get oracle proxy mapping for row and column in the cache")
     MJL_oracleProxyReplay = Param.Bool(False, "The flag to use oracle proxy result for cache accesses")
     MJL_bloomFilterSize = Param.Unsigned(0, "Size of the bloom filter, 0 when there isn't one")
     MJL_bloomFilterHashFuncId = Param.Unsigned(0, "Indicates which hash function to use for the bloom filter")
+    MJL_cacheLevel = Param.MJL_CacheLevel('MJL_AutoLevel', "Role of this cache in the hierarchy (L1I, L1D, L2, LLC)")
     # MJL_End 
 
     tag_latency = Param.Cycles("Tag lookup latency")
@@ -128,12 +160,10 @@ class Cache(BaseCache):
     # MJL_Begin
     MJL_PC2DirFile = Param.String("PC2Dir.txt", "File with PC to direction mapping")
     MJL_VecListFile = Param.String("", "File with list of PC numbers of vector instructions")
-    MJL_predictDir = Param.Bool(False, "Let direction predictor decide whether to generate miss in column or row")
-    MJL_1streamPredictDir = Param.Bool(False, "Use the 1 stream stride scheme for direction predictor")
-    MJL_utilPredictDir = Param.Bool(False, "Use the utilization scheme for direction predictor")
-    MJL_mshrPredictDir = Param.Bool(False, "Use the mshr scheme for direction predictor")
-    MJL_pfBasedPredictDir = Param.Bool(False, "Use the prefetch scheme for direction predictor")
-    MJL_combinePredictDir = Param.Bool(False, "Use the combine scheme for direction predictor")
-    MJL_linkMshr = Param.Bool(False, "When using mshr scheme for direction predictor, whether the observable history is linked to the MSHR's behavior")
+    MJL_pc2DirTable = Param.MJL_PC2DirTable(NULL, "Shared PC to direction table, overrides MJL_PC2DirFile and MJL_VecListFile when set")
+    MJL_regionDirTable = Param.MJL_RegionDirTable(NULL, "Shared table of the direction regions registered by the workload")
+    MJL_dirPredictor = Param.MJL_BaseDirPredictor(NULL, "Direction predictor deciding whether to generate miss in column or row")
     MJL_ignoreExtraTagCheckLatency = Param.Bool(False, "Used for debug")
+    MJL_footPrintLogSize = Param.Unsigned(0, "Number of tiles tracked by the footprint log of physically 2D caches, 0 for one per cache set")
+    MJL_dirTraceMemCap = Param.MemorySize("16MB", "Memory cap of the per-PC direction trace buffers at L2")
     # MJL_End
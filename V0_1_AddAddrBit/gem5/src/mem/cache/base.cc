@@ -66,6 +66,31 @@ BaseCache::CacheSlavePort::CacheSlavePort(const std::string &_name,
 {
 }
 
+/* MJL_Begin */
+/**
+ * Resolve the role of a cache. An explicit MJL_cacheLevel parameter is
+ * used as is, otherwise the role is derived from the SimObject name the
+ * way the standard configs name their caches.
+ */
+static Enums::MJL_CacheLevel
+MJL_resolveCacheLevel(const BaseCacheParams *p)
+{
+    if (p->MJL_cacheLevel != Enums::MJL_AutoLevel) {
+        return p->MJL_cacheLevel;
+    }
+    if (p->name.find("dcache") != std::string::npos) {
+        return Enums::MJL_L1D;
+    } else if (p->name.find("icache") != std::string::npos) {
+        return Enums::MJL_L1I;
+    } else if (p->name.find("l2") != std::string::npos) {
+        return Enums::MJL_L2;
+    } else if (p->name.find("l3") != std::string::npos) {
+        return Enums::MJL_LLC;
+    }
+    return Enums::MJL_OtherLevel;
+}
+/* MJL_End */
+
 BaseCache::BaseCache(const BaseCacheParams *p, unsigned blk_size)
     : MemObject(p),
       cpuSidePort(nullptr), memSidePort(nullptr),/* MJL_Begin */
@@ -76,13 +101,16 @@ BaseCache::BaseCache(const BaseCacheParams *p, unsigned blk_size)
       blkSize(blk_size),
       /* MJL_Begin */
       MJL_rowWidth(p->MJL_row_width),
+      MJL_geometry(MJL_AddrGeometry::MJL_get(blk_size, p->MJL_row_width)),
       MJL_defaultColumn(p->MJL_default_column),
       MJL_2DCache(p->MJL_2D_Cache),
       MJL_has2DLLC(p->MJL_has2DLLC),
       MJL_2DTransferType(p->MJL_2D_Transfer_Type),
+      MJL_tilePackets(p->MJL_tile_packets),
       MJL_extra2DWriteLatency(p->MJL_extra2DWrite_latency),
       MJL_oracleProxy(p->MJL_oracleProxy),
       MJL_oracleProxyReplay(p->MJL_oracleProxyReplay),
+      MJL_cacheLevel(MJL_resolveCacheLevel(p)),
       /* MJL_End */
       lookupLatency(p->tag_latency),
       dataLatency(p->data_latency),
@@ -109,6 +137,14 @@ BaseCache::BaseCache(const BaseCacheParams *p, unsigned blk_size)
     // whether the connected master is actually snooping or not
     /* MJL_Begin */
     assert(MJL_2DTransferType == 0 || MJL_2DTransferType == 1);
+    fatal_if(blkSize > Packet::MJL_maxBlkSize,
+             "Block size %d is larger than the packet word masks (%d)\n",
+             blkSize, Packet::MJL_maxBlkSize);
+    MJL_perPCAddrOracleProxyStats = nullptr;
+    // Crossing searches in the queues only look at the entries of a tile
+    Addr MJL_tileMask = ~(Addr(blkSize - 1) | MJL_geometry.MJL_blkMaskColumn);
+    mshrQueue.MJL_setTileMask(MJL_tileMask);
+    writeBuffer.MJL_setTileMask(MJL_tileMask);
     /* MJL_End */
 }
 
@@ -922,6 +958,50 @@ BaseCache::regStats()
         .flags(nozero)
         ;
 
+    MJL_footPrintHits
+        .name(name() + ".MJL_footPrintHits")
+        .desc("number of footprint fetches that found the tile in the footprint log")
+        .flags(nozero)
+        ;
+
+    MJL_footPrintMisses
+        .name(name() + ".MJL_footPrintMisses")
+        .desc("number of footprint fetches that did not find the tile in the footprint log")
+        .flags(nozero)
+        ;
+
+    MJL_footPrintEvictions
+        .name(name() + ".MJL_footPrintEvictions")
+        .desc("number of tiles dropped from the full footprint log")
+        .flags(nozero)
+        ;
+
+    MJL_footPrintHitRate
+        .name(name() + ".MJL_footPrintHitRate")
+        .desc("hit rate of the footprint log on footprint fetches")
+        .flags(nozero | nonan)
+        ;
+    MJL_footPrintHitRate = MJL_footPrintHits / (MJL_footPrintHits + MJL_footPrintMisses);
+
+    MJL_tileReqs
+        .name(name() + ".MJL_tileReqs")
+        .desc("number of tile packets sent below")
+        .flags(nozero)
+        ;
+
+    MJL_tileReqLines
+        .name(name() + ".MJL_tileReqLines")
+        .desc("number of lines sent below in tile packets")
+        .flags(nozero)
+        ;
+
+    MJL_avgTileReqLines
+        .name(name() + ".MJL_avgTileReqLines")
+        .desc("average number of lines per tile packet")
+        .flags(nozero | nonan)
+        ;
+    MJL_avgTileReqLines = MJL_tileReqLines / MJL_tileReqs;
+
     MJL_overallInterestedRowMisses
         .name(name() + ".MJL_overallInterestedRowMisses")
         .desc("number of overall row misses that are caused by interested instructions")
@@ -1080,48 +1160,6 @@ BaseCache::regStats()
         .flags(nozero)
         ;
 
-    MJL_numOfPredicts
-        .name(name() + ".MJL_numOfPredicts")
-        .desc("number of orientation predictions")
-        .flags(nozero)
-        ;
-
-    MJL_numOfMSHRPredicts
-        .name(name() + ".MJL_numOfMSHRPredicts")
-        .desc("number of mshr based orientation predictions")
-        .flags(nozero)
-        ;
-
-    MJL_numOfPfPredicts
-        .name(name() + ".MJL_numOfPfPredicts")
-        .desc("number of prefetcher based orientation predictions")
-        .flags(nozero)
-        ;
-    
-    MJL_numOfDiffPredicts
-        .name(name() + ".MJL_numOfDiffPredicts")
-        .desc("number of times where mshr based and prefetcher based orientation predictions differ")
-        .flags(nozero)
-        ;
-
-    MJL_numOfWarmupPredicts_MSHR
-        .name(name() + ".MJL_numOfWarmupPredicts_MSHR")
-        .desc("number of times where mshr based orientation prediction is still invalid")
-        .flags(nozero)
-        ;
-
-    MJL_numOfWarmupPredicts_Pf
-        .name(name() + ".MJL_numOfWarmupPredicts_Pf")
-        .desc("number of times where prefetcher based orientation prediction is still invalid")
-        .flags(nozero)
-        ;
-
-    MJL_numOfCopyMSHRQueueEvictNonResolved
-        .name(name() + ".MJL_numOfCopyMSHRQueueEvictNonResolved")
-        .desc("number of evictions from copyMSHRQueue where the corresponding MSHR entry hasn't been released yet")
-        .flags(nozero)
-        ;
-
     MJL_pfDropped
         .init(11)
         .name(name() + ".MJL_pfDropped")
@@ -62,6 +62,9 @@
 #include "debug/Cache.hh"
 #include "debug/CachePort.hh"
 #include "mem/cache/mshr_queue.hh"
+/* MJL_Begin */
+#include "mem/cache/oracle_proxy_table.hh"
+/* MJL_End */
 #include "mem/cache/write_queue.hh"
 #include "mem/mem_object.hh"
 #include "mem/packet.hh"
@@ -742,7 +745,8 @@ class BaseCache : public MemObject
             }
     };
     
-    std::map < Addr, std::map < Addr, MJL_oracleProxyStats * > > * MJL_perPCAddrOracleProxyStats;
+    /** Recorded per (PC, address) oracle proxy hits, nullptr when not recording */
+    MJL_PCAddrOracleRecorder * MJL_perPCAddrOracleProxyStats;
     /* MJL_End */
 
   protected:
@@ -820,14 +824,20 @@ class BaseCache : public MemObject
     /* MJL_Begin */
     /** Row size of this memory system in number of cachelines */
     const unsigned MJL_rowWidth;
+    /** Row/column address geometry of this cache */
+    const MJL_AddrGeometry &MJL_geometry;
     const bool MJL_defaultColumn;
     /** Whether this cache physically 2D */
     const bool MJL_2DCache;
     const bool MJL_has2DLLC;
     const int MJL_2DTransferType;
+    /** Whether whole tile transfers are sent as tile packets */
+    const bool MJL_tilePackets;
     const Cycles MJL_extra2DWriteLatency;
     const bool MJL_oracleProxy;
     const bool MJL_oracleProxyReplay;
+    /** Role of this cache in the hierarchy, resolved once at construction */
+    const Enums::MJL_CacheLevel MJL_cacheLevel;
     /* MJL_End */
 
     /**
@@ -1050,6 +1060,13 @@ class BaseCache : public MemObject
     Stats::Scalar MJL_mshrConflictCount;
     Stats::Scalar MJL_requestedBytes;
     Stats::Scalar MJL_touchedBytes;
+    Stats::Scalar MJL_footPrintHits;
+    Stats::Scalar MJL_footPrintMisses;
+    Stats::Scalar MJL_footPrintEvictions;
+    Stats::Formula MJL_footPrintHitRate;
+    Stats::Scalar MJL_tileReqs;
+    Stats::Scalar MJL_tileReqLines;
+    Stats::Formula MJL_avgTileReqLines;
     Stats::Scalar MJL_overallInterestedRowMisses;
     Stats::Scalar MJL_overallInterestedRowHits;
     Stats::Scalar MJL_overallInterestedColumnMisses;
@@ -1075,13 +1092,6 @@ class BaseCache : public MemObject
     Stats::Scalar MJL_predFalse;
     Stats::Scalar MJL_unusedRowPrefetches;
     Stats::Scalar MJL_unusedColumnPrefetches;
-    Stats::Scalar MJL_numOfPredicts;
-    Stats::Scalar MJL_numOfMSHRPredicts;
-    Stats::Scalar MJL_numOfPfPredicts;
-    Stats::Scalar MJL_numOfDiffPredicts;
-    Stats::Scalar MJL_numOfWarmupPredicts_MSHR;
-    Stats::Scalar MJL_numOfWarmupPredicts_Pf;
-    Stats::Scalar MJL_numOfCopyMSHRQueueEvictNonResolved;
     Stats::Vector MJL_pfDropped;
     Stats::Scalar MJL_untouchedPrefetches;
     bool MJL_Debug_Out;
@@ -1130,10 +1140,7 @@ class BaseCache : public MemObject
             while (!MJL_accessPCList->empty()) {
                 Addr PC = MJL_accessPCList->front();
                 Addr addr = MJL_accessAddrList->front();
-                if (MJL_perPCAddrOracleProxyStats->find(PC) == MJL_perPCAddrOracleProxyStats->end() || (*MJL_perPCAddrOracleProxyStats)[PC].find(addr) == (*MJL_perPCAddrOracleProxyStats)[PC].end()) {
-                    (*MJL_perPCAddrOracleProxyStats)[PC][addr] = new MJL_oracleProxyStats();
-                }
-                (*MJL_perPCAddrOracleProxyStats)[PC][addr]->count_hits(num_hits, blkDir);
+                MJL_perPCAddrOracleProxyStats->MJL_countHits(PC, addr, num_hits, blkDir);
                 MJL_accessPCList->pop_front();
                 MJL_accessAddrList->pop_front();
             }
@@ -1150,23 +1157,15 @@ class BaseCache : public MemObject
     }
 
     Addr MJL_blockAlign(Addr addr, MemCmd::MJL_DirAttribute MJL_dir) const {
-        if (MJL_dir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-            return (addr & ~(Addr(blkSize - 1)));
-        } else if (MJL_dir == MemCmd::MJL_DirAttribute::MJL_IsColumn) { // MJL_temp: temporary fix for column
-            return (addr & ~(Addr((blkSize/sizeof(uint64_t) - 1) << (floorLog2(MJL_rowWidth) + floorLog2(blkSize))) | (sizeof(uint64_t) - 1)));
+        if (MJL_dir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
+            return MJL_geometry.MJL_colBlockAlign(addr);
         } else {
             return (addr & ~(Addr(blkSize - 1)));
         }
     }
 
     Addr MJL_swapRowColBits(Addr addr) const {
-        int MJL_rowShift = floorLog2(sizeof(uint64_t));
-        uint64_t MJL_wordMask = blkSize/sizeof(uint64_t) - 1;
-        int MJL_colShift = floorLog2(MJL_rowWidth) + floorLog2(blkSize);
-
-        Addr new_row = (addr >> MJL_colShift) & (Addr)MJL_wordMask;
-        Addr new_col = (addr >> MJL_rowShift) & (Addr)MJL_wordMask;
-        return ((addr & ~(((Addr)MJL_wordMask << MJL_colShift) | ((Addr)MJL_wordMask << MJL_rowShift))) | (new_row << MJL_rowShift) | (new_col << MJL_colShift));
+        return MJL_geometry.MJL_swapRowColBits(addr);
     }
     /**
      * MJL_baseAddr: starting address
@@ -1175,10 +1174,8 @@ class BaseCache : public MemObject
      * return the address of the word
      */
     Addr MJL_addOffsetAddr(Addr MJL_baseAddr, MemCmd::MJL_DirAttribute MJL_cacheBlkDir, unsigned offset) const {
-        if (MJL_cacheBlkDir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-            return MJL_baseAddr + Addr(offset);
-        } else if (MJL_cacheBlkDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) { // MJL_temp temporary fix for column
-            return MJL_swapRowColBits(MJL_swapRowColBits(MJL_baseAddr) + Addr(offset));
+        if (MJL_cacheBlkDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
+            return MJL_geometry.MJL_addColOffset(MJL_baseAddr, offset);
         } else {
             return MJL_baseAddr + Addr(offset);
         }
@@ -1245,7 +1242,7 @@ class BaseCache : public MemObject
                 // If the packet is a write and the crossing word is written
                 if (pkt->isWrite() && (offset < target_offset + size && offset + sizeof(uint64_t) > target_offset)) {
                     /* MJL_Test */
-                    if (MJL_Debug_Out && this->name().find("dcache") != std::string::npos) {
+                    if (MJL_Debug_Out && MJL_isL1D()) {
                         std::clog << "MJL_Debug: markblock " << mshr << "->" << new_target << std::endl;
                         std::clog << mshr->print() << std::endl;
                         std::clog << ", blocked by " << crossMshr << std::endl;
@@ -1260,7 +1257,7 @@ class BaseCache : public MemObject
                 // Else if the packet is write but the crossing word is not written
                 } else if (pkt->isWrite()) {
                     /* MJL_Test */
-                    if (MJL_Debug_Out && this->name().find("dcache") != std::string::npos) {
+                    if (MJL_Debug_Out && MJL_isL1D()) {
                         std::clog << "MJL_Debug: markblock " << mshr << "->" << new_target << std::endl;
                         std::clog << mshr->print() << std::endl;
                         std::clog << ", blocked by " << crossMshr << std::endl;
@@ -1275,7 +1272,7 @@ class BaseCache : public MemObject
                 // And If there is a write target in the crossing mshr
                 } else if (crossMshr->MJL_getLastWriteTarget(target_cross_offset, blkSize, !new_mshr)) {
                     /* MJL_Test */
-                    if (MJL_Debug_Out && this->name().find("dcache") != std::string::npos) {
+                    if (MJL_Debug_Out && MJL_isL1D()) {
                         std::clog << "MJL_Debug: markblock " << mshr << "->" << new_target << std::endl;
                         std::clog << mshr->print() << std::endl;
                         std::clog << ", blocked by " << crossMshr << std::endl;
@@ -1291,7 +1288,7 @@ class BaseCache : public MemObject
                 // mark potential block information for when a target becomes the first of an mshr due to stale previous response and not being served
                 } else if (crossMshr->MJL_getLastWriteTarget(target_cross_offset, blkSize, false)) {
                     /* MJL_Test */
-                    if (MJL_Debug_Out && this->name().find("dcache") != std::string::npos) {
+                    if (MJL_Debug_Out && MJL_isL1D()) {
                         std::clog << "MJL_Debug: markblock " << mshr << "->" << new_target << std::endl;
                         std::clog << mshr->print() << std::endl;
                         std::clog << ", may be blocked by " << crossMshr << std::endl;
@@ -1326,6 +1323,18 @@ class BaseCache : public MemObject
     }
 
     unsigned MJL_getRowWidth() const { return MJL_rowWidth; }
+    const MJL_AddrGeometry &MJL_getGeometry() const { return MJL_geometry; }
+    Enums::MJL_CacheLevel MJL_getCacheLevel() const { return MJL_cacheLevel; }
+    bool MJL_isL1D() const { return MJL_cacheLevel == Enums::MJL_L1D; }
+    bool MJL_isL2() const { return MJL_cacheLevel == Enums::MJL_L2; }
+    bool MJL_isLLC() const { return MJL_cacheLevel == Enums::MJL_LLC; }
+    /** Whether this cache handles row/column accesses (L1D, L2 or LLC) */
+    bool MJL_isDataCache() const
+    {
+        return MJL_cacheLevel == Enums::MJL_L1D
+            || MJL_cacheLevel == Enums::MJL_L2
+            || MJL_cacheLevel == Enums::MJL_LLC;
+    }
     virtual void MJL_markBlocked2D(PacketPtr pkt, MSHR * mshr) = 0;
     MJL_RowColBloomFilter * MJL_get_rowColBloomFilter() const { return MJL_rowColBloomFilter; }
     MJL_Test_RowColBloomFilters * MJL_get_Test_rowColBloomFilters() const { return MJL_Test_rowColBloomFilters; }
@@ -1337,7 +1346,7 @@ class BaseCache : public MemObject
     {
         /* MJL_Begin */
         MSHR *mshr = nullptr;
-        if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+        if (MJL_isDataCache()) {
             mshr = mshrQueue.allocate(MJL_blockAlign(pkt->getAddr(), pkt->MJL_getCmdDir()), blkSize,
                                         pkt, time, order++,
                                         allocOnFill(pkt->cmd));
@@ -1353,7 +1362,7 @@ class BaseCache : public MemObject
                                         allocOnFill(pkt->cmd));
         */
         /* MJL_Begin */
-        if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+        if (MJL_isDataCache()) {
             MJL_markBlockInfo(mshr);
         }
         if (MJL_2DCache && mshr->getTarget()->source != MSHR::Target::FromPrefetcher) { 
@@ -1391,7 +1400,7 @@ class BaseCache : public MemObject
         */
         /* MJL_Begin */
             writeBuffer.MJL_findMatch(blk_addr, pkt->MJL_getDataDir(), pkt->isSecure());
-        WriteQueueEntry *crossing_wq_entry = writeBuffer.MJL_findMatchCrossing(blk_addr, pkt->MJL_getDataDir(), pkt->isSecure(), ~(Addr(blkSize - 1) | Addr(pkt->MJL_blkMaskColumn(blkSize, pkt->req->MJL_rowWidth))));
+        WriteQueueEntry *crossing_wq_entry = writeBuffer.MJL_findMatchCrossing(blk_addr, pkt->MJL_getDataDir(), pkt->isSecure(), ~(Addr(blkSize - 1) | Addr(MJL_geometry.MJL_blkMaskColumn)));
         if (crossing_wq_entry && (wq_entry == nullptr || (wq_entry && crossing_wq_entry->getTarget()->readyTime > wq_entry->getTarget()->readyTime))) {
             wq_entry = crossing_wq_entry;
         }
@@ -1408,9 +1417,7 @@ class BaseCache : public MemObject
             MJL_time = wq_entry->getTarget()->readyTime;
         }
         /* MJL_Test */
-        if (MJL_Debug_Out && (this->name().find("dcache") != std::string::npos
-                || this->name().find("l2") != std::string::npos
-                || this->name().find("l3") != std::string::npos)
+        if (MJL_Debug_Out && MJL_isDataCache()
                 // && (pkt->req->hasPC() && pkt->req->getPC() >= 0x407360 && pkt->req->getPC() <=0x4074ab )
                 // && ( MJL_debugOutFlag )
                 // && (pkt->getAddr() >= 0x38c000 && pkt->getAddr() < 0x390000)
@@ -117,8 +117,8 @@ class CacheBlk
     
     /** block data direction */
     MJL_CacheBlkDir MJL_blkDir;
-    bool MJL_wordDirty[8];
-    bool MJL_crossValid[8];
+    bool MJL_wordDirty[Packet::MJL_maxBlkWords];
+    bool MJL_crossValid[Packet::MJL_maxBlkWords];
     bool MJL_wasDirty; // to mark the blocks that are clean but has data that's different from the next levels (dirty passed back to the upper level caches)
     bool MJL_untouchedPrefetch;
     // For oracle proxy mode stats gathering
@@ -158,42 +158,6 @@ class CacheBlk
         Addr highAddr;     // high address of lock range
         /* MJL_Begin */
         Request::MJL_DirAttribute MJL_reqDir;
-        inline int
-        floorLog2(unsigned long x) const
-        {
-            assert(x > 0);
-
-            int y = 0;
-
-        #if defined(__LP64__)
-            if (x & ULL(0xffffffff00000000)) { y += 32; x >>= 32; }
-        #endif
-            if (x & 0xffff0000) { y += 16; x >>= 16; }
-            if (x & 0x0000ff00) { y +=  8; x >>=  8; }
-            if (x & 0x000000f0) { y +=  4; x >>=  4; }
-            if (x & 0x0000000c) { y +=  2; x >>=  2; }
-            if (x & 0x00000002) { y +=  1; }
-
-            return y;
-        }
-        Addr MJL_swapRowColBits(Addr addr, unsigned blkSize, unsigned MJL_rowWidth) const 
-        {
-            int MJL_rowShift = floorLog2(sizeof(uint64_t));
-            uint64_t MJL_wordMask = blkSize/sizeof(uint64_t) - 1;
-            int MJL_colShift = floorLog2(MJL_rowWidth) + floorLog2(blkSize);
-
-            Addr new_row = (addr >> MJL_colShift) & (Addr)MJL_wordMask;
-            Addr new_col = (addr >> MJL_rowShift) & (Addr)MJL_wordMask;
-            return ((addr & ~(((Addr)MJL_wordMask << MJL_colShift) | ((Addr)MJL_wordMask << MJL_rowShift))) | (new_row << MJL_rowShift) | (new_col << MJL_colShift));
-        }
-        Addr MJL_commonMask(Addr addr, unsigned blkSize, unsigned MJL_rowWidth) const 
-        {
-            int MJL_rowShift = floorLog2(sizeof(uint64_t));
-            uint64_t MJL_wordMask = blkSize/sizeof(uint64_t) - 1;
-            int MJL_colShift = floorLog2(MJL_rowWidth) + floorLog2(blkSize);
-
-            return (addr & ~(((Addr)MJL_wordMask << MJL_colShift) | ((Addr)MJL_wordMask << MJL_rowShift)));
-        }
         /* MJL_End */
 
         // check for matching execution context, and an address that
@@ -206,7 +170,7 @@ class CacheBlk
             if ( req->MJL_reqIsRow() ) {
                 req_high = req_low + req->getSize() -1;
             } else if ( req->MJL_reqIsColumn() ) { //MJL_temp temporary fix for column
-                req_high = MJL_swapRowColBits(MJL_swapRowColBits(req_low, req->MJL_cachelineSize, req->MJL_rowWidth) + req->getSize() -1, req->MJL_cachelineSize, req->MJL_rowWidth);
+                req_high = req->MJL_geometry->MJL_swapRowColBits(req->MJL_geometry->MJL_swapRowColBits(req_low) + req->getSize() -1);
             } else {
                 req_high = req_low + req->getSize() -1;
             }
@@ -233,7 +197,7 @@ class CacheBlk
             if ( req->MJL_reqIsRow() ) {
                 req_high = req_low + req->getSize() -1;
             } else if ( req->MJL_reqIsColumn() ) { //MJL_temp temporary fix for column
-                req_high = MJL_swapRowColBits(MJL_swapRowColBits(req_low, req->MJL_cachelineSize, req->MJL_rowWidth) + req->getSize() -1, req->MJL_cachelineSize, req->MJL_rowWidth);
+                req_high = req->MJL_geometry->MJL_swapRowColBits(req->MJL_geometry->MJL_swapRowColBits(req_low) + req->getSize() -1);
             } else {
                 req_high = req_low + req->getSize() -1;
             }
@@ -241,8 +205,8 @@ class CacheBlk
                 return (req_low <= highAddr) && (req_high >= lowAddr);
             } else {
                 //MJL_temp temporary fix for column, assuming that req->getSize() is smaller cacheline size
-                assert(req->getSize() <= req->MJL_cachelineSize);
-                return (MJL_commonMask(req_low, req->MJL_cachelineSize, req->MJL_rowWidth) == MJL_commonMask(lowAddr, req->MJL_cachelineSize, req->MJL_rowWidth));
+                assert(req->getSize() <= req->MJL_geometry->MJL_blkSize);
+                return (req->MJL_geometry->MJL_commonBits(req_low) == req->MJL_geometry->MJL_commonBits(lowAddr));
             }
             /* MJL_End */
             /* MJL_Comment
@@ -261,7 +225,7 @@ class CacheBlk
               /* MJL_End */
         {
             /* MJL_Begin */
-            highAddr = MJL_swapRowColBits(MJL_swapRowColBits(lowAddr, req->MJL_cachelineSize, req->MJL_rowWidth) + req->getSize() -1, req->MJL_cachelineSize, req->MJL_rowWidth);
+            highAddr = req->MJL_geometry->MJL_swapRowColBits(req->MJL_geometry->MJL_swapRowColBits(lowAddr) + req->getSize() -1);
             /* MJL_End */
         }
     };
@@ -277,8 +241,8 @@ class CacheBlk
           asid(-1), tag(0), data(0) ,size(0), status(0),
           /* MJL_Begin */ 
           MJL_blkDir(MJL_CacheBlkDir::MJL_IsRow),
-          MJL_wordDirty{false, false, false, false, false, false, false, false},
-          MJL_crossValid{false, false, false, false, false, false, false, false},
+          MJL_wordDirty{},
+          MJL_crossValid{},
           MJL_wasDirty(false),
           MJL_untouchedPrefetch(false),
           MJL_accessPCList(nullptr),
@@ -369,12 +333,13 @@ class CacheBlk
 
     /* MJL_Begin */
     void MJL_regOracleProxyStats(Addr PC, Addr addr) {
-        if (MJL_accessPCList) {
-            MJL_accessPCList->push_back(PC);
-        }
-        if (MJL_accessAddrList) {
-            MJL_accessAddrList->push_back(addr);
+        // Only the blocks of a recording cache ever get the lists
+        if (!MJL_accessPCList) {
+            MJL_accessPCList = new std::list< Addr >();
+            MJL_accessAddrList = new std::list< Addr >();
         }
+        MJL_accessPCList->push_back(PC);
+        MJL_accessAddrList->push_back(addr);
     }
     /**
      * Check if this block holds data in row direction
@@ -400,7 +365,7 @@ class CacheBlk
     void MJL_updateDirty()
     {
         bool dirty = false;
-        for (int i = 0; i < 8; ++i) {
+        for (unsigned i = 0; i < Packet::MJL_maxBlkWords; ++i) {
             dirty |= MJL_wordDirty[i];
         }
         if (dirty) {
@@ -431,7 +396,7 @@ class CacheBlk
      */
     void MJL_setAllDirty()
     {
-        for (int i = 0; i < 8; ++i) {
+        for (unsigned i = 0; i < Packet::MJL_maxBlkWords; ++i) {
             MJL_wordDirty[i] = true;
         }
     }
@@ -441,7 +406,7 @@ class CacheBlk
      */
     void MJL_clearAllDirty()
     {
-        for (int i = 0; i < 8; ++i) {
+        for (unsigned i = 0; i < Packet::MJL_maxBlkWords; ++i) {
             MJL_wordDirty[i] = false;
         }
     }
@@ -463,7 +428,7 @@ class CacheBlk
     bool MJL_hasCrossValid()
     {
         bool MJL_crossIsValid = false;
-        for (int i = 0; i < 8; ++i) {
+        for (unsigned i = 0; i < Packet::MJL_maxBlkWords; ++i) {
             MJL_crossIsValid |= MJL_crossValid[i];
         }
         return MJL_crossIsValid;
@@ -475,7 +440,7 @@ class CacheBlk
     bool MJL_allCrossValid()
     {
         bool MJL_allValid = true;
-        for (int i = 0; i < 8; ++i) {
+        for (unsigned i = 0; i < Packet::MJL_maxBlkWords; ++i) {
             MJL_allValid &= MJL_crossValid[i];
         }
         return MJL_allValid;
@@ -486,7 +451,7 @@ class CacheBlk
      */
     void MJL_clearCrossValid()
     {
-        for (int i = 0; i < 8; ++i) {
+        for (unsigned i = 0; i < Packet::MJL_maxBlkWords; ++i) {
             MJL_crossValid[i] = false;
         }
     }
@@ -496,7 +461,7 @@ class CacheBlk
      */
     void MJL_setAllCrossValid()
     {
-        for (int i = 0; i < 8; ++i) {
+        for (unsigned i = 0; i < Packet::MJL_maxBlkWords; ++i) {
             MJL_crossValid[i] = true;
         }
     }
@@ -62,6 +62,9 @@
 #include "mem/cache/mshr.hh"
 #include "mem/cache/prefetch/base.hh"
 #include "sim/sim_exit.hh"
+/* MJL_Begin */
+#include "base/output.hh"
+/* MJL_End */
 
 /* MJL_Begin */
 std::map< Addr, uint8_t[8] > MJL_current_data;
@@ -73,19 +76,17 @@ Cache::Cache(const CacheParams *p)
     : BaseCache(p, p->system->cacheLineSize()),
       tags(p->tags),
       prefetcher(p->prefetcher),/* MJL_Begin */
-      MJL_predictDir(p->MJL_predictDir),
-      MJL_1streamPredictDir(p->MJL_1streamPredictDir),
-      MJL_utilPredictDir(p->MJL_utilPredictDir), 
-      MJL_mshrPredictDir(p->MJL_mshrPredictDir), 
-      MJL_pfBasedPredictDir(p->MJL_pfBasedPredictDir),
-      MJL_combinePredictDir(p->MJL_combinePredictDir),
-      MJL_linkMshr(p->MJL_linkMshr),
-      MJL_ignoreExtraTagCheckLatency(p->MJL_ignoreExtraTagCheckLatency), /* MJL_End */
+      MJL_dirPredictor(p->MJL_dirPredictor),
+      MJL_ignoreExtraTagCheckLatency(p->MJL_ignoreExtraTagCheckLatency),
+      MJL_dirTraceMemCap(p->MJL_dirTraceMemCap), /* MJL_End */
       doFastWrites(true),
       prefetchOnAccess(p->prefetch_on_access),
       clusivity(p->clusivity),
       writebackClean(p->writeback_clean),
       tempBlockWriteback(nullptr),/* MJL_Begin */
+      MJL_pc2DirIndex(p->MJL_pc2DirTable ?
+                      &p->MJL_pc2DirTable->MJL_getIndex() : nullptr),
+      MJL_regionDirTable(p->MJL_regionDirTable),
       MJL_PC2DirFilename(p->MJL_PC2DirFile),
       MJL_VecListFilename(p->MJL_VecListFile), /* MJL_End */
       writebackTempBlockAtomicEvent(this, false,
@@ -104,30 +105,26 @@ Cache::Cache(const CacheParams *p)
         prefetcher->setCache(this);
 
     /* MJL_Begin */
-    if (this->name().find("dcache") != std::string::npos) {
-        MJL_readPC2DirMap();
-        if (MJL_VecListFilename != "") {
-            MJL_readVecList();
+    if (MJL_isL1D()) {
+        // The shared table is loaded once by the system, only read the
+        // files here when this cache was not given one
+        if (!MJL_pc2DirIndex) {
+            MJL_readPC2DirMap();
         }
+        MJL_initColVecList();
     }
     MJL_sndPacketWaiting = false;
     MJL_colVecHandler.cache = this;
 
     if (MJL_2DCache) {
-        MJL_footPrint = new MJL_FootPrint(tags->getNumSets(), tags->getNumSets());
+        MJL_footPrint = new MJL_FootPrint(p->MJL_footPrintLogSize ? p->MJL_footPrintLogSize : tags->getNumSets(), tags->getNumSets(), MJL_footPrintEvictions);
     }
     
     std::cout << "MJL_2DCache? " << MJL_2DCache << std::endl;
-    bool MJL_pred_Debug_Out = false;
-    /* MJL_Test 
-    if (this->name().find("dcache") != std::string::npos && this->name().find("cpu2") != std::string::npos) {
-        MJL_pred_Debug_Out = true;
-    }
-    */
     MJL_perPCAddrAccessCount = nullptr;
-    if (MJL_predictDir) {
-        MJL_dirPredictor = new MJL_DirPredictor(this, blkSize, MJL_pred_Debug_Out, MJL_rowWidth, MJL_1streamPredictDir, MJL_utilPredictDir, MJL_mshrPredictDir, MJL_pfBasedPredictDir, MJL_combinePredictDir, MJL_linkMshr);
-        if (this->name().find("dcache") != std::string::npos) {
+    if (MJL_dirPredictor) {
+        MJL_dirPredictor->setCache(this);
+        if (MJL_isL1D()) {
             MJL_perPCAddrAccessCount = new std::map < Addr, std::map < Addr, std::map< MemCmd::MJL_DirAttribute, uint64_t > > > ();
             registerExitCallback(new MakeCallback<Cache, &Cache::MJL_printPCAddrAccess>(this));
         }
@@ -135,22 +132,23 @@ Cache::Cache(const CacheParams *p)
     if (MJL_bloomFilterSize > 0) {
         MJL_rowColBloomFilter = new MJL_RowColBloomFilter(this->name() + ".MJL_bloomfilter", MJL_bloomFilterSize, tags->getNumSets() * tags->getNumWays(), MJL_rowWidth, blkSize, MJL_bloomFilterHashFuncId);//, true);
     }
-    if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+    if (MJL_isDataCache()) {
         std::cout << "MJL_ignoreExtraTagCheckLatency? " << MJL_ignoreExtraTagCheckLatency << std::endl;
     }
     /* MJL_End */
     /* MJL_Test */ 
-    if (this->name().find("l2") != std::string::npos) {
+    if (MJL_isL2()) {
     // if (this->name().find("l2") != std::string::npos || this->name().find("dcache") != std::string::npos) {
-        MJL_perPCAccessCount = new std::map < Addr, std::map < MemCmd::MJL_DirAttribute, uint64_t > >();
-        MJL_perPCAccessTrace = new std::map < Addr, std::vector < MemCmd::MJL_DirAttribute > >();
+        MJL_perPCAccessTrace = new MJL_DirTraceSink(simout.resolve(this->name() + "_dirTrace.gz"), MJL_dirTraceMemCap);
         registerExitCallback(new MakeCallback<Cache, &Cache::MJL_printAccess>(this));
     }
-    /* if (MJL_oracleProxy && this->name().find("dcache") != std::string::npos) {
-        MJL_perPCAddrOracleProxyStats = new std::map < Addr, std::map < Addr, MJL_oracleProxyStats * > >();
-        // registerExitCallback(new MakeCallback<Cache, &Cache::MJL_printOracleProxyStats>(this));
-    } */
     /* */
+    /* MJL_Begin */
+    if (MJL_oracleProxy && MJL_isL1D()) {
+        MJL_perPCAddrOracleProxyStats = new MJL_PCAddrOracleRecorder();
+        registerExitCallback(new MakeCallback<Cache, &Cache::MJL_printOracleProxyStats>(this));
+    }
+    /* MJL_End */
     /* MJL_Test  
     std::vector< unsigned > hash_func_ids;
     std::vector< unsigned > sizes;
@@ -167,7 +165,7 @@ Cache::Cache(const CacheParams *p)
     for (unsigned i = 1; i <= tags->getNumSets() * tags->getNumWays() / 2; i = 2*i) {
         sizes.emplace_back(i);
     }
-    if ((this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) && !MJL_2DCache) {
+    if (MJL_isDataCache() && !MJL_2DCache) {
         MJL_Test_rowColBloomFilters = new MJL_Test_RowColBloomFilters(this->name(), tags->getNumSets() * tags->getNumWays(), MJL_rowWidth, blkSize, hash_func_ids, sizes, true);
         registerExitCallback(new MakeCallback<Cache, &Cache::MJL_printTestBloomFiltersStats>(this));
     }
@@ -177,8 +175,7 @@ Cache::Cache(const CacheParams *p)
 Cache::~Cache()
 {
     /* MJL_Test */
-    if (this->name().find("l2") != std::string::npos) {
-        delete MJL_perPCAccessCount;
+    if (MJL_isL2()) {
         delete MJL_perPCAccessTrace;
     }
     if (MJL_Test_rowColBloomFilters) {
@@ -194,9 +191,6 @@ Cache::~Cache()
     if (MJL_2DCache) {
         delete MJL_footPrint;
     }
-    if (MJL_predictDir) {
-        delete MJL_dirPredictor;
-    }
     if (MJL_rowColBloomFilter) {
         delete MJL_rowColBloomFilter;
     }
@@ -287,7 +281,7 @@ Cache::satisfyRequest(PacketPtr pkt, CacheBlk *blk,
     assert( (pkt->MJL_getCmdDir() == blk->MJL_blkDir) || (pkt->getSize() <= sizeof(uint64_t)) 
             || MJL_2DCache);
     // Test for L1D$
-    if (this->name().find("dcache") != std::string::npos) {
+    if (MJL_isL1D()) {
        assert ((pkt->req->MJL_isVec()) || (pkt->getSize() <= sizeof(uint64_t)));
     }
     // MJL_TODO: a use case of getOffset, I think the direction of the cmd should be used, the requested size should not exceed the blksize anyway. And different direction should only happen when the size is smaller than a word.
@@ -301,7 +295,8 @@ Cache::satisfyRequest(PacketPtr pkt, CacheBlk *blk,
     // }
     assert(!pkt->isWrite() || pkt->getOffset(blkSize) + pkt->getSize() <= blkSize);
     pkt->MJL_setDataDir(MJL_origDataDir);
-    /* if (MJL_oracleProxy && pkt->req->hasPC()) {
+    // Record the accesses each block serves until it is evicted
+    if (MJL_perPCAddrOracleProxyStats && pkt->req->hasPC()) {
         blk->MJL_regOracleProxyStats(pkt->req->getPC(), pkt->getAddr());
         if (pkt->getSize() <= sizeof(uint64_t)) {
             CacheBlk::MJL_CacheBlkDir cross_blkDir = blk->MJL_blkDir;
@@ -315,7 +310,7 @@ Cache::satisfyRequest(PacketPtr pkt, CacheBlk *blk,
                 cross_blk->MJL_regOracleProxyStats(pkt->req->getPC(), pkt->getAddr());
             }
         }
-    } */
+    }
     /* MJL_End */
     /* MJL_Comment
     assert(pkt->getOffset(blkSize) + pkt->getSize() <= blkSize);
@@ -342,7 +337,7 @@ Cache::satisfyRequest(PacketPtr pkt, CacheBlk *blk,
                 for (int i = pkt->MJL_getRowOffset(blkSize); i < pkt->MJL_getRowOffset(blkSize) + pkt->getSize(); i = i + (sizeof(uint64_t) - i%sizeof(uint64_t))) {
                     memcpy(tags->MJL_findBlockByTile(blk, i/sizeof(uint64_t))->data + MJL_offset + i%sizeof(uint64_t), &MJL_tempData[i * sizeof(uint64_t)], sizeof(uint64_t) - i%sizeof(uint64_t));
                 }
-            } else if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+            } else if (MJL_isDataCache()) {
                 // Setting the direction to make sure that offset is calculated correctly. Maybe can also be used to collect the statistics on different directional hit?
                 pkt->MJL_setDataDir(blk->MJL_blkDir);
                 /* MJL_Test 
@@ -370,7 +365,7 @@ Cache::satisfyRequest(PacketPtr pkt, CacheBlk *blk,
                 tags->MJL_findBlockByTile(blk, i/sizeof(uint64_t))->status |= BlkDirty;
             }
         // If the access is row or this is a physically 1D, logically 2D cache
-        } else if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+        } else if (MJL_isDataCache()) {
             for (int i = pkt->getOffset(blkSize); i < pkt->getOffset(blkSize) + pkt->getSize(); i = i + sizeof(uint64_t)) {
                 blk->MJL_setWordDirty(i/sizeof(uint64_t));
             }
@@ -401,16 +396,13 @@ Cache::satisfyRequest(PacketPtr pkt, CacheBlk *blk,
             // In physically 2D cache, the cmd and the data direction should always align
             assert(pkt->MJL_sameCmdDataDir());
             // Construct the word dirty from the blocks in sets forming a column, and pass the information to pkt
-            bool MJL_crossBlkWordDirty[blkSize/sizeof(uint64_t)];
-            for (int i = 0; i < blkSize/sizeof(uint64_t); ++i) {
-                MJL_crossBlkWordDirty[i] = false;
-            }
+            Packet::MJL_WordMask MJL_crossBlkWordDirty;
             for (int i = pkt->getOffset(blkSize); i < pkt->getOffset(blkSize) + pkt->getSize(); i = i + sizeof(uint64_t) - i%sizeof(uint64_t)) {
                 MJL_crossBlkWordDirty[i/sizeof(uint64_t)] = tags->MJL_findBlockByTile(blk, i/sizeof(uint64_t))->MJL_wordDirty[pkt->MJL_getColOffset(blkSize)/sizeof(uint64_t)];
             }
             pkt->MJL_copyWordDirty(MJL_crossBlkWordDirty);
         // If the access is row or this is a physically 1D, logically 2D cache
-        } else if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+        } else if (MJL_isDataCache()) {
             pkt->MJL_setDataDir(blk->MJL_blkDir);
             if (blk->isDirty()) {// now that wordDirty does not mean block is dirty, this needs to be tested. 
                 pkt->MJL_setWordDirtyFromBlk(blk->MJL_wordDirty, blkSize);
@@ -467,7 +459,7 @@ Cache::satisfyRequest(PacketPtr pkt, CacheBlk *blk,
                             tags->MJL_findBlockByTile(blk, i/sizeof(uint64_t))->MJL_clearWordDirty(pkt->MJL_getColOffset(blkSize)/sizeof(uint64_t));
                             tags->MJL_findBlockByTile(blk, i/sizeof(uint64_t))->MJL_updateDirty();
                         }
-                    } else if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+                    } else if (MJL_isDataCache()) {
                         blk->MJL_clearAllDirty();
                         blk->status &= ~BlkDirty;
                     } else {
@@ -493,7 +485,7 @@ Cache::satisfyRequest(PacketPtr pkt, CacheBlk *blk,
                 //   copy of the line
                 if (blk->isDirty()) {
                     // special considerations if we're owner:
-                    if (!deferred_response/* MJL_Begin  && (this->name().find("dcache") == std::string::npos && this->name().find("l2") == std::string::npos && this->name().find("l3") == std::string::npos) MJL_End */) {
+                    if (!deferred_response/* MJL_Begin  && !MJL_isDataCache() MJL_End */) {
                         // respond with the line in Modified state
                         // (cacheResponding set, hasSharers not set)
                         pkt->setCacheResponding();
@@ -519,7 +511,7 @@ Cache::satisfyRequest(PacketPtr pkt, CacheBlk *blk,
                                 tags->MJL_findBlockByTile(blk, i/sizeof(uint64_t))->MJL_clearWordDirty(pkt->MJL_getColOffset(blkSize)/sizeof(uint64_t));
                                 tags->MJL_findBlockByTile(blk, i/sizeof(uint64_t))->MJL_updateDirty();
                             }
-                        } else if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+                        } else if (MJL_isDataCache()) {
                             //blk->MJL_clearAllDirty(); //keep the per word dirty data for wasDirty conflict check
                             blk->status &= ~BlkDirty;
                             blk->MJL_wasDirty |= true; //to indicate the block has different data then that's in the next levels
@@ -570,7 +562,7 @@ Cache::satisfyRequest(PacketPtr pkt, CacheBlk *blk,
                     tags->MJL_findBlockByTile(blk, i/sizeof(uint64_t))->MJL_updateDirty();
                 }
                 pkt->MJL_setWordDirtyFromBlk(MJL_tempWordDirty, blkSize);
-            } else if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+            } else if (MJL_isDataCache()) {
                 pkt->MJL_setWordDirtyFromBlk(blk->MJL_wordDirty, blkSize);
                 blk->MJL_clearAllDirty();
                 blk->status &= ~BlkDirty;
@@ -648,18 +640,18 @@ Cache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
     // Here lat is the value passed as parameter to accessBlock() function
     // that can modify its value.
     /* MJL_Begin */
-    if ( pkt->getSize() <= sizeof(uint64_t) && (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos)) { // Less than a word, cross direction possible
+    if ( pkt->getSize() <= sizeof(uint64_t) && MJL_isDataCache()) { // Less than a word, cross direction possible
         blk = tags->MJL_accessBlockOneWord(pkt->getAddr(), pkt->MJL_getCmdDir(), pkt->isSecure(), lat, id);
     } else if (MJL_2DCache && pkt->MJL_cmdIsColumn()) {
         blk = tags->MJL_accessCrossBlock(pkt->getAddr(), CacheBlk::MJL_CacheBlkDir::MJL_IsRow, pkt->isSecure(), lat, id, pkt->MJL_getColOffset(blkSize));
-    } else if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+    } else if (MJL_isDataCache()) {
         blk = tags->MJL_accessBlock(pkt->getAddr(), pkt->MJL_getCmdDir(), pkt->isSecure(), lat, id);
     } else {
         blk = tags->accessBlock(pkt->getAddr(), pkt->isSecure(), lat, id);
     }
     // MJL_TODO: may need to change lat if vector load/store is not possible
-    if (MJL_predictDir && (MJL_utilPredictDir || MJL_mshrPredictDir || MJL_combinePredictDir)) {
-        MJL_dirPredictor->MJL_updatePredictMshrQueue(pkt);
+    if (MJL_dirPredictor) {
+        MJL_dirPredictor->MJL_observe(pkt);
     }
     /* MJL_End */
     /* MJL_Comment
@@ -682,7 +674,7 @@ Cache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
         /* MJL_Begin */
         // MJL_TODO: Eviction should be from cache, so should be cacheline size requests. Writeback should be in order. Should we check the other direction as well for clean eviction?
         WriteQueueEntry *wb_entry = nullptr;
-        if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+        if (MJL_isDataCache()) {
             wb_entry = writeBuffer.MJL_findMatch(pkt->getAddr(),
                                                                 pkt->MJL_getCmdDir(),
                                                                 pkt->isSecure());
@@ -740,9 +732,9 @@ Cache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
         // any ordering/decisions about ownership already taken
         if (pkt->cmd == MemCmd::WritebackClean &&
         /* MJL_Begin */
-            (((this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) 
+            ((MJL_isDataCache() 
                 && mshrQueue.MJL_findMatch(pkt->getAddr(), pkt->MJL_getCmdDir(), pkt->isSecure())) 
-            || ((this->name().find("dcache") == std::string::npos && this->name().find("l2") == std::string::npos && this->name().find("l3") == std::string::npos) 
+            || (!MJL_isDataCache() 
                 && mshrQueue.findMatch(pkt->getAddr(), pkt->isSecure()))) ) {
         /* MJL_End */
         /* MJL_Comment
@@ -787,7 +779,7 @@ Cache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
         if (blk == nullptr) {
             // need to do a replacement
             /* MJL_Begin */
-            if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+            if (MJL_isDataCache()) {
                 assert(pkt->MJL_getCmdDir() == pkt->MJL_getDataDir());
                 blk = MJL_allocateBlock(pkt->getAddr(), pkt->MJL_getDataDir(), pkt->isSecure(), writebacks);
             } else {
@@ -900,7 +892,7 @@ Cache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
                 } else {
                     blk->MJL_setWordDirtyPkt(pkt, blkSize);
                 }
-            } else if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+            } else if (MJL_isDataCache()) {
                 assert (pkt->MJL_getCmdDir() == blk->MJL_blkDir);
                 // Bloom filter check
                 bool MJL_bloomFilterHasCross = true;
@@ -1030,7 +1022,7 @@ Cache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
         //     }
         // }
 
-        if (pkt->isWrite() && (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) && !MJL_2DCache ) {
+        if (pkt->isWrite() && MJL_isDataCache() && !MJL_2DCache ) {
             // Bloom filter check
             bool MJL_bloomFilterHasCross = true;
             if (MJL_rowColBloomFilter) {
@@ -1090,7 +1082,7 @@ Cache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
     }
     /* MJL_Begin */
     // Write upgrade miss
-    if (blk && pkt->isWrite() && (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) && !MJL_2DCache ) {
+    if (blk && pkt->isWrite() && MJL_isDataCache() && !MJL_2DCache ) {
         // Oracle proxy mode should not have upgrade misses since it can write without writable
         // assert(!MJL_oracleProxy); 
         // Bloom filter check
@@ -1109,11 +1101,11 @@ Cache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
     // We are going to bring in a cache line, crossing lines with dirty data at the crossing needs to be written back
     // And if the access were a write, then the crossing lines to the write section needs to be invalidated as well
     // If the cache is physically 2D, then there's no need for all this
-    if (blk == nullptr /* && !MJL_oracleProxy */ && (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) && !MJL_2DCache ) {
+    if (blk == nullptr /* && !MJL_oracleProxy */ && MJL_isDataCache() && !MJL_2DCache ) {
         CacheBlk *MJL_crossBlk = nullptr;
         Addr MJL_crossBlkAddr;
         Cycles templat = lat;
-        if (MJL_predictDir) {
+        if (MJL_dirPredictor) {
             MemCmd::MJL_DirAttribute MJL_predDir = MJL_dirPredictor->MJL_predictDir(pkt);
             pkt->cmd.MJL_setCmdDir(MJL_predDir);
             pkt->MJL_setDataDir(MJL_predDir);
@@ -1213,7 +1205,7 @@ Cache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
                     }
                 // in the case of cross block was dirty on crossing word, the packet should mark the corresponding word as stale
                 } else if (MJL_crossBlk->MJL_wasDirty && MJL_crossBlk->MJL_wordDirty[MJL_crossBlkOffset/sizeof(uint64_t)]) {
-                    pkt->MJL_isStale[MJL_offset/sizeof(uint64_t)] |= true;
+                    pkt->MJL_isStale[MJL_offset/sizeof(uint64_t)] = true;
                 // Otherwise, just revoke writable
                 } else {
                     MJL_crossBlk->status &= ~BlkWritable;
@@ -1398,7 +1390,7 @@ Cache::promoteWholeLineWrites(PacketPtr pkt)
 {
     // Cache line clearing instructions
     /* MJL_Begin */
-    if (pkt->cmd == MemCmd::WriteReq && (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos)) {
+    if (pkt->cmd == MemCmd::WriteReq && MJL_isDataCache()) {
         // For writes, dataDir should be the same as cmdDir, and getOffset() works on MJL_dataDir
         assert(pkt->MJL_sameCmdDataDir());
     }
@@ -1514,7 +1506,7 @@ Cache::recvTimingReq(PacketPtr pkt)
         if (MJL_rowColBloomFilter) {
             MJL_bloomFilterHasCross = MJL_rowColBloomFilter->hasCross(pkt->getAddr(), pkt->MJL_getCmdDir());
         }
-        if (!MJL_2DCache && !MJL_ignoreExtraTagCheckLatency && MJL_bloomFilterHasCross && (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) && 
+        if (!MJL_2DCache && !MJL_ignoreExtraTagCheckLatency && MJL_bloomFilterHasCross && MJL_isDataCache() && 
             ((!satisfied && !pkt->req->isUncacheable() && pkt->cmd != MemCmd::CleanEvict && !pkt->isWriteback())
             || (satisfied && pkt->cmd == MemCmd::WritebackDirty))) {
             forward_time = clockEdge(Cycles( blkSize/sizeof(uint64_t) * forwardLatency)) + pkt->headerDelay;
@@ -1570,11 +1562,6 @@ Cache::recvTimingReq(PacketPtr pkt)
             if (!pkt->cmd.isSWPrefetch())
                 next_pf_time = prefetcher->notify(pkt);
         }
-        /* MJL_Begin */
-        if (false && MJL_predictDir && !(MJL_utilPredictDir || MJL_mshrPredictDir || MJL_pfBasedPredictDir || MJL_combinePredictDir)) {
-            MJL_dirPredictor->MJL_updateStride(pkt);
-        }
-        /* MJL_End */
 
         if (needsResponse) {
             pkt->makeTimingResponse();
@@ -1603,7 +1590,7 @@ Cache::recvTimingReq(PacketPtr pkt)
         /* MJL_Begin */
         Addr blk_addr;
         MSHR *mshr = nullptr;
-        if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+        if (MJL_isDataCache()) {
             if (blk && blk->isValid() && pkt->needsWritable()) {
                 assert(!pkt->req->isUncacheable());
 
@@ -1632,7 +1619,7 @@ Cache::recvTimingReq(PacketPtr pkt)
                     }
                 }
                 /* MJL_TOADD: To avoid illegal passing of writable on read miss, needs to verify if this breaks anything
-                if (!MJL_2DCache && mshrQueue.MJL_hasCrossing(pkt->getAddr(), pkt->MJL_getCmdDir(), pkt->isSecure(), ~(Addr(blkSize - 1) | Addr(pkt->MJL_blkMaskColumn(blkSize, pkt->req->MJL_rowWidth))))) {
+                if (!MJL_2DCache && mshrQueue.MJL_hasCrossing(pkt->getAddr(), pkt->MJL_getCmdDir(), pkt->isSecure(), ~(Addr(blkSize - 1) | Addr(MJL_geometry.MJL_blkMaskColumn)))) {
                     pkt->setHasSharers(); 
                 }*/
             }
@@ -1681,11 +1668,10 @@ Cache::recvTimingReq(PacketPtr pkt)
                                              pkt->req->masterId());
                 
                 /* MJL_Begin */
-                if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+                if (MJL_isDataCache()) {
                     req->MJL_setReqDir(pkt->req->MJL_getReqDir());
                 }
-                req->MJL_cachelineSize = blkSize;
-                req->MJL_rowWidth = MJL_rowWidth;
+                req->MJL_geometry = &MJL_geometry;
                 // MJL_TODO: not sure whether this would cause problem, but reqDir may not be the same as cmdDir
                 //assert(pkt->req->MJL_getReqDir() == pkt->MJL_getCmdDir());
                 /* MJL_End */
@@ -1741,7 +1727,7 @@ Cache::recvTimingReq(PacketPtr pkt)
                     mshr->allocateTarget(pkt, forward_time, order++,
                                          allocOnFill(pkt->cmd));
                     /* MJL_Begin */
-                    if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+                    if (MJL_isDataCache()) {
                         MJL_markBlockInfo(mshr, false);
                     }
                     /* MJL_End */
@@ -1798,12 +1784,14 @@ Cache::recvTimingReq(PacketPtr pkt)
                             for (int i = 0; i < 8; ++i) {
                                 CacheBlk *tile_blk = tags->MJL_findBlockByTile(tile, i);
                                 if (tile_blk->isValid()) {
-                                    pkt->MJL_crossBlocksCached[i] |= true;
+                                    pkt->MJL_crossBlocksCached[i] = true;
                                 }
                             }
                         } else if (pkt->MJL_cmdIsRow()) {
                             for (int i = 0; i < 8; ++i) {
-                                pkt->MJL_crossBlocksCached[i] |= tile->MJL_crossValid[i];
+                                if (tile->MJL_crossValid[i]) {
+                                    pkt->MJL_crossBlocksCached[i] = true;
+                                }
                             }
                         }
                     }
@@ -1892,8 +1880,8 @@ Cache::recvTimingReq(PacketPtr pkt)
                 /* MJL_Begin */
                 MSHR* MJL_newMshr = /* MJL_End */allocateMissBuffer(pkt, forward_time);
                 /* MJL_Begin */
-                if (MJL_predictDir && (MJL_utilPredictDir || MJL_mshrPredictDir || MJL_combinePredictDir)) {
-                    MJL_dirPredictor->MJL_addToPredictMshrQueue(pkt, MJL_newMshr);
+                if (MJL_dirPredictor) {
+                    MJL_dirPredictor->MJL_missAllocated(pkt, MJL_newMshr);
                 }
                 if (MJL_2DCache && MJL_2DTransferType == 1) {
                      MJL_allocateFullMissBuffer(pkt, forward_time);
@@ -1966,7 +1954,7 @@ Cache::createMissPacket(PacketPtr cpu_pkt, CacheBlk *blk,
         // MJL_TODO: coherence related
         cmd = MemCmd::InvalidateReq;
         /* MJL_Begin */
-        if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+        if (MJL_isDataCache()) {
             cmd.MJL_setCmdDir(cpu_pkt->MJL_getCmdDir());
         }
         /* MJL_End */
@@ -1982,7 +1970,7 @@ Cache::createMissPacket(PacketPtr cpu_pkt, CacheBlk *blk,
         assert(!blk->isWritable());
         cmd = cpu_pkt->isLLSC() ? MemCmd::SCUpgradeReq : MemCmd::UpgradeReq;
         /* MJL_Begin */
-        if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+        if (MJL_isDataCache()) {
             cmd.MJL_setCmdDir(blk->MJL_blkDir);
         }
         /* MJL_End */
@@ -1994,7 +1982,7 @@ Cache::createMissPacket(PacketPtr cpu_pkt, CacheBlk *blk,
         // all caches not being on the same local bus.
         cmd = MemCmd::SCUpgradeFailReq;
         /* MJL_Begin */
-        if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+        if (MJL_isDataCache()) {
             cmd.MJL_setCmdDir(cpu_pkt->MJL_getCmdDir());
         }
         /* MJL_End */
@@ -2003,7 +1991,7 @@ Cache::createMissPacket(PacketPtr cpu_pkt, CacheBlk *blk,
         cmd = needsWritable ? MemCmd::ReadExReq :
             (isReadOnly ? MemCmd::ReadCleanReq : MemCmd::ReadSharedReq);
         /* MJL_Begin */
-        if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+        if (MJL_isDataCache()) {
             cmd.MJL_setCmdDir(cpu_pkt->MJL_getCmdDir());
         }
         /* MJL_End */
@@ -2026,14 +2014,14 @@ Cache::createMissPacket(PacketPtr cpu_pkt, CacheBlk *blk,
     // the packet should be block aligned
     /* MJL_Begin */
     pkt->MJL_copyWordDemanded(cpu_pkt->MJL_wordDemanded);
-    if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+    if (MJL_isDataCache()) {
         assert(pkt->getAddr() == MJL_blockAlign(pkt->getAddr(), pkt->MJL_getCmdDir()));
     } else {
         assert(pkt->getAddr() == blockAlign(pkt->getAddr()));
     }
     /* MJL_End */
     /* MJL_Test 
-    if (this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+    if (MJL_isL2() || MJL_isLLC()) {
         if (cpu_pkt->cmd == MemCmd::HardPFReq ) {
             std::cout << "MJL_colPfDebug: prefetch triggered miss packet " << pkt->print() << std::endl;
         }
@@ -2079,7 +2067,7 @@ Cache::recvAtomic(PacketPtr pkt)
 
     /* MJL_Begin */
     // In oracle proxy mode, make updates about data first if it's a write. 
-    /* if (MJL_oracleProxy && pkt->isWrite() && this->name().find("dcache") != std::string::npos) {
+    /* if (MJL_oracleProxy && pkt->isWrite() && MJL_isL1D()) {
         PacketPtr func_pkt = new Packet(pkt, false, pkt->hasData());
         func_pkt->setData(pkt->getConstPtr<uint8_t>());
         functionalAccess(func_pkt, true);
@@ -2124,7 +2112,7 @@ Cache::recvAtomic(PacketPtr pkt)
         /* MJL_Begin 
         // In oracle proxy mode, should make a column miss packet as well. Column blk should not exist since if it existed, there should not have been a miss anyway
          PacketPtr col_bus_pkt = nullptr;
-        if (!is_forward && MJL_oracleProxy && this->name().find("dcache") != std::string::npos && pkt->getSize() <= sizeof(uint64_t)) { 
+        if (!is_forward && MJL_oracleProxy && MJL_isL1D() && pkt->getSize() <= sizeof(uint64_t)) { 
             pkt->cmd.MJL_setCmdDir(MemCmd::MJL_DirAttribute::MJL_IsColumn); 
             col_bus_pkt = createMissPacket(pkt, col_blk, pkt->needsWritable()); 
             pkt->cmd.MJL_setCmdDir(MemCmd::MJL_DirAttribute::MJL_IsRow); 
@@ -2421,6 +2409,13 @@ Cache::recvTimingResp(PacketPtr pkt)
 {
     assert(pkt->isResponse());
 
+    /* MJL_Begin */
+    if (pkt->MJL_isTile()) {
+        MJL_recvTileResp(pkt);
+        return;
+    }
+    /* MJL_End */
+
     // all header delay should be paid for by the crossbar, unless
     // this is a prefetch response from above
     panic_if(pkt->headerDelay != 0 && pkt->cmd != MemCmd::HardPFResp,
@@ -2500,7 +2495,7 @@ Cache::recvTimingResp(PacketPtr pkt)
     if (MJL_2DCache && pkt->MJL_dataIsColumn()) {
         assert(pkt->MJL_sameCmdDataDir());
         blk = tags->MJL_findCrossBlock(pkt->getAddr(), CacheBlk::MJL_CacheBlkDir::MJL_IsRow, pkt->isSecure(), pkt->MJL_getColOffset(blkSize));
-    } else if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+    } else if (MJL_isDataCache()) {
         blk = tags->MJL_findBlock(pkt->getAddr(), pkt->MJL_getCmdDir(), pkt->isSecure());
     } else {
         blk = tags->findBlock(pkt->getAddr(), pkt->isSecure());
@@ -2550,8 +2545,8 @@ Cache::recvTimingResp(PacketPtr pkt)
         initial_tgt->pkt->MJL_setPfPredDir(pkt->MJL_getPfPredDir());
     }
     // If this is the L1 dcache, then the predicted direction should be added to the prediction hardware
-    if (this->name().find("dcache") != std::string::npos && MJL_predictDir && (MJL_pfBasedPredictDir || MJL_combinePredictDir) && initial_tgt->pkt->MJL_getPfPredDir() != MemCmd::MJL_DirAttribute::MJL_IsInvalid) {
-        MJL_dirPredictor->MJL_updatePfPredictEntry(pkt, initial_tgt->pkt->MJL_getPfPredDir());
+    if (MJL_isL1D() && MJL_dirPredictor && initial_tgt->pkt->MJL_getPfPredDir() != MemCmd::MJL_DirAttribute::MJL_IsInvalid) {
+        MJL_dirPredictor->MJL_prefetchHint(pkt, initial_tgt->pkt->MJL_getPfPredDir());
     }
     // If hardware prefetched and has no mshr hit demand requests, it is untouched prefetch
     bool untouchedPrefetch = false;
@@ -2679,7 +2674,7 @@ Cache::recvTimingResp(PacketPtr pkt)
                 // snoops as they should snoop the caches above where
                 // they will get the response from.
                 /* MJL_Begin */
-                if (mshr->isForward && pkt->cmd == MemCmd::UpgradeResp && (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos)) {
+                if (mshr->isForward && pkt->cmd == MemCmd::UpgradeResp && MJL_isDataCache()) {
                     tgt_pkt->MJL_copyWordDirty(pkt->MJL_wordDirty);
                     // Shouldn't this be true even if this is not a MDACache? Although since the dirty bit will be set upon write being satisfied, hence nothing changes really.
                     if (pkt->cacheResponding()) {
@@ -2773,7 +2768,7 @@ Cache::recvTimingResp(PacketPtr pkt)
             panic("Illegal target->source enum %d\n", target.source);
         }
         /* MJL_Begin */
-        if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+        if (MJL_isDataCache()) {
             MJL_writeback |= target.MJL_postWriteback;
             MJL_invalidate |= target.MJL_postInvalidate;
             assert(!target.MJL_postInvalidate || (&target == &targets.back())); 
@@ -2798,20 +2793,20 @@ Cache::recvTimingResp(PacketPtr pkt)
     if (blk 
         && (blk->isValid() 
             || (MJL_2DCache && blk->MJL_hasCrossValid()))) {
-        if ((this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) && !MJL_2DCache) {
+        if (MJL_isDataCache() && !MJL_2DCache) {
             // If the response granted writable, check the mshr for any crossing outstanding misses. If such miss exists, new crossing cache lines will be coming, and any potential writes to the shared element would have a hit, with crossing cache lines returning stale data. Hence, in such case, the blk should lose writable.
             if (pkt->cmd == MemCmd::UpgradeResp) {
-                if (mshrQueue.MJL_hasCrossing(pkt->getAddr(), pkt->MJL_getCmdDir(), pkt->isSecure(), ~(Addr(blkSize - 1) | Addr(pkt->MJL_blkMaskColumn(blkSize, pkt->req->MJL_rowWidth))))) {
+                if (mshrQueue.MJL_hasCrossing(pkt->getAddr(), pkt->MJL_getCmdDir(), pkt->isSecure(), ~(Addr(blkSize - 1) | Addr(MJL_geometry.MJL_blkMaskColumn)))) {
                     MJL_writeback |= true;
                 }
             }
             /* Even retry will not get new data if the write back happens before the cross miss returns in the next level of cache// If the response granted writable that was not asked for with dirty data in the block, check the mshr for crossing inservice misses. If such miss exist and arrived after the request with response that has dirty data, and that the overlapping word is dirty, then the inservice crossing miss is going to return stale data. Hence mark that a retry should be forced after it's return.
             if (MJL_writeback && !pkt->hasSharers() && pkt->cacheResponding() && pkt->cmd != MemCmd::UpgradeResp && pkt->cmd != MemCmd::WriteResp && pkt->cmd != MemCmd::ReadExResp) {
-                int MJL_crossShift = pkt->floorLog2(sizeof(uint64_t));
+                int MJL_crossShift = MJL_geometry.MJL_rowShift;
                 if (pkt->MJL_cmdIsColumn()) {
-                    MJL_crossShift = pkt->floorLog2(pkt->req->MJL_rowWidth) + floorLog2(blkSize);
+                    MJL_crossShift = MJL_geometry.MJL_colShift;
                 }
-                mshrQueue.MJL_markRetry(pkt->getAddr(), pkt->MJL_getCmdDir(), pkt->isSecure(), ~(Addr(blkSize - 1) | Addr(pkt->MJL_blkMaskColumn(blkSize, pkt->req->MJL_rowWidth))), MJL_crossShift, pkt->MJL_wordDirty, MJL_init_order);
+                mshrQueue.MJL_markRetry(pkt->getAddr(), pkt->MJL_getCmdDir(), pkt->isSecure(), ~(Addr(blkSize - 1) | Addr(MJL_geometry.MJL_blkMaskColumn)), MJL_crossShift, pkt->MJL_wordDirty, MJL_init_order);
             }*/
             
             PacketPtr MJL_postPkt = nullptr;
@@ -2886,8 +2881,8 @@ Cache::recvTimingResp(PacketPtr pkt)
         schedMemSideSendEvent(clockEdge() + pkt->payloadDelay);
     } else {
         /* MJL_Begin */
-        if (MJL_predictDir && (MJL_utilPredictDir || MJL_mshrPredictDir || MJL_combinePredictDir)) {
-            MJL_dirPredictor->MJL_removeFromPredictMshrQueue(mshr, MJL_targetHasPC, pkt->isUpgrade());
+        if (MJL_dirPredictor) {
+            MJL_dirPredictor->MJL_missResolved(mshr, MJL_targetHasPC, pkt->isUpgrade());
         }
         /* MJL_End */
         mshrQueue.deallocate(mshr);
@@ -3019,7 +3014,7 @@ Cache::writebackBlk(CacheBlk *blk)
     writebacks[Request::wbMasterId]++;
     /* MJL_Begin */
     Request *req = nullptr;
-    if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+    if (MJL_isDataCache()) {
         req = new Request(tags->MJL_regenerateBlkAddr(blk->tag, blk->MJL_blkDir, blk->set),
                                blkSize, 0, Request::wbMasterId);
         req->MJL_setReqDir(blk->MJL_blkDir);
@@ -3027,8 +3022,7 @@ Cache::writebackBlk(CacheBlk *blk)
         req = new Request(tags->regenerateBlkAddr(blk->tag, blk->set),
                                blkSize, 0, Request::wbMasterId);
     }
-    req->MJL_cachelineSize = blkSize;
-    req->MJL_rowWidth = MJL_rowWidth;
+    req->MJL_geometry = &MJL_geometry;
     /* MJL_End */
     /* MJL_Comment
     Request *req = new Request(tags->regenerateBlkAddr(blk->tag, blk->set),
@@ -3045,7 +3039,7 @@ Cache::writebackBlk(CacheBlk *blk)
         new Packet(req, blk->isDirty() ?
                    MemCmd::WritebackDirty : MemCmd::WritebackClean);
     /* MJL_Begin */
-    if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+    if (MJL_isDataCache()) {
         pkt->cmd.MJL_setCmdDir(req->MJL_getReqDir());
         pkt->MJL_setDataDir(req->MJL_getReqDir());
         if (blk->isDirty()) { // now that wordDirty does not mean block is dirty, this needs to be tested. 
@@ -3068,7 +3062,7 @@ Cache::writebackBlk(CacheBlk *blk)
 
     // make sure the block is not marked dirty
     /* MJL_Begin */
-    if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+    if (MJL_isDataCache()) {
         blk->MJL_clearAllDirty();
         blk->MJL_wasDirty = false; // Reset the wasDirty bit
     }
@@ -3078,7 +3072,7 @@ Cache::writebackBlk(CacheBlk *blk)
     pkt->allocate();
     std::memcpy(pkt->getPtr<uint8_t>(), blk->data, blkSize);
     /* MJL_Begin */
-    if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+    if (MJL_isDataCache()) {
         pkt->MJL_setDataDir(blk->MJL_blkDir);
     }
     /* MJL_End */
@@ -3108,8 +3102,7 @@ Cache::MJL_writebackColBlk(CacheBlk *blk, unsigned MJL_offset, bool blkDirty)
 
     Request *req = new Request(wbAddr, blkSize, 0, Request::wbMasterId);
     req->MJL_setReqDir(MemCmd::MJL_DirAttribute::MJL_IsColumn);
-    req->MJL_cachelineSize = blkSize;
-    req->MJL_rowWidth = MJL_rowWidth;
+    req->MJL_geometry = &MJL_geometry;
     
     if (blk->isSecure())
         req->setFlags(Request::SECURE);
@@ -3201,8 +3194,7 @@ Cache::MJL_cleanEvictColBlk(CacheBlk *blk, unsigned MJL_offset, bool blkDirty)
         new Request(wbAddr, blkSize, 0, Request::wbMasterId);
 
     req->MJL_setReqDir(MemCmd::MJL_DirAttribute::MJL_IsColumn);
-    req->MJL_cachelineSize = blkSize;
-    req->MJL_rowWidth = MJL_rowWidth;
+    req->MJL_geometry = &MJL_geometry;
     
     if (blk->isSecure())
         req->setFlags(Request::SECURE);
@@ -3232,7 +3224,7 @@ Cache::cleanEvictBlk(CacheBlk *blk)
     Request *req =
     /* MJL_Begin */
         nullptr;
-    if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+    if (MJL_isDataCache()) {
         req = new Request(tags->MJL_regenerateBlkAddr(blk->tag, blk->MJL_blkDir, blk->set), blkSize, 0,
                         Request::wbMasterId);
     req->MJL_setReqDir(blk->MJL_blkDir);
@@ -3240,8 +3232,7 @@ Cache::cleanEvictBlk(CacheBlk *blk)
         req = new Request(tags->regenerateBlkAddr(blk->tag, blk->set), blkSize, 0,
                         Request::wbMasterId);
     }
-    req->MJL_cachelineSize = blkSize;
-    req->MJL_rowWidth = MJL_rowWidth;
+    req->MJL_geometry = &MJL_geometry;
     /* MJL_End */
     /* MJL_Comment 
         new Request(tags->regenerateBlkAddr(blk->tag, blk->set), blkSize, 0,
@@ -3256,7 +3247,7 @@ Cache::cleanEvictBlk(CacheBlk *blk)
 
     PacketPtr pkt = new Packet(req, MemCmd::CleanEvict);
     /* MJL_Begin */
-    if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+    if (MJL_isDataCache()) {
         blk->MJL_wasDirty = false; // Reset the wasDirty bit
         blk->MJL_clearAllDirty(); // and clear the word dirty bits
         pkt->cmd.MJL_setCmdDir(blk->MJL_blkDir);
@@ -3302,8 +3293,7 @@ Cache::writebackVisitor(CacheBlk &blk)
         Request request(tags->MJL_regenerateBlkAddr(blk.tag, blk.MJL_blkDir, blk.set),
                         blkSize, 0, Request::funcMasterId);
         request.MJL_setReqDir(blk.MJL_blkDir);
-        request.MJL_cachelineSize = blkSize;
-        request.MJL_rowWidth = MJL_rowWidth;
+        request.MJL_geometry = &MJL_geometry;
         /* MJL_End */
         /* MJL_Comment 
         Request request(tags->regenerateBlkAddr(blk.tag, blk.set),
@@ -3348,6 +3338,32 @@ Cache::invalidateVisitor(CacheBlk &blk)
     return true;
 }
 
+/* MJL_Begin */
+bool
+Cache::MJL_collectOracleProxyVisitor(CacheBlk &blk)
+{
+    if (blk.MJL_accessPCList && !blk.MJL_accessPCList->empty()) {
+        MJL_collect_stats(blk.MJL_accessPCList, blk.MJL_accessAddrList,
+                          blk.MJL_blkDir);
+    }
+    return true;
+}
+
+void
+Cache::MJL_printOracleProxyStats()
+{
+    if (MJL_perPCAddrOracleProxyStats) {
+        // The blocks still resident at exit have not been counted yet
+        CacheBlkVisitorWrapper visitor(*this,
+                                       &Cache::MJL_collectOracleProxyVisitor);
+        tags->forEachBlk(visitor);
+        // Binary table image, loaded with mmap by the replay run
+        MJL_perPCAddrOracleProxyStats->MJL_writeBinary(this->name() + "_oracleProxyOut.bin");
+        MJL_perPCAddrOracleProxyStats->MJL_print(std::cout);
+    }
+}
+/* MJL_End */
+
 CacheBlk*
 Cache::allocateBlock(Addr addr, bool is_secure, PacketList &writebacks)
 {
@@ -3398,7 +3414,7 @@ Cache::MJL_allocateBlock(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, b
     CacheBlk *blk = nullptr;
     if (MJL_2DCache) {
         blk = tags->MJL_findVictim(addr, MemCmd::MJL_DirAttribute::MJL_IsRow);
-    } else if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+    } else if (MJL_isDataCache()) {
         blk = tags->MJL_findVictim(addr, MJL_cacheBlkDir);
     } else {
         return allocateBlock(addr, is_secure, writebacks);
@@ -3515,7 +3531,7 @@ Cache::MJL_allocateBlock(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, b
                     for (int j = 0; j < 8; ++j) {
                         CacheBlk *tile_blk = tags->MJL_findBlockByTile(blk, j);
                         if (tile_blk->isValid()) {
-                            writebacks.back()->MJL_crossBlocksCached[j] |= true;
+                            writebacks.back()->MJL_crossBlocksCached[j] = true;
                         }
                     }
                 }
@@ -3591,26 +3607,26 @@ Cache::MJL_allocateBlock(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, b
                 std::cout << std::endl;
                 */
                 /* MJL_Test: do we really need this? Looks like we don't
-                if ((this->name().find("dcache") != std::string::npos) && writebacks.back()->mustCheckAbove()) {
+                if (MJL_isL1D() && writebacks.back()->mustCheckAbove()) {
                     MSHR *MJL_crossMshr = nullptr;
                     CacheBlk *MJL_crossBlk = nullptr;
                     for (int i = 0; i < blkSize/sizeof(uint64_t); ++i) {
                         MJL_crossMshr =  mshrQueue.MJL_findMatch(writebacks.back()->MJL_getCrossBlockAddrs(blkSize, i), writebacks.back()->MJL_getCrossCmdDir(), is_secure);
                         if (MJL_crossMshr) {
-                            writebacks.back()->MJL_crossBlocksCached[i] |= true;
+                            writebacks.back()->MJL_crossBlocksCached[i] = true;
                         }
                         MJL_crossBlk =  tags->MJL_findBlock(writebacks.back()->MJL_getCrossBlockAddrs(blkSize, i), writebacks.back()->MJL_getCrossCmdDir(), writebacks.back()->isSecure());
                         if (MJL_crossBlk && MJL_crossBlk->isValid()) {
-                            writebacks.back()->MJL_crossBlocksCached[i] |= true;
+                            writebacks.back()->MJL_crossBlocksCached[i] = true;
                         }
                     }
                 }
-                if ((this->name().find("dcache") != std::string::npos) && writebacks.back()->isEviction()) {
+                if (MJL_isL1D() && writebacks.back()->isEviction()) {
                     WriteQueueEntry *MJL_crossWb_entry = nullptr;
                     for (int i = 0; i < blkSize/sizeof(uint64_t); ++i) {
                         MJL_crossWb_entry =  writeBuffer.MJL_findMatch(writebacks.back()->MJL_getCrossBlockAddrs(blkSize, i), writebacks.back()->MJL_getCrossCmdDir(), is_secure);
                         if (MJL_crossWb_entry) {
-                            writebacks.back()->MJL_crossBlocksCached[i] |= true;
+                            writebacks.back()->MJL_crossBlocksCached[i] = true;
                         }
                     }
                 } */ 
@@ -3726,7 +3742,7 @@ Cache::handleFill(PacketPtr pkt, CacheBlk *blk, PacketList &writebacks,
             if (MJL_2DCache) {
                 tempBlock->set = tags->MJL_extractSet(addr, MemCmd::MJL_DirAttribute::MJL_IsRow);
                 tempBlock->tag = tags->MJL_extractTag(addr, MemCmd::MJL_DirAttribute::MJL_IsRow);
-            } else if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+            } else if (MJL_isDataCache()) {
                 tempBlock->set = tags->MJL_extractSet(addr, pkt->MJL_getDataDir());
                 tempBlock->tag = tags->MJL_extractTag(addr, pkt->MJL_getDataDir());
                 tempBlock->MJL_blkDir = pkt->MJL_getDataDir();
@@ -3774,7 +3790,7 @@ Cache::handleFill(PacketPtr pkt, CacheBlk *blk, PacketList &writebacks,
         // assert(!MJL_oracleProxy);
         if (MJL_2DCache) {
             assert((blk->MJL_blkDir == MemCmd::MJL_DirAttribute::MJL_IsRow) && (blk->tag == tags->MJL_extractTag(addr, MemCmd::MJL_DirAttribute::MJL_IsRow)));
-        } else if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+        } else if (MJL_isDataCache()) {
             assert((blk->MJL_blkDir == pkt->MJL_getCmdDir()) && (blk->tag == tags->MJL_extractTag(addr, pkt->MJL_getCmdDir())));
         } else {
             assert(blk->tag == tags->extractTag(addr));
@@ -3883,7 +3899,7 @@ Cache::handleFill(PacketPtr pkt, CacheBlk *blk, PacketList &writebacks,
             // owners copy
             blk->status |= BlkDirty;
             /* MJL_Begin */
-            if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+            if (MJL_isDataCache()) {
                 // blk->MJL_clearAllDirty();
                 blk->MJL_setWordDirtyPkt(pkt, blkSize);
             }
@@ -3926,7 +3942,7 @@ Cache::handleFill(PacketPtr pkt, CacheBlk *blk, PacketList &writebacks,
                     }
                 }
             }
-        } else if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+        } else if (MJL_isDataCache()) {
             /* MJL_Test */
             if (pkt->MJL_getDataDir() != blk->MJL_blkDir) {
                 std::cout << this->name() << "::MJL_handleFillDebug blkdir != pktdatadir " << blk->print() << ", " << pkt->print() << std::endl;
@@ -4094,12 +4110,12 @@ Cache::handleSnoop(PacketPtr pkt, CacheBlk *blk, bool is_timing,
         std::cout << this->name() << "::MJL_Debug: point Before mustCheckAbove in handleSnoop " << std::endl;
     }
      
-    if ((this->name().find("dcache") != std::string::npos) && pkt->mustCheckAbove()) {
+    if (MJL_isL1D() && pkt->mustCheckAbove()) {
         CacheBlk *MJL_crossBlk = nullptr;
         for (int i = 0; i < blkSize/sizeof(uint64_t); ++i) {
             MJL_crossBlk =  tags->MJL_findBlock(pkt->MJL_getCrossBlockAddrs(blkSize, i), pkt->MJL_getCrossCmdDir(), pkt->isSecure());
             if (MJL_crossBlk && MJL_crossBlk->isValid()) {
-                pkt->MJL_crossBlocksCached[i] |= true;
+                pkt->MJL_crossBlocksCached[i] = true;
             }
         }
     */
@@ -4291,7 +4307,7 @@ Cache::handleSnoop(PacketPtr pkt, CacheBlk *blk, bool is_timing,
                     }
                     pkt->setDataFromBlock(MJL_tempData, blkSize);
                     pkt->MJL_setWordDirtyFromBlk(MJL_tempWordDirty,blkSize);
-                } else if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+                } else if (MJL_isDataCache()) {
                     pkt->setDataFromBlock(blk->data, blkSize);
                     if (blk->isDirty()) { // now that wordDirty does not mean block is dirty, this needs to be tested. 
                         pkt->MJL_setWordDirtyFromBlk(blk->MJL_wordDirty,blkSize);
@@ -4361,7 +4377,7 @@ Cache::recvTimingSnoopReq(PacketPtr pkt)
 
         blk_addr = MJL_blockAlign(pkt->getAddr(), pkt->MJL_getCmdDir());
         mshr = mshrQueue.MJL_findMatch(blk_addr, pkt->MJL_getCmdDir(), is_secure);
-    } else if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+    } else if (MJL_isDataCache()) {
         blk = tags->MJL_findBlock(pkt->getAddr(), pkt->MJL_getCmdDir(), is_secure);
 
         blk_addr = MJL_blockAlign(pkt->getAddr(), pkt->MJL_getCmdDir());
@@ -4397,41 +4413,41 @@ Cache::recvTimingSnoopReq(PacketPtr pkt)
         std::cout << this->name() << "MJL_Debug: point Beginning of recvTimingSnoopReq " << std::endl;
     }
      */
-    if ((this->name().find("dcache") != std::string::npos || (MJL_has2DLLC && !MJL_2DCache)) && pkt->mustCheckAbove()) {
+    if ((MJL_isL1D() || (MJL_has2DLLC && !MJL_2DCache)) && pkt->mustCheckAbove()) {
         MSHR *MJL_crossMshr = nullptr;
         for (int i = 0; i < blkSize/sizeof(uint64_t); ++i) {
             MJL_crossMshr =  mshrQueue.MJL_findMatch(pkt->MJL_getCrossBlockAddrs(blkSize, i), pkt->MJL_getCrossCmdDir(), is_secure);
             if (MJL_crossMshr) {
-                pkt->MJL_crossBlocksCached[i] |= true;
+                pkt->MJL_crossBlocksCached[i] = true;
             }
         }
         /* MJL_Test 
         std::cout << "MJL_Debug: point B " << std::oct << pkt->getAddr() << std::endl << std::endl;
          */
     }
-    if ((this->name().find("dcache") != std::string::npos || (MJL_has2DLLC && !MJL_2DCache)) && pkt->isEviction()) {
+    if ((MJL_isL1D() || (MJL_has2DLLC && !MJL_2DCache)) && pkt->isEviction()) {
         WriteQueueEntry *MJL_crossWb_entry = nullptr;
         for (int i = 0; i < blkSize/sizeof(uint64_t); ++i) {
             MJL_crossWb_entry = writeBuffer.MJL_findMatch(pkt->MJL_getCrossBlockAddrs(blkSize, i), pkt->MJL_getCrossCmdDir(), is_secure);
             if (MJL_crossWb_entry) {
-                pkt->MJL_crossBlocksCached[i] |= true;
+                pkt->MJL_crossBlocksCached[i] = true;
             }
         }
         /* MJL_Test
         std::cout << "MJL_Debug: point C " << std::oct << pkt->getAddr() << std::endl << std::endl;
          */
     }
-    if ((this->name().find("dcache") != std::string::npos || (MJL_has2DLLC && !MJL_2DCache)) && pkt->mustCheckAbove()) {
+    if ((MJL_isL1D() || (MJL_has2DLLC && !MJL_2DCache)) && pkt->mustCheckAbove()) {
         CacheBlk *MJL_crossBlk = nullptr;
         for (int i = 0; i < blkSize/sizeof(uint64_t); ++i) {
             MJL_crossBlk = tags->MJL_findBlock(pkt->MJL_getCrossBlockAddrs(blkSize, i), pkt->MJL_getCrossCmdDir(), pkt->isSecure());
             if (MJL_crossBlk && MJL_crossBlk->isValid()) {
-                pkt->MJL_crossBlocksCached[i] |= true;
+                pkt->MJL_crossBlocksCached[i] = true;
             }
         }
     }
     /* MJL_Test 
-    if ((this->name().find("dcache") != std::string::npos || (MJL_has2DLLC && !MJL_2DCache)) && pkt->mustCheckAbove()) {
+    if ((MJL_isL1D() || (MJL_has2DLLC && !MJL_2DCache)) && pkt->mustCheckAbove()) {
         std::cout << this->name() << "::recvTimingSnoopReq crossBlocksCached ";
         for (int i = 0; i < blkSize/sizeof(uint64_t); ++i) {
             std::cout << pkt->MJL_crossBlocksCached[i] << " ";
@@ -4463,7 +4479,7 @@ Cache::recvTimingSnoopReq(PacketPtr pkt)
     //We also need to check the writeback buffers and handle those
     /* MJL_Begin */
     WriteQueueEntry *wb_entry = nullptr;
-    if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+    if (MJL_isDataCache()) {
         wb_entry = writeBuffer.MJL_findMatch(blk_addr, pkt->MJL_getCmdDir(), is_secure);
     } else {
         wb_entry = writeBuffer.findMatch(blk_addr, is_secure);
@@ -4567,7 +4583,7 @@ Cache::recvAtomicSnoop(PacketPtr pkt)
     CacheBlk *blk = nullptr;
     if (MJL_2DCache && pkt->MJL_cmdIsColumn()) {
         blk = tags->MJL_findCrossBlock(pkt->getAddr(), CacheBlk::MJL_CacheBlkDir::MJL_IsRow, pkt->isSecure(), pkt->MJL_getColOffset(blkSize));
-    } else if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+    } else if (MJL_isDataCache()) {
         blk = tags->MJL_findBlock(pkt->getAddr(), pkt->MJL_getCmdDir(), pkt->isSecure());
     } else {
         blk = tags->findBlock(pkt->getAddr(), pkt->isSecure());
@@ -4597,7 +4613,7 @@ Cache::getNextQueueEntry()
         MSHR *conflict_mshr =
         /* MJL_Begin */
             nullptr;
-        if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+        if (MJL_isDataCache()) {
             conflict_mshr = mshrQueue.MJL_findPending(wq_entry->blkAddr, wq_entry->MJL_qEntryDir, 
                                   wq_entry->isSecure);
 
@@ -4656,11 +4672,11 @@ Cache::getNextQueueEntry()
         WriteQueueEntry *conflict_mshr =
         /* MJL_Begin */
             nullptr;
-        if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+        if (MJL_isDataCache()) {
             conflict_mshr = writeBuffer.MJL_findPending(miss_mshr->blkAddr, miss_mshr->MJL_qEntryDir, 
                                     miss_mshr->isSecure);
 
-            Addr tilemask = ~(Addr(blkSize - 1) | Addr(miss_mshr->getTarget()->pkt->MJL_blkMaskColumn(blkSize, MJL_rowWidth)));
+            Addr tilemask = ~(Addr(blkSize - 1) | Addr(MJL_geometry.MJL_blkMaskColumn));
             if (writeBuffer.MJL_hasCrossing(miss_mshr->blkAddr, miss_mshr->MJL_qEntryDir, miss_mshr->isSecure, tilemask)) {
                 conflict_mshr = writeBuffer.MJL_findPendingTile(miss_mshr->blkAddr, miss_mshr->isSecure, tilemask);
                 assert(conflict_mshr != nullptr);
@@ -4764,12 +4780,12 @@ Cache::getNextQueueEntry()
         if (pkt) {
             /* MJL_Begin */
             Addr pf_addr;
-            if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+            if (MJL_isDataCache()) {
                 pf_addr = MJL_blockAlign(pkt->getAddr(), pkt->MJL_getCmdDir());
             } else {
                 pf_addr = blockAlign(pkt->getAddr());
             }
-            if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+            if (MJL_isDataCache()) {
                 if (tags->MJL_findBlock(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure())) {
                     MJL_pfDropped[0]++;
                 }
@@ -4785,25 +4801,25 @@ Cache::getNextQueueEntry()
                 if (mshrQueue.MJL_findMatch(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure())) {
                     MJL_pfDropped[4]++;
                 }
-                if (mshrQueue.MJL_hasBlockingCrossing(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure(), blkSize, ~(Addr(blkSize - 1) | Addr(pkt->MJL_blkMaskColumn(blkSize, pkt->req->MJL_rowWidth))))) {
+                if (mshrQueue.MJL_hasBlockingCrossing(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure(), blkSize, ~(Addr(blkSize - 1) | Addr(MJL_geometry.MJL_blkMaskColumn)))) {
                     MJL_pfDropped[5]++;
                 }
                 if (writeBuffer.MJL_findMatch(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure())) {
                     MJL_pfDropped[6]++;
                 }
-                if (writeBuffer.MJL_hasCrossing(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure(), ~(Addr(blkSize - 1) | Addr(pkt->MJL_blkMaskColumn(blkSize, pkt->req->MJL_rowWidth))))) {
+                if (writeBuffer.MJL_hasCrossing(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure(), ~(Addr(blkSize - 1) | Addr(MJL_geometry.MJL_blkMaskColumn)))) {
                     MJL_pfDropped[7]++;
                 }
                 if (tags->MJL_findBlock(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure()) || mshrQueue.MJL_findMatch(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure()) || writeBuffer.MJL_findMatch(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure()) ) {
                     MJL_pfDropped[8]++;
-                } else if (tags->MJL_hasCrossingDirty(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure()) || mshrQueue.MJL_hasBlockingCrossing(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure(), blkSize, ~(Addr(blkSize - 1) | Addr(pkt->MJL_blkMaskColumn(blkSize, pkt->req->MJL_rowWidth)))) || writeBuffer.MJL_hasCrossing(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure(), ~(Addr(blkSize - 1) | Addr(pkt->MJL_blkMaskColumn(blkSize, pkt->req->MJL_rowWidth)))) ) {
+                } else if (tags->MJL_hasCrossingDirty(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure()) || mshrQueue.MJL_hasBlockingCrossing(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure(), blkSize, ~(Addr(blkSize - 1) | Addr(MJL_geometry.MJL_blkMaskColumn))) || writeBuffer.MJL_hasCrossing(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure(), ~(Addr(blkSize - 1) | Addr(MJL_geometry.MJL_blkMaskColumn))) ) {
                     MJL_pfDropped[9]++;
                 }
             }
-            if (((this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) && !tags->MJL_findBlock(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure()) && (MJL_2DCache || !tags->MJL_hasCrossingDirty(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure())) &&
-                !mshrQueue.MJL_findMatch(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure()) && (MJL_2DCache || !mshrQueue.MJL_hasBlockingCrossing(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure(), blkSize, ~(Addr(blkSize - 1) | Addr(pkt->MJL_blkMaskColumn(blkSize, pkt->req->MJL_rowWidth))))) &&
-                !writeBuffer.MJL_findMatch(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure()) && (MJL_2DCache || !writeBuffer.MJL_hasCrossing(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure(), ~(Addr(blkSize - 1) | Addr(pkt->MJL_blkMaskColumn(blkSize, pkt->req->MJL_rowWidth)))))) 
-               || ((this->name().find("dcache") == std::string::npos && this->name().find("l2") == std::string::npos && this->name().find("l3") == std::string::npos) && (!tags->findBlock(pf_addr, pkt->isSecure()) &&
+            if ((MJL_isDataCache() && !tags->MJL_findBlock(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure()) && (MJL_2DCache || !tags->MJL_hasCrossingDirty(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure())) &&
+                !mshrQueue.MJL_findMatch(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure()) && (MJL_2DCache || !mshrQueue.MJL_hasBlockingCrossing(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure(), blkSize, ~(Addr(blkSize - 1) | Addr(MJL_geometry.MJL_blkMaskColumn)))) &&
+                !writeBuffer.MJL_findMatch(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure()) && (MJL_2DCache || !writeBuffer.MJL_hasCrossing(pf_addr, pkt->MJL_getCmdDir(), pkt->isSecure(), ~(Addr(blkSize - 1) | Addr(MJL_geometry.MJL_blkMaskColumn))))) 
+               || (!MJL_isDataCache() && (!tags->findBlock(pf_addr, pkt->isSecure()) &&
                 !mshrQueue.findMatch(pf_addr, pkt->isSecure()) &&
                 !writeBuffer.findMatch(pf_addr, pkt->isSecure())))) {
             /* MJL_End */
@@ -4927,7 +4943,7 @@ Cache::sendMSHRQueuePacket(MSHR* mshr)
 
     /* MJL_Begin */
     CacheBlk *blk = nullptr;
-    if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+    if (MJL_isDataCache()) {
         blk = tags->MJL_findBlock(mshr->blkAddr, mshr->MJL_qEntryDir, mshr->isSecure);
     } else {
         blk = tags->findBlock(mshr->blkAddr, mshr->isSecure);
@@ -5030,6 +5046,14 @@ Cache::sendMSHRQueuePacket(MSHR* mshr)
     /* MJL_Begin */
     assert(!mshr->getTarget()->MJL_isBlocked());
     /* */
+    /* MJL_Begin */
+    // In whole tile transfer mode the ready misses of the tile go together
+    std::vector<MSHR*> MJL_tileMshrs;
+    PacketPtr MJL_tilePkt = MJL_createTileMissPacket(mshr, pkt, MJL_tileMshrs);
+    if (MJL_tilePkt) {
+        return MJL_sendTileMissPacket(MJL_tilePkt, MJL_tileMshrs);
+    }
+    /* MJL_End */
     if (!memSidePort->sendTimingReq(pkt)) {
         // we are awaiting a retry, but we
         // delete the packet and will be creating a new packet
@@ -5076,6 +5100,14 @@ Cache::sendWriteQueuePacket(WriteQueueEntry* wq_entry)
     std::cout << this->name() << "::MJL_Debug: At sendWriteQueuePacket " << tgt_pkt->print() << std::endl;
      */
 
+    /* MJL_Begin */
+    std::vector<WriteQueueEntry*> MJL_tileEntries;
+    PacketPtr MJL_tilePkt = MJL_createTileWritePacket(wq_entry, MJL_tileEntries);
+    if (MJL_tilePkt) {
+        return MJL_sendTileWritePacket(MJL_tilePkt, MJL_tileEntries);
+    }
+    /* MJL_End */
+
     // forward as is, both for evictions and uncacheable writes
     if (!memSidePort->sendTimingReq(tgt_pkt)) {
         // note that we have now masked any requestBus and
@@ -5090,6 +5122,216 @@ Cache::sendWriteQueuePacket(WriteQueueEntry* wq_entry)
     }
 }
 
+/* MJL_Begin */
+PacketPtr
+Cache::MJL_createTileMissPacket(MSHR *mshr, PacketPtr pkt,
+                                std::vector<MSHR*> &mshrs)
+{
+    // Only fills go in tile packets, and none while a writeback to the
+    // tile waits in the write buffer, so that the writes stay in order
+    Addr tilemask = ~(Addr(blkSize - 1) | Addr(MJL_geometry.MJL_blkMaskColumn));
+    if (!MJL_tilePacketsAllowed() || mshr->isForward || mshr->isUncacheable() ||
+        !pkt->isRead() ||
+        writeBuffer.MJL_findPendingTile(mshr->blkAddr, mshr->isSecure, tilemask)) {
+        return nullptr;
+    }
+
+    std::vector<MSHR*> mates;
+    mshrQueue.MJL_getTileMates(mshr, tilemask, mates);
+    const bool column = (mshr->MJL_qEntryDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn);
+    PacketPtr lines[Packet::MJL_maxBlkWords] = {};
+    MSHR *line_mshrs[Packet::MJL_maxBlkWords] = {};
+    int trigger = MJL_geometry.MJL_tileLine(mshr->blkAddr, column);
+    lines[trigger] = pkt;
+    line_mshrs[trigger] = mshr;
+    unsigned n = 1;
+    for (MSHR *other : mates) {
+        PacketPtr tgt_pkt = other->getTarget()->pkt;
+        // Hardware prefetches check the caches above before they go
+        if (other->getTarget()->MJL_isBlocked() ||
+            tgt_pkt->cmd == MemCmd::HardPFReq) {
+            continue;
+        }
+        CacheBlk *blk = tags->MJL_findBlock(other->blkAddr, other->MJL_qEntryDir, other->isSecure);
+        other->MJL_getWordDemanded(blkSize);
+        PacketPtr line = createMissPacket(tgt_pkt, blk, other->needsWritable());
+        if (line == nullptr || line->cmd != pkt->cmd ||
+            line->MJL_getCmdDir() != pkt->MJL_getCmdDir()) {
+            delete line;
+            continue;
+        }
+        line->pushSenderState(other);
+        int i = MJL_geometry.MJL_tileLine(other->blkAddr, column);
+        assert(lines[i] == nullptr);
+        lines[i] = line;
+        line_mshrs[i] = other;
+        ++n;
+        // Counted like the miss packet of the trigger in sendMSHRQueuePacket
+        if (MJL_perPCAddrAccessCount && tgt_pkt->req->hasPC()) {
+            MJL_countPCAddrAccess(tgt_pkt->req->getPC(), tgt_pkt->getAddr(),
+                                  line->MJL_getCmdDir());
+        }
+    }
+    if (n == 1) {
+        return nullptr;
+    }
+
+    Request *tile_req = new Request(MJL_geometry.MJL_commonBits(mshr->blkAddr),
+                                    n * blkSize, 0, pkt->req->masterId());
+    if (mshr->isSecure) {
+        tile_req->setFlags(Request::SECURE);
+    }
+    tile_req->MJL_geometry = &MJL_geometry;
+    PacketPtr tile_pkt = new Packet(tile_req, pkt->cmd);
+    for (int i = 0; i < Packet::MJL_maxBlkWords; ++i) {
+        if (lines[i]) {
+            tile_pkt->MJL_addTileLine(i, lines[i]);
+            mshrs.push_back(line_mshrs[i]);
+        }
+    }
+    tile_pkt->allocate();
+    DPRINTF(Cache, "%s: created %s with %d lines from %s\n", __func__,
+            tile_pkt->print(), n, pkt->print());
+    return tile_pkt;
+}
+
+PacketPtr
+Cache::MJL_createTileWritePacket(WriteQueueEntry *wq_entry,
+                                 std::vector<WriteQueueEntry*> &entries)
+{
+    // Only writebacks go in tile packets, and none while a miss to the
+    // tile waits in the MSHRs
+    PacketPtr pkt = wq_entry->getTarget()->pkt;
+    Addr tilemask = ~(Addr(blkSize - 1) | Addr(MJL_geometry.MJL_blkMaskColumn));
+    if (!MJL_tilePacketsAllowed() || pkt->cmd != MemCmd::WritebackDirty ||
+        mshrQueue.MJL_findPendingTile(wq_entry->blkAddr, wq_entry->isSecure, tilemask)) {
+        return nullptr;
+    }
+
+    std::vector<WriteQueueEntry*> mates;
+    writeBuffer.MJL_getTileMates(wq_entry, tilemask, mates);
+    const bool column = (wq_entry->MJL_qEntryDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn);
+    WriteQueueEntry *line_entries[Packet::MJL_maxBlkWords] = {};
+    line_entries[MJL_geometry.MJL_tileLine(wq_entry->blkAddr, column)] = wq_entry;
+    unsigned n = 1;
+    for (WriteQueueEntry *other : mates) {
+        PacketPtr line = other->getTarget()->pkt;
+        // The writebacks share the block cached flag of the tile packet
+        if (line->cmd != MemCmd::WritebackDirty ||
+            line->isBlockCached() != pkt->isBlockCached()) {
+            continue;
+        }
+        int i = MJL_geometry.MJL_tileLine(other->blkAddr, column);
+        assert(line_entries[i] == nullptr);
+        line_entries[i] = other;
+        ++n;
+    }
+    if (n == 1) {
+        return nullptr;
+    }
+
+    Request *tile_req = new Request(MJL_geometry.MJL_commonBits(wq_entry->blkAddr),
+                                    n * blkSize, 0, Request::wbMasterId);
+    if (wq_entry->isSecure) {
+        tile_req->setFlags(Request::SECURE);
+    }
+    tile_req->MJL_geometry = &MJL_geometry;
+    PacketPtr tile_pkt = new Packet(tile_req, pkt->cmd);
+    if (pkt->isBlockCached()) {
+        tile_pkt->setBlockCached();
+    }
+    tile_pkt->allocate();
+    for (int i = 0; i < Packet::MJL_maxBlkWords; ++i) {
+        if (line_entries[i]) {
+            PacketPtr line = line_entries[i]->getTarget()->pkt;
+            std::memcpy(tile_pkt->getPtr<uint8_t>() + entries.size() * blkSize,
+                        line->getConstPtr<uint8_t>(), blkSize);
+            tile_pkt->MJL_addTileLine(i, line);
+            entries.push_back(line_entries[i]);
+        }
+    }
+    DPRINTF(Cache, "%s: created %s with %d lines from %s\n", __func__,
+            tile_pkt->print(), n, pkt->print());
+    return tile_pkt;
+}
+
+bool
+Cache::MJL_sendTileMissPacket(PacketPtr tile_pkt,
+                              const std::vector<MSHR*> &mshrs)
+{
+    if (!memSidePort->sendTimingReq(tile_pkt)) {
+        // as for a single miss, the packets are created again on the
+        // retry
+        PacketPtr lines[Packet::MJL_maxBlkWords];
+        unsigned n = tile_pkt->MJL_releaseTileLines(lines);
+        for (unsigned k = 0; k < n; ++k) {
+            delete lines[k];
+        }
+        RequestPtr tile_req = tile_pkt->req;
+        delete tile_pkt;
+        delete tile_req;
+        return true;
+    }
+
+    bool pending_modified_resp = !tile_pkt->hasSharers() &&
+        tile_pkt->cacheResponding();
+    for (MSHR *mshr : mshrs) {
+        assert(!mshr->inService);
+        mshr->isForward = false;
+        markInService(mshr, pending_modified_resp);
+    }
+    MJL_tileReqs++;
+    MJL_tileReqLines += mshrs.size();
+    return false;
+}
+
+bool
+Cache::MJL_sendTileWritePacket(PacketPtr tile_pkt,
+                               const std::vector<WriteQueueEntry*> &entries)
+{
+    if (!memSidePort->sendTimingReq(tile_pkt)) {
+        // the writebacks stay in the write buffer for the retry
+        PacketPtr lines[Packet::MJL_maxBlkWords];
+        tile_pkt->MJL_releaseTileLines(lines);
+        delete tile_pkt;
+        return true;
+    }
+
+    for (WriteQueueEntry *wq_entry : entries) {
+        markInService(wq_entry);
+    }
+    MJL_tileReqs++;
+    MJL_tileReqLines += entries.size();
+    return false;
+}
+
+void
+Cache::MJL_recvTileResp(PacketPtr pkt)
+{
+    assert(pkt->isRead());
+    PacketPtr lines[Packet::MJL_maxBlkWords];
+    unsigned n = pkt->MJL_releaseTileLines(lines);
+    for (unsigned k = 0; k < n; ++k) {
+        PacketPtr line = lines[k];
+        assert(line->isResponse());
+        line->headerDelay = pkt->headerDelay;
+        line->payloadDelay = pkt->payloadDelay;
+        if (pkt->hasSharers()) {
+            line->setHasSharers();
+        }
+        if (pkt->isError()) {
+            line->copyError(pkt);
+        } else {
+            line->setData(pkt->getConstPtr<uint8_t>() + k * line->getSize());
+        }
+        recvTimingResp(line);
+    }
+    RequestPtr tile_req = pkt->req;
+    delete pkt;
+    delete tile_req;
+}
+/* MJL_End */
+
 void
 Cache::serialize(CheckpointOut &cp) const
 {
@@ -5139,14 +5381,33 @@ Cache::CpuSidePort::recvTimingReq(PacketPtr pkt)
 {
     /* MJL_Begin */ 
     // Set common system information to propagate the information everywhere
-    pkt->req->MJL_cachelineSize = cache->blkSize;
-    pkt->req->MJL_rowWidth = cache->MJL_rowWidth;
+    pkt->req->MJL_geometry = &cache->MJL_geometry;
+
+    // Assign direction preference from the region registered by the
+    // workload at L1D$, every other hint below takes precedence
+    CacheBlk::MJL_CacheBlkDir MJL_regionDir = cache->MJL_isL1D() ?
+        cache->MJL_getRegionDir(pkt->req) : CacheBlk::MJL_CacheBlkDir::MJL_IsInvalid;
+    if (MJL_regionDir != CacheBlk::MJL_CacheBlkDir::MJL_IsInvalid) {
+        pkt->cmd.MJL_setCmdDir(MJL_regionDir);
+        pkt->req->MJL_setReqDir(MJL_regionDir);
+        pkt->MJL_setDataDir(MJL_regionDir);
+    }
+
+    // Assign direction preference from the decoded instruction hint at
+    // L1D$, the PC and oracle annotations below take precedence
+    if (pkt->req->MJL_hasDirHint()
+        && cache->MJL_isL1D()) {
+        CacheBlk::MJL_CacheBlkDir InputDir = pkt->req->MJL_getDirHint();
+        pkt->cmd.MJL_setCmdDir(InputDir);
+        pkt->req->MJL_setReqDir(InputDir);
+        pkt->MJL_setDataDir(InputDir);
+    }
 
     // Assign direction preference to packet based on PC at L1D$
-    if ((pkt->req->hasPC())
-        && (this->name().find("dcache") != std::string::npos)
-        && (cache->MJL_PC2DirMap.find(pkt->req->getPC()) != cache->MJL_PC2DirMap.end())) {
-        CacheBlk::MJL_CacheBlkDir InputDir = cache->MJL_PC2DirMap.find(pkt->req->getPC())->second;
+    CacheBlk::MJL_CacheBlkDir MJL_pcDir = (pkt->req->hasPC() && cache->MJL_isL1D()) ?
+        cache->MJL_getPC2Dir(pkt->req->getPC()) : CacheBlk::MJL_CacheBlkDir::MJL_IsInvalid;
+    if (MJL_pcDir != CacheBlk::MJL_CacheBlkDir::MJL_IsInvalid) {
+        CacheBlk::MJL_CacheBlkDir InputDir = MJL_pcDir;
         pkt->cmd.MJL_setCmdDir(InputDir);
         pkt->req->MJL_setReqDir(InputDir);
         pkt->MJL_setDataDir(InputDir);
@@ -5156,11 +5417,10 @@ Cache::CpuSidePort::recvTimingReq(PacketPtr pkt)
     }
 
     // Assign direction preference to packet based on PC and address at L1D$
-    if (cache->MJL_oracleProxyReplay && (pkt->req->hasPC())
-        && (this->name().find("dcache") != std::string::npos)
-        && (cache->MJL_PCAddr2DirMap.find(pkt->req->getPC()) != cache->MJL_PCAddr2DirMap.end())
-         && (cache->MJL_PCAddr2DirMap[pkt->req->getPC()].find(pkt->getAddr()) != cache->MJL_PCAddr2DirMap[pkt->req->getPC()].end())) {
-        CacheBlk::MJL_CacheBlkDir InputDir = cache->MJL_PCAddr2DirMap[pkt->req->getPC()][pkt->getAddr()];
+    CacheBlk::MJL_CacheBlkDir MJL_oracleDir = (cache->MJL_oracleProxyReplay && pkt->req->hasPC() && cache->MJL_isL1D()) ?
+        cache->MJL_PCAddr2DirTable.MJL_lookup(pkt->req->getPC(), pkt->getAddr()) : CacheBlk::MJL_CacheBlkDir::MJL_IsInvalid;
+    if (MJL_oracleDir != CacheBlk::MJL_CacheBlkDir::MJL_IsInvalid) {
+        CacheBlk::MJL_CacheBlkDir InputDir = MJL_oracleDir;
         pkt->cmd.MJL_setCmdDir(InputDir);
         pkt->req->MJL_setReqDir(InputDir);
         pkt->MJL_setDataDir(InputDir);
@@ -5170,12 +5430,12 @@ Cache::CpuSidePort::recvTimingReq(PacketPtr pkt)
     }
 
     // Assign dirty bits for write requests at L1D$
-    if ((this->name().find("dcache") != std::string::npos) && pkt->isWrite()) {
+    if (cache->MJL_isL1D() && pkt->isWrite()) {
         pkt->MJL_setAllDirty();
     }
 
     /* MJL_Test */
-    if (this->name().find("l2") != std::string::npos) {
+    if (cache->MJL_isL2()) {
         if (pkt->req->hasPC()) {
             cache->MJL_countAccess(pkt->req->getPC(), pkt->MJL_getDataDir());
         }
@@ -5188,9 +5448,7 @@ Cache::CpuSidePort::recvTimingReq(PacketPtr pkt)
     /* */
 
     /* MJL_Test: Packet information output 
-    if ((this->name().find("dcache") != std::string::npos 
-             || this->name().find("l2") != std::string::npos
-             || this->name().find("l3") != std::string::npos
+    if ((cache->MJL_isDataCache()
         ) 
         && !blocked && !mustSendRetry
          //&& cache->MJL_colVecHandler.MJL_ColVecList.find(pkt->req->getPC()) != cache->MJL_colVecHandler.MJL_ColVecList.end() 
@@ -5229,10 +5487,9 @@ Cache::CpuSidePort::recvTimingReq(PacketPtr pkt)
     // if (this->name().find("dcache") != std::string::npos && pkt->isWrite() && pkt->getAddr() == 0x38c8c0) {
     //     MJL_debugOutFlag = true;
     // }
-    if ( cache->MJL_Debug_Out && (this->name().find("dcache") != std::string::npos
+    if ( cache->MJL_Debug_Out && (cache->MJL_isL1D()
     // if ( (this->name().find("dcache") != std::string::npos
-             || this->name().find("l2") != std::string::npos
-             || this->name().find("l3") != std::string::npos)
+             || cache->MJL_isL2() || cache->MJL_isLLC())
             //  && (pkt->req->hasPC() && pkt->req->getPC() >= 0x407360 && pkt->req->getPC() <=0x4074ab )
             // && ( MJL_debugOutFlag )
             // && (pkt->getAddr() >= 0x38c000 && pkt->getAddr() < 0x390000)
@@ -5247,7 +5504,7 @@ Cache::CpuSidePort::recvTimingReq(PacketPtr pkt)
     /* */
     /* MJL_TODO 
     std::list<uint64_t> access_list {0x40825c, 0x408265, 0x40826e, 0x408277, 0x408280, 0x408289, 0x408297, 0x40829b, 0x408397, 0x40839d, 0x4083a8, 0x4083b3, 0x4084a0, 0x4084a6, 0x4084b1, 0x4084bc, 0x408513, 0x408519, 0x408520, 0x408527, 0x408601, 0x40860a, 0x408613, 0x40861c, 0x408625, 0x40862e, 0x40863c, 0x408640, 0x40867c, 0x408685, 0x40868e, 0x408697, 0x4086a0, 0x4086a9, 0x4086b7, 0x4086bb};
-    if ((this->name().find("dcache") != std::string::npos) && pkt->req->hasPC() && (std::find(access_list.begin(), access_list.end(), pkt->req->getPC()) != access_list.end())) {
+    if (cache->MJL_isL1D() && pkt->req->hasPC() && (std::find(access_list.begin(), access_list.end(), pkt->req->getPC()) != access_list.end())) {
         if (pkt->isRead()) {
             std::cout << "r ";
         } else if (pkt->isWrite()) {
@@ -5266,13 +5523,13 @@ Cache::CpuSidePort::recvTimingReq(PacketPtr pkt)
 
     // Column vector access handler
     if ((pkt->req->hasPC())
-        && (this->name().find("dcache") != std::string::npos) && !blocked && !mustSendRetry
+        && cache->MJL_isL1D() && !blocked && !mustSendRetry
         && (cache->MJL_colVecHandler.MJL_ColVecList.find(pkt->req->getPC()) != cache->MJL_colVecHandler.MJL_ColVecList.end() && !cache->MJL_colVecHandler.isSend(pkt, true))) {
         return true;
     }
 
     // MJL_Test: see if the input is correct on vector operations
-    if ((this->name().find("dcache") != std::string::npos) && pkt->req->hasPC() && !blocked && !mustSendRetry && cache->MJL_VecListSet.find(pkt->req->getPC()) != cache->MJL_VecListSet.end()) {
+    if (cache->MJL_isL1D() && pkt->req->hasPC() && !blocked && !mustSendRetry && cache->MJL_isVecAccess(pkt->req->getPC())) {
         if (pkt->getSize() <= sizeof(uint64_t)) {
             std::cout << "NonVec: " << std::hex << pkt->req->getPC() << std::dec << "[" << pkt->getSize() << "], Addr(oct) " << std::oct << pkt->getAddr() << std::dec << std::endl;
         }
@@ -5289,7 +5546,7 @@ Cache::CpuSidePort::recvTimingReq(PacketPtr pkt)
     Addr MJL_baseAddr = pkt->getAddr();
     unsigned MJL_byteOffset = MJL_baseAddr & (Addr)(sizeof(uint64_t) - 1);
 
-    if ((this->name().find("dcache") != std::string::npos) // Only split for L1D$
+    if (cache->MJL_isL1D() // Only split for L1D$
         && !blocked // When the cache is not blocked
         && !mustSendRetry // Or committed to a retry
         && pkt->needsResponse() // Read and Writes needs response, otherwise don't care (should not recv writeback or evict requests at this point either)
@@ -5304,11 +5561,7 @@ Cache::CpuSidePort::recvTimingReq(PacketPtr pkt)
         assert(pkt->req->hasPC());
 
         // Set a unique sequence number to each packet that has the same PC and request time to identify the packet
-        int MJL_testSeq = 0;
-        while (cache->MJL_unalignedPacketList[pkt->req->getPC()][pkt->req->time()].find(MJL_testSeq) != cache->MJL_unalignedPacketList[pkt->req->getPC()][pkt->req->time()].end()) {
-            // Find the next sequence number
-            MJL_testSeq++;
-        }
+        int MJL_testSeq = cache->MJL_nextSplitSeq(pkt->req->getPC(), pkt->req->time());
         // Assign the sequence number
         pkt->MJL_testSeq = MJL_testSeq;
         
@@ -5328,9 +5581,7 @@ Cache::CpuSidePort::recvTimingReq(PacketPtr pkt)
         MJL_sndPkt->allocate();
 
         // Register the split packet pair 
-        cache->MJL_unalignedPacketList[pkt->req->getPC()][pkt->req->time()][MJL_testSeq] = std::tuple<PacketPtr, PacketPtr> (pkt, MJL_sndPkt);
-        cache->MJL_unalignedPacketCount[pkt->req->getPC()][pkt->req->time()][MJL_testSeq][0] = false;
-        cache->MJL_unalignedPacketCount[pkt->req->getPC()][pkt->req->time()][MJL_testSeq][1] = false;
+        cache->MJL_unalignedPackets[MJL_SplitKey{pkt->req->getPC(), pkt->req->time(), MJL_testSeq}] = MJL_SplitPair{pkt, MJL_sndPkt, {false, false}};
         if (pkt->hasData()) {
             memcpy(MJL_sndPkt->getPtr<uint8_t>(), pkt->getConstPtr<uint8_t>() + sizeof(uint64_t) - MJL_byteOffset, MJL_sndPkt->getSize());
         }
@@ -5341,7 +5592,7 @@ Cache::CpuSidePort::recvTimingReq(PacketPtr pkt)
     }
 
     // Assign column preference for default column access
-    if ((this->name().find("dcache") != std::string::npos) && cache->MJL_defaultColumn && !blocked && !mustSendRetry) {
+    if (cache->MJL_isL1D() && cache->MJL_defaultColumn && !blocked && !mustSendRetry) {
         pkt->cmd.MJL_setCmdDir(MemCmd::MJL_DirAttribute::MJL_IsColumn);
         pkt->req->MJL_setReqDir(MemCmd::MJL_DirAttribute::MJL_IsColumn);
         pkt->MJL_setDataDir(MemCmd::MJL_DirAttribute::MJL_IsColumn);
@@ -5354,8 +5605,7 @@ Cache::CpuSidePort::recvTimingReq(PacketPtr pkt)
 
     // Set common system information to propagate the information everywhere
     if (MJL_split) {
-        MJL_sndPkt->req->MJL_cachelineSize = cache->blkSize;
-        MJL_sndPkt->req->MJL_rowWidth = cache->MJL_rowWidth;
+        MJL_sndPkt->req->MJL_geometry = &cache->MJL_geometry;
     }
     /* MJL_End */
     assert(!cache->system->bypassCaches());
@@ -5366,7 +5616,7 @@ Cache::CpuSidePort::recvTimingReq(PacketPtr pkt)
     if (pkt->isExpressSnoop()) {
         // do not change the current retry state
         /* MJL_Test */
-        if (this->name().find("dcache") != std::string::npos) {
+        if (cache->MJL_isL1D()) {
             MJL_regReq(pkt);
         }
         /* */
@@ -5378,7 +5628,7 @@ Cache::CpuSidePort::recvTimingReq(PacketPtr pkt)
         success = false;
     /* MJL_Begin */
     // Sending mechanism on the second half of the split packets
-    } else if (this->name().find("dcache") != std::string::npos && cache->MJL_sndPacketWaiting) {
+    } else if (cache->MJL_isL1D() && cache->MJL_sndPacketWaiting) {
         // Wait till the second half of the split packets is sent to accept new packets
         if (pkt->req->contextId() == cache->MJL_retrySndPacket->req->contextId()) {
             assert(MJL_split);
@@ -5398,7 +5648,7 @@ Cache::CpuSidePort::recvTimingReq(PacketPtr pkt)
         // pass it on to the cache, and let the cache decide if we
         // have to retry or not
         /* MJL_Test */
-        if (this->name().find("dcache") != std::string::npos) {
+        if (cache->MJL_isL1D()) {
             MJL_regReq(pkt);
         }
         /* */
@@ -5411,7 +5661,7 @@ Cache::CpuSidePort::recvTimingReq(PacketPtr pkt)
         cache->MJL_sndPacketWaiting = !success;
         // Try sending the second packet if the first was sent successfully
         if (success) {
-            if (this->name().find("dcache") != std::string::npos) {
+            if (cache->MJL_isL1D()) {
                 MJL_regReq(pkt);
             }
             success = cache->recvTimingReq(MJL_sndPkt);
@@ -5432,11 +5682,31 @@ Tick
 Cache::CpuSidePort::recvAtomic(PacketPtr pkt)
 {
     /* MJL_Begin */
+    // Assign direction preference from the region registered by the
+    // workload at L1D$, every other hint below takes precedence
+    CacheBlk::MJL_CacheBlkDir MJL_regionDir = cache->MJL_isL1D() ?
+        cache->MJL_getRegionDir(pkt->req) : CacheBlk::MJL_CacheBlkDir::MJL_IsInvalid;
+    if (MJL_regionDir != CacheBlk::MJL_CacheBlkDir::MJL_IsInvalid) {
+        pkt->cmd.MJL_setCmdDir(MJL_regionDir);
+        pkt->req->MJL_setReqDir(MJL_regionDir);
+        pkt->MJL_setDataDir(MJL_regionDir);
+    }
+
+    // Assign direction preference from the decoded instruction hint at
+    // L1D$, the PC and oracle annotations below take precedence
+    if (pkt->req->MJL_hasDirHint()
+        && cache->MJL_isL1D()) {
+        CacheBlk::MJL_CacheBlkDir InputDir = pkt->req->MJL_getDirHint();
+        pkt->cmd.MJL_setCmdDir(InputDir);
+        pkt->req->MJL_setReqDir(InputDir);
+        pkt->MJL_setDataDir(InputDir);
+    }
+
     // Assign direction preference to packet based on PC at L1D$
-    if ((pkt->req->hasPC())
-        && (this->name().find("dcache") != std::string::npos)
-        && (cache->MJL_PC2DirMap.find(pkt->req->getPC()) != cache->MJL_PC2DirMap.end())) {
-        CacheBlk::MJL_CacheBlkDir InputDir = cache->MJL_PC2DirMap.find(pkt->req->getPC())->second;
+    CacheBlk::MJL_CacheBlkDir MJL_pcDir = (pkt->req->hasPC() && cache->MJL_isL1D()) ?
+        cache->MJL_getPC2Dir(pkt->req->getPC()) : CacheBlk::MJL_CacheBlkDir::MJL_IsInvalid;
+    if (MJL_pcDir != CacheBlk::MJL_CacheBlkDir::MJL_IsInvalid) {
+        CacheBlk::MJL_CacheBlkDir InputDir = MJL_pcDir;
         pkt->cmd.MJL_setCmdDir(InputDir);
         pkt->req->MJL_setReqDir(InputDir);
         pkt->MJL_setDataDir(InputDir);
@@ -5446,11 +5716,10 @@ Cache::CpuSidePort::recvAtomic(PacketPtr pkt)
     }
 
     // Assign direction preference to packet based on PC and address at L1D$
-    if (cache->MJL_oracleProxyReplay && (pkt->req->hasPC())
-        && (this->name().find("dcache") != std::string::npos)
-        && (cache->MJL_PCAddr2DirMap.find(pkt->req->getPC()) != cache->MJL_PCAddr2DirMap.end())
-         && (cache->MJL_PCAddr2DirMap[pkt->req->getPC()].find(pkt->getAddr()) != cache->MJL_PCAddr2DirMap[pkt->req->getPC()].end())) {
-        CacheBlk::MJL_CacheBlkDir InputDir = cache->MJL_PCAddr2DirMap[pkt->req->getPC()][pkt->getAddr()];
+    CacheBlk::MJL_CacheBlkDir MJL_oracleDir = (cache->MJL_oracleProxyReplay && pkt->req->hasPC() && cache->MJL_isL1D()) ?
+        cache->MJL_PCAddr2DirTable.MJL_lookup(pkt->req->getPC(), pkt->getAddr()) : CacheBlk::MJL_CacheBlkDir::MJL_IsInvalid;
+    if (MJL_oracleDir != CacheBlk::MJL_CacheBlkDir::MJL_IsInvalid) {
+        CacheBlk::MJL_CacheBlkDir InputDir = MJL_oracleDir;
         pkt->cmd.MJL_setCmdDir(InputDir);
         pkt->req->MJL_setReqDir(InputDir);
         pkt->MJL_setDataDir(InputDir);
@@ -5460,24 +5729,18 @@ Cache::CpuSidePort::recvAtomic(PacketPtr pkt)
     }
 
     // Assign dirty bits for write requests at L1D$
-    if ((this->name().find("dcache") != std::string::npos) && pkt->isWrite()) {
+    if (cache->MJL_isL1D() && pkt->isWrite()) {
         pkt->MJL_setAllDirty();
     }
     
-    // Trace output for oracle proxy analysis
-    if ((pkt->req->hasPC())
-        && (this->name().find("dcache") != std::string::npos) && cache->MJL_oracleProxy) {
-        std::cout << "MJL_traceOut: " << std::hex << pkt->req->getPC() << " " << pkt->getAddr() << std::dec << " " << pkt->getSize() << std::endl;
-    }
-    
     /* Test output for indirection-unrolled and qDyn-sweep-unrolled alignment  
     if ((pkt->req->hasPC())
-        && (this->name().find("dcache") != std::string::npos) && (pkt->req->getPC() == 0x40075c || pkt->req->getPC() == 0x400aae)) {
+        && cache->MJL_isL1D() && (pkt->req->getPC() == 0x40075c || pkt->req->getPC() == 0x400aae)) {
         std::cout << "MJL_align: " << std::hex << pkt->req->getPC() << " " << pkt->getAddr() << std::dec << std::endl;
     }  */
 
     /* MJL_Test: Request packet information output  
-    if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+    if (cache->MJL_isDataCache()) {
         std::cout << this->name() << "::recvAtomicPreAcc";
         std::cout << ": PC(hex) = ";
         if (pkt->req->hasPC()) {
@@ -5510,7 +5773,7 @@ Cache::CpuSidePort::recvAtomic(PacketPtr pkt)
 
     // Column vector access handler
     if ((pkt->req->hasPC())
-        && (this->name().find("dcache") != std::string::npos)
+        && cache->MJL_isL1D()
         && (cache->MJL_colVecHandler.MJL_ColVecList.find(pkt->req->getPC()) != cache->MJL_colVecHandler.MJL_ColVecList.end() && !cache->MJL_colVecHandler.isSend(pkt, false))) {
         if (pkt->isRead()) return 0;
         // Cannot do vector write work around since there one packet cannot wait on another
@@ -5523,7 +5786,7 @@ Cache::CpuSidePort::recvAtomic(PacketPtr pkt)
     Addr MJL_baseAddr = pkt->getAddr();
     unsigned MJL_byteOffset = MJL_baseAddr & (Addr)(sizeof(uint64_t) - 1);
 
-    if ((this->name().find("dcache") != std::string::npos)
+    if (cache->MJL_isL1D()
         && pkt->needsResponse()
         && !cache->MJL_sndPacketWaiting
         && !pkt->req->MJL_isVec()
@@ -5534,11 +5797,7 @@ Cache::CpuSidePort::recvAtomic(PacketPtr pkt)
         CacheBlk::MJL_CacheBlkDir pktOrigDir = pkt->MJL_getCmdDir();
         assert(pkt->req->hasPC());
 
-        int MJL_testSeq = 0;
-            
-        while (cache->MJL_unalignedPacketList[pkt->req->getPC()][pkt->req->time()].find(MJL_testSeq) != cache->MJL_unalignedPacketList[pkt->req->getPC()][pkt->req->time()].end()) {
-            MJL_testSeq++;
-        }
+        int MJL_testSeq = cache->MJL_nextSplitSeq(pkt->req->getPC(), pkt->req->time());
 
         pkt->MJL_testSeq = MJL_testSeq;
 
@@ -5556,9 +5815,7 @@ Cache::CpuSidePort::recvAtomic(PacketPtr pkt)
         MJL_sndPkt->MJL_testSeq = MJL_testSeq;
         MJL_sndPkt->allocate();
                 
-        cache->MJL_unalignedPacketList[pkt->req->getPC()][pkt->req->time()][MJL_testSeq] = std::tuple<PacketPtr, PacketPtr> (pkt, MJL_sndPkt);
-        cache->MJL_unalignedPacketCount[pkt->req->getPC()][pkt->req->time()][MJL_testSeq][0] = false;
-        cache->MJL_unalignedPacketCount[pkt->req->getPC()][pkt->req->time()][MJL_testSeq][1] = false;
+        cache->MJL_unalignedPackets[MJL_SplitKey{pkt->req->getPC(), pkt->req->time(), MJL_testSeq}] = MJL_SplitPair{pkt, MJL_sndPkt, {false, false}};
         if (pkt->hasData()) {
             memcpy(MJL_sndPkt->getPtr<uint8_t>(), pkt->getConstPtr<uint8_t>() + sizeof(uint64_t) - MJL_byteOffset, MJL_sndPkt->getSize());
         }
@@ -5569,7 +5826,7 @@ Cache::CpuSidePort::recvAtomic(PacketPtr pkt)
     }
 
     // Assign column preference for default column access
-    if (this->name().find("dcache") != std::string::npos && cache->MJL_defaultColumn) {
+    if (cache->MJL_isL1D() && cache->MJL_defaultColumn) {
         pkt->cmd.MJL_setCmdDir(MemCmd::MJL_DirAttribute::MJL_IsColumn);
         pkt->req->MJL_setReqDir(MemCmd::MJL_DirAttribute::MJL_IsColumn);
         pkt->MJL_setDataDir(MemCmd::MJL_DirAttribute::MJL_IsColumn);
@@ -5581,14 +5838,12 @@ Cache::CpuSidePort::recvAtomic(PacketPtr pkt)
     }
 
     // Set common system information to propagate the information everywhere
-    pkt->req->MJL_cachelineSize = cache->blkSize;
-    pkt->req->MJL_rowWidth = cache->MJL_rowWidth;
+    pkt->req->MJL_geometry = &cache->MJL_geometry;
     if (MJL_split) {
-        MJL_sndPkt->req->MJL_cachelineSize = cache->blkSize;
-        MJL_sndPkt->req->MJL_rowWidth = cache->MJL_rowWidth;
+        MJL_sndPkt->req->MJL_geometry = &cache->MJL_geometry;
     }
     
-    if (this->name().find("dcache") != std::string::npos){
+    if (cache->MJL_isL1D()){
         MJL_regReq(pkt);
         if (cache->MJL_Debug_Out) {
             std::cerr << this->name() << "::recvAtomicPreAcc" << pkt->print() << std::endl;
@@ -5596,7 +5851,7 @@ Cache::CpuSidePort::recvAtomic(PacketPtr pkt)
     }
     // The actual access
     Tick time = cache->recvAtomic(pkt);
-    if (this->name().find("dcache") != std::string::npos){
+    if (cache->MJL_isL1D()){
         MJL_checkResp(pkt);
         if (cache->MJL_Debug_Out) {
             std::cerr << this->name() << "::recvAtomicPostAcc" << pkt->print() << std::endl;
@@ -5604,7 +5859,7 @@ Cache::CpuSidePort::recvAtomic(PacketPtr pkt)
     }
     
     /* MJL_Test: Response packet information output 
-    if ((this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) && pkt->isResponse()) {
+    if ((cache->MJL_isL2() || cache->MJL_isLLC()) && pkt->isResponse()) {
         std::cout << this->name() << "::recvAtomicPostAcc";
         std::cout << ": PC(hex) = ";
         if (pkt->req->hasPC()) {
@@ -5637,14 +5892,14 @@ Cache::CpuSidePort::recvAtomic(PacketPtr pkt)
 
     /* MJL_Test 
     if ((pkt->req->hasPC())
-        && (this->name().find("dcache") != std::string::npos)
-        && (cache->MJL_PC2DirMap.find(pkt->req->getPC()) != cache->MJL_PC2DirMap.end())) {
+        && cache->MJL_isL1D()
+        && cache->MJL_isInterestedAccess(pkt->req->getPC())) {
         std::cout << this->name() << "::recvAtomic MJL_debug: " << pkt->print() << std::endl;
     }
      */
-    if (this->name().find("dcache") != std::string::npos && pkt->isResponse()) {
+    if (cache->MJL_isL1D() && pkt->isResponse()) {
         /* MJL_TODO 
-        if ((this->name().find("dcache") != std::string::npos) && pkt->req->hasPC() && pkt->req->getPC() >= 0x406f4c && pkt->req->getPC() <= 0x406f87) {
+        if (cache->MJL_isL1D() && pkt->req->hasPC() && pkt->req->getPC() >= 0x406f4c && pkt->req->getPC() <= 0x406f87) {
             std::cout << "MJL_Output: Starting address is " << pkt->print() << std::endl; 
         }
          */
@@ -5683,12 +5938,15 @@ Cache::CpuSidePort::recvAtomic(PacketPtr pkt)
         if (MJL_isUnaligned) {
             std::clog << "MJL_Merge: Received a packet that was split\n";
 
-            if (pkt == std::get<0>(cache->MJL_unalignedPacketList[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq])) {
-                cache->MJL_unalignedPacketCount[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq][0] = true;
-            } else if (pkt == std::get<1>(cache->MJL_unalignedPacketList[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq])) {
-                cache->MJL_unalignedPacketCount[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq][1] = true;
+            auto MJL_split_it = cache->MJL_unalignedPackets.find(MJL_SplitKey{pkt->req->getPC(), pkt->req->time(), pkt->MJL_testSeq});
+            assert(MJL_split_it != cache->MJL_unalignedPackets.end());
+            MJL_SplitPair& MJL_splitPair = MJL_split_it->second;
+            if (pkt == MJL_splitPair.orig) {
+                MJL_splitPair.received[0] = true;
+            } else if (pkt == MJL_splitPair.snd) {
+                MJL_splitPair.received[1] = true;
             } else {
-                assert((pkt == std::get<0>(cache->MJL_unalignedPacketList[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq])) || (pkt == std::get<1>(cache->MJL_unalignedPacketList[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq])));
+                assert((pkt == MJL_splitPair.orig) || (pkt == MJL_splitPair.snd));
             }
         }
     }
@@ -5696,22 +5954,22 @@ Cache::CpuSidePort::recvAtomic(PacketPtr pkt)
     // Access for the second half of the split packet
     if (MJL_split) {
         pkt = MJL_sndPkt;
-        if (this->name().find("dcache") != std::string::npos){
+        if (cache->MJL_isL1D()){
             MJL_regReq(pkt);
             if (cache->MJL_Debug_Out) {
                 std::cerr << this->name() << "::recvAtomicPreAcc" << pkt->print() << std::endl;
             }
         }
         time = time + cache->recvAtomic(pkt);
-        if (this->name().find("dcache") != std::string::npos){
+        if (cache->MJL_isL1D()){
             MJL_checkResp(pkt);
             if (cache->MJL_Debug_Out) {
                 std::cerr << this->name() << "::recvAtomicPostAcc" << pkt->print() << std::endl;
             }
         }
-        if (this->name().find("dcache") != std::string::npos && pkt->isResponse() && MJL_sndPkt->isResponse()) {
+        if (cache->MJL_isL1D() && pkt->isResponse() && MJL_sndPkt->isResponse()) {
             /* MJL_TODO 
-            if ((this->name().find("dcache") != std::string::npos) && pkt->req->hasPC() && pkt->req->getPC() >= 0x406f4c && pkt->req->getPC() <= 0x406f87) {
+            if (cache->MJL_isL1D() && pkt->req->hasPC() && pkt->req->getPC() >= 0x406f4c && pkt->req->getPC() <= 0x406f87) {
                 std::cout << "MJL_Output: Starting address is " << pkt->print() << std::endl; 
             }
              */
@@ -5746,18 +6004,21 @@ Cache::CpuSidePort::recvAtomic(PacketPtr pkt)
             */
 
             std::clog << "MJL_Merge: Received a packet that was split\n";
-            if (pkt == std::get<0>(cache->MJL_unalignedPacketList[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq])) {
-                cache->MJL_unalignedPacketCount[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq][0] = true;
-            } else if (pkt == std::get<1>(cache->MJL_unalignedPacketList[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq])) {
-                cache->MJL_unalignedPacketCount[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq][1] = true;
+            auto MJL_split_it = cache->MJL_unalignedPackets.find(MJL_SplitKey{pkt->req->getPC(), pkt->req->time(), pkt->MJL_testSeq});
+            assert(MJL_split_it != cache->MJL_unalignedPackets.end());
+            MJL_SplitPair& MJL_splitPair = MJL_split_it->second;
+            if (pkt == MJL_splitPair.orig) {
+                MJL_splitPair.received[0] = true;
+            } else if (pkt == MJL_splitPair.snd) {
+                MJL_splitPair.received[1] = true;
             } else {
-                assert((pkt == std::get<0>(cache->MJL_unalignedPacketList[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq])) || (pkt == std::get<1>(cache->MJL_unalignedPacketList[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq])));
+                assert((pkt == MJL_splitPair.orig) || (pkt == MJL_splitPair.snd));
             }
 
-            if (cache->MJL_unalignedPacketCount[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq][0] && cache->MJL_unalignedPacketCount[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq][1]) {
+            if (MJL_splitPair.received[0] && MJL_splitPair.received[1]) {
                 std::clog << "MJL_Merge: Both packet from split received, ";
-                PacketPtr MJL_origPacket = std::get<0>(cache->MJL_unalignedPacketList[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq]);
-                PacketPtr MJL_sndPacket = std::get<1>(cache->MJL_unalignedPacketList[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq]);
+                PacketPtr MJL_origPacket = MJL_splitPair.orig;
+                PacketPtr MJL_sndPacket = MJL_splitPair.snd;
 
                 if (pkt->isRead()) {
                     unsigned MJL_byteOffset = MJL_origPacket->getAddr() & (Addr)(sizeof(uint64_t) - 1);
@@ -5782,7 +6043,7 @@ Cache::CpuSidePort::recvAtomic(PacketPtr pkt)
                 
                 delete MJL_sndPacket;
                 std::clog << "Deleted created packet\n";
-                cache->MJL_unalignedPacketList[pkt->req->getPC()][pkt->req->time()].erase(pkt->MJL_testSeq);
+                cache->MJL_unalignedPackets.erase(MJL_split_it);
             }
         }
     }
@@ -5805,7 +6066,7 @@ Cache::CpuSidePort::recvFunctional(PacketPtr pkt)
 {
     /* MJL_Begin */
     /* MJL_Test request packet information output 
-    if (this->name().find("dcache") != std::string::npos) {
+    if (cache->MJL_isL1D()) {
         std::cout << this->name() << "::recvFunctionalPreAcc";
         std::cout << ": MemCmd = " << pkt->cmd.toString();
         std::cout << ", Addr(oct) = " << std::oct << pkt->getAddr() << std::dec;
@@ -5831,18 +6092,17 @@ Cache::CpuSidePort::recvFunctional(PacketPtr pkt)
     assert(pkt->MJL_getCmdDir() == MemCmd::MJL_DirAttribute::MJL_IsRow);
 
     // Set common system information to propagate the information everywhere
-    pkt->req->MJL_cachelineSize = cache->blkSize;
-    pkt->req->MJL_rowWidth = cache->MJL_rowWidth;
+    pkt->req->MJL_geometry = &cache->MJL_geometry;
     MJL_functionalUpdate(pkt);
     /* MJL_End */
     // functional request
     cache->functionalAccess(pkt, true);
     /* MJL_Begin */
-    if ((this->name().find("dcache") != std::string::npos) && cache->MJL_Debug_Out) {
+    if (cache->MJL_isL1D() && cache->MJL_Debug_Out) {
         std::cerr << this->name() << "::recvFunctional " << pkt->print() << std::endl;
     }
     /* MJL_Test response packet information output 
-    if ((this->name().find("dcache") != std::string::npos) && pkt->isResponse()) {
+    if (cache->MJL_isL1D() && pkt->isResponse()) {
         std::cout << this->name() << "::recvFunctionalPostAcc";
         std::cout << ": MemCmd = " << pkt->cmd.toString();
         std::cout << ", Addr(oct) = " << std::oct << pkt->getAddr() << std::dec;
@@ -5873,7 +6133,7 @@ CpuSidePort::CpuSidePort(const std::string &_name, Cache *_cache,
 {
     /* MJL_Begin */
     MJL_debugOutFlag = false;
-    if (this->name().find("dcache") != std::string::npos) {
+    if (cache->MJL_isL1D()) {
         MJL_value_test = true;
     } else {
         MJL_value_test = false;
@@ -5899,8 +6159,7 @@ Cache::MemSidePort::recvTimingResp(PacketPtr pkt)
 {
     /* MJL_Test  
     // if ( cache->MJL_Debug_Out && ( this->name().find("dcache") != std::string::npos
-    if ( ( this->name().find("dcache") != std::string::npos
-         || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos 
+    if ( ( cache->MJL_isDataCache() 
        )) {
         std::clog << cache->curCycle() << ":" << this->name() << "MJL_predDebug: recvTimingResp " << pkt->print() << std::endl;
     }
@@ -5914,8 +6173,7 @@ void
 Cache::MemSidePort::recvTimingSnoopReq(PacketPtr pkt)
 {
     /* MJL_Test */
-    if ( cache->MJL_Debug_Out && ( this->name().find("dcache") != std::string::npos
-         || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos
+    if ( cache->MJL_Debug_Out && ( cache->MJL_isDataCache()
        )) {
         std::clog << this->name() << "MJL_multiThreadDebug: recvTimingSnoopReq " << pkt->print() << std::endl;
     }
@@ -61,9 +61,17 @@
 #include "params/Cache.hh"
 #include "sim/eventq.hh"
 /* MJL_Begin */
+#include "base/bitfield.hh"
 #include "base/random.hh"
+#include "mem/cache/dir_trace.hh"
+#include "mem/cache/dirpred/base.hh"
+#include "mem/cache/pc2dir_table.hh"
+#include "mem/cache/region_dir_table.hh"
+#include "mem/cache/tags/tile_directory.hh"
+#include <deque>
 #include <fstream>
 #include <sstream>
+#include <unordered_map>
 
 extern std::map< Addr, uint8_t[8] > MJL_current_data;
 extern std::map< Addr, bool[8] > MJL_current_valid;
@@ -267,16 +275,14 @@ class Cache : public BaseCache
         {
             assert(pkt->isResponse());
 
-            if (this->name().find("dcache") != std::string::npos){
+            if (cache->MJL_isL1D()){
                 MJL_checkResp(pkt);
             } 
             /* MJL_Test */
             // if (this->name().find("dcache") != std::string::npos && pkt->req->hasPC() && pkt->req->getPC() == 0x43296c && pkt->getAddr() == 0x38c8c0 && pkt->MJL_dataIsColumn()) {
             //     MJL_debugOutFlag = false;
             // } 
-            if (cache->MJL_Debug_Out && (this->name().find("dcache") != std::string::npos
-                 || this->name().find("l2") != std::string::npos
-                 || this->name().find("l3") != std::string::npos)
+            if (cache->MJL_Debug_Out && cache->MJL_isDataCache()
                 // && (pkt->req->hasPC() && pkt->req->getPC() >= 0x407360 && pkt->req->getPC() <=0x4074ab )
                 // && (pkt->getAddr() <= 0x38c8c0 && (pkt->getAddr() + pkt->getSize()) >= 0x38c8c0)
                 // && MJL_debugOutFlag
@@ -291,9 +297,7 @@ class Cache : public BaseCache
             }
             /* */
             /* MJL_Test: Packet information output 
-            if ((this->name().find("dcache") != std::string::npos 
-                  || this->name().find("l2") != std::string::npos
-                  || this->name().find("l3") != std::string::npos
+            if ((cache->MJL_isDataCache()
                 )
                 //&& cache->MJL_colVecHandler.MJL_ColVecList.find(pkt->req->getPC()) != cache->MJL_colVecHandler.MJL_ColVecList.end() // Debug for column vec
                 //&& pkt->MJL_cmdIsColumn()
@@ -327,73 +331,68 @@ class Cache : public BaseCache
                 std::cout << std::endl;
             }
              */
-            if (this->name().find("dcache") != std::string::npos) {
+            if (cache->MJL_isL1D()) {
 
                 bool MJL_isUnaligned = false;
                 bool MJL_isMerged = false;
 
                 // Check whether the packet is part of a pair of split packets and handle split packets cases
-                auto unaligned_PC_it = cache->MJL_unalignedPacketList.find(pkt->req->getPC());
-                if (unaligned_PC_it != cache->MJL_unalignedPacketList.end()) {
-                    auto unaligned_time_it = unaligned_PC_it->second.find(pkt->req->time());
-                    if (unaligned_time_it != unaligned_PC_it->second.end()) {
-                        auto unaligned_seq_it = unaligned_time_it->second.find(pkt->MJL_testSeq);
-                        if (unaligned_seq_it != unaligned_time_it->second.end()) {
-
-                            // The packet received was split
-                            MJL_isUnaligned = true;
-                            std::cout << "MJL_Merge: received a packet that was split into 2, ";
-
-                            // Determine whether the response is to the original packet or the created second packet
-                            if (pkt == std::get<0>(unaligned_seq_it->second)) {
-                                std::cout << " this is the first packet\n";
-                                // Register that the response to the original packet has been received
-                                cache->MJL_unalignedPacketCount[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq][0] = true;
-                            } else if (pkt == std::get<1>(unaligned_seq_it->second)) {
-                                std::cout << " this is the second packet\n";
-                                // Register that the response to the second packet has been received
-                                cache->MJL_unalignedPacketCount[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq][1] = true;
-                            } else {
-                                // Should not have other cases
-                                assert((pkt == std::get<0>(unaligned_seq_it->second)) || (pkt == std::get<1>(unaligned_seq_it->second)));
-                            }
+                auto unaligned_seq_it = cache->MJL_unalignedPackets.find(MJL_SplitKey{pkt->req->getPC(), pkt->req->time(), pkt->MJL_testSeq});
+                if (unaligned_seq_it != cache->MJL_unalignedPackets.end()) {
+                    MJL_SplitPair& MJL_splitPair = unaligned_seq_it->second;
+
+                    // The packet received was split
+                    MJL_isUnaligned = true;
+                    std::cout << "MJL_Merge: received a packet that was split into 2, ";
+
+                    // Determine whether the response is to the original packet or the created second packet
+                    if (pkt == MJL_splitPair.orig) {
+                        std::cout << " this is the first packet\n";
+                        // Register that the response to the original packet has been received
+                        MJL_splitPair.received[0] = true;
+                    } else if (pkt == MJL_splitPair.snd) {
+                        std::cout << " this is the second packet\n";
+                        // Register that the response to the second packet has been received
+                        MJL_splitPair.received[1] = true;
+                    } else {
+                        // Should not have other cases
+                        assert((pkt == MJL_splitPair.orig) || (pkt == MJL_splitPair.snd));
+                    }
+
+                    // Merge if both packets have been received
+                    if (MJL_splitPair.received[0] && MJL_splitPair.received[1]) {
+                        // Both packets received
+                        MJL_isMerged = true;
+                        std::cout << "MJL_Merge: Received both packets that were previously split, ";
+                        PacketPtr MJL_origPacket = MJL_splitPair.orig;
+                        std::cout << ", got Original Packet, size = " << MJL_origPacket->getSize();
+                        PacketPtr MJL_sndPacket = MJL_splitPair.snd;
+                        std::cout << ", got Second Packet, size = " << MJL_sndPacket->getSize();
+                        
+                        // If there is data in the response packets, merge data from both packets to the original packet
+                        if (pkt->hasData()) {
+                            unsigned MJL_byteOffset = MJL_origPacket->getAddr() & (Addr)(sizeof(uint64_t) - 1);
+                            std::memcpy(MJL_origPacket->getPtr<uint8_t>() + sizeof(uint64_t) - MJL_byteOffset, MJL_sndPacket->getConstPtr<uint8_t>(), MJL_sndPacket->getSize());
+                            std::cout << ", copying data from snd to orig";
+                        // Reset the request and packet size back to original size for write responses
+                        } else if (pkt->isWrite()) {
+                            MJL_origPacket->MJL_setSize(MJL_origPacket->getSize() + MJL_sndPacket->getSize());
+                            MJL_origPacket->req->MJL_setSize(MJL_origPacket->getSize());
+                        }
 
-                            // Merge if both packets have been received
-                            if (cache->MJL_unalignedPacketCount[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq][0] && cache->MJL_unalignedPacketCount[pkt->req->getPC()][pkt->req->time()][pkt->MJL_testSeq][1]) {
-                                // Both packets received
-                                MJL_isMerged = true;
-                                std::cout << "MJL_Merge: Received both packets that were previously split, ";
-                                PacketPtr MJL_origPacket = std::get<0>(unaligned_seq_it->second);
-                                std::cout << ", got Original Packet, size = " << MJL_origPacket->getSize();
-                                PacketPtr MJL_sndPacket = std::get<1>(unaligned_seq_it->second);
-                                std::cout << ", got Second Packet, size = " << MJL_sndPacket->getSize();
-                                
-                                // If there is data in the response packets, merge data from both packets to the original packet
-                                if (pkt->hasData()) {
-                                    unsigned MJL_byteOffset = MJL_origPacket->getAddr() & (Addr)(sizeof(uint64_t) - 1);
-                                    std::memcpy(MJL_origPacket->getPtr<uint8_t>() + sizeof(uint64_t) - MJL_byteOffset, MJL_sndPacket->getConstPtr<uint8_t>(), MJL_sndPacket->getSize());
-                                    std::cout << ", copying data from snd to orig";
-                                // Reset the request and packet size back to original size for write responses
-                                } else if (pkt->isWrite()) {
-                                    MJL_origPacket->MJL_setSize(MJL_origPacket->getSize() + MJL_sndPacket->getSize());
-                                    MJL_origPacket->req->MJL_setSize(MJL_origPacket->getSize());
-                                }
-
-                                // If the packet arrived second is not the original packet
-                                if (pkt != MJL_origPacket) {
-                                    // Copy timing information from the packet to the original packet
-                                    MJL_origPacket->headerDelay = pkt->headerDelay;
-                                    MJL_origPacket->snoopDelay = pkt->snoopDelay;
-                                    MJL_origPacket->payloadDelay = pkt->payloadDelay;
-                                    // And set the packet to be passed on to be the original one
-                                    pkt = MJL_origPacket;
-                                }
-
-                                // Delete the now useless second packet and split packets entry
-                                delete MJL_sndPacket;
-                                unaligned_time_it->second.erase(pkt->MJL_testSeq);             
-                            }
+                        // If the packet arrived second is not the original packet
+                        if (pkt != MJL_origPacket) {
+                            // Copy timing information from the packet to the original packet
+                            MJL_origPacket->headerDelay = pkt->headerDelay;
+                            MJL_origPacket->snoopDelay = pkt->snoopDelay;
+                            MJL_origPacket->payloadDelay = pkt->payloadDelay;
+                            // And set the packet to be passed on to be the original one
+                            pkt = MJL_origPacket;
                         }
+
+                        // Delete the now useless second packet and split packets entry
+                        delete MJL_sndPacket;
+                        cache->MJL_unalignedPackets.erase(unaligned_seq_it);
                     }
                 }
 
@@ -535,977 +534,25 @@ class Cache : public BaseCache
     /** Prefetcher */
     BasePrefetcher *prefetcher;
     /* MJL_Begin */
-    class MJL_DirPredictor {
-      protected:
-        
-        Cache * cache; // Used to get access to stats
-        /** The block size of the parent cache. */
-        unsigned blkSize;
-        const bool MJL_Debug_Out;
-
-        const unsigned MJL_rowWidth;
-        const bool MJL_1streamPredictDir;
-        const bool MJL_utilPredictDir;
-        const bool MJL_mshrPredictDir;
-        const bool MJL_pfBasedPredictDir;
-        const bool MJL_combinePredictDir;
-        const bool MJL_linkMshr;
-
-        const int maxConf;
-        const int threshConf;
-        const int minConf;
-        const int startConf;
-
-        const int startPredLevel;
-        const int maxPredLevel;
-        const int maxResetLevel;
-
-        const int pcTableAssoc;
-        const int pcTableSets;
-
-        const int MJL_predMshrSize;
-
-        const bool useMasterId;
-
-        struct StrideEntry
-        {
-            StrideEntry() : instAddr(0), lastAddr(0), isSecure(false), stride(0),
-                            confidence(0), lastPredDir(MemCmd::MJL_DirAttribute::MJL_IsRow), 
-                            blkHits{false, false, false, false, false, false, false, false}, 
-                            crossBlkHits{false, false, false, false, false, false, false, false}, 
-                            lastRowOff(0), lastColOff(0), predictLevel(0), resetLevel(0), pfLastPredDir(MemCmd::MJL_DirAttribute::MJL_IsRow),
-                            pfPredictLevel(0)
-            { }
-
-            Addr instAddr;
-            Addr lastAddr;
-            bool isSecure;
-            int stride;
-            int confidence;
-            MemCmd::MJL_DirAttribute lastPredDir;
-            bool blkHits[8];
-            bool crossBlkHits[8];
-            int lastRowOff;
-            int lastColOff;
-            int predictLevel;
-            int resetLevel;
-            MemCmd::MJL_DirAttribute pfLastPredDir;
-            int pfPredictLevel;
-
-            MemCmd::MJL_DirAttribute MJL_getCrossLastPredDir() {
-                if (lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                    return MemCmd::MJL_DirAttribute::MJL_IsColumn;
-                } else if (lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                    return MemCmd::MJL_DirAttribute::MJL_IsRow;
-                } else {
-                    return MemCmd::MJL_DirAttribute::MJL_IsColumn;
-                }
-            }
-
-        };
-
-        class PCTable {
-          public:
-            PCTable(int assoc, int sets) :
-                pcTableAssoc(assoc), pcTableSets(sets) {}
-            StrideEntry** operator[] (int context) {
-                auto it = entries.find(context);
-                if (it != entries.end())
-                    return it->second;
-
-                return allocateNewContext(context);
-            }
-
-            ~PCTable()  {
-                for (auto entry : entries) {
-                    for (int s = 0; s < pcTableSets; s++) {
-                        delete[] entry.second[s];
-                    }
-                    delete[] entry.second;
-                }
-            }
-          private:
-            const int pcTableAssoc;
-            const int pcTableSets;
-            std::map<int, StrideEntry**> entries;
-
-            StrideEntry** allocateNewContext(int context) {
-                auto res = entries.insert(std::make_pair(context,
-                                        new StrideEntry*[pcTableSets]));
-                auto it = res.first;
-                chatty_assert(res.second, "Allocating an already created context\n");
-                assert(it->first == context);
-
-                /* MJL_Comemnt 
-                DPRINTF(HWPrefetch, "Adding context %i with stride entries at %p\n",
-                        context, it->second);
-                 */
-
-                StrideEntry** entry = it->second;
-                for (int s = 0; s < pcTableSets; s++) {
-                    entry[s] = new StrideEntry[pcTableAssoc];
-                }
-                return entry;
-            }
-        };
-        PCTable pcTable;
-
-        struct PredictMshrEntry
-        {
-            PredictMshrEntry(const PacketPtr pkt, const MSHR* in_mshr, unsigned blkSize) : pc(pkt->req->getPC()), blkAddr(pkt->getBlockAddr(blkSize)), crossBlkAddr(pkt->MJL_getCrossBlockAddr(blkSize)), blkDir(pkt->MJL_getCmdDir()), crossBlkDir(pkt->MJL_getCrossCmdDir()), isSecure(pkt->isSecure()), accessAddr(pkt->getAddr()), mshr(in_mshr), masterId(pkt->req->masterId()), wasUpgrade(false), blkHits{false, false, false, false, false, false, false, false}, crossBlkHits{false, false, false, false, false, false, false, false}/*, lastPfPredDir(MemCmd::MJL_DirAttribute::MJL_IsInvalid)*/, lastRowOff(pkt->MJL_getDirOffset(blkSize, MemCmd::MJL_DirAttribute::MJL_IsRow)/sizeof(uint64_t)), lastColOff(pkt->MJL_getDirOffset(blkSize, MemCmd::MJL_DirAttribute::MJL_IsColumn)/sizeof(uint64_t))
-            {
-                blkHits[pkt->MJL_getDirOffset(blkSize, blkDir)/sizeof(uint64_t)] |= true;
-                crossBlkHits[pkt->MJL_getDirOffset(blkSize, crossBlkDir)/sizeof(uint64_t)] |= true;
-            }
-
-            Addr pc;
-            Addr blkAddr;
-            Addr crossBlkAddr;
-            MemCmd::MJL_DirAttribute blkDir;
-            MemCmd::MJL_DirAttribute crossBlkDir;
-            bool isSecure;
-            Addr accessAddr;
-            const MSHR* mshr;
-            MasterID masterId;
-            bool wasUpgrade;
-            bool blkHits[8];
-            bool crossBlkHits[8];
-            // MemCmd::MJL_DirAttribute lastPfPredDir;
-            int lastRowOff;
-            int lastColOff;
-
-            /* MJL_Test */
-            std::string print() {
-                std::ostringstream output;
-                std::string blkDir_str = (blkDir == MemCmd::MJL_DirAttribute::MJL_IsRow) ? "r" : "c";
-                std::string crossBlkDir_str = (crossBlkDir == MemCmd::MJL_DirAttribute::MJL_IsRow) ? "r" : "c";
-                output << "pc " << std::hex << pc << " " << std::dec; 
-                output << "blk " << blkDir_str << "/" << crossBlkDir_str << ":" << std::hex << blkAddr << "/" << crossBlkAddr << " " << std::dec;
-                output << "hit/crosshit " ;
-                for (int i = 0; i < 8; ++i) {
-                    output << blkHits[i];
-                }
-                output << "/";
-                for (int i = 0; i < 8; ++i) {
-                    output << crossBlkHits[i];
-                }
-                return output.str();
-            }
-            /* */
-        };
-        std::list<PredictMshrEntry> copyPredictMshrQueue;
-
-        int floorLog2(unsigned x) const {
-            assert(x > 0);
-
-            int y = 0;
-
-            if (x & 0xffff0000) { y += 16; x >>= 16; }
-            if (x & 0x0000ff00) { y +=  8; x >>=  8; }
-            if (x & 0x000000f0) { y +=  4; x >>=  4; }
-            if (x & 0x0000000c) { y +=  2; x >>=  2; }
-            if (x & 0x00000002) { y +=  1; }
-
-            return y;
-        }
-
-        Addr pcHash(Addr pc) const {
-            Addr hash1 = pc >> 1;
-            Addr hash2 = hash1 >> floorLog2((unsigned)pcTableSets);
-            return (hash1 ^ hash2) & (Addr)(pcTableSets - 1);
-        }
-
-        bool pcTableHit(Addr pc, bool is_secure, int master_id, StrideEntry* &entry) {
-            int set = pcHash(pc);
-            StrideEntry* set_entries = pcTable[master_id][set];
-            for (int way = 0; way < pcTableAssoc; way++) {
-                // Search ways for match
-                if (set_entries[way].instAddr == pc &&
-                    set_entries[way].isSecure == is_secure) {
-                    /* MJL_Comment 
-                    DPRINTF(HWPrefetch, "Lookup hit table[%d][%d].\n", set, way);
-                     */
-                    entry = &set_entries[way];
-                    return true;
-                }
-            }
-            return false;
-        }
-
-        StrideEntry* pcTableVictim(Addr pc, int master_id) {
-            // Rand replacement for now
-            int set = pcHash(pc);
-            int way = random_mt.random<int>(0, pcTableAssoc - 1);
-
-            /* MJL_Comment 
-            DPRINTF(HWPrefetch, "Victimizing lookup table[%d][%d].\n", set, way);
-             */
-            return &pcTable[master_id][set][way];
-        }
-
-        bool observeAccess(const PacketPtr &pkt) const {
-            bool fetch = pkt->req->isInstFetch();
-            bool read = pkt->isRead();
-            bool inv = pkt->isInvalidate();
-
-            if (pkt->req->isUncacheable()) return false;
-            if (fetch) return false;
-            if (!fetch && !read && inv) return false;
-            if (pkt->cmd == MemCmd::CleanEvict) return false;
-            // Do not predict the direction of a vector access
-            if (pkt->getSize() > sizeof(uint64_t)) return false;
-
-            return true;
-        }
-
-        MemCmd::MJL_DirAttribute MJL_mshrPredict(Addr pkt_addr, StrideEntry* entry, int pkt_rowOff, int pkt_colOff, bool isWrite) {
-            unsigned blkHitCount = 0;
-            unsigned crossBlkHitCount = 0;
-
-            int new_stride = pkt_addr - entry->lastAddr;
-            bool stride_match = (new_stride == entry->stride);
-
-            // Adjust confidence for stride entry
-            if (stride_match && new_stride != 0) {
-                if (entry->confidence < maxConf)
-                    entry->confidence++;
-            } else {
-                if (entry->confidence > minConf)
-                    entry->confidence--;
-                // If confidence has dropped below the threshold, train new stride
-                if (entry->confidence < threshConf)
-                    entry->stride = new_stride;
-            }
-
-             entry->lastAddr = pkt_addr;
-
-            // Only generation if above confidence threshold
-            MemCmd::MJL_DirAttribute selfStrideDir = MemCmd::MJL_DirAttribute::MJL_IsRow;
-            int selfStrideStep = 0;
-            if (entry->confidence >= threshConf) {
-                int colOffset = new_stride / (MJL_rowWidth * blkSize) + entry->lastColOff;
-                int rowOffset = new_stride/sizeof(uint64_t) + entry->lastRowOff;
-                if (new_stride < (MJL_rowWidth * blkSize) && new_stride > -(MJL_rowWidth * blkSize)) {
-                    if (new_stride % ((MJL_rowWidth * blkSize) / (1 + floorLog2(entry->confidence))) == 0) {
-                        if (new_stride > 0) {
-                            colOffset = 1 + entry->lastColOff;
-                        } else if (new_stride < 0) {
-                            colOffset = -1 + entry->lastColOff;
-                        }
-                    }
-                }
-                if (new_stride % ((MJL_rowWidth * blkSize) / (1 + floorLog2(entry->confidence))) == 0 && colOffset >= 0 && colOffset < (int) (blkSize/sizeof(uint64_t)) ) {
-                    selfStrideDir = MemCmd::MJL_DirAttribute::MJL_IsColumn;
-                    selfStrideStep = colOffset - entry->lastColOff;
-                } else if ( rowOffset >= 0 && rowOffset < (int) (blkSize/sizeof(uint64_t)) ) {
-                    selfStrideDir = MemCmd::MJL_DirAttribute::MJL_IsRow;
-                    selfStrideStep = rowOffset - entry->lastRowOff;
-                }
-            }
-            
-            if (selfStrideStep != 0 && stride_match && !MJL_utilPredictDir) {
-                if (selfStrideDir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                    for (int i = entry->lastRowOff + selfStrideStep; i >= 0 && i < (int) (blkSize/sizeof(uint64_t)); i += selfStrideStep) {
-                        if (entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                            entry->blkHits[i] |= true;
-                        } else if (entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                            entry->crossBlkHits[i] |= true;
-                        }
-                    }
-                    /*for (int i = entry->lastRowOff - selfStrideStep; i >= 0 && i < (int) (blkSize/sizeof(uint64_t)); i -= selfStrideStep) {
-                        if (entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                            entry->blkHits[i] |= true;
-                        } else if (entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                            entry->crossBlkHits[i] |= true;
-                        }
-                    }*/
-                } else if (selfStrideDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                    for (int i = entry->lastColOff + selfStrideStep; i >= 0 && i < (int) (blkSize/sizeof(uint64_t)); i += selfStrideStep) {
-                        if (entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                            entry->blkHits[i] |= true;
-                        } else if (entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                            entry->crossBlkHits[i] |= true;
-                        }
-                    }
-                    /*for (int i = entry->lastColOff - selfStrideStep; i >= 0 && i < (int) (blkSize/sizeof(uint64_t)); i -= selfStrideStep) {
-                        if (entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                            entry->blkHits[i] |= true;
-                        } else if (entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                            entry->crossBlkHits[i] |= true;
-                        }
-                    }*/
-                }
-            }
-
-            for (unsigned i = 0; i < blkSize/sizeof(uint64_t); ++i) {
-                blkHitCount += entry->blkHits[i] ? 1 : 0;
-                crossBlkHitCount += entry->crossBlkHits[i] ? 1 : 0;
-            }
-            bool changeDir = false;
-            // assert((entry->predictLevel > 1 && entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) || (entry->predictLevel <= 1 && entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsRow));
-            if (!((entry->predictLevel == 0 && entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsRow) || (entry->predictLevel == maxPredLevel && entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) || (entry->predictLevel > 0 && entry->predictLevel < maxPredLevel))) {
-                std::cerr << "MJL_mshrPred: lastPredDir " << entry->lastPredDir << ", predLevel " << entry->predictLevel << std::endl;
-            }
-            assert((entry->predictLevel == 0 && entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsRow) || (entry->predictLevel == maxPredLevel && entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) || (entry->predictLevel > 0 && entry->predictLevel < maxPredLevel));
-            if (blkHitCount == 1 && crossBlkHitCount == 1) {
-                // if (entry->predictLevel == 2) {
-                //     changeDir = true;
-                // }
-                // if (entry->predictLevel > 1) {
-                //     entry->predictLevel--;
-                // } else if (entry->predictLevel == 0) {
-                //     entry->predictLevel++;
-                // }
-                if (entry->resetLevel < maxResetLevel) {
-                    entry->resetLevel++;
-                }
-                if (entry->resetLevel == maxResetLevel) {
-                    entry->resetLevel = 0;
-                    if (entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                        changeDir = true;
-                        entry->predictLevel = 0;
-                    }
-                }
-            } else if (blkHitCount >= crossBlkHitCount) {
-                // if (entry->predictLevel == 2) {
-                //     assert( entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn );
-                //     entry->predictLevel++;
-                // } else if (entry->predictLevel == 1) {
-                //     assert( entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsRow );
-                //     entry->predictLevel--;
-                // }
-                if (blkHitCount > crossBlkHitCount) { 
-                    if ( entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn && entry->predictLevel < maxPredLevel) {
-                        entry->predictLevel++;
-                    } else if ( entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsRow && entry->predictLevel > 0) {
-                        entry->predictLevel--;
-                    }
-                }
-                entry->resetLevel = 0;
-            } else {
-                // changeDir = true;
-                // if (entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                //     entry->predictLevel = 1;
-                // } else if (entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                //     entry->predictLevel = 2;
-                // }
-                if ( entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn ) {
-                    entry->predictLevel--;
-                } else if ( entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsRow ) {
-                    entry->predictLevel++;
-                }
-                if (entry->predictLevel == 0 || entry->predictLevel == maxPredLevel) {
-                    changeDir = true;
-                }
-                entry->resetLevel = 0;
-            }
-            /* MJL_Test */
-            if (MJL_Debug_Out) {
-                std::clog << ", predLevel " << entry->predictLevel << ", resetLevel " << entry->resetLevel << ", blk/crossHits ";
-                for (unsigned i = 0; i < blkSize/sizeof(uint64_t); ++i) {
-                    std::clog << entry->blkHits[i];
-                }
-                std::clog << "(" << blkHitCount << ")/";
-                for (unsigned i = 0; i < blkSize/sizeof(uint64_t); ++i) {
-                    std::clog << entry->crossBlkHits[i];
-                }
-                std::clog << "(" << crossBlkHitCount << ")/";
-            }
-            /* */
-
-            if (changeDir) {
-                entry->lastPredDir = entry->MJL_getCrossLastPredDir();
-                bool tempBlkHits[8];
-                for (unsigned i = 0; i < blkSize/sizeof(uint64_t); ++i) {
-                    tempBlkHits[i] = entry->blkHits[i];
-                    entry->blkHits[i] = entry->crossBlkHits[i];
-                    entry->crossBlkHits[i] = tempBlkHits[i];
-                }
-            }
-            entry->lastRowOff = pkt_rowOff;
-            entry->lastColOff = pkt_colOff;
-            return entry->lastPredDir;
-        }
-
-        MemCmd::MJL_DirAttribute MJL_pfPredict(const StrideEntry* entry) {
-            return entry->pfLastPredDir;
-        }
-
-        MemCmd::MJL_DirAttribute MJL_combinePredict(Addr pkt_addr, StrideEntry* entry, int pkt_rowOff, int pkt_colOff, bool isWrite) {
-            MemCmd::MJL_DirAttribute mshr_lastPredDir = MJL_mshrPredict(pkt_addr, entry, pkt_rowOff, pkt_colOff, isWrite);
-            int mshr_predLevel = entry->predictLevel;
-            MemCmd::MJL_DirAttribute pf_lastPredDir = MJL_pfPredict(entry);
-            int pf_predLevel = entry->pfPredictLevel;
-
-            int unstable_thresh = (maxPredLevel + 1)/4;
-            bool mshr_unstable = (mshr_lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsInvalid || (mshr_lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn && mshr_predLevel < unstable_thresh) || (mshr_lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsRow && mshr_predLevel > maxPredLevel-unstable_thresh));
-            bool pf_unstable = (pf_lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsInvalid || (pf_lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn && pf_predLevel < unstable_thresh) || (pf_lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsRow && pf_predLevel > maxPredLevel-unstable_thresh));
-
-            MemCmd::MJL_DirAttribute predictDir = mshr_lastPredDir;
-            cache->MJL_numOfPredicts++;
-            if (mshr_unstable && !pf_unstable) {
-                predictDir = pf_lastPredDir;
-                cache->MJL_numOfPfPredicts++;
-            } else {
-                cache->MJL_numOfMSHRPredicts++;
-            }
-            if (mshr_lastPredDir != pf_lastPredDir && mshr_lastPredDir != MemCmd::MJL_DirAttribute::MJL_IsInvalid && pf_lastPredDir != MemCmd::MJL_DirAttribute::MJL_IsInvalid) {
-                cache->MJL_numOfDiffPredicts++;
-            } else if (mshr_lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsInvalid) {
-                cache->MJL_numOfWarmupPredicts_MSHR++;
-            } else if (pf_lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsInvalid) {
-                cache->MJL_numOfWarmupPredicts_Pf++;
-            }
-            assert(predictDir != MemCmd::MJL_DirAttribute::MJL_IsInvalid);
-            return predictDir;
-        }
-
-        MemCmd::MJL_DirAttribute MJL_stridePredict(Addr pkt_addr, StrideEntry* entry, MemCmd::MJL_DirAttribute pkt_dir) {
-            MemCmd::MJL_DirAttribute predictedDir = pkt_dir;
-            int new_stride = pkt_addr - entry->lastAddr;
-            bool stride_match = (new_stride == entry->stride);
-
-            // Adjust confidence for stride entry
-            if (stride_match && new_stride != 0) {
-                if (entry->confidence < maxConf)
-                    entry->confidence++;
-            } else {
-                if (entry->confidence > minConf)
-                    entry->confidence--;
-                // If confidence has dropped below the threshold, train new stride
-                if (entry->confidence < threshConf)
-                    entry->stride = new_stride;
-            }
-
-            /* MJL_Comment 
-            DPRINTF(HWPrefetch, "Hit: PC %x pkt_addr %x (%s) stride %d (%s), "
-                    "conf %d\n", pc, pkt_addr, is_secure ? "s" : "ns", new_stride,
-                    stride_match ? "match" : "change",
-                    entry->confidence);
-                */
-
-            entry->lastAddr = pkt_addr;
-
-            // Only generation if above confidence threshold
-            if (entry->confidence >= threshConf) {
-                if (new_stride % ((MJL_rowWidth * blkSize) / (1 + floorLog2(entry->confidence))) == 0 && (new_stride < (MJL_rowWidth * blkSize * blkSize/sizeof(uint64_t)) || pkt_dir == MemCmd::MJL_DirAttribute::MJL_IsColumn)) {
-                // if (new_stride % (MJL_rowWidth * blkSize) == 0) {
-                    predictedDir = MemCmd::MJL_DirAttribute::MJL_IsColumn;
-                    /* MJL_Test  
-                    if (MJL_Debug_Out) {
-                        std::clog << "MJL_predDebug: MJL_predictDir " << pkt->print() << " predicted column" << std::endl;
-                    }
-                    */
-                } else {
-                    predictedDir = MemCmd::MJL_DirAttribute::MJL_IsRow;
-                }
-            }
-            if (entry->confidence >= threshConf && predictedDir == MemCmd::MJL_DirAttribute::MJL_IsColumn && entry->pfPredictLevel < maxPredLevel) {
-                entry->pfPredictLevel++;
-            } else if ((entry->confidence < threshConf || predictedDir == MemCmd::MJL_DirAttribute::MJL_IsRow) && entry->pfPredictLevel > 0) {
-                entry->pfPredictLevel--;
-            }
-            if (entry->pfPredictLevel == 0) {
-                entry->lastPredDir = MemCmd::MJL_DirAttribute::MJL_IsRow;
-            } else if (entry->pfPredictLevel == maxPredLevel) {
-                entry->lastPredDir = MemCmd::MJL_DirAttribute::MJL_IsColumn;
-            }
-
-            return entry->lastPredDir;
-        }
-
-      public:
-        MJL_DirPredictor(Cache * _cache, unsigned _blkSize, bool _MJL_Debug_Out, unsigned _MJL_rowWidth, bool _MJL_1streamPredictDir, bool _MJL_utilPredictDir, bool _MJL_mshrPredictDir, bool _MJL_pfBasedPredictDir, bool _MJL_combinePredictDir, bool _MJL_linkMshr)
-            : cache(_cache), blkSize(_blkSize), MJL_Debug_Out(_MJL_Debug_Out), MJL_rowWidth(_MJL_rowWidth), MJL_1streamPredictDir(_MJL_1streamPredictDir), MJL_utilPredictDir(_MJL_utilPredictDir), MJL_mshrPredictDir(_MJL_mshrPredictDir), MJL_pfBasedPredictDir(_MJL_pfBasedPredictDir), MJL_combinePredictDir(_MJL_combinePredictDir), MJL_linkMshr(_MJL_linkMshr), maxConf(3), 
-              threshConf(2), minConf(0), startConf(2), startPredLevel(7), maxPredLevel(15), maxResetLevel(7), pcTableAssoc(4), 
-              pcTableSets(16), MJL_predMshrSize(16), useMasterId(true), pcTable(pcTableAssoc, pcTableSets)
-            {}
-        virtual ~MJL_DirPredictor() {}
-
-        // Update counters on access
-        void MJL_updatePredictMshrQueue(const PacketPtr pkt) {
-            assert(MJL_utilPredictDir || MJL_mshrPredictDir || MJL_combinePredictDir);
-            Addr pkt_blkAddr = pkt->getBlockAddr(blkSize);
-            Addr pkt_crossBlkAddr = pkt->MJL_getCrossBlockAddr(blkSize);
-            bool pkt_isSecure = pkt->isSecure();
-            /* MJL_Test */
-            if (MJL_Debug_Out) {
-                std::clog << "MJL_predDebug: MJL_mshrPredictDir update " << pkt->print();
-            }
-            /* */
-            for (std::list<PredictMshrEntry>::iterator it = copyPredictMshrQueue.begin(); it != copyPredictMshrQueue.end(); it++) {
-                if (pkt->getSize() > sizeof(uint64_t)) {
-                    pkt_blkAddr = pkt->getBlockAddr(blkSize);
-                    if (pkt_blkAddr == it->blkAddr && pkt->MJL_getCmdDir() == it->blkDir && pkt_isSecure == it->isSecure) {
-                        for (unsigned i = 0; i <= pkt->getSize()/sizeof(uint64_t); ++i) {
-                            it->blkHits[pkt->getOffset(blkSize)/sizeof(uint64_t) + i] |= true;
-                        }
-                    }
-                    pkt_crossBlkAddr = pkt->getBlockAddr(blkSize);
-                    if (pkt_crossBlkAddr == it->crossBlkAddr && pkt->MJL_getCmdDir() == it->crossBlkDir && pkt_isSecure == it->isSecure) {
-                        for (unsigned i = 0; i <= pkt->getSize()/sizeof(uint64_t); ++i) {
-                            it->crossBlkHits[pkt->getOffset(blkSize)/sizeof(uint64_t) + i] |= true;
-                        }
-                    }
-                    /* MJL_Test */
-                    if (MJL_Debug_Out && ((pkt_blkAddr == it->blkAddr && pkt->MJL_getCmdDir() == it->blkDir && pkt_isSecure == it->isSecure) || (pkt_crossBlkAddr == it->crossBlkAddr && pkt->MJL_getCmdDir() == it->crossBlkDir && pkt_isSecure == it->isSecure))) {
-                        std::clog << ", " << it->print();
-                    }
-                    /* */
-                } else {
-                    pkt_blkAddr = pkt->MJL_getDirBlockAddr(blkSize, it->blkDir);
-                    if (pkt_blkAddr == it->blkAddr && pkt_isSecure == it->isSecure) {
-                        it->blkHits[pkt->MJL_getDirOffset(blkSize, it->blkDir)/sizeof(uint64_t)] |= true;
-                    }
-                    pkt_crossBlkAddr = pkt->MJL_getDirBlockAddr(blkSize, it->crossBlkDir);
-                    if (pkt_crossBlkAddr == it->crossBlkAddr && pkt_isSecure == it->isSecure) {
-                        it->crossBlkHits[pkt->MJL_getDirOffset(blkSize, it->crossBlkDir)/sizeof(uint64_t)] |= true;
-                    }
-                    /* MJL_Test */
-                    if (MJL_Debug_Out && ((pkt_blkAddr == it->blkAddr && pkt_isSecure == it->isSecure) || (pkt_crossBlkAddr == it->crossBlkAddr && pkt_isSecure == it->isSecure))) {
-                        std::clog << ", " << it->print();
-                    }
-                    /* */
-                }
-            }
-            /* MJL_Test */
-            if (MJL_Debug_Out) {
-                std::clog << std::endl;
-            }
-            /* */
-        }
-        // Add entry to both predict queue
-        void MJL_addToPredictMshrQueue(const PacketPtr pkt, const MSHR* mshr) {
-            assert(MJL_utilPredictDir || MJL_mshrPredictDir || MJL_combinePredictDir);
-            if (pkt->req->hasPC()) {
-                copyPredictMshrQueue.emplace_back(pkt, mshr, blkSize);
-                /* MJL_Test */ 
-                if (MJL_Debug_Out) {
-                    std::clog << "MJL_predDebug: MJL_mshrPredictDir create mshr " << pkt->print() << std::endl;
-                }
-                /* */
-                // If there is already a copy of the same PC recording for the same dir, and we land in the same cache line as it's cross dir, inherit it's crossBlkHits[] to avoid row biasing (this instruction loading in cross dir would have been able to bring all the crossBlkHits[])
-                for (std::list<PredictMshrEntry>::iterator it = copyPredictMshrQueue.begin(); it != --copyPredictMshrQueue.end(); it++) {
-                    if (it->pc == copyPredictMshrQueue.back().pc) {
-                        if (it->crossBlkAddr == copyPredictMshrQueue.back().crossBlkAddr && it->isSecure == copyPredictMshrQueue.back().isSecure) {
-                            for (unsigned i = 0; i < blkSize/sizeof(uint64_t); ++i) {
-                                copyPredictMshrQueue.back().crossBlkHits[i] |= it->crossBlkHits[i];
-                            }
-                            break;
-                        }
-                    }
-                }
-                for (std::list<PredictMshrEntry>::iterator it = copyPredictMshrQueue.begin(); it != --copyPredictMshrQueue.end(); it++) {
-                    if (it->blkAddr == copyPredictMshrQueue.back().blkAddr && it->isSecure == copyPredictMshrQueue.back().isSecure) {
-                        std::clog << "MJL_Warning: An existing copyPredictMshrQueue entry has the same block address as the one being created " << pkt->print() << std::endl;
-                    }
-                }
-                if (!MJL_linkMshr) {
-                    // If the copyPredictMshrQueue is full, remove the least recently created entry (technically should happen before the insertion, but this reordering shouldn't change anything)
-                    if (copyPredictMshrQueue.size() > MJL_predMshrSize) {
-                        std::list<PredictMshrEntry>::iterator front_entry = copyPredictMshrQueue.begin();
-                        if (front_entry->mshr != nullptr) {
-                            cache->MJL_numOfCopyMSHRQueueEvictNonResolved++;
-                        }
-                        MasterID master_id = useMasterId ? front_entry->masterId : 0;
-                        StrideEntry *pcTable_entry;
-                        if (MJL_combinePredictDir && pcTableHit(front_entry->pc, front_entry->isSecure, master_id, pcTable_entry) && pcTable_entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsInvalid) {
-                            pcTable_entry->lastAddr = front_entry->accessAddr;
-                            pcTable_entry->stride = 0;
-                            pcTable_entry->confidence = startConf;
-                            if (front_entry->blkDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                                pcTable_entry->predictLevel = startPredLevel + 1;
-                            } else {
-                                pcTable_entry->predictLevel = startPredLevel;
-                            }
-                            pcTable_entry->lastPredDir = front_entry->blkDir;
-                            pcTable_entry->resetLevel = 0;
-                            for (unsigned i = 0; i < blkSize/sizeof(uint64_t); ++i) {
-                                pcTable_entry->blkHits[i] = front_entry->blkHits[i];
-                                pcTable_entry->crossBlkHits[i] = front_entry->crossBlkHits[i];
-                            }
-                            pcTable_entry->lastRowOff = front_entry->lastRowOff;
-                            pcTable_entry->lastColOff = front_entry->lastColOff;
-                        } else if (pcTableHit(front_entry->pc, front_entry->isSecure, master_id, pcTable_entry)) {
-                            pcTable_entry->lastAddr = front_entry->accessAddr;
-                            // Take upgrade miss direction change into account
-                            if (front_entry->wasUpgrade) {
-                                unsigned hitCount = 0;
-                                unsigned crossHitCount = 0;
-                                for (unsigned i = 0; i < blkSize/sizeof(uint64_t); ++i) {
-                                    hitCount += pcTable_entry->blkHits[i] ? 1 : 0;
-                                    crossHitCount += pcTable_entry->crossBlkHits[i] ? 1 : 0;
-                                }
-                                if (hitCount == 1 && crossHitCount == 1) {
-                                    if (pcTable_entry->lastPredDir != front_entry->blkDir) {
-                                        if (front_entry->blkDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                                            pcTable_entry->predictLevel = maxPredLevel;
-                                        } else if (front_entry->blkDir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                                            pcTable_entry->predictLevel = 0;
-                                        }
-                                    }
-                                    pcTable_entry->lastPredDir = front_entry->blkDir;
-                                }
-                            }
-                            if (pcTable_entry->lastPredDir == front_entry->blkDir) {
-                                for (unsigned i = 0; i < blkSize/sizeof(uint64_t); ++i) {
-                                    pcTable_entry->blkHits[i] = front_entry->blkHits[i];
-                                    pcTable_entry->crossBlkHits[i] = front_entry->crossBlkHits[i];
-                                }
-                            } else {
-                                for (unsigned i = 0; i < blkSize/sizeof(uint64_t); ++i) {
-                                    pcTable_entry->blkHits[i] = front_entry->crossBlkHits[i];
-                                    pcTable_entry->crossBlkHits[i] = front_entry->blkHits[i];
-                                }
-                            }
-                            pcTable_entry->lastRowOff = front_entry->lastRowOff;
-                            pcTable_entry->lastColOff = front_entry->lastColOff;
-                        } else {
-                            StrideEntry* victim_entry = pcTableVictim(front_entry->pc, master_id);
-                            victim_entry->instAddr = front_entry->pc;
-                            victim_entry->lastAddr = front_entry->accessAddr;
-                            victim_entry->isSecure= front_entry->isSecure;
-                            victim_entry->stride = 0;
-                            victim_entry->confidence = startConf;
-                            if (front_entry->blkDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                                victim_entry->predictLevel = startPredLevel + 1;
-                            } else {
-                                victim_entry->predictLevel = startPredLevel;
-                            }
-                            victim_entry->lastPredDir = front_entry->blkDir;
-                            victim_entry->resetLevel = 0;
-                            for (unsigned i = 0; i < blkSize/sizeof(uint64_t); ++i) {
-                                victim_entry->blkHits[i] = front_entry->blkHits[i];
-                                victim_entry->crossBlkHits[i] = front_entry->crossBlkHits[i];
-                            }
-                            victim_entry->lastRowOff = front_entry->lastRowOff;
-                            victim_entry->lastColOff = front_entry->lastColOff;
-                            if (MJL_combinePredictDir) {
-                                victim_entry->pfLastPredDir = MemCmd::MJL_DirAttribute::MJL_IsInvalid;
-                                victim_entry->pfPredictLevel = startPredLevel;
-                            }
-                        }
-                        /* MJL_Test */
-                        if (MJL_Debug_Out) {
-                            std::clog << "MJL_predDebug: MJL_mshrPredictDir added predict entry " << front_entry->print() << std::endl;
-                        }
-                        /* */
-                        copyPredictMshrQueue.pop_front();
-                    }
-                }
-                /* for (std::list<PredictMshrEntry>::iterator it = copyPredictMshrQueue.begin(); it != copyPredictMshrQueue.end(); it++) {
-                    Addr pkt_blkAddr = pkt->getBlockAddr(blkSize);
-                    Addr pkt_crossBlkAddr = pkt->MJL_getCrossBlockAddr(blkSize);
-                    bool pkt_isSecure = pkt->isSecure();
-                    if (pkt_crossBlkAddr == it->crossBlkAddr && pkt_isSecure == it->isSecure && pkt->MJL_getCrossCmdDir() == it->crossBlkDir) {
-                        copyPredictMshrQueue.back().crossBlkHits[pkt->MJL_getDirOffset(blkSize, it->crossBlkDir)/sizeof(uint64_t)] |= it->crossBlkHits[pkt->MJL_getDirOffset(blkSize, it->crossBlkDir)/sizeof(uint64_t)];
-                    } else if (pkt_blkAddr == it->crossBlkAddr && pkt_isSecure == it->isSecure && pkt->MJL_getCmdDir() == it->crossBlkDir) {
-                        copyPredictMshrQueue.back().blkHits[pkt->MJL_getDirOffset(blkSize, it->crossBlkDir)/sizeof(uint64_t)] |= it->crossBlkHits[pkt->MJL_getDirOffset(blkSize, it->crossBlkDir)/sizeof(uint64_t)];
-                    }
-                } */
-            }
-        }
-        // Remove entry from both predict queues and get predict direction
-        void MJL_removeFromPredictMshrQueue(const MSHR* mshr, bool targetHasPC, bool isUpgrade) {
-            assert(MJL_utilPredictDir || MJL_mshrPredictDir || MJL_combinePredictDir);
-            // software prefetch actually happened and does not have a pc... need to bypass this case since prediction cannot be made without a pc
-            if (!targetHasPC) {
-                return;
-            }
-
-            std::list<PredictMshrEntry>::iterator entry_found = copyPredictMshrQueue.end();
-            StrideEntry *pcTable_entry;
-            MasterID master_id = 0;
-            // Find the entry to be removed
-            for (std::list<PredictMshrEntry>::iterator it = copyPredictMshrQueue.begin(); it != copyPredictMshrQueue.end(); it++) {
-                if (mshr == it->mshr) {
-                    entry_found = it;
-                    assert(mshr->blkAddr == it->blkAddr && mshr->MJL_qEntryDir == it->blkDir && mshr->isSecure == it->isSecure);
-                    break;
-                }
-            }
-            // If the predMshrQueue is not linked to MSHR, just record the upgrade status, remove the pointer to mshr, and do nothing else. (Technically could have detected the upgrade status when inserting entry into the copyPredictMshrQueue, hence no need for pointer to mshr, but making this change here should not change anything logically and requires less changes to the existing code)
-            if (!MJL_linkMshr) {
-                if (entry_found != copyPredictMshrQueue.end()) {
-                    entry_found->wasUpgrade = isUpgrade;
-                    entry_found->mshr = nullptr;
-                }
-                return;
-            }
-            assert(entry_found != copyPredictMshrQueue.end());
-            // Add predict direction to pc table
-            master_id = useMasterId ? entry_found->masterId : 0;
-            if (MJL_combinePredictDir && pcTableHit(entry_found->pc, entry_found->isSecure, master_id, pcTable_entry) && pcTable_entry->lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsInvalid) {
-                pcTable_entry->lastAddr = entry_found->accessAddr;
-                pcTable_entry->stride = 0;
-                pcTable_entry->confidence = startConf;
-                if (entry_found->blkDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                    pcTable_entry->predictLevel = startPredLevel + 1;
-                } else {
-                    pcTable_entry->predictLevel = startPredLevel;
-                }
-                pcTable_entry->lastPredDir = entry_found->blkDir;
-                pcTable_entry->resetLevel = 0;
-                for (unsigned i = 0; i < blkSize/sizeof(uint64_t); ++i) {
-                    pcTable_entry->blkHits[i] = entry_found->blkHits[i];
-                    pcTable_entry->crossBlkHits[i] = entry_found->crossBlkHits[i];
-                }
-                pcTable_entry->lastRowOff = entry_found->lastRowOff;
-                pcTable_entry->lastColOff = entry_found->lastColOff;
-            } else if (pcTableHit(entry_found->pc, entry_found->isSecure, master_id, pcTable_entry)) {
-                pcTable_entry->lastAddr = entry_found->accessAddr;
-                // Take upgrade miss direction change into account
-                if (isUpgrade) {
-                    unsigned hitCount = 0;
-                    unsigned crossHitCount = 0;
-                    for (unsigned i = 0; i < blkSize/sizeof(uint64_t); ++i) {
-                        hitCount += pcTable_entry->blkHits[i] ? 1 : 0;
-                        crossHitCount += pcTable_entry->crossBlkHits[i] ? 1 : 0;
-                    }
-                    if (hitCount == 1 && crossHitCount == 1) {
-                        if (pcTable_entry->lastPredDir != entry_found->blkDir) {
-                            if (entry_found->blkDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                                pcTable_entry->predictLevel = maxPredLevel;
-                            } else if (entry_found->blkDir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                                pcTable_entry->predictLevel = 0;
-                            }
-                        }
-                        pcTable_entry->lastPredDir = entry_found->blkDir;
-                    }
-                }
-                if (pcTable_entry->lastPredDir == entry_found->blkDir) {
-                    for (unsigned i = 0; i < blkSize/sizeof(uint64_t); ++i) {
-                        pcTable_entry->blkHits[i] = entry_found->blkHits[i];
-                        pcTable_entry->crossBlkHits[i] = entry_found->crossBlkHits[i];
-                    }
-                } else {
-                    for (unsigned i = 0; i < blkSize/sizeof(uint64_t); ++i) {
-                        pcTable_entry->blkHits[i] = entry_found->crossBlkHits[i];
-                        pcTable_entry->crossBlkHits[i] = entry_found->blkHits[i];
-                    }
-                }
-                pcTable_entry->lastRowOff = entry_found->lastRowOff;
-                pcTable_entry->lastColOff = entry_found->lastColOff;
-            } else {
-                StrideEntry* victim_entry = pcTableVictim(entry_found->pc, master_id);
-                victim_entry->instAddr = entry_found->pc;
-                victim_entry->lastAddr = entry_found->accessAddr;
-                victim_entry->isSecure= entry_found->isSecure;
-                victim_entry->stride = 0;
-                victim_entry->confidence = startConf;
-                if (entry_found->blkDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                    victim_entry->predictLevel = startPredLevel + 1;
-                } else {
-                    victim_entry->predictLevel = startPredLevel;
-                }
-                victim_entry->lastPredDir = entry_found->blkDir;
-                victim_entry->resetLevel = 0;
-                for (unsigned i = 0; i < blkSize/sizeof(uint64_t); ++i) {
-                    victim_entry->blkHits[i] = entry_found->blkHits[i];
-                    victim_entry->crossBlkHits[i] = entry_found->crossBlkHits[i];
-                }
-                victim_entry->lastRowOff = entry_found->lastRowOff;
-                victim_entry->lastColOff = entry_found->lastColOff;
-                if (MJL_combinePredictDir) {
-                    victim_entry->pfLastPredDir = MemCmd::MJL_DirAttribute::MJL_IsInvalid;
-                    victim_entry->pfPredictLevel = startPredLevel;
-                }
-            }
-
-            /* MJL_Test */
-            if (MJL_Debug_Out) {
-                std::clog << "MJL_predDebug: MJL_mshrPredictDir remove mshr " << mshr->print() << ", added predict entry " << entry_found->print() << std::endl;
-            }
-            /* */
-            copyPredictMshrQueue.erase(entry_found);
-        }
-        // Update prediction for prefetch based scheme
-        void MJL_updatePfPredictEntry(const PacketPtr pkt, MemCmd::MJL_DirAttribute predictedDir) {
-            assert(MJL_pfBasedPredictDir || MJL_combinePredictDir);
-            // Get required packet info
-            Addr pc = pkt->req->getPC();
-            bool is_secure = pkt->isSecure();
-            MasterID master_id = useMasterId ? pkt->req->masterId() : 0;
-
-            // Lookup pc-based information
-            StrideEntry *entry;
-
-            if (MJL_combinePredictDir && pcTableHit(pc, is_secure, master_id, entry) && entry->pfLastPredDir == MemCmd::MJL_DirAttribute::MJL_IsInvalid) {
-                entry->pfLastPredDir = predictedDir;
-                if (predictedDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                    entry->pfPredictLevel = startPredLevel + 1;
-                } else {
-                    entry->pfPredictLevel = startPredLevel;
-                }
-            } else if (pcTableHit(pc, is_secure, master_id, entry)) {
-                if ( predictedDir == MemCmd::MJL_DirAttribute::MJL_IsColumn && entry->pfPredictLevel < maxPredLevel) {
-                    entry->pfPredictLevel++;
-                } else if ( predictedDir == MemCmd::MJL_DirAttribute::MJL_IsRow && entry->pfPredictLevel > 0) {
-                    entry->pfPredictLevel--;
-                }
-                if (entry->pfPredictLevel == 0) {
-                    entry->pfLastPredDir = MemCmd::MJL_DirAttribute::MJL_IsRow;
-                } else if (entry->pfPredictLevel == maxPredLevel) {
-                    entry->pfLastPredDir = MemCmd::MJL_DirAttribute::MJL_IsColumn;
-                }
-            } else {
-                StrideEntry* entry = pcTableVictim(pc, master_id);
-                entry->instAddr = pc;
-                entry->lastAddr = pkt->getAddr();
-                entry->isSecure= is_secure;
-                entry->stride = 0;
-                entry->confidence = startConf;
-                entry->pfLastPredDir = predictedDir;
-                if (predictedDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                    entry->pfPredictLevel = startPredLevel + 1;
-                } else {
-                    entry->pfPredictLevel = startPredLevel;
-                }
-                if (MJL_combinePredictDir) {
-                    entry->lastPredDir = MemCmd::MJL_DirAttribute::MJL_IsInvalid;
-                    for (unsigned i = 0; i < blkSize/sizeof(uint64_t); ++i) {
-                        entry->blkHits[i] = 0;
-                        entry->crossBlkHits[i] = 0;
-                    }
-                    entry->lastRowOff = 0;
-                    entry->lastColOff = 0;
-                    entry->predictLevel = startPredLevel;
-                    entry->resetLevel = 0;
-                }
-            }
-        }
-
-        void MJL_updateStride(const PacketPtr &pkt) {
-            if (observeAccess(pkt) && pkt->req->hasPC()) {
-                // Get required packet info
-                Addr pkt_addr = pkt->getAddr();
-                Addr pc = pkt->req->getPC();
-                bool is_secure = pkt->isSecure();
-                MasterID master_id = useMasterId ? pkt->req->masterId() : 0;
-                StrideEntry* entry;
-                if (MJL_1streamPredictDir) {
-                    pc = 0;
-                }
-                if (pcTableHit(pc, is_secure, master_id, entry)) {
-                    int new_stride = pkt_addr - entry->lastAddr;
-                    bool stride_match = (new_stride == entry->stride);
-
-                    // Adjust confidence for stride entry
-                    if (stride_match && new_stride != 0) {
-                        if (entry->confidence < maxConf)
-                            entry->confidence++;
-                    } else {
-                        if (entry->confidence > minConf)
-                            entry->confidence--;
-                        // If confidence has dropped below the threshold, train new stride
-                        if (entry->confidence < threshConf)
-                            entry->stride = new_stride;
-                    }
-                }
-            }
-        }
-
-        MemCmd::MJL_DirAttribute MJL_predictDir(const PacketPtr &pkt) {
-            MemCmd::MJL_DirAttribute predictedDir = pkt->MJL_getCmdDir();
-            if (observeAccess(pkt) && pkt->req->hasPC()) {
-                // Get required packet info
-                Addr pkt_addr = pkt->getAddr();
-                Addr pc = pkt->req->getPC();
-                bool is_secure = pkt->isSecure();
-                MasterID master_id = useMasterId ? pkt->req->masterId() : 0;
-
-                // Lookup pc-based information
-                StrideEntry *entry;
-
-                if (MJL_1streamPredictDir) {
-                    pc = 0;
-                }
-
-                if (pcTableHit(pc, is_secure, master_id, entry)) {
-                    // Hit in table
-                    if (MJL_utilPredictDir || MJL_mshrPredictDir) {
-                        /* MJL_Test */
-                        if (MJL_Debug_Out) {
-                            std::clog << "MJL_predDebug: MJL_mshrPredictDir " << pkt->print() << ", lastPredDir " << entry->lastPredDir << ", predictLevel " << entry->predictLevel;
-                        }
-                        /* */
-                        predictedDir = MJL_mshrPredict(pkt_addr, entry, pkt->MJL_getDirOffset(blkSize, MemCmd::MJL_DirAttribute::MJL_IsRow)/sizeof(uint64_t), pkt->MJL_getDirOffset(blkSize, MemCmd::MJL_DirAttribute::MJL_IsColumn)/sizeof(uint64_t), pkt->isWrite());
-                        /* MJL_Test */
-                        if (MJL_Debug_Out) {
-                            std::clog << ", predicted " << predictedDir << std::endl;
-                        }
-                        /* */
-                    } else if (MJL_pfBasedPredictDir) {
-                        predictedDir = MJL_pfPredict(entry);
-                    } else if (MJL_combinePredictDir) {
-                        predictedDir = MJL_combinePredict(pkt_addr, entry, pkt->MJL_getDirOffset(blkSize, MemCmd::MJL_DirAttribute::MJL_IsRow)/sizeof(uint64_t), pkt->MJL_getDirOffset(blkSize, MemCmd::MJL_DirAttribute::MJL_IsColumn)/sizeof(uint64_t), pkt->isWrite());
-                    } else {
-                        predictedDir = MJL_stridePredict(pkt_addr, entry, pkt->MJL_getCmdDir());
-                    }
-                } else {
-                    // Miss in table
-                    /* MJL_Comment 
-                    DPRINTF(HWPrefetch, "Miss: PC %x pkt_addr %x (%s)\n", pc, pkt_addr,
-                            is_secure ? "s" : "ns");
-                     */
-
-                    if (!MJL_utilPredictDir && !MJL_mshrPredictDir && !MJL_pfBasedPredictDir && !MJL_combinePredictDir) {
-                        StrideEntry* entry = pcTableVictim(pc, master_id);
-                        entry->instAddr = pc;
-                        entry->lastAddr = pkt_addr;
-                        entry->isSecure= is_secure;
-                        entry->stride = 0;
-                        entry->confidence = startConf;
-                        entry->predictLevel = startPredLevel;
-                        entry->resetLevel = 0;
-                        entry->lastPredDir = MemCmd::MJL_DirAttribute::MJL_IsRow;
-                        entry->pfPredictLevel = startPredLevel;
-                    }
-                }
-            }
-            return predictedDir;
-        }
-    };
-
-    MJL_DirPredictor * MJL_dirPredictor;
-    bool MJL_predictDir;
-    bool MJL_1streamPredictDir;
-    bool MJL_utilPredictDir;
-    bool MJL_mshrPredictDir;
-    bool MJL_pfBasedPredictDir;
-    bool MJL_combinePredictDir;
-    bool MJL_linkMshr;
+    /** Direction predictor of the misses, null when the packet direction is kept */
+    MJL_BaseDirPredictor * MJL_dirPredictor;
 
     bool MJL_ignoreExtraTagCheckLatency;
 
-    void MJL_printOracleProxyStats() {
-        std::ofstream oracleProxyOutFile;
-        if (MJL_perPCAddrOracleProxyStats) {
-            oracleProxyOutFile.open(this->name() + "_oracleProxyOut.txt");
-            for (auto PC_it = MJL_perPCAddrOracleProxyStats->begin(); PC_it != MJL_perPCAddrOracleProxyStats->end(); ++PC_it) {
-                for (auto addr_it = PC_it->second.begin(); addr_it != PC_it->second.end(); ++addr_it) {
-                    if (addr_it->second->getDir() == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                        oracleProxyOutFile << std::hex << PC_it->first << " " << addr_it->first << std::dec << " " << addr_it->second->printDir() << std::endl;
-                    }
-                    if (addr_it->second->row_hits > 1 || addr_it->second->col_hits > 1) {
-                        std::cout << std::hex << PC_it->first << " " << addr_it->first << std::dec << " " << addr_it->second->print() << std::endl;
-                	}
-                }
-            }
-            oracleProxyOutFile.close();
-        }
-    }
+    /** Write the recorded oracle proxy hits, counting the resident blocks too */
+    void MJL_printOracleProxyStats();
+
+    /** Cache block visitor handing the hits of a block to the recorder */
+    bool MJL_collectOracleProxyVisitor(CacheBlk &blk);
 
-    std::map < Addr, std::map < MemCmd::MJL_DirAttribute, uint64_t > > * MJL_perPCAccessCount;
-    std::map < Addr, std::vector < MemCmd::MJL_DirAttribute > > * MJL_perPCAccessTrace;
+    /** Per-PC direction trace of the requests at L2, written to <name>_dirTrace.gz */
+    MJL_DirTraceSink * MJL_perPCAccessTrace;
+    /** Memory cap of the direction trace buffers */
+    const uint64_t MJL_dirTraceMemCap;
     std::map < Addr, std::map < Addr, std::map< MemCmd::MJL_DirAttribute, uint64_t> > > * MJL_perPCAddrAccessCount;
 
     void MJL_countAccess(Addr pc, MemCmd::MJL_DirAttribute dir) {
-        if ( MJL_perPCAccessCount->find(pc) == MJL_perPCAccessCount->end() || (*MJL_perPCAccessCount)[pc].find(dir) == (*MJL_perPCAccessCount)[pc].end() ) {
-            (*MJL_perPCAccessCount)[pc][dir] = 0;
-        }
-        (*MJL_perPCAccessCount)[pc][dir]++;
-        (*MJL_perPCAccessTrace)[pc].push_back(dir);
+        MJL_perPCAccessTrace->MJL_record(pc, dir);
     }
 
     void MJL_countPCAddrAccess(Addr pc, Addr addr, MemCmd::MJL_DirAttribute dir) {
@@ -1514,9 +561,9 @@ class Cache : public BaseCache
             (*MJL_perPCAddrAccessCount)[pc][addr][dir] = 0;
         }
         (*MJL_perPCAddrAccessCount)[pc][addr][dir]++;
-        if (MJL_PCAddr2DirMap.find(pc) != MJL_PCAddr2DirMap.end()
-         && MJL_PCAddr2DirMap[pc].find(addr) != MJL_PCAddr2DirMap[pc].end()) {
-             if (MJL_PCAddr2DirMap[pc][addr] == dir) {
+        CacheBlk::MJL_CacheBlkDir oracleDir = MJL_PCAddr2DirTable.MJL_lookup(pc, addr);
+        if (oracleDir != CacheBlk::MJL_CacheBlkDir::MJL_IsInvalid) {
+             if (oracleDir == dir) {
                  MJL_predTrue++;
              } else {
                  MJL_predFalse++;
@@ -1545,56 +592,13 @@ class Cache : public BaseCache
     void MJL_printAccess() {
         std::cout << std::endl << "==== MJL_perPCAccessCount Begin ====" << this->name() << std::endl;
         std::cout << "PC Row_Accesses Col_Accesses" << std::endl;
-        for (auto it = MJL_perPCAccessCount->begin(); it != MJL_perPCAccessCount->end(); ++it) {
-            if ( it->second.find(MemCmd::MJL_DirAttribute::MJL_IsRow) == it->second.end() ) {
-                (it->second)[MemCmd::MJL_DirAttribute::MJL_IsRow] = 0;
-            }
-            if ( it->second.find(MemCmd::MJL_DirAttribute::MJL_IsColumn) == it->second.end() ) {
-                (it->second)[MemCmd::MJL_DirAttribute::MJL_IsColumn] = 0;
-            }
-            std::cout << std::hex << it->first << std::dec << " " << (it->second)[MemCmd::MJL_DirAttribute::MJL_IsRow] << " " << (it->second)[MemCmd::MJL_DirAttribute::MJL_IsColumn] << std::endl;
+        for (auto const &it : MJL_perPCAccessTrace->MJL_getCounts()) {
+            std::cout << std::hex << it.first << std::dec << " " << it.second.row << " " << it.second.col << std::endl;
         }
         std::cout << "==== MJL_perPCAccessCount End ====" << this->name() << std::endl;
-        std::cout << "==== MJL_perPCAccessTrace Begin ====" << this->name() << std::endl;
-        std::cout << "PC Trace(0 for row, 1 for column)" << std::endl;
-        for (auto it = MJL_perPCAccessTrace->begin(); it != MJL_perPCAccessTrace->end(); ++it) {
-            uint64_t temp_rowAccesses = 0;
-            uint64_t temp_colAccesses = 0;
-            uint64_t current_accesses = 0;
-            if ((*MJL_perPCAccessCount)[it->first][MemCmd::MJL_DirAttribute::MJL_IsRow] == 0 || (*MJL_perPCAccessCount)[it->first][MemCmd::MJL_DirAttribute::MJL_IsColumn] == 0) { continue; }
-            std::cout << std::hex << it->first << std::dec << " ";
-            MemCmd::MJL_DirAttribute last_dir = MemCmd::MJL_DirAttribute::MJL_IsInvalid;
-            for (auto dir : (it->second)) {
-                if (dir == last_dir) {
-                    current_accesses++;
-                } else if (last_dir == MemCmd::MJL_DirAttribute::MJL_IsInvalid) {
-                    if (dir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                        std::cout << 0 << "*";
-                    } else if (dir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                        std::cout << 1 << "*";
-                    };
-                    current_accesses++;
-                } else {
-                    std::cout << current_accesses << " ";
-                    current_accesses = 0;
-                    if (dir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                        std::cout << 0 << "*";
-                    } else if (dir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                        std::cout << 1 << "*";
-                    }
-                    current_accesses++;
-                }
-                last_dir = dir;
-                if (dir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                    temp_rowAccesses++;
-                } else if (dir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                    temp_colAccesses++;
-                }
-            }
-            std::cout << current_accesses << std::endl;
-            assert(temp_rowAccesses == (*MJL_perPCAccessCount)[it->first][MemCmd::MJL_DirAttribute::MJL_IsRow] && temp_colAccesses == (*MJL_perPCAccessCount)[it->first][MemCmd::MJL_DirAttribute::MJL_IsColumn]);
-        }
-        std::cout << "==== MJL_perPCAccessTrace End ====" << this->name() << std::endl;
+        // The trace itself is streamed to file, decode it with util/mjl_dir_trace_decode.py
+        MJL_perPCAccessTrace->MJL_close();
+        std::cout << "==== MJL_perPCAccessTrace in " << MJL_perPCAccessTrace->MJL_getFilename() << " ====" << this->name() << std::endl;
     }
     void MJL_printTestBloomFiltersStats () {    
         if (MJL_Test_rowColBloomFilters) {
@@ -1656,15 +660,20 @@ class Cache : public BaseCache
     PacketPtr tempBlockWriteback;
     /* MJL_Begin */
     /**
-     * The map that contains the mapping from PC to direction
+     * The PC to direction table, either the system-wide shared table or
+     * MJL_localPC2DirIndex when no table is given to this cache
      */
-    std::map<Addr, CacheBlk::MJL_CacheBlkDir> MJL_PC2DirMap;
-    std::map<Addr, std::map<Addr, CacheBlk::MJL_CacheBlkDir> > MJL_PCAddr2DirMap;
-
+    const MJL_PC2DirIndex *MJL_pc2DirIndex;
+    MJL_PC2DirIndex MJL_localPC2DirIndex;
     /**
-     * The set that contains the PC number of vector instructions
+     * The (PC, address) to direction table of the oracle proxy replay
      */
-    std::set<Addr> MJL_VecListSet;
+    MJL_PCAddrDirTable MJL_PCAddr2DirTable;
+    /**
+     * The direction regions registered by the workload, nullptr when the
+     * cache is not given a table
+     */
+    MJL_RegionDirTable *MJL_regionDirTable;
 
     /**
      * The name of the input file that contains the mapping information from PC to direction
@@ -1681,116 +690,99 @@ class Cache : public BaseCache
      * If the instruction is part of a vector column access, then the position of the instruction and the other part of the vector access instruction should also be provided.
      * The position 0 means that it is not a vector column access, 1 means that it is the first instruction, 2 means that it is the second instruction.
      * The other intstruction's PC can be set to 0 for non column vector insturctions.
+     * A binary table made by util/mjl_pc2dir_convert.py is mapped instead of parsed.
+     * Oracle proxy replay inputs (PCAddr2Dir text or a binary _oracleProxyOut.bin) fill MJL_PCAddr2DirTable instead.
      */
     void MJL_readPC2DirMap () {
-        std::ifstream MJL_PC2DirFile;
-        std::string line;
-        Addr tempPC;
-        char tempDir;
-        int tempPos;
-        Addr tempOtherPC;
-
-        MJL_PC2DirFile.open(MJL_PC2DirFilename);
-        if (MJL_PC2DirFile.is_open()) {
+        if (MJL_PC2DirFilename.find("PCAddr2Dir") == std::string::npos
+            && !MJL_PCAddrDirTable::MJL_isBinary(MJL_PC2DirFilename)) {
             std::cout << this->name() << "::Reading PC to direction preference input from " << MJL_PC2DirFilename << ":" << std::endl;
-            if (MJL_PC2DirFilename.find("PCAddr2Dir") != std::string::npos) {
-                Addr tempAddr;
-                uint64_t tempRowCount;
-                uint64_t tempColCount;
-                while (getline(MJL_PC2DirFile, line)) {
-                    std::stringstream(line) >> std::hex >> tempPC >> tempAddr >> std::dec >> tempDir >> tempRowCount >> tempColCount;
-                    if (tempDir == 'R') {
-                        MJL_PCAddr2DirMap[tempPC][tempAddr] =  CacheBlk::MJL_CacheBlkDir::MJL_IsRow;
-                    } else if (tempDir == 'C') {
-                        MJL_PCAddr2DirMap[tempPC][tempAddr] =  CacheBlk::MJL_CacheBlkDir::MJL_IsColumn;
-                    } else {
-                        std::cout << "MJL_Error: Invalid input direction annotation!\n";
-                        assert((tempDir == 'R') || (tempDir == 'C'));
-                    }
-                    /* MJL_Test: file information output 
-                    std::cout << "PC: " << std::hex << MJL_PCAddr2DirMap.find(tempPC)->first << ", Addr: " << MJL_PCAddr2DirMap[tempPC].find(tempAddr)->first << std::dec << ", Dir: " << MJL_PCAddr2DirMap[tempPC].find(tempAddr)->second << std::endl;
-                     */
-                };
+            if (MJL_PC2DirIndex::MJL_isBinary(MJL_PC2DirFilename)) {
+                MJL_localPC2DirIndex.MJL_loadBinary(MJL_PC2DirFilename);
             } else {
-                while (getline(MJL_PC2DirFile, line)) {
-                    std::stringstream(line) >> std::hex >> tempPC >> std::dec >> tempDir >> tempPos >> std::hex >> tempOtherPC >> std::dec;
-                    if (MJL_PC2DirMap.find(tempPC) != MJL_PC2DirMap.end()) {
-                        std::cout << "MJL_Error: Redefinition of instruction direction found!\n";
-                    }
-                    if (tempDir == 'R') {
-                        MJL_PC2DirMap[tempPC] =  CacheBlk::MJL_CacheBlkDir::MJL_IsRow;
-                    } else if (tempDir == 'C') {
-                        MJL_PC2DirMap[tempPC] =  CacheBlk::MJL_CacheBlkDir::MJL_IsColumn;
-                    } else {
-                        std::cout << "MJL_Error: Invalid input direction annotation!\n";
-                        assert((tempDir == 'R') || (tempDir == 'C'));
-                    }
-                    if (tempPos > 0) {
-                        assert(tempPos == 1 || tempPos == 2);
-                        assert( MJL_colVecHandler.MJL_ColVecList.find(tempOtherPC) == MJL_colVecHandler.MJL_ColVecList.end() || MJL_colVecHandler.MJL_ColVecList.at(tempOtherPC).pos != tempPos-1);
-                        MJL_colVecHandler.MJL_ColVecList.emplace(tempPC, MJL_ColVecHandler::MJL_VecInfo(tempOtherPC, tempPos-1));
-                    }
-                    /* MJL_Test: file information output */
-                    if (MJL_PC2DirMap.find(tempPC) != MJL_PC2DirMap.end()) {
-                        std::cout << "PC: " << std::hex << MJL_PC2DirMap.find(tempPC)->first << std::dec << ", Dir: " << MJL_PC2DirMap.find(tempPC)->second << ", ColumnVec: " << tempPos << ", OtherPC: " << std::hex << tempOtherPC << std::dec << "\n";
-                    }
-                    /* */
-                }
+                MJL_localPC2DirIndex.MJL_loadText(MJL_PC2DirFilename, MJL_VecListFilename);
             }
+            MJL_pc2DirIndex = &MJL_localPC2DirIndex;
+            std::cout << this->name() << "::" << MJL_pc2DirIndex->MJL_size() << " PC entries loaded" << std::endl;
+            return;
         }
-        else {
-            std::cout << "MJL_Error: Could not open input file!\n";
-            assert(MJL_PC2DirFile.is_open());
+
+        std::cout << this->name() << "::Reading PC and address to direction preference input from " << MJL_PC2DirFilename << ":" << std::endl;
+        if (MJL_PCAddrDirTable::MJL_isBinary(MJL_PC2DirFilename)) {
+            MJL_PCAddr2DirTable.MJL_loadBinary(MJL_PC2DirFilename);
+        } else {
+            MJL_PCAddr2DirTable.MJL_loadText(MJL_PC2DirFilename);
         }
-        MJL_PC2DirFile.close();
+        std::cout << this->name() << "::" << MJL_PCAddr2DirTable.MJL_size() << " PC and address entries loaded" << std::endl;
     }
 
     /**
-     * The function that reads in the list of vector instructions from the file
+     * Register the column vector instruction pairs of the PC to direction
+     * table with the column vector handler
      */
-    void MJL_readVecList () {
-        std::ifstream MJL_VecListFile;
-        std::string line;
-        Addr tempPC;
-
-        assert(MJL_VecListFilename != "");
-        MJL_VecListFile.open(MJL_VecListFilename);
-        if (MJL_VecListFile.is_open()) {
-            std::cout << this->name() << "::Reading vector instruction PC from " << MJL_VecListFilename << ":" << std::endl;
-            /* MJL_Test: file information output */
-            std::cout << "Vec inst PC:";
-            /* */
-            while (getline(MJL_VecListFile, line)) {
-                std::stringstream(line) >> std::hex >> tempPC >> std::dec;
-                if (MJL_VecListSet.find(tempPC) != MJL_VecListSet.end()) {
-                    std::cout << "MJL_Warning: Repeated vector PC found in file!\n";
-                }
-                MJL_VecListSet.insert(tempPC);
-                /* MJL_Test: file information output */
-                if (MJL_VecListSet.find(tempPC) != MJL_VecListSet.end()) {
-                    std::cout << " " << std::hex << *(MJL_VecListSet.find(tempPC)) << std::dec;
-                }
-                /* */
-            }
-            /* MJL_Test: file information output */
-            std::cout << std::endl;
-            /* */
+    void MJL_initColVecList () {
+        if (!MJL_pc2DirIndex) {
+            return;
         }
-        else {
-            std::cout << "MJL_Error: Could not open input file!\n";
-            assert(MJL_VecListFile.is_open());
+        for (const MJL_PC2DirEntry &entry : *MJL_pc2DirIndex) {
+            if (entry.pos > 0) {
+                assert(entry.pos == 1 || entry.pos == 2);
+                assert( MJL_colVecHandler.MJL_ColVecList.find(entry.otherPC) == MJL_colVecHandler.MJL_ColVecList.end() || MJL_colVecHandler.MJL_ColVecList.at(entry.otherPC).pos != entry.pos-1);
+                MJL_colVecHandler.MJL_ColVecList.emplace(entry.pc, MJL_ColVecHandler::MJL_VecInfo(entry.otherPC, entry.pos-1));
+            }
         }
-        MJL_VecListFile.close();
+    }
+
+    /** Preferred direction of the region of a request, MJL_IsInvalid if none */
+    CacheBlk::MJL_CacheBlkDir MJL_getRegionDir(const RequestPtr &req) const {
+        return MJL_regionDirTable ?
+            MJL_regionDirTable->MJL_lookup(req) : CacheBlk::MJL_CacheBlkDir::MJL_IsInvalid;
+    }
+
+    /** Preferred direction of a PC, MJL_IsInvalid if it is not annotated */
+    CacheBlk::MJL_CacheBlkDir MJL_getPC2Dir(Addr pc) const {
+        const MJL_PC2DirEntry *entry = MJL_pc2DirIndex ? MJL_pc2DirIndex->MJL_lookup(pc) : nullptr;
+        return entry ? entry->MJL_getDir() : CacheBlk::MJL_CacheBlkDir::MJL_IsInvalid;
     }
 
     /**
-     * Track the pointers to a pair of split packets.
+     * A pair of split packets is identified by the PC and time of the
+     * request and a sequence number among the pairs sharing them.
      */
-    std::map< Addr, std::map< Tick, std::map< int , std::tuple<PacketPtr, PacketPtr> > > > MJL_unalignedPacketList;  //[PC][_time][MJL_testSeq] = <OrigPtr, SecPtr>
+    struct MJL_SplitKey {
+        Addr pc;
+        Tick time;
+        int seq;
+        bool operator==(const MJL_SplitKey& other) const {
+            return pc == other.pc && time == other.time && seq == other.seq;
+        }
+    };
+    struct MJL_SplitKeyHash {
+        size_t operator()(const MJL_SplitKey& key) const {
+            return MJL_PCAddrDirTable::MJL_hash(key.pc, key.time ^ ((Tick)key.seq << 56));
+        }
+    };
     /**
-     * Register whether both response packets of a pair of split packets has been received.
+     * The pointers to a pair of split packets, and whether the response
+     * of each of them has been received.
      */
-    std::map< Addr, std::map< Tick, std::map< int , std::map< int, bool > > > > MJL_unalignedPacketCount;  //[PC][_time][MJL_testSeq][PacketAddrSeq] = received
+    struct MJL_SplitPair {
+        PacketPtr orig;
+        PacketPtr snd;
+        bool received[2];
+    };
+    /**
+     * Track the pairs of split packets until both responses are merged.
+     */
+    std::unordered_map<MJL_SplitKey, MJL_SplitPair, MJL_SplitKeyHash> MJL_unalignedPackets;
+    /** @return The first sequence number not used by a split pair of the request */
+    int MJL_nextSplitSeq(Addr pc, Tick time) const {
+        int seq = 0;
+        while (MJL_unalignedPackets.count(MJL_SplitKey{pc, time, seq})) {
+            ++seq;
+        }
+        return seq;
+    }
     /**
      * Track whether there is a second half of split packets waiting to be sent
      */
@@ -1807,6 +799,9 @@ class Cache : public BaseCache
 
         Cache* cache;
 
+        /** Most bytes of data a vector access carries */
+        static const unsigned MJL_maxVecSize = Packet::MJL_maxBlkSize;
+
         /**
          * The class that holds the column access that is waiting for the other part of the vector access
          */
@@ -1815,12 +810,84 @@ class Cache : public BaseCache
                 // For read, the packet that came second and the corresponding data from the first response packet are recorded
                 // For write, the packet that came first and the data from the second packet are recorded here.
                 PacketPtr pktWaiting;
-                uint8_t* dataWaiting;
-                MJL_VecWaiting(): pktWaiting(nullptr), dataWaiting(nullptr) { }
-                ~MJL_VecWaiting() {delete dataWaiting;}
+                bool hasData;
+                uint8_t dataWaiting[MJL_maxVecSize];
+                /** The next entry of the same PC and address, or the next free entry */
+                MJL_VecWaiting* next;
+                MJL_VecWaiting(): pktWaiting(nullptr), hasData(false), next(nullptr) { }
+        };
+
+        /** Key of the waiting entries, the PC and address of the packet they wait for */
+        struct MJL_VecKey {
+            Addr pc;
+            Addr addr;
+            bool operator==(const MJL_VecKey& other) const {
+                return pc == other.pc && addr == other.addr;
+            }
         };
+        struct MJL_VecKeyHash {
+            size_t operator()(const MJL_VecKey& key) const {
+                return MJL_PCAddrDirTable::MJL_hash(key.pc, key.addr);
+            }
+        };
+        /** The waiting entries of one key, oldest first */
+        struct MJL_VecQueue {
+            MJL_VecWaiting* head;
+            MJL_VecWaiting* tail;
+        };
+        std::unordered_map<MJL_VecKey, MJL_VecQueue, MJL_VecKeyHash> MJL_VecPktWaitingList;
+
+        /** Storage of all the waiting entries, a deque so entries never move */
+        std::deque<MJL_VecWaiting> MJL_vecPool;
+        /** Entries of the pool that are not in use */
+        MJL_VecWaiting* MJL_vecFreeList = nullptr;
+
+        /** Append a new entry to the entries waiting for the PC and address */
+        MJL_VecWaiting* MJL_pushVecWaiting(Addr pc, Addr addr) {
+            MJL_VecWaiting* vecWaiting = MJL_vecFreeList;
+            if (vecWaiting) {
+                MJL_vecFreeList = vecWaiting->next;
+            } else {
+                MJL_vecPool.emplace_back();
+                vecWaiting = &MJL_vecPool.back();
+            }
+            vecWaiting->pktWaiting = nullptr;
+            vecWaiting->hasData = false;
+            vecWaiting->next = nullptr;
+            auto queue_it = MJL_VecPktWaitingList.find(MJL_VecKey{pc, addr});
+            if (queue_it == MJL_VecPktWaitingList.end()) {
+                MJL_VecPktWaitingList.emplace(MJL_VecKey{pc, addr}, MJL_VecQueue{vecWaiting, vecWaiting});
+            } else {
+                queue_it->second.tail->next = vecWaiting;
+                queue_it->second.tail = vecWaiting;
+            }
+            return vecWaiting;
+        }
 
-        std::map< Addr, std::map< Addr, std::list<MJL_VecWaiting*> > > MJL_VecPktWaitingList; //[PC][Addr] = MJL_VecPktWaiting
+        /**
+         * Remove an entry from its queue and return it to the pool, the
+         * queue is erased when it becomes empty
+         * @param prev The entry before it in the queue, nullptr for the head
+         */
+        void MJL_removeVecWaiting(decltype(MJL_VecPktWaitingList)::iterator queue_it, MJL_VecWaiting* prev, MJL_VecWaiting* vecWaiting) {
+            MJL_VecQueue& queue = queue_it->second;
+            if (prev) {
+                assert(prev->next == vecWaiting);
+                prev->next = vecWaiting->next;
+            } else {
+                assert(queue.head == vecWaiting);
+                queue.head = vecWaiting->next;
+            }
+            if (queue.tail == vecWaiting) {
+                queue.tail = prev;
+            }
+            vecWaiting->pktWaiting = nullptr;
+            vecWaiting->next = MJL_vecFreeList;
+            MJL_vecFreeList = vecWaiting;
+            if (!queue.head) {
+                MJL_VecPktWaitingList.erase(queue_it);
+            }
+        }
 
         class MJL_VecInfo {
             public:
@@ -1828,7 +895,7 @@ class Cache : public BaseCache
                 int pos;
                 MJL_VecInfo(Addr in_otherPC, int in_pos): otherPC(in_otherPC), pos(in_pos) {}
         };
-        std::map< Addr, MJL_VecInfo> MJL_ColVecList; //[PC][{PC of the other instruction that makes the vector access, pos}], pos=0 is the first word, pos=1 is the second.
+        std::unordered_map< Addr, MJL_VecInfo> MJL_ColVecList; //[PC][{PC of the other instruction that makes the vector access, pos}], pos=0 is the first word, pos=1 is the second.
 
         /**
          * Determine whether the packet should be send to the L1 data cache.
@@ -1840,61 +907,55 @@ class Cache : public BaseCache
             bool satisfyPkt = false;
 
             // Try to find an entry matching the packet in the waiting list
-            auto PC_it = MJL_VecPktWaitingList.find(pkt->req->getPC());
+            auto queue_it = MJL_VecPktWaitingList.find(MJL_VecKey{pkt->req->getPC(), pkt->getAddr()});
             // If the entry is found
-            if (PC_it != MJL_VecPktWaitingList.end() && PC_it->second.find(pkt->getAddr()) != PC_it->second.end()) {
-                auto Addr_it = PC_it->second.find(pkt->getAddr());
-                auto vec_it = Addr_it->second.end();
+            if (queue_it != MJL_VecPktWaitingList.end()) {
+                MJL_VecWaiting* prev = nullptr;
+                MJL_VecWaiting* vecWaiting = queue_it->second.head;
                 // And the request is a read
                 if (pkt->isRead()) {
                     // An earlier request should have been sent to get the data for this request as well
                     // So we do not send this packet to the cache
                     shouldSend = false;
-                    // Should not have duplicate requests for this... but it happened... so I'm using a list...
-                    for (vec_it = Addr_it->second.begin(); vec_it != Addr_it->second.end(); ++vec_it) {
-                        if ((*vec_it)->pktWaiting != nullptr) continue;
+                    // Should not have duplicate requests for this... but it happened... so entries are queued per key
+                    for (; vecWaiting != nullptr; prev = vecWaiting, vecWaiting = vecWaiting->next) {
+                        if (vecWaiting->pktWaiting != nullptr) continue;
                         // Record this packet in the entry
-                        (*vec_it)->pktWaiting = pkt;
+                        vecWaiting->pktWaiting = pkt;
                         // And just satisfy the packet is the data is already available
-                        if ((*vec_it)->dataWaiting != nullptr) {
-                            satisfyPkt = satisfy_and_respond(*vec_it, isTiming);
+                        if (vecWaiting->hasData) {
+                            satisfyPkt = satisfy_and_respond(vecWaiting, isTiming);
                             assert(satisfyPkt);
                         }
                         break;
                     }
                 // If the request is a write
                 } else if (pkt->isWrite()) {
-                    for (vec_it = Addr_it->second.begin(); vec_it != Addr_it->second.end(); ++vec_it) {
+                    for (; vecWaiting != nullptr; prev = vecWaiting, vecWaiting = vecWaiting->next) {
                         // We should have the earlier packet available
-                        assert((*vec_it)->pktWaiting != nullptr);
-                        // Since we are using a list for duplicate case, the unused entry should not have a dataWaiting allocated
-                        if ((*vec_it)->dataWaiting != nullptr) continue;
+                        assert(vecWaiting->pktWaiting != nullptr);
+                        // Since duplicates are queued, the unused entry should not have data yet
+                        if (vecWaiting->hasData) continue;
                         // Keep a copy of the data in the packet
                         int write_size = pkt->getSize();
-                        (*vec_it)->dataWaiting = new uint8_t[write_size];
-                        pkt->writeData((*vec_it)->dataWaiting);
+                        assert((unsigned)write_size <= MJL_maxVecSize);
+                        pkt->writeData(vecWaiting->dataWaiting);
+                        vecWaiting->hasData = true;
                         // Modify the pkt to form a vector access
                         updatePkt(pkt);
                         // Reset data for vector access
                         pkt->deleteData();
                         pkt->allocate();
-                        std::memcpy(pkt->getPtr<uint8_t>() + MJL_ColVecList.at(pkt->req->getPC()).pos * write_size, (*vec_it)->dataWaiting, write_size);
-                        std::memcpy(pkt->getPtr<uint8_t>() + MJL_ColVecList.at((*vec_it)->pktWaiting->req->getPC()).pos * write_size, (*vec_it)->pktWaiting->getConstPtr<uint8_t>(), write_size);
+                        std::memcpy(pkt->getPtr<uint8_t>() + MJL_ColVecList.at(pkt->req->getPC()).pos * write_size, vecWaiting->dataWaiting, write_size);
+                        std::memcpy(pkt->getPtr<uint8_t>() + MJL_ColVecList.at(vecWaiting->pktWaiting->req->getPC()).pos * write_size, vecWaiting->pktWaiting->getConstPtr<uint8_t>(), write_size);
                         break;
                     }
                 }
-                assert(vec_it != Addr_it->second.end());
+                assert(vecWaiting != nullptr);
                 // If we have already done with the vector access
                 if (satisfyPkt) {
                     // Erase the entry from waiting list
-                    auto Addr_it = PC_it->second.find(pkt->getAddr());
-                    Addr_it->second.erase(vec_it);
-                    if (Addr_it->second.empty()) {
-                        PC_it->second.erase(Addr_it);
-                        if (PC_it->second.empty()) {
-                            MJL_VecPktWaitingList.erase(PC_it);
-                        }
-                    }
+                    MJL_removeVecWaiting(queue_it, prev, vecWaiting);
                 }
 
             // If the entry is not found
@@ -1917,7 +978,7 @@ class Cache : public BaseCache
         bool satisfy_and_respond(MJL_VecWaiting* vecWaiting, bool isTiming) {
             // The VecWaiting should have both a packet and data to be able to satisfy and respond
             assert(vecWaiting->pktWaiting != nullptr);
-            assert(vecWaiting->dataWaiting != nullptr);
+            assert(vecWaiting->hasData);
                 
             PacketPtr pkt = vecWaiting->pktWaiting;
             // Copy the data to packet if it is a read
@@ -1956,7 +1017,7 @@ class Cache : public BaseCache
                 } else {
                     otherAddr = cache->MJL_addOffsetAddr(otherAddr, pkt->MJL_getCmdDir(), pkt->getSize());
                 }
-                MJL_VecPktWaitingList[otherPC][otherAddr].push_back(new MJL_VecWaiting());
+                MJL_pushVecWaiting(otherPC, otherAddr);
                 // Modify the packet for vector accesses
                 updatePkt(pkt);
             // The packet for write is saved and not sent
@@ -1971,9 +1032,8 @@ class Cache : public BaseCache
                 } else {
                     otherAddr = cache->MJL_addOffsetAddr(otherAddr, pkt->MJL_getCmdDir(), pkt->getSize());
                 }
-                MJL_VecPktWaitingList[otherPC][otherAddr].push_back(new MJL_VecWaiting());
                 // Add self to the new entry's pktWaiting
-                MJL_VecPktWaitingList[otherPC][otherAddr].back()->pktWaiting = pkt;
+                MJL_pushVecWaiting(otherPC, otherAddr)->pktWaiting = pkt;
             }
 
             return shouldSend;
@@ -2001,11 +1061,13 @@ class Cache : public BaseCache
                         otherAddr = cache->MJL_addOffsetAddr(otherAddr, pkt->MJL_getCmdDir(), pkt->getSize()/2);
                     }
                     // This entry should exist
-                    auto PC_it = MJL_VecPktWaitingList.find(otherPC);
-                    assert(PC_it != MJL_VecPktWaitingList.end() && PC_it->second.find(otherAddr) != PC_it->second.end());
+                    auto queue_it = MJL_VecPktWaitingList.find(MJL_VecKey{otherPC, otherAddr});
+                    assert(queue_it != MJL_VecPktWaitingList.end());
+                    MJL_VecWaiting* vecWaiting = queue_it->second.head;
                     // Copy data from the packet to dataWaiting
-                    uint8_t *data = new uint8_t[pkt->getSize()];
-                    MJL_VecPktWaitingList[otherPC][otherAddr].front()->dataWaiting = data;
+                    assert(pkt->getSize() <= MJL_maxVecSize);
+                    uint8_t *data = vecWaiting->dataWaiting;
+                    vecWaiting->hasData = true;
                     pkt->writeData(data);
                     // Reset pkt to original form and get the correct portion of the data
                     resetPkt(pkt);
@@ -2014,18 +1076,12 @@ class Cache : public BaseCache
                     int write_size = pkt->getSize();
                     std::memcpy(pkt->getPtr<uint8_t>() + MJL_ColVecList.at(pkt->req->getPC()).pos * write_size, data, write_size);
                     // Satisfy the other packet if it is waiting 
-                    if (MJL_VecPktWaitingList[otherPC][otherAddr].front()->pktWaiting != nullptr) {
+                    if (vecWaiting->pktWaiting != nullptr) {
                         bool satisfy = false;
-                        satisfy = satisfy_and_respond(MJL_VecPktWaitingList[otherPC][otherAddr].front(), isTiming);
+                        satisfy = satisfy_and_respond(vecWaiting, isTiming);
                         assert(satisfy);
                         // Delete the entry after it has served it's purpose 
-                        MJL_VecPktWaitingList[otherPC][otherAddr].pop_front();
-                        if (MJL_VecPktWaitingList[otherPC][otherAddr].empty()) {
-                            MJL_VecPktWaitingList[otherPC].erase(otherAddr);
-                            if (MJL_VecPktWaitingList[otherPC].empty()) {
-                                MJL_VecPktWaitingList.erase(otherPC);
-                            }
-                        }
+                        MJL_removeVecWaiting(queue_it, nullptr, vecWaiting);
                     }
                 // Else if it is a write response
                 } else if (pkt->isWrite()) {
@@ -2034,21 +1090,16 @@ class Cache : public BaseCache
                     Addr thisPC = pkt->req->getPC();
                     Addr thisAddr = pkt->getAddr();
                     // This entry should exist
-                    auto PC_it = MJL_VecPktWaitingList.find(thisPC);
-                    assert(PC_it != MJL_VecPktWaitingList.end() && PC_it->second.find(thisAddr) != PC_it->second.end());
+                    auto queue_it = MJL_VecPktWaitingList.find(MJL_VecKey{thisPC, thisAddr});
+                    assert(queue_it != MJL_VecPktWaitingList.end());
+                    MJL_VecWaiting* vecWaiting = queue_it->second.head;
                     // And a packet should be present in the entry
-                    assert(MJL_VecPktWaitingList[thisPC][thisAddr].front()->pktWaiting != nullptr);
+                    assert(vecWaiting->pktWaiting != nullptr);
                     // The write for both packets has been satisfied, respond and delete the entry
                     bool satisfy = false;
-                    satisfy = satisfy_and_respond(MJL_VecPktWaitingList[thisPC][thisAddr].front(), isTiming);
+                    satisfy = satisfy_and_respond(vecWaiting, isTiming);
                     assert(satisfy);
-                    MJL_VecPktWaitingList[thisPC][thisAddr].pop_front();
-                    if (MJL_VecPktWaitingList[thisPC][thisAddr].empty()) {
-                        MJL_VecPktWaitingList[thisPC].erase(thisAddr);
-                        if (MJL_VecPktWaitingList[thisPC].empty()) {
-                            MJL_VecPktWaitingList.erase(thisPC);
-                        }
-                    }
+                    MJL_removeVecWaiting(queue_it, nullptr, vecWaiting);
                 }
             }
 
@@ -2086,121 +1137,154 @@ class Cache : public BaseCache
 
     MJL_ColVecHandler MJL_colVecHandler;
 
-    // MJL_TODO: dummy functions for now
+    /**
+     * Bounded log of the rows and columns touched in each tile. Entries
+     * come from a fixed pool, are found through a hash map and kept in an
+     * intrusive LRU list, so touching and evicting are O(1). When the log
+     * is full the least recently touched tile is dropped.
+     */
     class MJL_FootPrint {
         public:
 
             class MJL_FootPrintEntry {
                 public:
-                    bool MJL_rowFootPrint[8];
-                    bool MJL_colFootPrint[8];
-                    bool MJL_rowEvictFootPrint[8];
-                    bool MJL_colEvictFootPrint[8];
-
-                    MJL_FootPrintEntry() : MJL_rowFootPrint{false, false, false, false, false, false, false, false}, MJL_colFootPrint{false, false, false, false, false, false, false, false}, MJL_rowEvictFootPrint{false, false, false, false, false, false, false, false}, MJL_colEvictFootPrint{false, false, false, false, false, false, false, false} {}
+                    Addr tagSet;
+                    /** Bit i set if row/column i of the tile was touched */
+                    uint8_t MJL_rowFootPrint;
+                    uint8_t MJL_colFootPrint;
+                    uint8_t MJL_rowEvictFootPrint;
+                    uint8_t MJL_colEvictFootPrint;
+                    /** LRU list links, the list head is the least recent */
+                    MJL_FootPrintEntry *prev;
+                    MJL_FootPrintEntry *next;
+
+                    MJL_FootPrintEntry() : tagSet(0), MJL_rowFootPrint(0), MJL_colFootPrint(0), MJL_rowEvictFootPrint(0), MJL_colEvictFootPrint(0), prev(nullptr), next(nullptr) {}
+
+                    void MJL_reset(Addr tag_set) {
+                        tagSet = tag_set;
+                        MJL_rowFootPrint = 0;
+                        MJL_colFootPrint = 0;
+                        MJL_rowEvictFootPrint = 0;
+                        MJL_colEvictFootPrint = 0;
+                    }
             };
 
             unsigned logSize;
             unsigned numSets;
-            std::map<Addr, MJL_FootPrintEntry*> MJL_footPrintLog;
-            std::list<Addr> MJL_orderLog;
+            std::unordered_map<Addr, MJL_FootPrintEntry*> MJL_footPrintLog;
 
-            MJL_FootPrint(unsigned size, unsigned numsets) : logSize(size), numSets(numsets) {}
+            MJL_FootPrint(unsigned size, unsigned numsets, Stats::Scalar &evictions) : logSize(size), numSets(numsets), MJL_pool(size), MJL_freeList(nullptr), MJL_evictions(evictions) {
+                assert(logSize > 0);
+                MJL_footPrintLog.reserve(logSize);
+                MJL_lru.prev = &MJL_lru;
+                MJL_lru.next = &MJL_lru;
+                for (auto &entry : MJL_pool) {
+                    entry.next = MJL_freeList;
+                    MJL_freeList = &entry;
+                }
+            }
+
+            Addr MJL_tagSet(Addr tag, int set) const {
+                return (tag * (numSets) + set)/sizeof(uint64_t);
+            }
+
+            /** The entry of a tile, nullptr if it is not in the log */
+            MJL_FootPrintEntry * MJL_find(Addr tag, int set) const {
+                auto it = MJL_footPrintLog.find(MJL_tagSet(tag, set));
+                return it == MJL_footPrintLog.end() ? nullptr : it->second;
+            }
 
             void MJL_addFootPrint(Addr tag, int set, MemCmd::MJL_DirAttribute dir) {
-                auto found = MJL_orderLog.end();
-                Addr tag_set = (tag * (numSets) + set)/sizeof(uint64_t);
-                auto footPrintEntry = MJL_footPrintLog.find(tag_set);
-                
                 int set_offset = set % sizeof(uint64_t);
                 if (dir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                    if (footPrintEntry == MJL_footPrintLog.end()) {
-                        MJL_footPrintLog[tag_set] = new MJL_FootPrintEntry();
-                    }
-                    MJL_footPrintLog[tag_set]->MJL_rowFootPrint[set_offset] = true;
+                    MJL_touch(MJL_tagSet(tag, set))->MJL_rowFootPrint |= 1 << set_offset;
                 } else if (dir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                    if (footPrintEntry == MJL_footPrintLog.end()) {
-                        MJL_footPrintLog[tag_set] = new MJL_FootPrintEntry();
-                    }
-                    MJL_footPrintLog[tag_set]->MJL_colFootPrint[set_offset] = true;
-                }
-                for (auto it = MJL_orderLog.begin(); it != MJL_orderLog.end(); ++it) {
-                    if (*it == tag_set) {
-                        found = it;
-                        break;
-                    }
-                }
-                if (found == MJL_orderLog.end()) {
-                    MJL_orderLog.push_back(tag_set);
-                } else {
-                    MJL_orderLog.erase(found);
-                    MJL_orderLog.push_back(tag_set);
+                    MJL_touch(MJL_tagSet(tag, set))->MJL_colFootPrint |= 1 << set_offset;
                 }
             }
  
             void MJL_addEvictFootPrint(Addr tag, int set, MemCmd::MJL_DirAttribute dir) {
-                Addr tag_set = (tag * (numSets) + set)/sizeof(uint64_t);
-
                 int set_offset = set % sizeof(uint64_t);
                 if (dir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                    MJL_footPrintLog[tag_set] = new MJL_FootPrintEntry();
-                    MJL_footPrintLog[tag_set]->MJL_rowEvictFootPrint[set_offset] = true;
+                    MJL_FootPrintEntry *entry = MJL_touch(MJL_tagSet(tag, set));
+                    entry->MJL_reset(entry->tagSet);
+                    entry->MJL_rowEvictFootPrint |= 1 << set_offset;
                 } else if (dir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                    MJL_footPrintLog[tag_set] = new MJL_FootPrintEntry();
-                    MJL_footPrintLog[tag_set]->MJL_colEvictFootPrint[set_offset] = true;
+                    MJL_FootPrintEntry *entry = MJL_touch(MJL_tagSet(tag, set));
+                    entry->MJL_reset(entry->tagSet);
+                    entry->MJL_colEvictFootPrint |= 1 << set_offset;
                 }
             }
 
             void MJL_clearFootPrint(Addr tag, int set) {
-                Addr tag_set = (tag * (numSets) + set)/sizeof(uint64_t);
-                MJL_FootPrintEntry *clearEntry = MJL_footPrintLog[tag_set];
-                for (int i = 0; i < 8; ++i) {
-                    clearEntry->MJL_rowFootPrint[i] = false;
-                    clearEntry->MJL_colFootPrint[i] = false;
+                MJL_FootPrintEntry *clearEntry = MJL_find(tag, set);
+                if (clearEntry) {
+                    clearEntry->MJL_rowFootPrint = 0;
+                    clearEntry->MJL_colFootPrint = 0;
                 }
             }
 
             bool MJL_isFullFootPrint(Addr tag, int set) {
-                bool isFull = true;
-                Addr tag_set = (tag * (numSets) + set)/sizeof(uint64_t);
-                MJL_FootPrintEntry *entry = MJL_footPrintLog[tag_set];
-                for (int i = 0; i < 8; ++i) {
-                    isFull &= entry->MJL_rowFootPrint[i];
-                }
-                if (isFull) {
-                    return isFull;
-                } else {
-                    isFull = true;
-                    for (int i = 0; i < 8; ++i) {
-                        isFull &= entry->MJL_colFootPrint[i];
-                    }
-                }
-                return isFull;
+                MJL_FootPrintEntry *entry = MJL_find(tag, set);
+                return entry && (entry->MJL_rowFootPrint == 0xff || entry->MJL_colFootPrint == 0xff);
             }
 
             void MJL_setFullFootPrint(Addr tag, int set) {
-                Addr tag_set = (tag * (numSets) + set)/sizeof(uint64_t);
-                MJL_FootPrintEntry *setEntry = MJL_footPrintLog[tag_set];
-                for (int i = 0; i < 8; ++i) {
-                    setEntry->MJL_rowFootPrint[i] = true;
-                    setEntry->MJL_colFootPrint[i] = true;
-                }
+                MJL_FootPrintEntry *setEntry = MJL_touch(MJL_tagSet(tag, set));
+                setEntry->MJL_rowFootPrint = 0xff;
+                setEntry->MJL_colFootPrint = 0xff;
             }
 
             int MJL_touchedBytes(Addr tag, int set, unsigned blkSize) {
-                int touchedRows = 0;
-                int touchedCols = 0;
-                Addr tag_set = (tag * (numSets) + set)/sizeof(uint64_t);
-                MJL_FootPrintEntry *setEntry = MJL_footPrintLog[tag_set];
-                for (int i = 0; i < 8; ++i) {
-                    if (setEntry->MJL_rowFootPrint[i]) {
-                        touchedRows++;
-                    } else if (setEntry->MJL_colFootPrint[i]) {
-                        touchedCols++;
-                    }
+                MJL_FootPrintEntry *setEntry = MJL_find(tag, set);
+                if (!setEntry) {
+                    return 0;
                 }
+                // A row takes precedence over the column of the same index
+                int touchedRows = popCount(setEntry->MJL_rowFootPrint);
+                int touchedCols = popCount(setEntry->MJL_colFootPrint & ~setEntry->MJL_rowFootPrint);
                 return (touchedRows + touchedCols) * blkSize - touchedRows * touchedCols * sizeof(uint64_t);
             }
+
+        private:
+            /** Find or allocate the entry of a tile and make it the most recent */
+            MJL_FootPrintEntry * MJL_touch(Addr tag_set) {
+                MJL_FootPrintEntry *entry;
+                auto it = MJL_footPrintLog.find(tag_set);
+                if (it != MJL_footPrintLog.end()) {
+                    entry = it->second;
+                    MJL_unlink(entry);
+                } else {
+                    if (MJL_freeList) {
+                        entry = MJL_freeList;
+                        MJL_freeList = entry->next;
+                    } else {
+                        entry = MJL_lru.next;
+                        assert(entry != &MJL_lru);
+                        MJL_unlink(entry);
+                        MJL_footPrintLog.erase(entry->tagSet);
+                        MJL_evictions++;
+                    }
+                    entry->MJL_reset(tag_set);
+                    MJL_footPrintLog[tag_set] = entry;
+                }
+                entry->prev = MJL_lru.prev;
+                entry->next = &MJL_lru;
+                MJL_lru.prev->next = entry;
+                MJL_lru.prev = entry;
+                return entry;
+            }
+
+            void MJL_unlink(MJL_FootPrintEntry *entry) {
+                entry->prev->next = entry->next;
+                entry->next->prev = entry->prev;
+            }
+
+            std::vector<MJL_FootPrintEntry> MJL_pool;
+            MJL_FootPrintEntry *MJL_freeList;
+            /** Sentinel of the circular LRU list */
+            MJL_FootPrintEntry MJL_lru;
+            Stats::Scalar &MJL_evictions;
     };
 
     MJL_FootPrint *MJL_footPrint;
@@ -2208,28 +1292,33 @@ class Cache : public BaseCache
     void MJL_footPrintCachelines(Addr triggerAddr, MemCmd::MJL_DirAttribute triggerDir, std::list<Addr>* BlkAddrs, std::list<MemCmd::MJL_DirAttribute>* BlkDirs) {
         Addr triggerTag = tags->MJL_extractTag(triggerAddr, MemCmd::MJL_DirAttribute::MJL_IsRow);
         int triggerSet = tags->MJL_extractSet(triggerAddr, MemCmd::MJL_DirAttribute::MJL_IsRow);
-        Addr triggerTag_Set = (triggerTag * (tags->getNumSets()) + triggerSet)/sizeof(uint64_t);
+        MJL_FootPrint::MJL_FootPrintEntry *entry = MJL_footPrint->MJL_find(triggerTag, triggerSet);
+        if (!entry) {
+            MJL_footPrintMisses++;
+            return;
+        }
+        MJL_footPrintHits++;
         for (int i = 0; i < 8; ++i) {
             Addr rowBlkAddr = tags->MJL_regenerateBlkAddr(triggerTag, MemCmd::MJL_DirAttribute::MJL_IsRow, triggerSet/sizeof(uint64_t) + i);
             Addr colBlkAddr = tags->MJL_regenerateBlkAddr(triggerTag, MemCmd::MJL_DirAttribute::MJL_IsRow, triggerSet/sizeof(uint64_t)) + i * sizeof(uint64_t);
             if (triggerSet/sizeof(uint64_t) == i) {
                 if (triggerDir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                    if (MJL_footPrint->MJL_footPrintLog[triggerTag_Set]->MJL_colFootPrint[i]) {
+                    if ((entry->MJL_colFootPrint & (1 << i))) {
                         BlkAddrs->push_back(colBlkAddr);
                         BlkDirs->push_back(MemCmd::MJL_DirAttribute::MJL_IsColumn);
                     }
                 } else if (triggerDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                    if (MJL_footPrint->MJL_footPrintLog[triggerTag_Set]->MJL_rowFootPrint[i]) {
+                    if ((entry->MJL_rowFootPrint & (1 << i))) {
                         BlkAddrs->push_back(rowBlkAddr);
                         BlkDirs->push_back(MemCmd::MJL_DirAttribute::MJL_IsRow);
                     }
                 }
                 continue;
             }
-            if (MJL_footPrint->MJL_footPrintLog[triggerTag_Set]->MJL_rowFootPrint[i]) {
+            if ((entry->MJL_rowFootPrint & (1 << i))) {
                 BlkAddrs->push_back(rowBlkAddr);
                 BlkDirs->push_back(MemCmd::MJL_DirAttribute::MJL_IsRow);
-            } else if (MJL_footPrint->MJL_footPrintLog[triggerTag_Set]->MJL_colFootPrint[i]) {
+            } else if ((entry->MJL_colFootPrint & (1 << i))) {
                 BlkAddrs->push_back(colBlkAddr);
                 BlkDirs->push_back(MemCmd::MJL_DirAttribute::MJL_IsColumn);
             }
@@ -2363,8 +1452,7 @@ class Cache : public BaseCache
             if (mshr == nullptr) {
                 Request *fp_req =
                         new Request(*addr_it, blkSize, 0, pkt->req->masterId());
-                fp_req->MJL_cachelineSize = blkSize;
-                fp_req->MJL_rowWidth = pkt->req->MJL_rowWidth;
+                fp_req->MJL_geometry = &MJL_geometry;
                 MemCmd fp_cmd = pkt->needsWritable() ? MemCmd::ReadExReq :
             (isReadOnly ? MemCmd::ReadCleanReq : MemCmd::ReadSharedReq);
                 PacketPtr fp_pkt = new Packet(fp_req, fp_cmd, blkSize);
@@ -2414,8 +1502,7 @@ class Cache : public BaseCache
             if (mshr == nullptr && !mshrQueue.isFull() && !(blk && ((triggerDir == MemCmd::MJL_DirAttribute::MJL_IsRow && blk->isValid()) || (triggerDir == MemCmd::MJL_DirAttribute::MJL_IsColumn && blk->MJL_crossValid[tags->MJL_extractSet(*addr_it, MemCmd::MJL_DirAttribute::MJL_IsRow)%sizeof(uint64_t)])))) {
                 Request *fp_req =
                         new Request(*addr_it, blkSize, 0, pkt->req->masterId());
-                fp_req->MJL_cachelineSize = blkSize;
-                fp_req->MJL_rowWidth = pkt->req->MJL_rowWidth;
+                fp_req->MJL_geometry = &MJL_geometry;
                 MemCmd fp_cmd = pkt->needsWritable() ? MemCmd::ReadExReq :
             (isReadOnly ? MemCmd::ReadCleanReq : MemCmd::ReadSharedReq);
                 PacketPtr fp_pkt = new Packet(fp_req, fp_cmd, blkSize);
@@ -2758,25 +1845,17 @@ class Cache : public BaseCache
      * size: size of bytes written, can be used to determine how many words are written and their address
      * is_secure: used in MJL_findBlk
      */
-    void MJL_invalidateOtherBlocks(Addr MJL_written_addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, unsigned size, bool is_secure, PacketList& writebacks, bool MJL_wordDirty[8]) {
-        CacheBlk::MJL_CacheBlkDir MJL_diffDir;
+    void MJL_invalidateOtherBlocks(Addr MJL_written_addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, unsigned size, bool is_secure, PacketList& writebacks, const Packet::MJL_WordMask &MJL_wordDirty) {
         Addr MJL_writtenWord_addr;
         CacheBlk *MJL_diffDir_blk;
-        if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow) {
-            MJL_diffDir = CacheBlk::MJL_CacheBlkDir::MJL_IsColumn;
-        } else if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn) {
-            MJL_diffDir = CacheBlk::MJL_CacheBlkDir::MJL_IsRow;
-        } else {
+        if (MJL_cacheBlkDir != CacheBlk::MJL_CacheBlkDir::MJL_IsRow && MJL_cacheBlkDir != CacheBlk::MJL_CacheBlkDir::MJL_IsColumn) {
             assert(MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow || MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn);
-            MJL_diffDir = CacheBlk::MJL_CacheBlkDir::MJL_IsColumn;
+            MJL_cacheBlkDir = CacheBlk::MJL_CacheBlkDir::MJL_IsRow;
         }
         // Check for bloom filter stats
-        bool MJL_hasCrossBlk = false;
-        for (unsigned offset = 0; offset < blkSize; offset = offset + sizeof(uint64_t)) {
-            Addr MJL_writtenBlkAddr = MJL_blockAlign(MJL_written_addr, MJL_cacheBlkDir);
-            CacheBlk * MJL_crossBlk = tags->MJL_findBlock(MJL_addOffsetAddr(MJL_writtenBlkAddr, MJL_cacheBlkDir, offset), MJL_diffDir, is_secure);
-            MJL_hasCrossBlk |= ((MJL_crossBlk != nullptr) && MJL_crossBlk->isValid());
-        }
+        CacheBlk *MJL_crossBlks[MJL_TileDirectory::MJL_maxWords];
+        unsigned MJL_crossMask = tags->MJL_findCrossBlocks(MJL_written_addr, MJL_cacheBlkDir, is_secure, MJL_crossBlks);
+        bool MJL_hasCrossBlk = MJL_crossMask != 0;
         /* MJL_Test */
         if (MJL_Test_rowColBloomFilters) {
             MJL_Test_rowColBloomFilters->test_hasCrossStatCountBloomFilters(MJL_written_addr, MJL_cacheBlkDir, MJL_hasCrossBlk);
@@ -2796,10 +1875,11 @@ class Cache : public BaseCache
             assert(tags->MJL_get_tagsInUse() == MJL_rowColBloomFilter->total());
         }
         // Actual invalidation
-        for (unsigned offset = 0; offset < size; offset = offset + sizeof(uint64_t)) {
+        for (unsigned offset = 0; offset < size && MJL_crossMask; offset = offset + sizeof(uint64_t)) {
             if (MJL_wordDirty[offset/sizeof(uint64_t)]) {
                 MJL_writtenWord_addr = MJL_addOffsetAddr(MJL_written_addr, MJL_cacheBlkDir, offset);
-                MJL_diffDir_blk = tags->MJL_findBlock(MJL_writtenWord_addr, MJL_diffDir, is_secure);
+                unsigned MJL_word = tags->MJL_extractBlkOffset(MJL_writtenWord_addr, MJL_cacheBlkDir)/sizeof(uint64_t);
+                MJL_diffDir_blk = (MJL_crossMask & (1 << MJL_word)) ? MJL_crossBlks[MJL_word] : nullptr;
                 if ((MJL_diffDir_blk != nullptr) && MJL_diffDir_blk->isValid()) {
                     // MJL_TODO: should check if there's an upgrade miss waiting on this I guess?
                     MJL_conflictWBCount4++;
@@ -2826,20 +1906,18 @@ class Cache : public BaseCache
      * is_secure: used in MJL_findBlk
      */
     void MJL_unreadableOtherBlocks(Addr MJL_upgrade_addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, unsigned size, bool is_secure) {
-        CacheBlk::MJL_CacheBlkDir MJL_diffDir;
         Addr MJL_writtenWord_addr;
         CacheBlk *MJL_diffDir_blk;
-        if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow) {
-            MJL_diffDir = CacheBlk::MJL_CacheBlkDir::MJL_IsColumn;
-        } else if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn) {
-            MJL_diffDir = CacheBlk::MJL_CacheBlkDir::MJL_IsRow;
-        } else {
+        if (MJL_cacheBlkDir != CacheBlk::MJL_CacheBlkDir::MJL_IsRow && MJL_cacheBlkDir != CacheBlk::MJL_CacheBlkDir::MJL_IsColumn) {
             assert(MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow || MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn);
-            MJL_diffDir = CacheBlk::MJL_CacheBlkDir::MJL_IsColumn;
+            MJL_cacheBlkDir = CacheBlk::MJL_CacheBlkDir::MJL_IsRow;
         }
-        for (unsigned offset = 0; offset < size; offset = offset + sizeof(uint64_t)) {
+        CacheBlk *MJL_crossBlks[MJL_TileDirectory::MJL_maxWords];
+        unsigned MJL_crossMask = tags->MJL_findCrossBlocks(MJL_upgrade_addr, MJL_cacheBlkDir, is_secure, MJL_crossBlks);
+        for (unsigned offset = 0; offset < size && MJL_crossMask; offset = offset + sizeof(uint64_t)) {
             MJL_writtenWord_addr = MJL_addOffsetAddr(MJL_upgrade_addr, MJL_cacheBlkDir, offset);
-	        MJL_diffDir_blk = tags->MJL_findBlock(MJL_writtenWord_addr, MJL_diffDir, is_secure);
+            unsigned MJL_word = tags->MJL_extractBlkOffset(MJL_writtenWord_addr, MJL_cacheBlkDir)/sizeof(uint64_t);
+            MJL_diffDir_blk = (MJL_crossMask & (1 << MJL_word)) ? MJL_crossBlks[MJL_word] : nullptr;
             if (MJL_diffDir_blk != nullptr) {
                 if (MJL_diffDir_blk->isValid()) {
                     MJL_diffDir_blk->status &= ~BlkReadable;
@@ -3131,15 +2209,7 @@ class Cache : public BaseCache
         return (mshrQueue.MJL_findMatch(addr, MJL_cacheBlkDir, is_secure) != 0);
     }
     bool MJL_crossDirtyInCache(const PacketPtr &pkt) const override {
-        bool crossDirtyInCache = false;
-        for ( int i = 0; i < blkSize/sizeof(uint64_t); ++i ) {
-            CacheBlk * MJL_crossBlk = nullptr;
-            MJL_crossBlk = tags->MJL_findBlock(pkt->MJL_getCrossBlockAddrs(blkSize, i), pkt->MJL_getCrossCmdDir(), pkt->isSecure());
-            if (MJL_crossBlk && MJL_crossBlk->isValid() && MJL_crossBlk->isDirty()) {
-                crossDirtyInCache |= true;
-            }
-        }
-        return crossDirtyInCache;
+        return MJL_crossDirtyInCache(pkt->getAddr(), pkt->MJL_getCmdDir(), pkt->isSecure());
     }
     bool MJL_crossDirtyInMissQueue(const PacketPtr &pkt) const override {
         bool crossDirtyInMissQueue = false;
@@ -3164,21 +2234,19 @@ class Cache : public BaseCache
         return crossDirtyInWriteBuffer;
     }
     bool MJL_crossDirtyInCache(Addr addr, MemCmd::MJL_DirAttribute MJL_cacheBlkDir, bool is_secure) const override {
-        bool crossDirtyInCache = false;
-        for ( int i = 0; i < blkSize; i += sizeof(uint64_t) ) {
-            CacheBlk * MJL_crossBlk = nullptr;
-            MemCmd::MJL_DirAttribute MJL_crossBlkDir = MJL_cacheBlkDir;
-            if (MJL_cacheBlkDir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                MJL_crossBlkDir = MemCmd::MJL_DirAttribute::MJL_IsColumn;
-            } else if (MJL_cacheBlkDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                MJL_crossBlkDir = MemCmd::MJL_DirAttribute::MJL_IsRow;
-            }
-            MJL_crossBlk = tags->MJL_findBlock(MJL_addOffsetAddr(addr, MJL_crossBlkDir, i), MJL_crossBlkDir, is_secure);
-            if (MJL_crossBlk && MJL_crossBlk->isValid() && MJL_crossBlk->isDirty()) {
-                crossDirtyInCache |= true;
+        if (MJL_cacheBlkDir != MemCmd::MJL_DirAttribute::MJL_IsRow && MJL_cacheBlkDir != MemCmd::MJL_DirAttribute::MJL_IsColumn) {
+            return false;
+        }
+        CacheBlk *MJL_crossBlks[MJL_TileDirectory::MJL_maxWords];
+        unsigned MJL_crossMask = tags->MJL_findCrossBlocks(addr, MJL_cacheBlkDir, is_secure, MJL_crossBlks);
+        while (MJL_crossMask) {
+            CacheBlk *MJL_crossBlk = MJL_crossBlks[__builtin_ctz(MJL_crossMask)];
+            MJL_crossMask &= MJL_crossMask - 1;
+            if (MJL_crossBlk->isDirty()) {
+                return true;
             }
         }
-        return crossDirtyInCache;
+        return false;
     }
     bool MJL_crossDirtyInMissQueue(Addr addr, MemCmd::MJL_DirAttribute MJL_cacheBlkDir, bool is_secure) const override {
         bool crossDirtyInMissQueue = false;
@@ -3214,13 +2282,14 @@ class Cache : public BaseCache
         }
         return crossDirtyInWriteBuffer;
     }
-    /** Test to see if the address is in the MJL_PC2DirMap */
+    /** Test to see if the address is in the PC to direction table */
     virtual bool MJL_isInterestedAccess(Addr addr) const {
-        return (MJL_PC2DirMap.find(addr) != MJL_PC2DirMap.end());
+        return MJL_getPC2Dir(addr) != CacheBlk::MJL_CacheBlkDir::MJL_IsInvalid;
     }
 
     virtual bool MJL_isVecAccess(Addr addr) const {
-        return (MJL_VecListSet.find(addr) != MJL_VecListSet.end());
+        const MJL_PC2DirEntry *entry = MJL_pc2DirIndex ? MJL_pc2DirIndex->MJL_lookup(addr) : nullptr;
+        return entry && entry->MJL_isVec();
     }
     /* MJL_End */
 
@@ -3258,6 +2327,48 @@ class Cache : public BaseCache
      */
     bool sendWriteQueuePacket(WriteQueueEntry* wq_entry);
 
+    /* MJL_Begin */
+    /**
+     * In whole tile transfer mode, put the miss packet of an MSHR and the
+     * misses of the same tile that are ready to go into one tile packet.
+     *
+     * @param mshr The MSHR being sent
+     * @param pkt The miss packet of mshr, with mshr as its sender state
+     * @param mshrs Filled with the MSHRs of the lines, in tile order
+     * @return The tile packet, nullptr if no other line can go with pkt
+     */
+    PacketPtr MJL_createTileMissPacket(MSHR *mshr, PacketPtr pkt,
+                                       std::vector<MSHR*> &mshrs);
+
+    /**
+     * Same as MJL_createTileMissPacket, for the writebacks of a tile in
+     * the write buffer.
+     */
+    PacketPtr MJL_createTileWritePacket(WriteQueueEntry *wq_entry,
+                                        std::vector<WriteQueueEntry*> &entries);
+
+    /** @return Whether the lines are in a tile packet and it can go */
+    bool MJL_tilePacketsAllowed() const
+    {
+        return MJL_2DCache && MJL_2DTransferType == 1 && MJL_tilePackets;
+    }
+
+    /**
+     * Send a tile packet of misses, marking the MSHRs of its lines in
+     * service if it goes.
+     * @return True if the port is waiting for a retry
+     */
+    bool MJL_sendTileMissPacket(PacketPtr tile_pkt,
+                                const std::vector<MSHR*> &mshrs);
+
+    /** MJL_sendTileMissPacket for a tile packet of writebacks */
+    bool MJL_sendTileWritePacket(PacketPtr tile_pkt,
+                                 const std::vector<WriteQueueEntry*> &entries);
+
+    /** Hand the response of each line of a tile packet to recvTimingResp */
+    void MJL_recvTileResp(PacketPtr pkt);
+    /* MJL_End */
+
     /** serialize the state of the caches
      * We currently don't support checkpointing cache state, so this panics.
      */
@@ -0,0 +1,209 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Definition of the bounded per-PC direction trace.
+ */
+
+#include "mem/cache/dir_trace.hh"
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+
+#include "base/misc.hh"
+
+const char MJL_DirTraceSink::MJL_magic[8] = {'M', 'J', 'L', 'D', 'T', 'R',
+                                             'C', '\0'};
+const uint32_t MJL_DirTraceSink::MJL_version;
+const size_t MJL_DirTraceSink::MJL_chunkBytes;
+
+MJL_DirTraceSink::MJL_DirTraceSink(const std::string &filename,
+                                   uint64_t mem_cap)
+    : filename(filename), memCap(mem_cap), openChunks(0), pendingBytes(0),
+      closing(false), writeFailed(false), writeErrno(0), file(nullptr)
+{
+    if (memCap < 4 * MJL_chunkBytes) {
+        fatal("Direction trace memory cap %d is below %d bytes\n", memCap,
+              4 * MJL_chunkBytes);
+    }
+    file = gzopen(filename.c_str(), "wb");
+    if (file == NULL) {
+        fatal("Could not open direction trace '%s'\n", filename);
+    }
+    if (gzwrite(file, MJL_magic, sizeof(MJL_magic)) != (int)sizeof(MJL_magic) ||
+        gzwrite(file, &MJL_version, sizeof(MJL_version)) !=
+        (int)sizeof(MJL_version)) {
+        fatal("Write failed on direction trace '%s'\n", filename);
+    }
+    writer = std::thread(&MJL_DirTraceSink::MJL_writerLoop, this);
+}
+
+MJL_DirTraceSink::~MJL_DirTraceSink()
+{
+    MJL_close();
+}
+
+void
+MJL_DirTraceSink::MJL_record(Addr pc, MemCmd::MJL_DirAttribute dir)
+{
+    assert(!closing);
+    assert(dir == MemCmd::MJL_DirAttribute::MJL_IsRow ||
+           dir == MemCmd::MJL_DirAttribute::MJL_IsColumn);
+    bool is_column = dir == MemCmd::MJL_DirAttribute::MJL_IsColumn;
+
+    auto it = pcStates.find(pc);
+    if (it == pcStates.end()) {
+        MJL_PCState &state = pcStates[pc];
+        state.count.row = 0;
+        state.count.col = 0;
+        state.runIsColumn = is_column;
+        state.runLength = 0;
+        it = pcStates.find(pc);
+    }
+    MJL_PCState &state = it->second;
+
+    if (is_column) {
+        state.count.col++;
+    } else {
+        state.count.row++;
+    }
+
+    if (state.runLength > 0 && state.runIsColumn != is_column) {
+        MJL_encodeRun(pc, state);
+    }
+    state.runIsColumn = is_column;
+    state.runLength++;
+}
+
+void
+MJL_DirTraceSink::MJL_encodeRun(Addr pc, MJL_PCState &state)
+{
+    // A varint of a 64-bit run takes at most 10 bytes
+    if (state.chunk.size() + 10 > MJL_chunkBytes) {
+        MJL_seal(pc, state);
+    }
+    if (state.chunk.capacity() == 0) {
+        if ((openChunks + 1) * MJL_chunkBytes > memCap / 2) {
+            MJL_flushOpenChunks();
+        }
+        state.chunk.reserve(MJL_chunkBytes);
+        openChunks++;
+    }
+    uint64_t value = (state.runLength << 1) | (state.runIsColumn ? 1 : 0);
+    do {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        state.chunk.push_back(value ? (byte | 0x80) : byte);
+    } while (value);
+    state.runLength = 0;
+}
+
+void
+MJL_DirTraceSink::MJL_seal(Addr pc, MJL_PCState &state)
+{
+    if (state.chunk.capacity() == 0) {
+        return;
+    }
+    MJL_checkWriter();
+    MJL_Chunk chunk;
+    chunk.pc = pc;
+    chunk.bytes.swap(state.chunk);
+    openChunks--;
+
+    std::unique_lock<std::mutex> lock(queueLock);
+    // Back-pressure when the writer falls behind
+    queueCond.wait(lock, [this] {
+        return pendingBytes + MJL_chunkBytes <= memCap / 2;
+    });
+    pendingBytes += MJL_chunkBytes;
+    pending.push_back(std::move(chunk));
+    queueCond.notify_all();
+}
+
+void
+MJL_DirTraceSink::MJL_flushOpenChunks()
+{
+    for (auto &it : pcStates) {
+        MJL_seal(it.first, it.second);
+    }
+    assert(openChunks == 0);
+}
+
+void
+MJL_DirTraceSink::MJL_writerLoop()
+{
+    std::unique_lock<std::mutex> lock(queueLock);
+    while (true) {
+        queueCond.wait(lock, [this] { return closing || !pending.empty(); });
+        if (pending.empty()) {
+            return;
+        }
+        MJL_Chunk chunk = std::move(pending.front());
+        pending.pop_front();
+        lock.unlock();
+
+        // fatal() is not safe off the main thread, the error is raised
+        // there on the next seal or at close
+        uint64_t pc = chunk.pc;
+        uint32_t size = chunk.bytes.size();
+        errno = 0;
+        if (!writeFailed.load(std::memory_order_relaxed) &&
+            (gzwrite(file, &pc, sizeof(pc)) != (int)sizeof(pc) ||
+             gzwrite(file, &size, sizeof(size)) != (int)sizeof(size) ||
+             gzwrite(file, chunk.bytes.data(), size) != (int)size)) {
+            writeErrno = errno;
+            writeFailed.store(true, std::memory_order_release);
+        }
+
+        lock.lock();
+        pendingBytes -= MJL_chunkBytes;
+        queueCond.notify_all();
+    }
+}
+
+void
+MJL_DirTraceSink::MJL_close()
+{
+    if (!file) {
+        return;
+    }
+    for (auto &it : pcStates) {
+        if (it.second.runLength > 0) {
+            MJL_encodeRun(it.first, it.second);
+        }
+    }
+    MJL_flushOpenChunks();
+    {
+        std::lock_guard<std::mutex> lock(queueLock);
+        closing = true;
+        queueCond.notify_all();
+    }
+    writer.join();
+    MJL_checkWriter();
+    if (gzclose(file) != Z_OK) {
+        fatal("Close failed on direction trace '%s'\n", filename);
+    }
+    file = nullptr;
+}
+
+void
+MJL_DirTraceSink::MJL_checkWriter() const
+{
+    if (writeFailed.load(std::memory_order_acquire)) {
+        fatal("Write failed on direction trace '%s': %s\n", filename,
+              writeErrno ? std::strerror(writeErrno) : "zlib error");
+    }
+}
+
+std::map<Addr, MJL_DirTraceSink::MJL_PCCount>
+MJL_DirTraceSink::MJL_getCounts() const
+{
+    std::map<Addr, MJL_PCCount> counts;
+    for (const auto &it : pcStates) {
+        counts[it.first] = it.second.count;
+    }
+    return counts;
+}
+
+/* MJL_End */
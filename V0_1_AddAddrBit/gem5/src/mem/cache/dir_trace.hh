@@ -0,0 +1,126 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Declaration of the bounded per-PC direction trace. Each PC's direction
+ * stream is run-length encoded into fixed-size chunks which a background
+ * thread writes to a gzip compressed file, so memory does not grow with
+ * the length of the run. util/mjl_dir_trace_decode.py reads the file back.
+ */
+
+#ifndef __MEM_CACHE_DIR_TRACE_HH__
+#define __MEM_CACHE_DIR_TRACE_HH__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <zlib.h>
+
+#include "base/types.hh"
+#include "mem/packet.hh"
+
+/**
+ * File layout (inside the gzip stream): an 8 byte magic and a 32-bit
+ * version, followed by chunk records. A chunk record is the 64-bit PC, the
+ * 32-bit byte count and the bytes, which are LEB128 varints of
+ * (run_length << 1 | is_column). The runs of one PC are in order across
+ * its chunks.
+ */
+class MJL_DirTraceSink
+{
+  public:
+    static const char MJL_magic[8];
+    static const uint32_t MJL_version = 1;
+    /** Size of the per-PC encoding buffer */
+    static const size_t MJL_chunkBytes = 256;
+
+    /** Access counts of one PC */
+    struct MJL_PCCount
+    {
+        uint64_t row;
+        uint64_t col;
+    };
+
+    /**
+     * @param filename Output file, gzip compressed
+     * @param mem_cap Bound on the chunk buffers, half for the open chunks
+     *                (flushed when full) and half for the chunks waiting
+     *                to be written (recording waits when full)
+     */
+    MJL_DirTraceSink(const std::string &filename, uint64_t mem_cap);
+    ~MJL_DirTraceSink();
+
+    MJL_DirTraceSink(const MJL_DirTraceSink &) = delete;
+    MJL_DirTraceSink &operator=(const MJL_DirTraceSink &) = delete;
+
+    /** Record one access of a PC */
+    void MJL_record(Addr pc, MemCmd::MJL_DirAttribute dir);
+
+    /** Encode the open runs, write everything out and close the file */
+    void MJL_close();
+
+    /** Per PC access counts, ordered by PC */
+    std::map<Addr, MJL_PCCount> MJL_getCounts() const;
+
+    const std::string &MJL_getFilename() const { return filename; }
+
+  private:
+    struct MJL_Chunk
+    {
+        Addr pc;
+        std::vector<uint8_t> bytes;
+    };
+
+    struct MJL_PCState
+    {
+        MJL_PCCount count;
+        /** Direction and length of the run not yet encoded */
+        bool runIsColumn;
+        uint64_t runLength;
+        /** Open chunk, empty when the PC has nothing buffered */
+        std::vector<uint8_t> chunk;
+    };
+
+    void MJL_encodeRun(Addr pc, MJL_PCState &state);
+    void MJL_seal(Addr pc, MJL_PCState &state);
+    void MJL_flushOpenChunks();
+    void MJL_writerLoop();
+    /** Raise a write error of the writer thread, on the main thread */
+    void MJL_checkWriter() const;
+
+    const std::string filename;
+    const uint64_t memCap;
+
+    std::unordered_map<Addr, MJL_PCState> pcStates;
+    /** Number of PCs with an open chunk */
+    uint64_t openChunks;
+
+    /** Chunks handed to the writer thread */
+    std::mutex queueLock;
+    std::condition_variable queueCond;
+    std::deque<MJL_Chunk> pending;
+    uint64_t pendingBytes;
+    bool closing;
+
+    /**
+     * Set by the writer thread when a write failed, with the errno of the
+     * failure in writeErrno. The writer drops the chunks after it.
+     */
+    std::atomic<bool> writeFailed;
+    int writeErrno;
+
+    gzFile file;
+    std::thread writer;
+};
+
+#endif // __MEM_CACHE_DIR_TRACE_HH__
+
+/* MJL_End */
@@ -0,0 +1,73 @@
+# MJL_Begin
+# Direction predictors of the data caches, they pick whether a miss is
+# fetched as a row or a column line. All the schemes keep a PC table of
+# table_sets x table_assoc entries per master.
+
+from m5.SimObject import SimObject
+from m5.params import *
+from m5.proxy import *
+
+class MJL_BaseDirPredictor(SimObject):
+    type = 'MJL_BaseDirPredictor'
+    abstract = True
+    cxx_header = "mem/cache/dirpred/base.hh"
+
+    table_sets = Param.Int(16, "Number of sets in the PC table, a power of 2")
+    table_assoc = Param.Int(4, "Associativity of the PC table")
+    use_master_id = Param.Bool(True, "Keep a PC table per master")
+    one_stream = Param.Bool(False, "Track all accesses as one stream instead of one per PC")
+
+    max_conf = Param.Int(3, "Maximum stride confidence")
+    thresh_conf = Param.Int(2, "Stride confidence needed to use the stride")
+    min_conf = Param.Int(0, "Minimum stride confidence")
+    start_conf = Param.Int(2, "Stride confidence of a new entry")
+
+    start_pred_level = Param.Int(7, "Prediction level of a new entry")
+    max_pred_level = Param.Int(15, "Prediction level at which the column direction is taken, level 0 takes the row direction")
+    max_reset_level = Param.Int(7, "Misses without locality before a column entry falls back to row")
+
+    debug_out = Param.Bool(False, "Trace the predictor on std::clog")
+
+# Stride scheme, a confident stride of a multiple of the row size predicts
+# column
+class MJL_StrideDirPredictor(MJL_BaseDirPredictor):
+    type = 'MJL_StrideDirPredictor'
+    cxx_header = "mem/cache/dirpred/stride.hh"
+
+# Mshr scheme, learns from the words touched around each miss
+class MJL_MshrDirPredictor(MJL_BaseDirPredictor):
+    type = 'MJL_MshrDirPredictor'
+    cxx_header = "mem/cache/dirpred/mshr.hh"
+
+    link_mshr = Param.Bool(False, "Stop tracking a miss when its mshr is freed")
+    queue_size = Param.Unsigned(16, "Misses tracked, with link_mshr it should "
+                                "cover the mshrs of the cache")
+    self_stride = Param.Bool(True, "Extend the touched words of an entry along its confident stride")
+
+# Utilization scheme, the mshr scheme without the stride extension
+class MJL_UtilDirPredictor(MJL_MshrDirPredictor):
+    self_stride = False
+
+# Prefetch scheme, follows the directions picked by the downstream
+# prefetcher (MJL_pfBasedPredictDir of the prefetcher)
+class MJL_PfDirPredictor(MJL_BaseDirPredictor):
+    type = 'MJL_PfDirPredictor'
+    cxx_header = "mem/cache/dirpred/pf.hh"
+
+# Mshr scheme backed by the prefetch scheme when its direction is unstable
+class MJL_CombineDirPredictor(MJL_MshrDirPredictor):
+    type = 'MJL_CombineDirPredictor'
+    cxx_header = "mem/cache/dirpred/combine.hh"
+
+# Runs all the predictors on the same accesses, only the steer one decides
+# the direction of the misses. Each prediction is scored once window newer
+# misses were predicted, against the direction whose line got more of its
+# words touched. The table parameters of the shadow itself are unused.
+class MJL_ShadowDirPredictor(MJL_BaseDirPredictor):
+    type = 'MJL_ShadowDirPredictor'
+    cxx_header = "mem/cache/dirpred/shadow.hh"
+
+    predictors = VectorParam.MJL_BaseDirPredictor("Predictors to run")
+    steer = Param.Unsigned(0, "Index of the predictor deciding the misses")
+    window = Param.Unsigned(16, "Misses tracked before they are scored")
+# MJL_End
@@ -0,0 +1,272 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Definition of the base direction predictor.
+ */
+
+#include "mem/cache/dirpred/base.hh"
+
+#include <algorithm>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/misc.hh"
+#include "base/random.hh"
+#include "mem/cache/base.hh"
+#include "mem/cache/tags/tag_match.hh"
+
+MJL_BaseDirPredictor::PCTable::PCTable(int assoc, int sets)
+    : pcTableAssoc(assoc), pcTableSets(sets), tagWays(roundUp(assoc, 8))
+{
+}
+
+MJL_BaseDirPredictor::PCTable::Context&
+MJL_BaseDirPredictor::PCTable::MJL_context(int context)
+{
+    assert(context >= 0);
+    if (context >= contexts.size()) {
+        contexts.resize(context + 1);
+    }
+    Context &ctx = contexts[context];
+    if (ctx.entries.empty()) {
+        ctx.tags.assign(pcTableSets * tagWays, 0);
+        ctx.entries.resize(pcTableSets * pcTableAssoc);
+    }
+    return ctx;
+}
+
+MJL_BaseDirPredictor::StrideEntry*
+MJL_BaseDirPredictor::PCTable::MJL_find(int context, int set, Addr pc,
+                                        bool is_secure)
+{
+    Context &ctx = MJL_context(context);
+    uint64_t matches = MJL_matchTags16(&ctx.tags[set * tagWays], tagWays,
+                                       MJL_pcPartialTag(pc, is_secure));
+    while (matches) {
+        int way = findLsbSet(matches);
+        matches &= matches - 1;
+        StrideEntry &entry = ctx.entries[set * pcTableAssoc + way];
+        if (entry.instAddr == pc) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+MJL_BaseDirPredictor::StrideEntry*
+MJL_BaseDirPredictor::PCTable::MJL_install(int context, int set, int way,
+                                           Addr pc, bool is_secure)
+{
+    Context &ctx = MJL_context(context);
+    ctx.tags[set * tagWays + way] = MJL_pcPartialTag(pc, is_secure);
+    StrideEntry &entry = ctx.entries[set * pcTableAssoc + way];
+    entry.instAddr = pc;
+    entry.isSecure = is_secure;
+    return &entry;
+}
+
+MJL_BaseDirPredictor::MJL_BaseDirPredictor(const Params *p)
+    : SimObject(p), cache(nullptr), blkSize(0), MJL_rowWidth(0),
+      MJL_Debug_Out(p->debug_out), maxConf(p->max_conf),
+      threshConf(p->thresh_conf), minConf(p->min_conf),
+      startConf(p->start_conf), startPredLevel(p->start_pred_level),
+      maxPredLevel(p->max_pred_level), maxResetLevel(p->max_reset_level),
+      pcTableAssoc(p->table_assoc), pcTableSets(p->table_sets),
+      useMasterId(p->use_master_id), oneStream(p->one_stream),
+      pcTable(pcTableAssoc, pcTableSets)
+{
+    fatal_if(pcTableSets <= 0 || !isPowerOf2(pcTableSets),
+             "%s: table_sets must be a power of 2\n", name());
+    fatal_if(pcTableAssoc <= 0 || pcTableAssoc > 64,
+             "%s: table_assoc must be between 1 and 64\n", name());
+    // The table entries keep the counters in narrow fields
+    fatal_if(std::min(minConf, startConf) < INT8_MIN ||
+             std::max(maxConf, startConf) > INT8_MAX,
+             "%s: confidences must be within [%d, %d]\n", name(), INT8_MIN,
+             INT8_MAX);
+    fatal_if(startPredLevel < 0 || startPredLevel >= INT16_MAX ||
+             maxPredLevel > INT16_MAX,
+             "%s: prediction levels must be within [0, %d]\n", name(),
+             INT16_MAX);
+    fatal_if(maxResetLevel < 0 || maxResetLevel > INT8_MAX,
+             "%s: max_reset_level must be within [0, %d]\n", name(),
+             INT8_MAX);
+}
+
+void
+MJL_BaseDirPredictor::setCache(BaseCache *_cache)
+{
+    assert(!cache);
+    cache = _cache;
+    blkSize = cache->getBlockSize();
+    MJL_rowWidth = cache->MJL_getRowWidth();
+    // The hit vectors of the table entries hold one bit per word
+    fatal_if(blkSize / sizeof(uint64_t) > 8,
+             "%s: blocks of more than 8 words are not supported\n", name());
+}
+
+void
+MJL_BaseDirPredictor::regStats()
+{
+    SimObject::regStats();
+
+    numPredicts
+        .name(name() + ".numPredicts")
+        .desc("number of direction predictions")
+        ;
+
+    numCoveredPredicts
+        .name(name() + ".numCoveredPredicts")
+        .desc("number of direction predictions made from a table entry")
+        ;
+
+    coverage
+        .name(name() + ".coverage")
+        .desc("fraction of direction predictions made from a table entry")
+        ;
+    coverage = numCoveredPredicts / numPredicts;
+}
+
+bool
+MJL_BaseDirPredictor::MJL_predicts(const PacketPtr &pkt) const
+{
+    return observeAccess(pkt) && pkt->req->hasPC();
+}
+
+MemCmd::MJL_DirAttribute
+MJL_BaseDirPredictor::MJL_predictDir(const PacketPtr &pkt, bool &covered)
+{
+    covered = false;
+    if (!MJL_predicts(pkt)) {
+        return pkt->MJL_getCmdDir();
+    }
+    // Get required packet info
+    Addr pc = oneStream ? 0 : pkt->req->getPC();
+    bool is_secure = pkt->isSecure();
+    MasterID master_id = useMasterId ? pkt->req->masterId() : 0;
+
+    numPredicts++;
+    StrideEntry *entry;
+    if (pcTableHit(pc, is_secure, master_id, entry)) {
+        covered = true;
+        numCoveredPredicts++;
+        return MJL_predictHit(pkt, entry);
+    }
+    MJL_predictMiss(pkt, pc, is_secure, master_id);
+    return pkt->MJL_getCmdDir();
+}
+
+Addr
+MJL_BaseDirPredictor::pcHash(Addr pc) const
+{
+    Addr hash1 = pc >> 1;
+    Addr hash2 = hash1 >> floorLog2(pcTableSets);
+    return (hash1 ^ hash2) & (Addr)(pcTableSets - 1);
+}
+
+bool
+MJL_BaseDirPredictor::pcTableHit(Addr pc, bool is_secure, int master_id,
+                                 StrideEntry* &entry)
+{
+    entry = pcTable.MJL_find(master_id, pcHash(pc), pc, is_secure);
+    return entry != nullptr;
+}
+
+MJL_BaseDirPredictor::StrideEntry*
+MJL_BaseDirPredictor::pcTableVictim(Addr pc, bool is_secure, int master_id)
+{
+    // Rand replacement for now
+    int set = pcHash(pc);
+    int way = random_mt.random<int>(0, pcTableAssoc - 1);
+    return pcTable.MJL_install(master_id, set, way, pc, is_secure);
+}
+
+MJL_BaseDirPredictor::StrideEntry*
+MJL_BaseDirPredictor::MJL_allocEntry(Addr pc, Addr addr, bool is_secure,
+                                     int master_id)
+{
+    StrideEntry* entry = pcTableVictim(pc, is_secure, master_id);
+    entry->lastAddr = addr;
+    entry->stride = 0;
+    entry->confidence = startConf;
+    return entry;
+}
+
+bool
+MJL_BaseDirPredictor::observeAccess(const PacketPtr &pkt) const
+{
+    bool fetch = pkt->req->isInstFetch();
+    bool read = pkt->isRead();
+    bool inv = pkt->isInvalidate();
+
+    if (pkt->req->isUncacheable()) return false;
+    if (fetch) return false;
+    if (!fetch && !read && inv) return false;
+    if (pkt->cmd == MemCmd::CleanEvict) return false;
+    // Do not predict the direction of a vector access
+    if (pkt->getSize() > sizeof(uint64_t)) return false;
+
+    return true;
+}
+
+bool
+MJL_BaseDirPredictor::MJL_trainStride(Addr pkt_addr, StrideEntry *entry,
+                                      int &new_stride)
+{
+    new_stride = pkt_addr - entry->lastAddr;
+    bool stride_match = (new_stride == entry->stride);
+
+    // Adjust confidence for stride entry
+    if (stride_match && new_stride != 0) {
+        if (entry->confidence < maxConf)
+            entry->confidence++;
+    } else {
+        if (entry->confidence > minConf)
+            entry->confidence--;
+        // If confidence has dropped below the threshold, train new stride
+        if (entry->confidence < threshConf)
+            entry->stride = new_stride;
+    }
+
+    entry->lastAddr = pkt_addr;
+    return stride_match;
+}
+
+unsigned
+MJL_BaseDirPredictor::MJL_countWords(uint8_t hits) const
+{
+    return popCount(hits & mask(blkSize / sizeof(uint64_t)));
+}
+
+void
+MJL_BaseDirPredictor::MJL_stepPfLevel(StrideEntry *entry,
+                                      MemCmd::MJL_DirAttribute dir)
+{
+    if (dir == MemCmd::MJL_DirAttribute::MJL_IsColumn &&
+        entry->pfPredictLevel < maxPredLevel) {
+        entry->pfPredictLevel++;
+    } else if (dir == MemCmd::MJL_DirAttribute::MJL_IsRow &&
+               entry->pfPredictLevel > 0) {
+        entry->pfPredictLevel--;
+    }
+    if (entry->pfPredictLevel == 0) {
+        entry->MJL_setPfLastPredDir(MemCmd::MJL_DirAttribute::MJL_IsRow);
+    } else if (entry->pfPredictLevel == maxPredLevel) {
+        entry->MJL_setPfLastPredDir(MemCmd::MJL_DirAttribute::MJL_IsColumn);
+    }
+}
+
+void
+MJL_BaseDirPredictor::MJL_startPfLevel(StrideEntry *entry,
+                                       MemCmd::MJL_DirAttribute dir)
+{
+    entry->MJL_setPfLastPredDir(dir);
+    if (dir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
+        entry->pfPredictLevel = startPredLevel + 1;
+    } else {
+        entry->pfPredictLevel = startPredLevel;
+    }
+}
+
+/* MJL_End */
@@ -0,0 +1,210 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Declaration of the base direction predictor. A direction predictor
+ * decides whether a data cache miss is fetched as a row or a column line.
+ * The cache reports its accesses, misses and prefetch hints to it, the
+ * subclasses implement the prediction schemes on top of the PC table kept
+ * here.
+ */
+
+#ifndef __MEM_CACHE_DIRPRED_BASE_HH__
+#define __MEM_CACHE_DIRPRED_BASE_HH__
+
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/cache/dirpred/pc_table_entry.hh"
+#include "mem/packet.hh"
+#include "params/MJL_BaseDirPredictor.hh"
+#include "sim/sim_object.hh"
+
+class BaseCache;
+class MSHR;
+
+class MJL_BaseDirPredictor : public SimObject
+{
+  public:
+    typedef MJL_BaseDirPredictorParams Params;
+    MJL_BaseDirPredictor(const Params *p);
+    virtual ~MJL_BaseDirPredictor() {}
+
+    virtual void setCache(BaseCache *_cache);
+
+    void regStats() override;
+
+    /** Observe an access of the cache, hit or miss */
+    virtual void MJL_observe(const PacketPtr pkt) {}
+
+    /** A miss allocated mshr */
+    virtual void MJL_missAllocated(const PacketPtr pkt, const MSHR *mshr) {}
+
+    /** The miss of mshr was serviced and mshr is about to be freed */
+    virtual void MJL_missResolved(const MSHR *mshr, bool targetHasPC,
+                                  bool isUpgrade) {}
+
+    /** The prefetcher downstream predicted dir for the access of pkt */
+    virtual void MJL_prefetchHint(const PacketPtr pkt,
+                                  MemCmd::MJL_DirAttribute dir) {}
+
+    /**
+     * Predict the direction of the miss of pkt
+     *
+     * @param covered Set when the prediction came from a table entry
+     * @return The direction of the miss, the packet direction when no
+     * prediction is made
+     */
+    virtual MemCmd::MJL_DirAttribute MJL_predictDir(const PacketPtr &pkt,
+                                                    bool &covered);
+
+    MemCmd::MJL_DirAttribute MJL_predictDir(const PacketPtr &pkt) {
+        bool covered;
+        return MJL_predictDir(pkt, covered);
+    }
+
+    /** Whether a prediction is made for pkt at all */
+    bool MJL_predicts(const PacketPtr &pkt) const;
+
+  protected:
+    /**
+     * A PC table entry, the fields of MJL_PCTableEntry with their
+     * directions typed
+     */
+    struct StrideEntry : public MJL_PCTableEntry
+    {
+        StrideEntry()
+        {
+            dirs = MemCmd::MJL_DirAttribute::MJL_IsRow |
+                   MemCmd::MJL_DirAttribute::MJL_IsRow << 2;
+        }
+
+        MemCmd::MJL_DirAttribute MJL_getLastPredDir() const {
+            return (MemCmd::MJL_DirAttribute)(dirs & 0x3);
+        }
+        void MJL_setLastPredDir(MemCmd::MJL_DirAttribute dir) {
+            dirs = (dirs & ~0x3) | dir;
+        }
+        MemCmd::MJL_DirAttribute MJL_getPfLastPredDir() const {
+            return (MemCmd::MJL_DirAttribute)(dirs >> 2 & 0x3);
+        }
+        void MJL_setPfLastPredDir(MemCmd::MJL_DirAttribute dir) {
+            dirs = (dirs & ~0xc) | dir << 2;
+        }
+
+        MemCmd::MJL_DirAttribute MJL_getCrossLastPredDir() const {
+            if (MJL_getLastPredDir() == MemCmd::MJL_DirAttribute::MJL_IsRow) {
+                return MemCmd::MJL_DirAttribute::MJL_IsColumn;
+            } else if (MJL_getLastPredDir() == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
+                return MemCmd::MJL_DirAttribute::MJL_IsRow;
+            } else {
+                return MemCmd::MJL_DirAttribute::MJL_IsColumn;
+            }
+        }
+    };
+    static_assert(sizeof(StrideEntry) == sizeof(MJL_PCTableEntry),
+                  "StrideEntry should only type the table entry");
+
+    /**
+     * The PC table of every context. The partial tags of a set are kept
+     * apart from the entries, padded to a multiple of 8 ways so a lookup
+     * is one or a few vector compares. A partial tag only picks candidate
+     * ways, the full PC in the entry decides the hit.
+     */
+    class PCTable {
+      public:
+        PCTable(int assoc, int sets);
+
+        /** The entry of pc in set, nullptr if it has none */
+        StrideEntry* MJL_find(int context, int set, Addr pc, bool is_secure);
+        /** Give way of set to pc */
+        StrideEntry* MJL_install(int context, int set, int way, Addr pc,
+                                 bool is_secure);
+
+      private:
+        struct Context
+        {
+            /** Partial tags, tagWays per set, 0 for a way never used */
+            std::vector<uint16_t> tags;
+            std::vector<StrideEntry> entries;
+        };
+
+        Context& MJL_context(int context);
+
+        const int pcTableAssoc;
+        const int pcTableSets;
+        /** Ways of a set in the partial tag array */
+        const int tagWays;
+        /** Indexed by context, created on first use */
+        std::vector<Context> contexts;
+    };
+
+    /** Predict from the table entry of the PC of pkt */
+    virtual MemCmd::MJL_DirAttribute MJL_predictHit(const PacketPtr &pkt,
+                                                    StrideEntry *entry) = 0;
+
+    /** The PC of pkt has no table entry */
+    virtual void MJL_predictMiss(const PacketPtr &pkt, Addr pc,
+                                 bool is_secure, MasterID master_id) {}
+
+    Addr pcHash(Addr pc) const;
+    bool pcTableHit(Addr pc, bool is_secure, int master_id,
+                    StrideEntry* &entry);
+    StrideEntry* pcTableVictim(Addr pc, bool is_secure, int master_id);
+    bool observeAccess(const PacketPtr &pkt) const;
+
+    /** Replace a victim with a fresh entry of pc, last accessing addr */
+    StrideEntry* MJL_allocEntry(Addr pc, Addr addr, bool is_secure,
+                                int master_id);
+
+    /**
+     * Train the stride and confidence of entry with pkt_addr
+     *
+     * @param new_stride Set to the stride from the last address of entry
+     * @return Whether the stride matched the trained one
+     */
+    bool MJL_trainStride(Addr pkt_addr, StrideEntry *entry, int &new_stride);
+
+    /** Number of words of a block set in hits */
+    unsigned MJL_countWords(uint8_t hits) const;
+
+    /** Move the prefetch hint level of entry toward dir */
+    void MJL_stepPfLevel(StrideEntry *entry, MemCmd::MJL_DirAttribute dir);
+    /** Restart the prefetch hint level of entry at dir */
+    void MJL_startPfLevel(StrideEntry *entry, MemCmd::MJL_DirAttribute dir);
+
+    /** Pointer to the parent cache */
+    BaseCache *cache;
+    /** The block size of the parent cache */
+    unsigned blkSize;
+    unsigned MJL_rowWidth;
+
+    const bool MJL_Debug_Out;
+
+    const int maxConf;
+    const int threshConf;
+    const int minConf;
+    const int startConf;
+
+    const int startPredLevel;
+    const int maxPredLevel;
+    const int maxResetLevel;
+
+    const int pcTableAssoc;
+    const int pcTableSets;
+
+    const bool useMasterId;
+    /** Track every access as one stream instead of one per PC */
+    const bool oneStream;
+
+    PCTable pcTable;
+
+    Stats::Scalar numPredicts;
+    Stats::Scalar numCoveredPredicts;
+    Stats::Formula coverage;
+};
+
+#endif // __MEM_CACHE_DIRPRED_BASE_HH__
+
+/* MJL_End */
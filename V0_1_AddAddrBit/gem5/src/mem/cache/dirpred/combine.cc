@@ -0,0 +1,136 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Definition of the combined direction predictor.
+ */
+
+#include "mem/cache/dirpred/combine.hh"
+
+MJL_CombineDirPredictor::MJL_CombineDirPredictor(
+    const MJL_CombineDirPredictorParams *p)
+    : MJL_MshrDirPredictor(p)
+{
+}
+
+void
+MJL_CombineDirPredictor::regStats()
+{
+    MJL_MshrDirPredictor::regStats();
+
+    numOfMSHRPredicts
+        .name(name() + ".numOfMSHRPredicts")
+        .desc("number of mshr based orientation predictions")
+        .flags(Stats::nozero)
+        ;
+
+    numOfPfPredicts
+        .name(name() + ".numOfPfPredicts")
+        .desc("number of prefetcher based orientation predictions")
+        .flags(Stats::nozero)
+        ;
+
+    numOfDiffPredicts
+        .name(name() + ".numOfDiffPredicts")
+        .desc("number of times where mshr based and prefetcher based orientation predictions differ")
+        .flags(Stats::nozero)
+        ;
+
+    numOfWarmupPredicts_MSHR
+        .name(name() + ".numOfWarmupPredicts_MSHR")
+        .desc("number of times where mshr based orientation prediction is still invalid")
+        .flags(Stats::nozero)
+        ;
+
+    numOfWarmupPredicts_Pf
+        .name(name() + ".numOfWarmupPredicts_Pf")
+        .desc("number of times where prefetcher based orientation prediction is still invalid")
+        .flags(Stats::nozero)
+        ;
+}
+
+void
+MJL_CombineDirPredictor::MJL_prefetchHint(const PacketPtr pkt,
+                                          MemCmd::MJL_DirAttribute dir)
+{
+    // Get required packet info
+    Addr pc = pkt->req->getPC();
+    bool is_secure = pkt->isSecure();
+    MasterID master_id = useMasterId ? pkt->req->masterId() : 0;
+
+    StrideEntry *entry;
+    if (pcTableHit(pc, is_secure, master_id, entry)) {
+        if (entry->MJL_getPfLastPredDir() == MemCmd::MJL_DirAttribute::MJL_IsInvalid) {
+            MJL_startPfLevel(entry, dir);
+        } else {
+            MJL_stepPfLevel(entry, dir);
+        }
+        return;
+    }
+    // The mshr scheme starts from the first tracked miss
+    entry = MJL_allocEntry(pc, pkt->getAddr(), is_secure, master_id);
+    MJL_startPfLevel(entry, dir);
+    entry->MJL_setLastPredDir(MemCmd::MJL_DirAttribute::MJL_IsInvalid);
+    entry->blkHits = 0;
+    entry->crossBlkHits = 0;
+    entry->lastRowOff = 0;
+    entry->lastColOff = 0;
+    entry->predictLevel = startPredLevel;
+    entry->resetLevel = 0;
+}
+
+void
+MJL_CombineDirPredictor::MJL_entryAllocated(StrideEntry *entry)
+{
+    // The prefetch scheme starts from the first hint
+    entry->MJL_setPfLastPredDir(MemCmd::MJL_DirAttribute::MJL_IsInvalid);
+    entry->pfPredictLevel = startPredLevel;
+}
+
+bool
+MJL_CombineDirPredictor::MJL_unstable(MemCmd::MJL_DirAttribute dir,
+                                      int level) const
+{
+    int unstable_thresh = (maxPredLevel + 1)/4;
+    return dir == MemCmd::MJL_DirAttribute::MJL_IsInvalid ||
+        (dir == MemCmd::MJL_DirAttribute::MJL_IsColumn && level < unstable_thresh) ||
+        (dir == MemCmd::MJL_DirAttribute::MJL_IsRow && level > maxPredLevel-unstable_thresh);
+}
+
+MemCmd::MJL_DirAttribute
+MJL_CombineDirPredictor::MJL_predictHit(const PacketPtr &pkt,
+                                        StrideEntry *entry)
+{
+    MemCmd::MJL_DirAttribute mshr_lastPredDir = MJL_MshrDirPredictor::MJL_predictHit(pkt, entry);
+    int mshr_predLevel = entry->predictLevel;
+    MemCmd::MJL_DirAttribute pf_lastPredDir = entry->MJL_getPfLastPredDir();
+    int pf_predLevel = entry->pfPredictLevel;
+
+    bool mshr_unstable = MJL_unstable(mshr_lastPredDir, mshr_predLevel);
+    bool pf_unstable = MJL_unstable(pf_lastPredDir, pf_predLevel);
+
+    MemCmd::MJL_DirAttribute predictDir = mshr_lastPredDir;
+    if (mshr_unstable && !pf_unstable) {
+        predictDir = pf_lastPredDir;
+        numOfPfPredicts++;
+    } else {
+        numOfMSHRPredicts++;
+    }
+    if (mshr_lastPredDir != pf_lastPredDir && mshr_lastPredDir != MemCmd::MJL_DirAttribute::MJL_IsInvalid && pf_lastPredDir != MemCmd::MJL_DirAttribute::MJL_IsInvalid) {
+        numOfDiffPredicts++;
+    } else if (mshr_lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsInvalid) {
+        numOfWarmupPredicts_MSHR++;
+    } else if (pf_lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsInvalid) {
+        numOfWarmupPredicts_Pf++;
+    }
+    assert(predictDir != MemCmd::MJL_DirAttribute::MJL_IsInvalid);
+    return predictDir;
+}
+
+MJL_CombineDirPredictor*
+MJL_CombineDirPredictorParams::create()
+{
+    return new MJL_CombineDirPredictor(this);
+}
+
+/* MJL_End */
@@ -0,0 +1,47 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Declaration of the combined direction predictor. It runs the mshr scheme
+ * and the prefetch based scheme on the same table entries and takes the
+ * prefetch direction when only the mshr direction is unstable.
+ */
+
+#ifndef __MEM_CACHE_DIRPRED_COMBINE_HH__
+#define __MEM_CACHE_DIRPRED_COMBINE_HH__
+
+#include "mem/cache/dirpred/mshr.hh"
+#include "params/MJL_CombineDirPredictor.hh"
+
+class MJL_CombineDirPredictor : public MJL_MshrDirPredictor
+{
+  public:
+    MJL_CombineDirPredictor(const MJL_CombineDirPredictorParams *p);
+
+    void regStats() override;
+
+    void MJL_prefetchHint(const PacketPtr pkt,
+                          MemCmd::MJL_DirAttribute dir) override;
+
+  protected:
+    MemCmd::MJL_DirAttribute MJL_predictHit(const PacketPtr &pkt,
+                                            StrideEntry *entry) override;
+
+    /** The entry was made by a prefetch hint and has no mshr history */
+    bool MJL_warmingUp(const StrideEntry *entry) const override
+    { return entry->MJL_getLastPredDir() == MemCmd::MJL_DirAttribute::MJL_IsInvalid; }
+    void MJL_entryAllocated(StrideEntry *entry) override;
+
+    /** Whether dir at level is in the quarter next to switching */
+    bool MJL_unstable(MemCmd::MJL_DirAttribute dir, int level) const;
+
+    Stats::Scalar numOfMSHRPredicts;
+    Stats::Scalar numOfPfPredicts;
+    Stats::Scalar numOfDiffPredicts;
+    Stats::Scalar numOfWarmupPredicts_MSHR;
+    Stats::Scalar numOfWarmupPredicts_Pf;
+};
+
+#endif // __MEM_CACHE_DIRPRED_COMBINE_HH__
+
+/* MJL_End */
@@ -0,0 +1,442 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Definition of the mshr direction predictor.
+ */
+
+#include "mem/cache/dirpred/mshr.hh"
+
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/misc.hh"
+#include "mem/cache/mshr.hh"
+
+MJL_MshrDirPredictor::PredictMshrEntry::PredictMshrEntry(const PacketPtr pkt, const MSHR* in_mshr, unsigned blkSize)
+    : pc(pkt->req->getPC()), blkAddr(pkt->getBlockAddr(blkSize)), crossBlkAddr(pkt->MJL_getCrossBlockAddr(blkSize)), blkDir(pkt->MJL_getCmdDir()), crossBlkDir(pkt->MJL_getCrossCmdDir()), isSecure(pkt->isSecure()), accessAddr(pkt->getAddr()), mshr(in_mshr), masterId(pkt->req->masterId()), wasUpgrade(false), blkHits(0), crossBlkHits(0), lastRowOff(pkt->MJL_getDirOffset(blkSize, MemCmd::MJL_DirAttribute::MJL_IsRow)/sizeof(uint64_t)), lastColOff(pkt->MJL_getDirOffset(blkSize, MemCmd::MJL_DirAttribute::MJL_IsColumn)/sizeof(uint64_t))
+{
+    blkHits |= 1 << (pkt->MJL_getDirOffset(blkSize, blkDir)/sizeof(uint64_t));
+    crossBlkHits |= 1 << (pkt->MJL_getDirOffset(blkSize, crossBlkDir)/sizeof(uint64_t));
+}
+
+std::string
+MJL_MshrDirPredictor::PredictMshrEntry::print() const
+{
+    std::ostringstream output;
+    std::string blkDir_str = (blkDir == MemCmd::MJL_DirAttribute::MJL_IsRow) ? "r" : "c";
+    std::string crossBlkDir_str = (crossBlkDir == MemCmd::MJL_DirAttribute::MJL_IsRow) ? "r" : "c";
+    output << "pc " << std::hex << pc << " " << std::dec;
+    output << "blk " << blkDir_str << "/" << crossBlkDir_str << ":" << std::hex << blkAddr << "/" << crossBlkAddr << " " << std::dec;
+    output << "hit/crosshit " ;
+    for (int i = 0; i < 8; ++i) {
+        output << (blkHits >> i & 1);
+    }
+    output << "/";
+    for (int i = 0; i < 8; ++i) {
+        output << (crossBlkHits >> i & 1);
+    }
+    return output.str();
+}
+
+MJL_MshrDirPredictor::PredictMshrEntry&
+MJL_MshrDirPredictor::PredictMshrQueue::push_back(const PredictMshrEntry &entry)
+{
+    assert(!full());
+    count++;
+    back() = entry;
+    return back();
+}
+
+void
+MJL_MshrDirPredictor::PredictMshrQueue::pop_front()
+{
+    assert(count > 0);
+    head = (head + 1) % slots.size();
+    count--;
+}
+
+void
+MJL_MshrDirPredictor::PredictMshrQueue::erase(unsigned i)
+{
+    assert(i < count);
+    for (; i + 1 < count; ++i) {
+        (*this)[i] = (*this)[i + 1];
+    }
+    count--;
+}
+
+MJL_MshrDirPredictor::MJL_MshrDirPredictor(
+    const MJL_MshrDirPredictorParams *p)
+    : MJL_BaseDirPredictor(p), MJL_linkMshr(p->link_mshr),
+      MJL_predMshrSize(p->queue_size), selfStride(p->self_stride),
+      // Unlinked, a new miss is tracked before the oldest is learnt from
+      copyPredictMshrQueue(p->link_mshr ? p->queue_size : p->queue_size + 1)
+{
+    fatal_if(MJL_predMshrSize == 0, "%s: queue_size must not be 0\n",
+             name());
+}
+
+void
+MJL_MshrDirPredictor::regStats()
+{
+    MJL_BaseDirPredictor::regStats();
+
+    numOfCopyMSHRQueueEvictNonResolved
+        .name(name() + ".numOfCopyMSHRQueueEvictNonResolved")
+        .desc("number of evictions from copyMSHRQueue where the corresponding MSHR entry hasn't been released yet")
+        .flags(Stats::nozero)
+        ;
+}
+
+MemCmd::MJL_DirAttribute
+MJL_MshrDirPredictor::MJL_predictHit(const PacketPtr &pkt, StrideEntry *entry)
+{
+    /* MJL_Test */
+    if (MJL_Debug_Out) {
+        std::clog << "MJL_predDebug: MJL_mshrPredictDir " << pkt->print() << ", lastPredDir " << entry->MJL_getLastPredDir() << ", predictLevel " << entry->predictLevel;
+    }
+    /* */
+    int pkt_rowOff = pkt->MJL_getDirOffset(blkSize, MemCmd::MJL_DirAttribute::MJL_IsRow)/sizeof(uint64_t);
+    int pkt_colOff = pkt->MJL_getDirOffset(blkSize, MemCmd::MJL_DirAttribute::MJL_IsColumn)/sizeof(uint64_t);
+    int new_stride;
+    bool stride_match = MJL_trainStride(pkt->getAddr(), entry, new_stride);
+
+    // Only generation if above confidence threshold
+    MemCmd::MJL_DirAttribute selfStrideDir = MemCmd::MJL_DirAttribute::MJL_IsRow;
+    int selfStrideStep = 0;
+    if (entry->confidence >= threshConf) {
+        int colOffset = new_stride / (MJL_rowWidth * blkSize) + entry->lastColOff;
+        int rowOffset = new_stride/sizeof(uint64_t) + entry->lastRowOff;
+        if (new_stride < (MJL_rowWidth * blkSize) && new_stride > -(MJL_rowWidth * blkSize)) {
+            if (new_stride % ((MJL_rowWidth * blkSize) / (1 + floorLog2(entry->confidence))) == 0) {
+                if (new_stride > 0) {
+                    colOffset = 1 + entry->lastColOff;
+                } else if (new_stride < 0) {
+                    colOffset = -1 + entry->lastColOff;
+                }
+            }
+        }
+        if (new_stride % ((MJL_rowWidth * blkSize) / (1 + floorLog2(entry->confidence))) == 0 && colOffset >= 0 && colOffset < (int) (blkSize/sizeof(uint64_t)) ) {
+            selfStrideDir = MemCmd::MJL_DirAttribute::MJL_IsColumn;
+            selfStrideStep = colOffset - entry->lastColOff;
+        } else if ( rowOffset >= 0 && rowOffset < (int) (blkSize/sizeof(uint64_t)) ) {
+            selfStrideDir = MemCmd::MJL_DirAttribute::MJL_IsRow;
+            selfStrideStep = rowOffset - entry->lastRowOff;
+        }
+    }
+
+    if (selfStrideStep != 0 && stride_match && selfStride) {
+        if (selfStrideDir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
+            for (int i = entry->lastRowOff + selfStrideStep; i >= 0 && i < (int) (blkSize/sizeof(uint64_t)); i += selfStrideStep) {
+                if (entry->MJL_getLastPredDir() == MemCmd::MJL_DirAttribute::MJL_IsRow) {
+                    entry->blkHits |= 1 << i;
+                } else if (entry->MJL_getLastPredDir() == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
+                    entry->crossBlkHits |= 1 << i;
+                }
+            }
+        } else if (selfStrideDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
+            for (int i = entry->lastColOff + selfStrideStep; i >= 0 && i < (int) (blkSize/sizeof(uint64_t)); i += selfStrideStep) {
+                if (entry->MJL_getLastPredDir() == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
+                    entry->blkHits |= 1 << i;
+                } else if (entry->MJL_getLastPredDir() == MemCmd::MJL_DirAttribute::MJL_IsRow) {
+                    entry->crossBlkHits |= 1 << i;
+                }
+            }
+        }
+    }
+
+    unsigned blkHitCount = MJL_countWords(entry->blkHits);
+    unsigned crossBlkHitCount = MJL_countWords(entry->crossBlkHits);
+    MemCmd::MJL_DirAttribute lastPredDir = entry->MJL_getLastPredDir();
+    bool changeDir = false;
+    if (!((entry->predictLevel == 0 && lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsRow) || (entry->predictLevel == maxPredLevel && lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) || (entry->predictLevel > 0 && entry->predictLevel < maxPredLevel))) {
+        std::cerr << "MJL_mshrPred: lastPredDir " << lastPredDir << ", predLevel " << entry->predictLevel << std::endl;
+    }
+    assert((entry->predictLevel == 0 && lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsRow) || (entry->predictLevel == maxPredLevel && lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) || (entry->predictLevel > 0 && entry->predictLevel < maxPredLevel));
+    if (blkHitCount == 1 && crossBlkHitCount == 1) {
+        if (entry->resetLevel < maxResetLevel) {
+            entry->resetLevel++;
+        }
+        if (entry->resetLevel == maxResetLevel) {
+            entry->resetLevel = 0;
+            if (lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
+                changeDir = true;
+                entry->predictLevel = 0;
+            }
+        }
+    } else if (blkHitCount >= crossBlkHitCount) {
+        if (blkHitCount > crossBlkHitCount) {
+            if ( lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn && entry->predictLevel < maxPredLevel) {
+                entry->predictLevel++;
+            } else if ( lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsRow && entry->predictLevel > 0) {
+                entry->predictLevel--;
+            }
+        }
+        entry->resetLevel = 0;
+    } else {
+        if ( lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsColumn ) {
+            entry->predictLevel--;
+        } else if ( lastPredDir == MemCmd::MJL_DirAttribute::MJL_IsRow ) {
+            entry->predictLevel++;
+        }
+        if (entry->predictLevel == 0 || entry->predictLevel == maxPredLevel) {
+            changeDir = true;
+        }
+        entry->resetLevel = 0;
+    }
+    /* MJL_Test */
+    if (MJL_Debug_Out) {
+        std::clog << ", predLevel " << entry->predictLevel << ", resetLevel " << (int)entry->resetLevel << ", blk/crossHits ";
+        for (unsigned i = 0; i < blkSize/sizeof(uint64_t); ++i) {
+            std::clog << (entry->blkHits >> i & 1);
+        }
+        std::clog << "(" << blkHitCount << ")/";
+        for (unsigned i = 0; i < blkSize/sizeof(uint64_t); ++i) {
+            std::clog << (entry->crossBlkHits >> i & 1);
+        }
+        std::clog << "(" << crossBlkHitCount << ")/";
+    }
+    /* */
+
+    if (changeDir) {
+        entry->MJL_setLastPredDir(entry->MJL_getCrossLastPredDir());
+        std::swap(entry->blkHits, entry->crossBlkHits);
+    }
+    entry->lastRowOff = pkt_rowOff;
+    entry->lastColOff = pkt_colOff;
+    /* MJL_Test */
+    if (MJL_Debug_Out) {
+        std::clog << ", predicted " << entry->MJL_getLastPredDir() << std::endl;
+    }
+    /* */
+    return entry->MJL_getLastPredDir();
+}
+
+void
+MJL_MshrDirPredictor::MJL_observe(const PacketPtr pkt)
+{
+    Addr pkt_blkAddr = pkt->getBlockAddr(blkSize);
+    Addr pkt_crossBlkAddr = pkt->MJL_getCrossBlockAddr(blkSize);
+    bool pkt_isSecure = pkt->isSecure();
+    // A vector access hits its words along its own direction
+    uint8_t vec_hits = mask(pkt->getSize()/sizeof(uint64_t) + 1) << (pkt->getOffset(blkSize)/sizeof(uint64_t));
+    /* MJL_Test */
+    if (MJL_Debug_Out) {
+        std::clog << "MJL_predDebug: MJL_mshrPredictDir update " << pkt->print();
+    }
+    /* */
+    for (unsigned j = 0; j < copyPredictMshrQueue.size(); ++j) {
+        PredictMshrEntry *it = &copyPredictMshrQueue[j];
+        if (pkt->getSize() > sizeof(uint64_t)) {
+            pkt_blkAddr = pkt->getBlockAddr(blkSize);
+            if (pkt_blkAddr == it->blkAddr && pkt->MJL_getCmdDir() == it->blkDir && pkt_isSecure == it->isSecure) {
+                it->blkHits |= vec_hits;
+            }
+            pkt_crossBlkAddr = pkt->getBlockAddr(blkSize);
+            if (pkt_crossBlkAddr == it->crossBlkAddr && pkt->MJL_getCmdDir() == it->crossBlkDir && pkt_isSecure == it->isSecure) {
+                it->crossBlkHits |= vec_hits;
+            }
+            /* MJL_Test */
+            if (MJL_Debug_Out && ((pkt_blkAddr == it->blkAddr && pkt->MJL_getCmdDir() == it->blkDir && pkt_isSecure == it->isSecure) || (pkt_crossBlkAddr == it->crossBlkAddr && pkt->MJL_getCmdDir() == it->crossBlkDir && pkt_isSecure == it->isSecure))) {
+                std::clog << ", " << it->print();
+            }
+            /* */
+        } else {
+            pkt_blkAddr = pkt->MJL_getDirBlockAddr(blkSize, it->blkDir);
+            if (pkt_blkAddr == it->blkAddr && pkt_isSecure == it->isSecure) {
+                it->blkHits |= 1 << (pkt->MJL_getDirOffset(blkSize, it->blkDir)/sizeof(uint64_t));
+            }
+            pkt_crossBlkAddr = pkt->MJL_getDirBlockAddr(blkSize, it->crossBlkDir);
+            if (pkt_crossBlkAddr == it->crossBlkAddr && pkt_isSecure == it->isSecure) {
+                it->crossBlkHits |= 1 << (pkt->MJL_getDirOffset(blkSize, it->crossBlkDir)/sizeof(uint64_t));
+            }
+            /* MJL_Test */
+            if (MJL_Debug_Out && ((pkt_blkAddr == it->blkAddr && pkt_isSecure == it->isSecure) || (pkt_crossBlkAddr == it->crossBlkAddr && pkt_isSecure == it->isSecure))) {
+                std::clog << ", " << it->print();
+            }
+            /* */
+        }
+    }
+    /* MJL_Test */
+    if (MJL_Debug_Out) {
+        std::clog << std::endl;
+    }
+    /* */
+}
+
+void
+MJL_MshrDirPredictor::MJL_evictFront()
+{
+    const PredictMshrEntry &front_entry = copyPredictMshrQueue.front();
+    if (front_entry.mshr != nullptr) {
+        numOfCopyMSHRQueueEvictNonResolved++;
+    }
+    MJL_learn(front_entry, front_entry.wasUpgrade);
+    /* MJL_Test */
+    if (MJL_Debug_Out) {
+        std::clog << "MJL_predDebug: MJL_mshrPredictDir added predict entry " << front_entry.print() << std::endl;
+    }
+    /* */
+    copyPredictMshrQueue.pop_front();
+}
+
+void
+MJL_MshrDirPredictor::MJL_missAllocated(const PacketPtr pkt, const MSHR *mshr)
+{
+    if (!pkt->req->hasPC()) {
+        return;
+    }
+    // Linked to the mshrs, the queue only fills up when it is smaller than the mshrs
+    if (copyPredictMshrQueue.full()) {
+        assert(MJL_linkMshr);
+        MJL_evictFront();
+    }
+    PredictMshrEntry &created = copyPredictMshrQueue.push_back(PredictMshrEntry(pkt, mshr, blkSize));
+    /* MJL_Test */
+    if (MJL_Debug_Out) {
+        std::clog << "MJL_predDebug: MJL_mshrPredictDir create mshr " << pkt->print() << std::endl;
+    }
+    /* */
+    unsigned num_older = copyPredictMshrQueue.size() - 1;
+    // If there is already a copy of the same PC recording for the same dir, and we land in the same cache line as it's cross dir, inherit it's crossBlkHits[] to avoid row biasing (this instruction loading in cross dir would have been able to bring all the crossBlkHits[])
+    for (unsigned j = 0; j < num_older; ++j) {
+        const PredictMshrEntry &older = copyPredictMshrQueue[j];
+        if (older.pc == created.pc) {
+            if (older.crossBlkAddr == created.crossBlkAddr && older.isSecure == created.isSecure) {
+                created.crossBlkHits |= older.crossBlkHits;
+                break;
+            }
+        }
+    }
+    for (unsigned j = 0; j < num_older; ++j) {
+        const PredictMshrEntry &older = copyPredictMshrQueue[j];
+        if (older.blkAddr == created.blkAddr && older.isSecure == created.isSecure) {
+            std::clog << "MJL_Warning: An existing copyPredictMshrQueue entry has the same block address as the one being created " << pkt->print() << std::endl;
+        }
+    }
+    if (!MJL_linkMshr) {
+        // If the copyPredictMshrQueue is full, remove the least recently created entry (technically should happen before the insertion, but this reordering shouldn't change anything)
+        if (copyPredictMshrQueue.size() > MJL_predMshrSize) {
+            MJL_evictFront();
+        }
+    }
+}
+
+void
+MJL_MshrDirPredictor::MJL_missResolved(const MSHR *mshr, bool targetHasPC,
+                                       bool isUpgrade)
+{
+    // software prefetch actually happened and does not have a pc... need to bypass this case since prediction cannot be made without a pc
+    if (!targetHasPC) {
+        return;
+    }
+
+    unsigned found = copyPredictMshrQueue.size();
+    // Find the entry to be removed
+    for (unsigned j = 0; j < copyPredictMshrQueue.size(); ++j) {
+        const PredictMshrEntry &tracked = copyPredictMshrQueue[j];
+        if (mshr == tracked.mshr) {
+            found = j;
+            assert(mshr->blkAddr == tracked.blkAddr && mshr->MJL_qEntryDir == tracked.blkDir && mshr->isSecure == tracked.isSecure);
+            break;
+        }
+    }
+    // If the predMshrQueue is not linked to MSHR, just record the upgrade status, remove the pointer to mshr, and do nothing else. (Technically could have detected the upgrade status when inserting entry into the copyPredictMshrQueue, hence no need for pointer to mshr, but making this change here should not change anything logically and requires less changes to the existing code)
+    if (!MJL_linkMshr) {
+        if (found != copyPredictMshrQueue.size()) {
+            copyPredictMshrQueue[found].wasUpgrade = isUpgrade;
+            copyPredictMshrQueue[found].mshr = nullptr;
+        }
+        return;
+    }
+    // The queue ran out of room and learnt from the miss early
+    if (found == copyPredictMshrQueue.size()) {
+        return;
+    }
+    const PredictMshrEntry &entry_found = copyPredictMshrQueue[found];
+    MJL_learn(entry_found, isUpgrade);
+
+    /* MJL_Test */
+    if (MJL_Debug_Out) {
+        std::clog << "MJL_predDebug: MJL_mshrPredictDir remove mshr " << mshr->print() << ", added predict entry " << entry_found.print() << std::endl;
+    }
+    /* */
+    copyPredictMshrQueue.erase(found);
+}
+
+void
+MJL_MshrDirPredictor::MJL_restartEntry(StrideEntry *entry,
+                                       const PredictMshrEntry &found)
+{
+    entry->lastAddr = found.accessAddr;
+    entry->stride = 0;
+    entry->confidence = startConf;
+    if (found.blkDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
+        entry->predictLevel = startPredLevel + 1;
+    } else {
+        entry->predictLevel = startPredLevel;
+    }
+    entry->MJL_setLastPredDir(found.blkDir);
+    entry->resetLevel = 0;
+    entry->blkHits = found.blkHits;
+    entry->crossBlkHits = found.crossBlkHits;
+    entry->lastRowOff = found.lastRowOff;
+    entry->lastColOff = found.lastColOff;
+}
+
+void
+MJL_MshrDirPredictor::MJL_learn(const PredictMshrEntry &found,
+                                bool is_upgrade)
+{
+    MasterID master_id = useMasterId ? found.masterId : 0;
+    StrideEntry *pcTable_entry;
+    if (!pcTableHit(found.pc, found.isSecure, master_id, pcTable_entry)) {
+        pcTable_entry = MJL_allocEntry(found.pc, found.accessAddr,
+                                       found.isSecure, master_id);
+        MJL_restartEntry(pcTable_entry, found);
+        MJL_entryAllocated(pcTable_entry);
+        return;
+    }
+    if (MJL_warmingUp(pcTable_entry)) {
+        MJL_restartEntry(pcTable_entry, found);
+        return;
+    }
+
+    pcTable_entry->lastAddr = found.accessAddr;
+    // Take upgrade miss direction change into account
+    if (is_upgrade) {
+        unsigned hitCount = MJL_countWords(pcTable_entry->blkHits);
+        unsigned crossHitCount = MJL_countWords(pcTable_entry->crossBlkHits);
+        if (hitCount == 1 && crossHitCount == 1) {
+            if (pcTable_entry->MJL_getLastPredDir() != found.blkDir) {
+                if (found.blkDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
+                    pcTable_entry->predictLevel = maxPredLevel;
+                } else if (found.blkDir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
+                    pcTable_entry->predictLevel = 0;
+                }
+            }
+            pcTable_entry->MJL_setLastPredDir(found.blkDir);
+        }
+    }
+    if (pcTable_entry->MJL_getLastPredDir() == found.blkDir) {
+        pcTable_entry->blkHits = found.blkHits;
+        pcTable_entry->crossBlkHits = found.crossBlkHits;
+    } else {
+        pcTable_entry->blkHits = found.crossBlkHits;
+        pcTable_entry->crossBlkHits = found.blkHits;
+    }
+    pcTable_entry->lastRowOff = found.lastRowOff;
+    pcTable_entry->lastColOff = found.lastColOff;
+}
+
+MJL_MshrDirPredictor*
+MJL_MshrDirPredictorParams::create()
+{
+    return new MJL_MshrDirPredictor(this);
+}
+
+/* MJL_End */
@@ -0,0 +1,124 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Declaration of the mshr direction predictor. Each miss with a PC gets a
+ * copy of its mshr that records which words of the line and of the cross
+ * line are touched while the miss is tracked. The PC table learns from the
+ * copies which direction would have served more of the words.
+ */
+
+#ifndef __MEM_CACHE_DIRPRED_MSHR_HH__
+#define __MEM_CACHE_DIRPRED_MSHR_HH__
+
+#include <string>
+#include <vector>
+
+#include "mem/cache/dirpred/base.hh"
+#include "params/MJL_MshrDirPredictor.hh"
+
+class MJL_MshrDirPredictor : public MJL_BaseDirPredictor
+{
+  public:
+    MJL_MshrDirPredictor(const MJL_MshrDirPredictorParams *p);
+
+    void regStats() override;
+
+    /** Update the word hits of the tracked misses */
+    void MJL_observe(const PacketPtr pkt) override;
+    /** Track the new miss */
+    void MJL_missAllocated(const PacketPtr pkt, const MSHR *mshr) override;
+    /** Learn from the miss if the tracking is linked to the mshr */
+    void MJL_missResolved(const MSHR *mshr, bool targetHasPC,
+                          bool isUpgrade) override;
+
+  protected:
+    struct PredictMshrEntry
+    {
+        PredictMshrEntry() {}
+        PredictMshrEntry(const PacketPtr pkt, const MSHR* in_mshr, unsigned blkSize);
+
+        Addr pc;
+        Addr blkAddr;
+        Addr crossBlkAddr;
+        MemCmd::MJL_DirAttribute blkDir;
+        MemCmd::MJL_DirAttribute crossBlkDir;
+        bool isSecure;
+        Addr accessAddr;
+        const MSHR* mshr;
+        MasterID masterId;
+        bool wasUpgrade;
+        /** Words hit in the block, one bit per word */
+        uint8_t blkHits;
+        /** Words hit in the cross block, one bit per word */
+        uint8_t crossBlkHits;
+        int lastRowOff;
+        int lastColOff;
+
+        std::string print() const;
+    };
+
+    /**
+     * The tracked misses oldest first, in a ring sized at construction so
+     * tracking a miss never allocates
+     */
+    class PredictMshrQueue
+    {
+      public:
+        PredictMshrQueue(unsigned capacity)
+            : slots(capacity), head(0), count(0) {}
+
+        unsigned size() const { return count; }
+        bool full() const { return count == slots.size(); }
+
+        /** The i-th oldest tracked miss */
+        PredictMshrEntry& operator[](unsigned i)
+        { return slots[(head + i) % slots.size()]; }
+        PredictMshrEntry& front() { return (*this)[0]; }
+        PredictMshrEntry& back() { return (*this)[count - 1]; }
+
+        PredictMshrEntry& push_back(const PredictMshrEntry &entry);
+        void pop_front();
+        /** Drop the i-th oldest, the younger ones move up */
+        void erase(unsigned i);
+
+      private:
+        std::vector<PredictMshrEntry> slots;
+        unsigned head;
+        unsigned count;
+    };
+
+    MemCmd::MJL_DirAttribute MJL_predictHit(const PacketPtr &pkt,
+                                            StrideEntry *entry) override;
+
+    /** Whether entry has yet to learn from a tracked miss */
+    virtual bool MJL_warmingUp(const StrideEntry *entry) const
+    { return false; }
+    /** The tracked miss replaced a table entry with entry */
+    virtual void MJL_entryAllocated(StrideEntry *entry) {}
+
+    /** Learn from the oldest tracked miss and drop it */
+    void MJL_evictFront();
+    /** Write what the tracked miss found into the table */
+    void MJL_learn(const PredictMshrEntry &found, bool is_upgrade);
+    /** Start entry from the tracked miss */
+    void MJL_restartEntry(StrideEntry *entry, const PredictMshrEntry &found);
+
+    /** Whether the tracked misses are dropped with their mshr */
+    const bool MJL_linkMshr;
+    /**
+     * Number of tracked misses. When they are linked to the mshrs the
+     * oldest is only learnt from early if the queue runs out of room.
+     */
+    const unsigned MJL_predMshrSize;
+    /** Extend the word hits of an entry along its confident stride */
+    const bool selfStride;
+
+    PredictMshrQueue copyPredictMshrQueue;
+
+    Stats::Scalar numOfCopyMSHRQueueEvictNonResolved;
+};
+
+#endif // __MEM_CACHE_DIRPRED_MSHR_HH__
+
+/* MJL_End */
@@ -0,0 +1,64 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Layout of a direction predictor PC table entry and its partial tag. Kept
+ * apart from MJL_BaseDirPredictor so the table can be built on its own.
+ */
+
+#ifndef __MEM_CACHE_DIRPRED_PC_TABLE_ENTRY_HH__
+#define __MEM_CACHE_DIRPRED_PC_TABLE_ENTRY_HH__
+
+#include <cstdint>
+
+#include "base/types.hh"
+
+/**
+ * The fields of a PC table entry, packed into half a cache line. The
+ * counters are narrowed to the ranges checked against the parameters, the
+ * word hits are one bit per word and both directions share one byte.
+ */
+struct MJL_PCTableEntry
+{
+    MJL_PCTableEntry() : instAddr(0), lastAddr(0), stride(0), predictLevel(0),
+                         pfPredictLevel(0), confidence(0), resetLevel(0),
+                         lastRowOff(0), lastColOff(0), blkHits(0),
+                         crossBlkHits(0), dirs(0), isSecure(false)
+    { }
+
+    Addr instAddr;
+    Addr lastAddr;
+    int32_t stride;
+    int16_t predictLevel;
+    int16_t pfPredictLevel;
+    int8_t confidence;
+    int8_t resetLevel;
+    int8_t lastRowOff;
+    int8_t lastColOff;
+    /** Words hit in the predicted direction, one bit per word */
+    uint8_t blkHits;
+    /** Words hit in the cross direction, one bit per word */
+    uint8_t crossBlkHits;
+    /** Last predicted direction in bits 1:0, prefetch hint one in 3:2 */
+    uint8_t dirs;
+    bool isSecure;
+};
+static_assert(sizeof(MJL_PCTableEntry) == 32,
+              "Two PC table entries should share a cache line");
+
+/**
+ * Partial tag of pc in the PC table: valid bit, secure bit and 14 bits
+ * folded from pc. It is never 0, the tag of a way never used.
+ */
+inline uint16_t
+MJL_pcPartialTag(Addr pc, bool is_secure)
+{
+    Addr fold = pc >> 1;
+    fold ^= fold >> 14;
+    fold ^= fold >> 28;
+    return 0x8000 | (is_secure ? 0x4000 : 0) | (fold & 0x3fff);
+}
+
+#endif // __MEM_CACHE_DIRPRED_PC_TABLE_ENTRY_HH__
+
+/* MJL_End */
@@ -0,0 +1,45 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Definition of the prefetch based direction predictor.
+ */
+
+#include "mem/cache/dirpred/pf.hh"
+
+MJL_PfDirPredictor::MJL_PfDirPredictor(const MJL_PfDirPredictorParams *p)
+    : MJL_BaseDirPredictor(p)
+{
+}
+
+void
+MJL_PfDirPredictor::MJL_prefetchHint(const PacketPtr pkt,
+                                     MemCmd::MJL_DirAttribute dir)
+{
+    // Get required packet info
+    Addr pc = pkt->req->getPC();
+    bool is_secure = pkt->isSecure();
+    MasterID master_id = useMasterId ? pkt->req->masterId() : 0;
+
+    StrideEntry *entry;
+    if (pcTableHit(pc, is_secure, master_id, entry)) {
+        MJL_stepPfLevel(entry, dir);
+    } else {
+        entry = MJL_allocEntry(pc, pkt->getAddr(), is_secure, master_id);
+        MJL_startPfLevel(entry, dir);
+    }
+}
+
+MemCmd::MJL_DirAttribute
+MJL_PfDirPredictor::MJL_predictHit(const PacketPtr &pkt, StrideEntry *entry)
+{
+    return entry->MJL_getPfLastPredDir();
+}
+
+MJL_PfDirPredictor*
+MJL_PfDirPredictorParams::create()
+{
+    return new MJL_PfDirPredictor(this);
+}
+
+/* MJL_End */
@@ -0,0 +1,30 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Declaration of the prefetch based direction predictor. It follows the
+ * directions the downstream prefetcher picked for the misses of each PC.
+ */
+
+#ifndef __MEM_CACHE_DIRPRED_PF_HH__
+#define __MEM_CACHE_DIRPRED_PF_HH__
+
+#include "mem/cache/dirpred/base.hh"
+#include "params/MJL_PfDirPredictor.hh"
+
+class MJL_PfDirPredictor : public MJL_BaseDirPredictor
+{
+  public:
+    MJL_PfDirPredictor(const MJL_PfDirPredictorParams *p);
+
+    void MJL_prefetchHint(const PacketPtr pkt,
+                          MemCmd::MJL_DirAttribute dir) override;
+
+  protected:
+    MemCmd::MJL_DirAttribute MJL_predictHit(const PacketPtr &pkt,
+                                            StrideEntry *entry) override;
+};
+
+#endif // __MEM_CACHE_DIRPRED_PF_HH__
+
+/* MJL_End */
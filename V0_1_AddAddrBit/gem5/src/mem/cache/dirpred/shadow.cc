@@ -0,0 +1,241 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Definition of the shadow direction predictor.
+ */
+
+#include "mem/cache/dirpred/shadow.hh"
+
+#include "base/bitfield.hh"
+#include "base/misc.hh"
+
+MJL_ShadowDirPredictor::MJL_ShadowDirPredictor(
+    const MJL_ShadowDirPredictorParams *p)
+    : MJL_BaseDirPredictor(p), predictors(p->predictors), steer(p->steer),
+      window(p->window)
+{
+    fatal_if(predictors.empty(), "%s: no predictor to run\n", name());
+    fatal_if(steer >= predictors.size(),
+             "%s: steer %d is not one of the %d predictors\n", name(), steer,
+             predictors.size());
+    fatal_if(window == 0, "%s: window must not be 0\n", name());
+}
+
+void
+MJL_ShadowDirPredictor::setCache(BaseCache *_cache)
+{
+    MJL_BaseDirPredictor::setCache(_cache);
+    for (MJL_BaseDirPredictor *predictor : predictors) {
+        predictor->setCache(_cache);
+    }
+}
+
+void
+MJL_ShadowDirPredictor::regStats()
+{
+    MJL_BaseDirPredictor::regStats();
+
+    shadowPredicts
+        .init(predictors.size())
+        .name(name() + ".shadowPredicts")
+        .desc("number of direction predictions of each predictor")
+        .flags(Stats::nozero)
+        ;
+
+    shadowCoveredPredicts
+        .init(predictors.size())
+        .name(name() + ".shadowCoveredPredicts")
+        .desc("number of predictions made from a table entry of each predictor")
+        .flags(Stats::nozero)
+        ;
+
+    shadowCorrect
+        .init(predictors.size())
+        .name(name() + ".shadowCorrect")
+        .desc("number of scored misses each predictor got right")
+        .flags(Stats::nozero)
+        ;
+
+    shadowWrong
+        .init(predictors.size())
+        .name(name() + ".shadowWrong")
+        .desc("number of scored misses each predictor got wrong")
+        .flags(Stats::nozero)
+        ;
+
+    numUndecided
+        .name(name() + ".numUndecided")
+        .desc("number of misses with as many row as column words touched")
+        ;
+
+    shadowAccuracy
+        .name(name() + ".shadowAccuracy")
+        .desc("fraction of scored misses each predictor got right")
+        .flags(Stats::nozero)
+        ;
+    shadowAccuracy = shadowCorrect / (shadowCorrect + shadowWrong);
+
+    shadowCoverage
+        .name(name() + ".shadowCoverage")
+        .desc("fraction of predictions made from a table entry of each predictor")
+        .flags(Stats::nozero)
+        ;
+    shadowCoverage = shadowCoveredPredicts / shadowPredicts;
+
+    for (int i = 0; i < predictors.size(); ++i) {
+        // The predictors are named after the parameter, e.g. predictors0
+        const std::string &full = predictors[i]->name();
+        std::string subname = full.substr(full.rfind('.') + 1);
+        shadowPredicts.subname(i, subname);
+        shadowCoveredPredicts.subname(i, subname);
+        shadowCorrect.subname(i, subname);
+        shadowWrong.subname(i, subname);
+        shadowAccuracy.subname(i, subname);
+        shadowCoverage.subname(i, subname);
+    }
+}
+
+void
+MJL_ShadowDirPredictor::MJL_observe(const PacketPtr pkt)
+{
+    for (MJL_BaseDirPredictor *predictor : predictors) {
+        predictor->MJL_observe(pkt);
+    }
+    if (tracked.empty() || pkt->req->isUncacheable() ||
+        pkt->req->isInstFetch()) {
+        return;
+    }
+
+    Addr row_blk = pkt->MJL_getDirBlockAddr(blkSize,
+                                            MemCmd::MJL_DirAttribute::MJL_IsRow);
+    Addr col_blk = pkt->MJL_getDirBlockAddr(blkSize,
+                                            MemCmd::MJL_DirAttribute::MJL_IsColumn);
+    unsigned row_off = pkt->MJL_getDirOffset(blkSize,
+        MemCmd::MJL_DirAttribute::MJL_IsRow) / sizeof(uint64_t);
+    unsigned col_off = pkt->MJL_getDirOffset(blkSize,
+        MemCmd::MJL_DirAttribute::MJL_IsColumn) / sizeof(uint64_t);
+    // A vector access covers its words along its own direction
+    unsigned words = pkt->getSize() > sizeof(uint64_t) ?
+        pkt->getSize() / sizeof(uint64_t) : 1;
+    uint8_t row_mask = 1 << row_off;
+    uint8_t col_mask = 1 << col_off;
+    if (pkt->MJL_cmdIsRow()) {
+        row_mask = mask(words) << row_off;
+    } else {
+        col_mask = mask(words) << col_off;
+    }
+
+    for (MJL_ShadowEntry &entry : tracked) {
+        if (entry.isSecure != pkt->isSecure()) {
+            continue;
+        }
+        if (entry.rowBlkAddr == row_blk) {
+            entry.rowHits |= row_mask;
+        }
+        if (entry.colBlkAddr == col_blk) {
+            entry.colHits |= col_mask;
+        }
+    }
+}
+
+void
+MJL_ShadowDirPredictor::MJL_missAllocated(const PacketPtr pkt,
+                                          const MSHR *mshr)
+{
+    for (MJL_BaseDirPredictor *predictor : predictors) {
+        predictor->MJL_missAllocated(pkt, mshr);
+    }
+}
+
+void
+MJL_ShadowDirPredictor::MJL_missResolved(const MSHR *mshr, bool targetHasPC,
+                                         bool isUpgrade)
+{
+    for (MJL_BaseDirPredictor *predictor : predictors) {
+        predictor->MJL_missResolved(mshr, targetHasPC, isUpgrade);
+    }
+}
+
+void
+MJL_ShadowDirPredictor::MJL_prefetchHint(const PacketPtr pkt,
+                                         MemCmd::MJL_DirAttribute dir)
+{
+    for (MJL_BaseDirPredictor *predictor : predictors) {
+        predictor->MJL_prefetchHint(pkt, dir);
+    }
+}
+
+MemCmd::MJL_DirAttribute
+MJL_ShadowDirPredictor::MJL_predictDir(const PacketPtr &pkt, bool &covered)
+{
+    bool predicted = MJL_predicts(pkt);
+    MJL_ShadowEntry entry;
+    entry.dirs.resize(predictors.size());
+    for (int i = 0; i < predictors.size(); ++i) {
+        bool predictor_covered;
+        entry.dirs[i] = predictors[i]->MJL_predictDir(pkt, predictor_covered);
+        if (predicted) {
+            shadowPredicts[i]++;
+            if (predictor_covered) {
+                shadowCoveredPredicts[i]++;
+            }
+        }
+        if (i == steer) {
+            covered = predictor_covered;
+        }
+    }
+    if (!predicted) {
+        return entry.dirs[steer];
+    }
+
+    numPredicts++;
+    if (covered) {
+        numCoveredPredicts++;
+    }
+    entry.rowBlkAddr = pkt->MJL_getDirBlockAddr(blkSize,
+        MemCmd::MJL_DirAttribute::MJL_IsRow);
+    entry.colBlkAddr = pkt->MJL_getDirBlockAddr(blkSize,
+        MemCmd::MJL_DirAttribute::MJL_IsColumn);
+    entry.isSecure = pkt->isSecure();
+    entry.rowHits = 1 << (pkt->MJL_getDirOffset(blkSize,
+        MemCmd::MJL_DirAttribute::MJL_IsRow) / sizeof(uint64_t));
+    entry.colHits = 1 << (pkt->MJL_getDirOffset(blkSize,
+        MemCmd::MJL_DirAttribute::MJL_IsColumn) / sizeof(uint64_t));
+    MemCmd::MJL_DirAttribute steered = entry.dirs[steer];
+    tracked.push_back(std::move(entry));
+    if (tracked.size() > window) {
+        MJL_score(tracked.front());
+        tracked.pop_front();
+    }
+    return steered;
+}
+
+void
+MJL_ShadowDirPredictor::MJL_score(const MJL_ShadowEntry &scored)
+{
+    int row_count = popCount(scored.rowHits);
+    int col_count = popCount(scored.colHits);
+    if (row_count == col_count) {
+        numUndecided++;
+        return;
+    }
+    MemCmd::MJL_DirAttribute best = row_count > col_count ?
+        MemCmd::MJL_DirAttribute::MJL_IsRow :
+        MemCmd::MJL_DirAttribute::MJL_IsColumn;
+    for (int i = 0; i < predictors.size(); ++i) {
+        if (scored.dirs[i] == best) {
+            shadowCorrect[i]++;
+        } else {
+            shadowWrong[i]++;
+        }
+    }
+}
+
+MJL_ShadowDirPredictor*
+MJL_ShadowDirPredictorParams::create()
+{
+    return new MJL_ShadowDirPredictor(this);
+}
+
+/* MJL_End */
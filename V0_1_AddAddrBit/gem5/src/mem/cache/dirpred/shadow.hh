@@ -0,0 +1,84 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Declaration of the shadow direction predictor. It runs several
+ * predictors on the same access stream and lets one of them steer the
+ * misses. For every miss the predictions of all of them are kept until
+ * the words touched in the row line and in the column line of the miss
+ * tell which direction would have served more, then each prediction is
+ * scored against that.
+ */
+
+#ifndef __MEM_CACHE_DIRPRED_SHADOW_HH__
+#define __MEM_CACHE_DIRPRED_SHADOW_HH__
+
+#include <deque>
+#include <vector>
+
+#include "mem/cache/dirpred/base.hh"
+#include "params/MJL_ShadowDirPredictor.hh"
+
+class MJL_ShadowDirPredictor : public MJL_BaseDirPredictor
+{
+  public:
+    MJL_ShadowDirPredictor(const MJL_ShadowDirPredictorParams *p);
+
+    void setCache(BaseCache *_cache) override;
+
+    void regStats() override;
+
+    void MJL_observe(const PacketPtr pkt) override;
+    void MJL_missAllocated(const PacketPtr pkt, const MSHR *mshr) override;
+    void MJL_missResolved(const MSHR *mshr, bool targetHasPC,
+                          bool isUpgrade) override;
+    void MJL_prefetchHint(const PacketPtr pkt,
+                          MemCmd::MJL_DirAttribute dir) override;
+
+    /** Ask every predictor, return the direction of the steering one */
+    MemCmd::MJL_DirAttribute MJL_predictDir(const PacketPtr &pkt,
+                                            bool &covered) override;
+
+  protected:
+    /** A predicted miss waiting to be scored */
+    struct MJL_ShadowEntry
+    {
+        Addr rowBlkAddr;
+        Addr colBlkAddr;
+        bool isSecure;
+        /** Words touched in the row line, one bit per word */
+        uint8_t rowHits;
+        /** Words touched in the column line, one bit per word */
+        uint8_t colHits;
+        /** Prediction of each predictor */
+        std::vector<MemCmd::MJL_DirAttribute> dirs;
+    };
+
+    /** Never used, the predictors are asked instead */
+    MemCmd::MJL_DirAttribute MJL_predictHit(const PacketPtr &pkt,
+                                            StrideEntry *entry) override
+    { return pkt->MJL_getCmdDir(); }
+
+    /** Score the predictions of the oldest tracked miss */
+    void MJL_score(const MJL_ShadowEntry &scored);
+
+    const std::vector<MJL_BaseDirPredictor *> predictors;
+    const unsigned steer;
+    /** Number of misses tracked before they are scored */
+    const unsigned window;
+
+    std::deque<MJL_ShadowEntry> tracked;
+
+    Stats::Vector shadowPredicts;
+    Stats::Vector shadowCoveredPredicts;
+    Stats::Vector shadowCorrect;
+    Stats::Vector shadowWrong;
+    /** Scored misses whose row and column lines were touched alike */
+    Stats::Scalar numUndecided;
+    Stats::Formula shadowAccuracy;
+    Stats::Formula shadowCoverage;
+};
+
+#endif // __MEM_CACHE_DIRPRED_SHADOW_HH__
+
+/* MJL_End */
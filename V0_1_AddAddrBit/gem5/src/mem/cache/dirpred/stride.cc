@@ -0,0 +1,67 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Definition of the stride direction predictor.
+ */
+
+#include "mem/cache/dirpred/stride.hh"
+
+#include "base/intmath.hh"
+
+MJL_StrideDirPredictor::MJL_StrideDirPredictor(
+    const MJL_StrideDirPredictorParams *p)
+    : MJL_BaseDirPredictor(p)
+{
+}
+
+MemCmd::MJL_DirAttribute
+MJL_StrideDirPredictor::MJL_predictHit(const PacketPtr &pkt,
+                                       StrideEntry *entry)
+{
+    MemCmd::MJL_DirAttribute pkt_dir = pkt->MJL_getCmdDir();
+    MemCmd::MJL_DirAttribute predictedDir = pkt_dir;
+    int new_stride;
+    MJL_trainStride(pkt->getAddr(), entry, new_stride);
+
+    // Only generation if above confidence threshold
+    if (entry->confidence >= threshConf) {
+        if (new_stride % ((MJL_rowWidth * blkSize) / (1 + floorLog2(entry->confidence))) == 0 && (new_stride < (MJL_rowWidth * blkSize * blkSize/sizeof(uint64_t)) || pkt_dir == MemCmd::MJL_DirAttribute::MJL_IsColumn)) {
+            predictedDir = MemCmd::MJL_DirAttribute::MJL_IsColumn;
+        } else {
+            predictedDir = MemCmd::MJL_DirAttribute::MJL_IsRow;
+        }
+    }
+    if (entry->confidence >= threshConf && predictedDir == MemCmd::MJL_DirAttribute::MJL_IsColumn && entry->pfPredictLevel < maxPredLevel) {
+        entry->pfPredictLevel++;
+    } else if ((entry->confidence < threshConf || predictedDir == MemCmd::MJL_DirAttribute::MJL_IsRow) && entry->pfPredictLevel > 0) {
+        entry->pfPredictLevel--;
+    }
+    if (entry->pfPredictLevel == 0) {
+        entry->MJL_setLastPredDir(MemCmd::MJL_DirAttribute::MJL_IsRow);
+    } else if (entry->pfPredictLevel == maxPredLevel) {
+        entry->MJL_setLastPredDir(MemCmd::MJL_DirAttribute::MJL_IsColumn);
+    }
+
+    return entry->MJL_getLastPredDir();
+}
+
+void
+MJL_StrideDirPredictor::MJL_predictMiss(const PacketPtr &pkt, Addr pc,
+                                        bool is_secure, MasterID master_id)
+{
+    StrideEntry* entry = MJL_allocEntry(pc, pkt->getAddr(), is_secure,
+                                        master_id);
+    entry->predictLevel = startPredLevel;
+    entry->resetLevel = 0;
+    entry->MJL_setLastPredDir(MemCmd::MJL_DirAttribute::MJL_IsRow);
+    entry->pfPredictLevel = startPredLevel;
+}
+
+MJL_StrideDirPredictor*
+MJL_StrideDirPredictorParams::create()
+{
+    return new MJL_StrideDirPredictor(this);
+}
+
+/* MJL_End */
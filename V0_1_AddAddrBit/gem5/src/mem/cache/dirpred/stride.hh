@@ -0,0 +1,29 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Declaration of the stride direction predictor. A PC whose confident
+ * stride is a multiple of the row size is predicted to walk a column.
+ */
+
+#ifndef __MEM_CACHE_DIRPRED_STRIDE_HH__
+#define __MEM_CACHE_DIRPRED_STRIDE_HH__
+
+#include "mem/cache/dirpred/base.hh"
+#include "params/MJL_StrideDirPredictor.hh"
+
+class MJL_StrideDirPredictor : public MJL_BaseDirPredictor
+{
+  public:
+    MJL_StrideDirPredictor(const MJL_StrideDirPredictorParams *p);
+
+  protected:
+    MemCmd::MJL_DirAttribute MJL_predictHit(const PacketPtr &pkt,
+                                            StrideEntry *entry) override;
+    void MJL_predictMiss(const PacketPtr &pkt, Addr pc, bool is_secure,
+                         MasterID master_id) override;
+};
+
+#endif // __MEM_CACHE_DIRPRED_STRIDE_HH__
+
+/* MJL_End */
@@ -413,7 +413,7 @@ class MSHR : public QueueEntry, public Printable
     void MJL_getWordDemanded(unsigned blk_size)
     {
         for (std::list<Target>::iterator it = targets.begin(); it != targets.end(); ++it) {
-            targets.front().pkt->MJL_wordDemanded[it->pkt->getOffset(blk_size)/sizeof(uint64_t)] |= true;
+            targets.front().pkt->MJL_wordDemanded[it->pkt->getOffset(blk_size)/sizeof(uint64_t)] = true;
         }
     }
     /**
@@ -66,6 +66,9 @@ MSHRQueue::allocate(Addr blk_addr, unsigned blk_size, PacketPtr pkt,
 
     mshr->allocate(blk_addr, blk_size, pkt, when_ready, order, alloc_on_fill);
     mshr->allocIter = allocatedList.insert(allocatedList.end(), mshr);
+    /* MJL_Begin */
+    MJL_indexEntry(mshr);
+    /* MJL_End */
     mshr->readyIter = addToReadyList(mshr);
 
     allocated += 1;
@@ -83,6 +86,9 @@ MSHRQueue::MJL_allocateFootPrint(Addr blk_addr, MemCmd::MJL_DirAttribute blk_dir
 
     mshr->MJL_allocateFootPrint(blk_addr, blk_dir, blk_size, pkt, when_ready, order, alloc_on_fill);
     mshr->allocIter = allocatedList.insert(allocatedList.end(), mshr);
+    /* MJL_Begin */
+    MJL_indexEntry(mshr);
+    /* MJL_End */
     mshr->readyIter = addToReadyList(mshr);
 
     allocated += 1;
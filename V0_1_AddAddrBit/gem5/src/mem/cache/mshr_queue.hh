@@ -175,15 +175,13 @@ class MSHRQueue : public Queue<MSHR>
 
     bool MJL_hasBlockingCrossing(Addr blk_addr, MemCmd::MJL_DirAttribute MJL_queue_entry_dir, bool is_secure, unsigned blk_size, Addr tilemask) const
     {
-    	MemCmd::MJL_DirAttribute MJL_cross_queue_entry_dir = MJL_queue_entry_dir;
-        if (MJL_queue_entry_dir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-            MJL_cross_queue_entry_dir = MemCmd::MJL_DirAttribute::MJL_IsColumn;
-        } else if (MJL_queue_entry_dir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-            MJL_cross_queue_entry_dir = MemCmd::MJL_DirAttribute::MJL_IsRow;
-        } else {
-            assert(MJL_queue_entry_dir == MemCmd::MJL_DirAttribute::MJL_IsRow || MJL_queue_entry_dir == QueueEntry::MJL_QEntryDir::MJL_IsColumn);
+    	MemCmd::MJL_DirAttribute MJL_cross_queue_entry_dir = MJL_crossDir(MJL_queue_entry_dir);
+        assert(!(MJL_tileMask & ~tilemask));
+        const std::vector<MSHR*>* tile_entries = MJL_getTileEntries(blk_addr);
+        if (!tile_entries) {
+            return false;
         }
-        for (const auto& entry : allocatedList) {
+        for (const auto& entry : *tile_entries) {
             if ((entry->blkAddr & tilemask) == (blk_addr & tilemask) && entry->isSecure == is_secure && entry->MJL_qEntryDir == MJL_cross_queue_entry_dir) {
                 if (entry->MJL_getLastWriteTarget(blk_addr, blk_size, false)) {
                 	return true;
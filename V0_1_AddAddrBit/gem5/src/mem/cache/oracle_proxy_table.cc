@@ -0,0 +1,282 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Definition of the oracle proxy (PC, address) to direction tables.
+ */
+
+#include "mem/cache/oracle_proxy_table.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "base/misc.hh"
+
+const char MJL_PCAddrDirTable::MJL_magic[8] = {'M', 'J', 'L', 'P', 'A', '2',
+                                               'D', '\0'};
+
+MJL_PCAddrDirTable::MJL_PCAddrDirTable()
+    : slots(nullptr), dirBits(nullptr), capacity(0), numEntries(0),
+      mappedBase(nullptr), mappedSize(0)
+{
+}
+
+MJL_PCAddrDirTable::~MJL_PCAddrDirTable()
+{
+    MJL_unmap();
+}
+
+void
+MJL_PCAddrDirTable::MJL_unmap()
+{
+    if (mappedBase) {
+        munmap(mappedBase, mappedSize);
+        mappedBase = nullptr;
+        mappedSize = 0;
+    }
+}
+
+void
+MJL_PCAddrDirTable::MJL_resize(uint64_t new_capacity)
+{
+    std::vector<MJL_Slot> old_slots;
+    std::vector<uint64_t> old_dir_bits;
+    old_slots.swap(ownedSlots);
+    old_dir_bits.swap(ownedDirBits);
+
+    MJL_Slot empty = {MJL_emptyPC, 0};
+    ownedSlots.assign(new_capacity, empty);
+    ownedDirBits.assign((new_capacity + 31) / 32, 0);
+    slots = ownedSlots.data();
+    dirBits = ownedDirBits.data();
+    capacity = new_capacity;
+    numEntries = 0;
+
+    for (uint64_t i = 0; i < old_slots.size(); ++i) {
+        if (old_slots[i].pc != MJL_emptyPC) {
+            MemCmd::MJL_DirAttribute dir = (MemCmd::MJL_DirAttribute)
+                ((old_dir_bits[i / 32] >> (2 * (i % 32))) & 0x3);
+            MJL_insert(old_slots[i].pc, old_slots[i].addr, dir);
+        }
+    }
+}
+
+void
+MJL_PCAddrDirTable::MJL_insert(Addr pc, Addr addr,
+                               MemCmd::MJL_DirAttribute dir)
+{
+    assert(!mappedBase);
+    assert(pc != MJL_emptyPC);
+    // Keep the load factor at or below one half
+    if (2 * (numEntries + 1) > capacity) {
+        MJL_resize(capacity ? 2 * capacity : 1024);
+    }
+    const uint64_t mask = capacity - 1;
+    uint64_t i = MJL_hash(pc, addr) & mask;
+    while (ownedSlots[i].pc != MJL_emptyPC &&
+           (ownedSlots[i].pc != pc || ownedSlots[i].addr != addr)) {
+        i = (i + 1) & mask;
+    }
+    if (ownedSlots[i].pc == MJL_emptyPC) {
+        ownedSlots[i].pc = pc;
+        ownedSlots[i].addr = addr;
+        ++numEntries;
+    }
+    ownedDirBits[i / 32] &= ~(0x3ULL << (2 * (i % 32)));
+    ownedDirBits[i / 32] |= ((uint64_t)dir & 0x3) << (2 * (i % 32));
+}
+
+void
+MJL_PCAddrDirTable::MJL_loadText(const std::string &filename)
+{
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        fatal("Could not open oracle proxy input '%s'\n", filename);
+    }
+    std::string line;
+    while (getline(file, line)) {
+        Addr tempPC = 0;
+        Addr tempAddr = 0;
+        char tempDir = 0;
+        std::stringstream(line) >> std::hex >> tempPC >> tempAddr >> std::dec
+                                >> tempDir;
+        if (tempDir == 'R') {
+            MJL_insert(tempPC, tempAddr, MemCmd::MJL_DirAttribute::MJL_IsRow);
+        } else if (tempDir == 'C') {
+            MJL_insert(tempPC, tempAddr,
+                       MemCmd::MJL_DirAttribute::MJL_IsColumn);
+        } else if (tempDir != 0) {
+            fatal("Invalid direction annotation '%c' in '%s'\n", tempDir,
+                  filename);
+        }
+    }
+}
+
+bool
+MJL_PCAddrDirTable::MJL_isBinary(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    char magic[sizeof(MJL_magic)];
+    if (!file.read(magic, sizeof(magic))) {
+        return false;
+    }
+    return std::memcmp(magic, MJL_magic, sizeof(MJL_magic)) == 0;
+}
+
+void
+MJL_PCAddrDirTable::MJL_loadBinary(const std::string &filename)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        fatal("Could not open oracle proxy input '%s'\n", filename);
+    }
+
+    struct stat sb;
+    if (fstat(fd, &sb) != 0 || (size_t)sb.st_size < sizeof(MJL_Header)) {
+        close(fd);
+        fatal("Oracle proxy input '%s' is truncated\n", filename);
+    }
+
+    void *base = mmap(NULL, sb.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        perror("mmap");
+        fatal("Could not mmap oracle proxy input '%s'\n", filename);
+    }
+
+    const MJL_Header *header = (const MJL_Header *)base;
+    const uint64_t dir_words = (header->capacity + 31) / 32;
+    if (std::memcmp(header->magic, MJL_magic, sizeof(MJL_magic)) != 0 ||
+        header->version != MJL_version ||
+        header->slotSize != sizeof(MJL_Slot) ||
+        (header->capacity & (header->capacity - 1)) != 0 ||
+        header->numEntries >= header->capacity + (header->capacity == 0) ||
+        sizeof(MJL_Header) + header->capacity * sizeof(MJL_Slot) +
+        dir_words * sizeof(uint64_t) > (size_t)sb.st_size) {
+        munmap(base, sb.st_size);
+        fatal("Oracle proxy input '%s' has an unsupported format\n",
+              filename);
+    }
+
+    MJL_unmap();
+    ownedSlots.clear();
+    ownedDirBits.clear();
+    mappedBase = base;
+    mappedSize = sb.st_size;
+    capacity = header->capacity;
+    numEntries = header->numEntries;
+    slots = (const MJL_Slot *)((const uint8_t *)base + sizeof(MJL_Header));
+    dirBits = (const uint64_t *)(slots + capacity);
+}
+
+void
+MJL_PCAddrDirTable::MJL_writeBinary(const std::string &filename) const
+{
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        fatal("Could not open oracle proxy output '%s'\n", filename);
+    }
+    MJL_Header header;
+    std::memcpy(header.magic, MJL_magic, sizeof(MJL_magic));
+    header.version = MJL_version;
+    header.slotSize = sizeof(MJL_Slot);
+    header.capacity = capacity;
+    header.numEntries = numEntries;
+    file.write((const char *)&header, sizeof(header));
+    file.write((const char *)slots, capacity * sizeof(MJL_Slot));
+    file.write((const char *)dirBits,
+               (capacity + 31) / 32 * sizeof(uint64_t));
+}
+
+MJL_PCAddrOracleRecorder::MJL_PCAddrOracleRecorder(uint64_t initial_capacity)
+    : numEntries(0)
+{
+    assert(initial_capacity > 0 &&
+           (initial_capacity & (initial_capacity - 1)) == 0);
+    MJL_resize(initial_capacity);
+}
+
+void
+MJL_PCAddrOracleRecorder::MJL_resize(uint64_t new_capacity)
+{
+    std::vector<MJL_Counts> old_slots;
+    old_slots.swap(slots);
+    MJL_Counts empty = {MJL_PCAddrDirTable::MJL_emptyPC, 0, 0, 0};
+    slots.assign(new_capacity, empty);
+
+    const uint64_t mask = new_capacity - 1;
+    for (const MJL_Counts &counts : old_slots) {
+        if (counts.pc != MJL_PCAddrDirTable::MJL_emptyPC) {
+            uint64_t i = MJL_PCAddrDirTable::MJL_hash(counts.pc, counts.addr)
+                         & mask;
+            while (slots[i].pc != MJL_PCAddrDirTable::MJL_emptyPC) {
+                i = (i + 1) & mask;
+            }
+            slots[i] = counts;
+        }
+    }
+}
+
+void
+MJL_PCAddrOracleRecorder::MJL_countHits(Addr pc, Addr addr, uint64_t in_hits,
+                                        MemCmd::MJL_DirAttribute blkDir)
+{
+    assert(pc != MJL_PCAddrDirTable::MJL_emptyPC);
+    if (2 * (numEntries + 1) > slots.size()) {
+        MJL_resize(2 * slots.size());
+    }
+    const uint64_t mask = slots.size() - 1;
+    uint64_t i = MJL_PCAddrDirTable::MJL_hash(pc, addr) & mask;
+    while (slots[i].pc != MJL_PCAddrDirTable::MJL_emptyPC &&
+           (slots[i].pc != pc || slots[i].addr != addr)) {
+        i = (i + 1) & mask;
+    }
+    if (slots[i].pc == MJL_PCAddrDirTable::MJL_emptyPC) {
+        slots[i].pc = pc;
+        slots[i].addr = addr;
+        ++numEntries;
+    }
+    if (blkDir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
+        slots[i].row_hits += in_hits;
+    } else if (blkDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
+        slots[i].col_hits += in_hits;
+    } else {
+        assert(false);
+    }
+}
+
+void
+MJL_PCAddrOracleRecorder::MJL_writeBinary(const std::string &filename) const
+{
+    MJL_PCAddrDirTable table;
+    for (const MJL_Counts &counts : slots) {
+        if (counts.pc != MJL_PCAddrDirTable::MJL_emptyPC &&
+            counts.getDir() == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
+            table.MJL_insert(counts.pc, counts.addr, counts.getDir());
+        }
+    }
+    table.MJL_writeBinary(filename);
+}
+
+void
+MJL_PCAddrOracleRecorder::MJL_print(std::ostream &os) const
+{
+    for (const MJL_Counts &counts : slots) {
+        if (counts.pc != MJL_PCAddrDirTable::MJL_emptyPC &&
+            (counts.row_hits > 1 || counts.col_hits > 1)) {
+            os << std::hex << counts.pc << " " << counts.addr << std::dec
+               << " " << counts.row_hits << " " << counts.col_hits
+               << std::endl;
+        }
+    }
+}
+
+/* MJL_End */
@@ -0,0 +1,168 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Declaration of the (PC, address) to direction tables used by the oracle
+ * proxy. MJL_PCAddrOracleRecorder accumulates the row/column hits of each
+ * (PC, address) pair while recording, and MJL_PCAddrDirTable is the
+ * read-only table consulted on every L1D request during replay.
+ */
+
+#ifndef __MEM_CACHE_ORACLE_PROXY_TABLE_HH__
+#define __MEM_CACHE_ORACLE_PROXY_TABLE_HH__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/packet.hh"
+
+/**
+ * Flat open-addressing (linear probing) hash from (PC, address) to a 2-bit
+ * direction. The binary file is an image of the table itself so replay
+ * maps it read-only and probes it without parsing.
+ *
+ * File layout: MJL_Header, capacity MJL_Slot records, then the directions
+ * packed 32 per 64-bit word in slot order.
+ */
+class MJL_PCAddrDirTable
+{
+  public:
+    static const char MJL_magic[8];
+    static const uint32_t MJL_version = 1;
+
+    struct MJL_Slot
+    {
+        uint64_t pc;
+        uint64_t addr;
+    };
+
+    struct MJL_Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t slotSize;
+        uint64_t capacity;
+        uint64_t numEntries;
+    };
+
+    MJL_PCAddrDirTable();
+    ~MJL_PCAddrDirTable();
+
+    MJL_PCAddrDirTable(const MJL_PCAddrDirTable &) = delete;
+    MJL_PCAddrDirTable &operator=(const MJL_PCAddrDirTable &) = delete;
+
+    /** Add or overwrite an entry, only for tables not loaded from a file */
+    void MJL_insert(Addr pc, Addr addr, MemCmd::MJL_DirAttribute dir);
+
+    /** Direction of a (PC, address) pair, MJL_IsInvalid if not present */
+    MemCmd::MJL_DirAttribute MJL_lookup(Addr pc, Addr addr) const
+    {
+        if (numEntries == 0) {
+            return MemCmd::MJL_DirAttribute::MJL_IsInvalid;
+        }
+        const uint64_t mask = capacity - 1;
+        for (uint64_t i = MJL_hash(pc, addr) & mask; ; i = (i + 1) & mask) {
+            if (slots[i].pc == MJL_emptyPC) {
+                return MemCmd::MJL_DirAttribute::MJL_IsInvalid;
+            }
+            if (slots[i].pc == pc && slots[i].addr == addr) {
+                return MJL_getDir(i);
+            }
+        }
+    }
+
+    /** Load the text format, "PC Addr Dir RowCount ColCount" per line */
+    void MJL_loadText(const std::string &filename);
+    /** Map a binary table written by MJL_writeBinary */
+    void MJL_loadBinary(const std::string &filename);
+    /** Whether the file starts with the binary table magic */
+    static bool MJL_isBinary(const std::string &filename);
+    /** Stream the table image to a file */
+    void MJL_writeBinary(const std::string &filename) const;
+
+    uint64_t MJL_size() const { return numEntries; }
+
+    static uint64_t MJL_hash(Addr pc, Addr addr)
+    {
+        uint64_t h = pc * 0x9E3779B97F4A7C15ULL;
+        h ^= addr * 0xC2B2AE3D27D4EB4FULL;
+        return h ^ (h >> 31);
+    }
+
+    /** No instruction is fetched from the last byte of the address space */
+    static const uint64_t MJL_emptyPC = ~0ULL;
+
+  private:
+    MemCmd::MJL_DirAttribute MJL_getDir(uint64_t i) const
+    {
+        return (MemCmd::MJL_DirAttribute)((dirBits[i / 32] >> (2 * (i % 32)))
+                                          & 0x3);
+    }
+    void MJL_resize(uint64_t new_capacity);
+    void MJL_unmap();
+
+    const MJL_Slot *slots;
+    const uint64_t *dirBits;
+    uint64_t capacity;
+    uint64_t numEntries;
+
+    /** Backing storage when built in memory */
+    std::vector<MJL_Slot> ownedSlots;
+    std::vector<uint64_t> ownedDirBits;
+
+    /** Mapping when loaded from a binary file */
+    void *mappedBase;
+    size_t mappedSize;
+};
+
+/**
+ * Per (PC, address) row/column hit counters of the oracle proxy. The
+ * counters live in one flat open-addressing array, so recording does not
+ * allocate per entry.
+ */
+class MJL_PCAddrOracleRecorder
+{
+  public:
+    struct MJL_Counts
+    {
+        uint64_t pc;
+        uint64_t addr;
+        uint64_t row_hits;
+        uint64_t col_hits;
+
+        MemCmd::MJL_DirAttribute getDir() const
+        {
+            return row_hits >= col_hits ?
+                MemCmd::MJL_DirAttribute::MJL_IsRow :
+                MemCmd::MJL_DirAttribute::MJL_IsColumn;
+        }
+    };
+
+    MJL_PCAddrOracleRecorder(uint64_t initial_capacity = 1 << 16);
+
+    void MJL_countHits(Addr pc, Addr addr, uint64_t in_hits,
+                       MemCmd::MJL_DirAttribute blkDir);
+
+    /**
+     * Write the column preferring pairs as a binary MJL_PCAddrDirTable,
+     * rows are the default so they are not stored.
+     */
+    void MJL_writeBinary(const std::string &filename) const;
+
+    /** Print the pairs hit more than once in one direction */
+    void MJL_print(std::ostream &os) const;
+
+    uint64_t MJL_size() const { return numEntries; }
+
+  private:
+    void MJL_resize(uint64_t new_capacity);
+
+    std::vector<MJL_Counts> slots;
+    uint64_t numEntries;
+};
+
+#endif // __MEM_CACHE_ORACLE_PROXY_TABLE_HH__
+
+/* MJL_End */
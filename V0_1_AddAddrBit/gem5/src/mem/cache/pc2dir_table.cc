@@ -0,0 +1,226 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Definition of the PC to direction preference table.
+ */
+
+#include "mem/cache/pc2dir_table.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+
+#include "base/misc.hh"
+
+const char MJL_PC2DirIndex::MJL_magic[8] = {'M', 'J', 'L', 'P', 'C', '2',
+                                            'D', '\0'};
+
+MJL_PC2DirIndex::MJL_PC2DirIndex()
+    : entries(nullptr), numEntries(0), mappedBase(nullptr), mappedSize(0)
+{
+}
+
+MJL_PC2DirIndex::~MJL_PC2DirIndex()
+{
+    MJL_unmap();
+}
+
+void
+MJL_PC2DirIndex::MJL_unmap()
+{
+    if (mappedBase) {
+        munmap(mappedBase, mappedSize);
+        mappedBase = nullptr;
+        mappedSize = 0;
+    }
+}
+
+bool
+MJL_PC2DirIndex::MJL_isBinary(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    char magic[sizeof(MJL_magic)];
+    if (!file.read(magic, sizeof(magic))) {
+        return false;
+    }
+    return std::memcmp(magic, MJL_magic, sizeof(MJL_magic)) == 0;
+}
+
+void
+MJL_PC2DirIndex::MJL_loadBinary(const std::string &filename)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        fatal("Could not open PC to direction table '%s'\n", filename);
+    }
+
+    struct stat sb;
+    if (fstat(fd, &sb) != 0 || (size_t)sb.st_size < sizeof(MJL_PC2DirHeader)) {
+        close(fd);
+        fatal("PC to direction table '%s' is truncated\n", filename);
+    }
+
+    void *base = mmap(NULL, sb.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        perror("mmap");
+        fatal("Could not mmap PC to direction table '%s'\n", filename);
+    }
+
+    const MJL_PC2DirHeader *header = (const MJL_PC2DirHeader *)base;
+    if (std::memcmp(header->magic, MJL_magic, sizeof(MJL_magic)) != 0 ||
+        header->version != MJL_version ||
+        header->entrySize != sizeof(MJL_PC2DirEntry) ||
+        sizeof(MJL_PC2DirHeader) +
+        header->numEntries * sizeof(MJL_PC2DirEntry) > (size_t)sb.st_size) {
+        munmap(base, sb.st_size);
+        fatal("PC to direction table '%s' has an unsupported format\n",
+              filename);
+    }
+
+    MJL_unmap();
+    ownedEntries.clear();
+    mappedBase = base;
+    mappedSize = sb.st_size;
+    numEntries = header->numEntries;
+    entries = (const MJL_PC2DirEntry *)((const uint8_t *)base +
+                                        sizeof(MJL_PC2DirHeader));
+}
+
+void
+MJL_PC2DirIndex::MJL_loadText(const std::string &pc2dir_file,
+                              const std::string &vec_list_file)
+{
+    std::unordered_map<Addr, MJL_PC2DirEntry> parsed;
+    std::string line;
+
+    std::ifstream MJL_PC2DirFile(pc2dir_file);
+    if (!MJL_PC2DirFile.is_open()) {
+        fatal("Could not open PC to direction file '%s'\n", pc2dir_file);
+    }
+    while (getline(MJL_PC2DirFile, line)) {
+        Addr tempPC = 0;
+        char tempDir = 0;
+        int tempPos = 0;
+        Addr tempOtherPC = 0;
+        double tempConfidence = 0;
+        std::stringstream(line) >> std::hex >> tempPC >> std::dec >> tempDir
+                                >> tempPos >> std::hex >> tempOtherPC
+                                >> std::dec >> tempConfidence;
+        if (tempDir == 0) {
+            // Skip empty lines
+            continue;
+        }
+        MJL_PC2DirEntry &entry = parsed[tempPC];
+        if (entry.MJL_hasDir()) {
+            std::cout << "MJL_Error: Redefinition of instruction direction "
+                         "found!\n";
+        }
+        entry.pc = tempPC;
+        if (tempDir == 'R') {
+            entry.dir = MemCmd::MJL_DirAttribute::MJL_IsRow;
+        } else if (tempDir == 'C') {
+            entry.dir = MemCmd::MJL_DirAttribute::MJL_IsColumn;
+        } else {
+            fatal("Invalid direction annotation '%c' in '%s'\n", tempDir,
+                  pc2dir_file);
+        }
+        if (tempPos < 0 || tempPos > 2) {
+            fatal("Invalid column vector position %d in '%s'\n", tempPos,
+                  pc2dir_file);
+        }
+        entry.pos = tempPos;
+        entry.otherPC = tempPos > 0 ? tempOtherPC : 0;
+        // 0 means unknown, so a low but nonzero confidence rounds up to 1
+        // as in the binary table of MJL_PC2DirProfiler
+        double confidence = std::min(std::max(tempConfidence, 0.0), 1.0);
+        entry.confidence = confidence > 0 ?
+            std::max(1L, std::lround(confidence * 255)) : 0;
+    }
+
+    if (vec_list_file != "") {
+        std::ifstream MJL_VecListFile(vec_list_file);
+        if (!MJL_VecListFile.is_open()) {
+            fatal("Could not open vector list file '%s'\n", vec_list_file);
+        }
+        while (getline(MJL_VecListFile, line)) {
+            Addr tempPC = 0;
+            if (!(std::stringstream(line) >> std::hex >> tempPC)) {
+                continue;
+            }
+            auto it = parsed.find(tempPC);
+            if (it == parsed.end()) {
+                MJL_PC2DirEntry &entry = parsed[tempPC];
+                entry.pc = tempPC;
+                entry.dir = MemCmd::MJL_DirAttribute::MJL_IsInvalid;
+                it = parsed.find(tempPC);
+            } else if (it->second.MJL_isVec()) {
+                std::cout << "MJL_Warning: Repeated vector PC found in file!\n";
+            }
+            it->second.flags |= MJL_PC2DirEntry::MJL_IsVecFlag;
+        }
+    }
+
+    std::vector<MJL_PC2DirEntry> sorted;
+    sorted.reserve(parsed.size());
+    for (const auto &it : parsed) {
+        sorted.push_back(it.second);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](const MJL_PC2DirEntry &a, const MJL_PC2DirEntry &b)
+              { return a.pc < b.pc; });
+
+    MJL_unmap();
+    ownedEntries = MJL_toEytzinger(sorted);
+    entries = ownedEntries.data();
+    numEntries = ownedEntries.size();
+}
+
+std::vector<MJL_PC2DirEntry>
+MJL_PC2DirIndex::MJL_toEytzinger(const std::vector<MJL_PC2DirEntry> &sorted)
+{
+    std::vector<MJL_PC2DirEntry> out(sorted.size());
+    // In-order walk of the implicit tree, node k has children 2k and 2k+1
+    size_t i = 0;
+    uint64_t k = 1;
+    const uint64_t n = sorted.size();
+    while (i < n) {
+        while (k <= n) {
+            k = 2 * k;
+        }
+        k >>= __builtin_ffsll(~k);
+        out[k - 1] = sorted[i++];
+        k = 2 * k + 1;
+    }
+    return out;
+}
+
+MJL_PC2DirTable::MJL_PC2DirTable(const Params *p)
+    : SimObject(p)
+{
+    if (MJL_PC2DirIndex::MJL_isBinary(p->file)) {
+        index.MJL_loadBinary(p->file);
+    } else {
+        index.MJL_loadText(p->file, p->vec_list_file);
+    }
+    inform("%s: %d PC to direction entries loaded from %s\n", name(),
+           index.MJL_size(), p->file);
+}
+
+MJL_PC2DirTable*
+MJL_PC2DirTableParams::create()
+{
+    return new MJL_PC2DirTable(this);
+}
+
+/* MJL_End */
@@ -0,0 +1,153 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Declaration of the PC to direction preference table. The table is
+ * loaded once per system (text or mmapped binary file) and shared by all
+ * the L1 data caches, which query it on every request.
+ */
+
+#ifndef __MEM_CACHE_PC2DIR_TABLE_HH__
+#define __MEM_CACHE_PC2DIR_TABLE_HH__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/packet.hh"
+#include "params/MJL_PC2DirTable.hh"
+#include "sim/sim_object.hh"
+
+/**
+ * One annotated instruction. The layout is also the on-disk record of
+ * the binary table, see util/mjl_pc2dir_convert.py.
+ */
+struct MJL_PC2DirEntry
+{
+    /** PC of the annotated instruction */
+    uint64_t pc;
+    /** PC of the other half of a column vector access, 0 if none */
+    uint64_t otherPC;
+    /** Preferred direction, MJL_IsInvalid if the PC is only a vector PC */
+    uint8_t dir;
+    /** 0 if not a column vector access, 1 first half, 2 second half */
+    uint8_t pos;
+    /** Entry flags, see MJL_IsVecFlag */
+    uint8_t flags;
+    /** Confidence of a profiled direction out of 255, 0 if unknown */
+    uint8_t confidence;
+    uint8_t pad[4];
+
+    static const uint8_t MJL_IsVecFlag = 0x1;
+
+    MemCmd::MJL_DirAttribute MJL_getDir() const
+    { return (MemCmd::MJL_DirAttribute)dir; }
+    bool MJL_hasDir() const
+    { return dir != MemCmd::MJL_DirAttribute::MJL_IsInvalid; }
+    bool MJL_isVec() const { return flags & MJL_IsVecFlag; }
+};
+
+/**
+ * Header of the binary table. It is followed by numEntries records of
+ * MJL_PC2DirEntry stored in Eytzinger (breadth first) order of the
+ * sorted PCs.
+ */
+struct MJL_PC2DirHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t entrySize;
+    uint64_t numEntries;
+};
+
+/**
+ * Read-only PC lookup structure. The entries are kept in Eytzinger order
+ * so a lookup is a branch-free descent over a contiguous array, either
+ * owned (text input) or mapped from a binary file.
+ */
+class MJL_PC2DirIndex
+{
+  public:
+    static const char MJL_magic[8];
+    static const uint32_t MJL_version = 1;
+
+    MJL_PC2DirIndex();
+    ~MJL_PC2DirIndex();
+
+    MJL_PC2DirIndex(const MJL_PC2DirIndex &) = delete;
+    MJL_PC2DirIndex &operator=(const MJL_PC2DirIndex &) = delete;
+
+    /**
+     * Load a binary table produced by util/mjl_pc2dir_convert.py. The
+     * file is mapped read-only and shared between processes.
+     */
+    void MJL_loadBinary(const std::string &filename);
+
+    /**
+     * Load the legacy text format, "PC Dir Pos OtherPC [Confidence]" per
+     * line for the direction file, the confidence being within [0, 1],
+     * and one PC per line for the optional vector list.
+     */
+    void MJL_loadText(const std::string &pc2dir_file,
+                      const std::string &vec_list_file);
+
+    /** Whether the file starts with the binary table magic */
+    static bool MJL_isBinary(const std::string &filename);
+
+    /** Find the entry of a PC, nullptr if the PC is not annotated */
+    const MJL_PC2DirEntry *MJL_lookup(Addr pc) const
+    {
+        uint64_t k = 1;
+        while (k <= numEntries) {
+            k = 2 * k + (entries[k - 1].pc < pc);
+        }
+        // Strip the trailing right turns to find the lower bound
+        k >>= __builtin_ffsll(~k);
+        if (k == 0 || entries[k - 1].pc != pc) {
+            return nullptr;
+        }
+        return &entries[k - 1];
+    }
+
+    uint64_t MJL_size() const { return numEntries; }
+    const MJL_PC2DirEntry *begin() const { return entries; }
+    const MJL_PC2DirEntry *end() const { return entries + numEntries; }
+
+    /** Rearrange sorted entries into Eytzinger order */
+    static std::vector<MJL_PC2DirEntry>
+    MJL_toEytzinger(const std::vector<MJL_PC2DirEntry> &sorted);
+
+  private:
+    void MJL_unmap();
+
+    const MJL_PC2DirEntry *entries;
+    uint64_t numEntries;
+
+    /** Backing storage when loaded from text */
+    std::vector<MJL_PC2DirEntry> ownedEntries;
+
+    /** Mapping when loaded from a binary file */
+    void *mappedBase;
+    size_t mappedSize;
+};
+
+/**
+ * System-wide SimObject holding the PC to direction table, referenced by
+ * the MJL_PC2DirTable parameter of every cache that needs it.
+ */
+class MJL_PC2DirTable : public SimObject
+{
+  public:
+    typedef MJL_PC2DirTableParams Params;
+    MJL_PC2DirTable(const Params *p);
+
+    const MJL_PC2DirIndex &MJL_getIndex() const { return index; }
+
+  private:
+    MJL_PC2DirIndex index;
+};
+
+#endif // __MEM_CACHE_PC2DIR_TABLE_HH__
+
+/* MJL_End */
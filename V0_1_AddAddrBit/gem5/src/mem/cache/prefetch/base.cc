@@ -55,6 +55,7 @@
 
 BasePrefetcher::BasePrefetcher(const BasePrefetcherParams *p)
     : ClockedObject(p), cache(nullptr), blkSize(0), lBlkSize(0),
+      /* MJL_Begin */MJL_geometry(nullptr),/* MJL_End */
       system(p->sys), onMiss(p->on_miss), onRead(p->on_read),
       onWrite(p->on_write), onData(p->on_data), onInst(p->on_inst),/* MJL_Begin */
       MJL_colPf(p->MJL_colPf), MJL_colPageSize(p->MJL_colPageSize),
@@ -71,6 +72,9 @@ BasePrefetcher::setCache(BaseCache *_cache)
     cache = _cache;
     blkSize = cache->getBlockSize();
     lBlkSize = floorLog2(blkSize);
+    /* MJL_Begin */
+    MJL_geometry = &cache->MJL_getGeometry();
+    /* MJL_End */
 }
 
 void
@@ -230,49 +234,19 @@ BasePrefetcher::MJL_colSamePage(Addr a, Addr b) const
 Addr 
 BasePrefetcher::MJL_movColRight(Addr addr) const 
 {
-    int MJL_rowShift = floorLog2(sizeof(uint64_t));
-    int MJL_colShift = floorLog2(MJL_getRowWidth()) + floorLog2(blkSize);
-    int MJL_wordShift = floorLog2(blkSize/sizeof(uint64_t));
-    uint64_t MJL_highMask = ~((1 << (MJL_colShift + MJL_wordShift)) - 1);
-    uint64_t MJL_middleMask = (MJL_getRowWidth() - 1) << floorLog2(blkSize);;
-    uint64_t MJL_wordMask = blkSize/sizeof(uint64_t) - 1;
-    uint64_t MJL_offsetMask = sizeof(uint64_t) - 1;
-
-    Addr same = addr & ((Addr)MJL_highMask | (Addr)MJL_offsetMask);
-    Addr middle = addr & (Addr)MJL_middleMask;
-    Addr col = (addr >> MJL_colShift) & (Addr)MJL_wordMask;
-    Addr row = (addr >> MJL_rowShift) & (Addr)MJL_wordMask;
-    return (same | (middle << MJL_wordShift) | (col << (MJL_wordShift + MJL_rowShift)) | (row << MJL_rowShift));
+    return MJL_geometry->MJL_movColRight(addr);
 }
 
 Addr 
 BasePrefetcher::MJL_movColLeft(Addr addr) const 
 {
-    int MJL_rowShift = floorLog2(sizeof(uint64_t));
-    int MJL_colShift = floorLog2(MJL_getRowWidth()) + floorLog2(blkSize);
-    int MJL_wordShift = floorLog2(blkSize/sizeof(uint64_t));
-    uint64_t MJL_highMask = ~((1 << (MJL_colShift + MJL_wordShift)) - 1);
-    uint64_t MJL_middleMask = (MJL_getRowWidth() - 1) << floorLog2(blkSize);;
-    uint64_t MJL_wordMask = blkSize/sizeof(uint64_t) - 1;
-    uint64_t MJL_offsetMask = sizeof(uint64_t) - 1;
-
-    Addr same = addr & ((Addr)MJL_highMask | (Addr)MJL_offsetMask);
-    Addr middle = addr & ((Addr)MJL_middleMask << MJL_wordShift);
-    Addr row = (addr >> MJL_rowShift) & (Addr)MJL_wordMask;
-    Addr col = (addr >> (MJL_rowShift + MJL_wordShift)) & (Addr)MJL_wordMask;
-    return (same | (col << MJL_colShift) | (middle >> MJL_wordShift) | (row << MJL_rowShift));
+    return MJL_geometry->MJL_movColLeft(addr);
 }
 
 Addr 
 BasePrefetcher::MJL_swapRowColBits(Addr addr) const 
 {
-    int MJL_rowShift = floorLog2(sizeof(uint64_t));
-    uint64_t MJL_wordMask = blkSize/sizeof(uint64_t) - 1;
-    int MJL_colShift = floorLog2(MJL_getRowWidth()) + floorLog2(blkSize);
-
-    Addr new_row = (addr >> MJL_colShift) & (Addr)MJL_wordMask;
-    Addr new_col = (addr >> MJL_rowShift) & (Addr)MJL_wordMask;
-    return ((addr & ~(((Addr)MJL_wordMask << MJL_colShift) | ((Addr)MJL_wordMask << MJL_rowShift))) | (new_row << MJL_rowShift) | (new_col << MJL_colShift));
+    return MJL_geometry->MJL_swapRowColBits(addr);
 }
 
 Addr 
@@ -71,6 +71,11 @@ class BasePrefetcher : public ClockedObject
     /** log_2(block size of the parent cache). */
     unsigned lBlkSize;
 
+    /* MJL_Begin */
+    /** Row/column address geometry of the parent cache */
+    const MJL_AddrGeometry *MJL_geometry;
+    /* MJL_End */
+
     /** System we belong to */
     System* system;
 
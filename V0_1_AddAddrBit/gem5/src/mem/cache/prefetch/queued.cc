@@ -113,7 +113,7 @@ QueuedPrefetcher::notify(/* MJL_Comment const */ PacketPtr &pkt)
             // Block align prefetch address
             /* MJL_Begin */
             if (MJL_colPf && pkt->MJL_cmdIsColumn()) {
-                pf_info.first &= ~(Addr)(pkt->MJL_blkMaskColumn(blkSize, pkt->req->MJL_rowWidth));
+                pf_info.first &= ~(Addr)(MJL_geometry->MJL_blkMaskColumn);
             } else {
                 pf_info.first &= ~(Addr)(blkSize - 1);
             }
@@ -138,7 +138,7 @@ QueuedPrefetcher::notify(/* MJL_Comment const */ PacketPtr &pkt)
                 // } else {
                     pf_pkt = MJL_insert(pf_info, MJL_cmdDir, is_secure);
                 // }
-            } else if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+            } else if (cache->MJL_isDataCache()) {
                 pf_pkt = MJL_insert(pf_info, MemCmd::MJL_DirAttribute::MJL_IsRow, is_secure);
             } else {
                 pf_pkt = insert(pf_info, is_secure);
@@ -300,8 +300,7 @@ QueuedPrefetcher::insert(AddrPriority &pf_info, bool is_secure)
     Request *pf_req =
         new Request(pf_info.first, blkSize, 0, masterId);
     /* MJL_Begin */
-    pf_req->MJL_cachelineSize = blkSize;
-    pf_req->MJL_rowWidth = cache->MJL_getRowWidth();
+    pf_req->MJL_geometry = MJL_geometry;
     /* MJL_End */
 
     if (is_secure) {
@@ -412,8 +411,7 @@ QueuedPrefetcher::MJL_insert(AddrPriority &pf_info, MemCmd::MJL_DirAttribute MJL
     Request *pf_req =
         new Request(pf_info.first, blkSize, 0, masterId);
     /* MJL_Begin */
-    pf_req->MJL_cachelineSize = blkSize;
-    pf_req->MJL_rowWidth = cache->MJL_getRowWidth();
+    pf_req->MJL_geometry = MJL_geometry;
     pf_req->MJL_setReqDir(MJL_cmdDir);
     /* MJL_End */
 
@@ -50,6 +50,11 @@
 #define __MEM_CACHE_QUEUE_HH__
 
 #include <cassert>
+/* MJL_Begin */
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+/* MJL_End */
 
 #include "base/trace.hh"
 #include "debug/Drain.hh"
@@ -114,6 +119,52 @@ class Queue : public Drainable
     /** The number of currently allocated entries. */
     int allocated;
 
+    /* MJL_Begin */
+    /**
+     * Bits of a block address that name its tile. Entries are indexed by
+     * tile, so the crossing searches only look at the entries of one
+     * tile. While it is 0 every entry is in the same bucket.
+     */
+    Addr MJL_tileMask;
+    /** Allocated entries of each tile, in allocation order */
+    std::unordered_map<Addr, std::vector<Entry*>> MJL_tileEntries;
+
+    /** @return The allocated entries of the tile, nullptr if none */
+    const std::vector<Entry*>* MJL_getTileEntries(Addr blk_addr) const
+    {
+        auto it = MJL_tileEntries.find(blk_addr & MJL_tileMask);
+        return it == MJL_tileEntries.end() ? nullptr : &it->second;
+    }
+
+    /** Add a newly allocated entry to the tile index */
+    void MJL_indexEntry(Entry* entry)
+    {
+        MJL_tileEntries[entry->blkAddr & MJL_tileMask].push_back(entry);
+    }
+
+    /** Remove an entry from the tile index, before it is deallocated */
+    void MJL_unindexEntry(Entry* entry)
+    {
+        auto it = MJL_tileEntries.find(entry->blkAddr & MJL_tileMask);
+        assert(it != MJL_tileEntries.end());
+        std::vector<Entry*>& tile_entries = it->second;
+        auto pos = std::find(tile_entries.begin(), tile_entries.end(), entry);
+        assert(pos != tile_entries.end());
+        tile_entries.erase(pos);
+        if (tile_entries.empty()) {
+            MJL_tileEntries.erase(it);
+        }
+    }
+
+    static QueueEntry::MJL_QEntryDir MJL_crossDir(QueueEntry::MJL_QEntryDir MJL_queue_entry_dir)
+    {
+        assert(MJL_queue_entry_dir == QueueEntry::MJL_QEntryDir::MJL_IsRow || MJL_queue_entry_dir == QueueEntry::MJL_QEntryDir::MJL_IsColumn);
+        return MJL_queue_entry_dir == QueueEntry::MJL_QEntryDir::MJL_IsRow ?
+               QueueEntry::MJL_QEntryDir::MJL_IsColumn :
+               QueueEntry::MJL_QEntryDir::MJL_IsRow;
+    }
+    /* MJL_End */
+
   public:
 
     /**
@@ -125,7 +176,7 @@ class Queue : public Drainable
     Queue(const std::string &_label, int num_entries, int reserve) :
         label(_label), numEntries(num_entries + reserve),
         numReserve(reserve), entries(numEntries), _numInService(0),
-        allocated(0)
+        allocated(0)/* MJL_Begin */, MJL_tileMask(0)/* MJL_End */
     {
         for (int i = 0; i < numEntries; ++i) {
             freeList.push_back(&entries[i]);
@@ -147,6 +198,18 @@ class Queue : public Drainable
         return _numInService;
     }
 
+    /* MJL_Begin */
+    /**
+     * Set the tile of a block address for the index. The tilemask of
+     * later crossing searches has to keep at least these bits.
+     */
+    void MJL_setTileMask(Addr tile_mask)
+    {
+        assert(allocated == 0);
+        MJL_tileMask = tile_mask;
+    }
+    /* MJL_End */
+
     /**
      * Find the first WriteQueueEntry that matches the provided address.
      * @param blk_addr The block address to find.
@@ -173,7 +236,11 @@ class Queue : public Drainable
     /* MJL_Begin */
     Entry* MJL_findMatch(Addr blk_addr, QueueEntry::MJL_QEntryDir MJL_queue_entry_dir, bool is_secure) const
     {
-        for (const auto& entry : allocatedList) {
+        const std::vector<Entry*>* tile_entries = MJL_getTileEntries(blk_addr);
+        if (!tile_entries) {
+            return nullptr;
+        }
+        for (const auto& entry : *tile_entries) {
             // we ignore any entries allocated for uncacheable
             // accesses and simply ignore them when matching, in the
             // cache we never check for matches when adding new
@@ -205,8 +272,12 @@ class Queue : public Drainable
     /* MJL_Begin */
     bool MJL_checkFunctional(PacketPtr pkt, Addr blk_addr, QueueEntry::MJL_QEntryDir MJL_queue_entry_dir)
     {
+        const std::vector<Entry*>* tile_entries = MJL_getTileEntries(blk_addr);
+        if (!tile_entries) {
+            return false;
+        }
         pkt->pushLabel(label);
-        for (const auto& entry : allocatedList) {
+        for (const auto& entry : *tile_entries) {
             if (entry->blkAddr == blk_addr && entry->MJL_qEntryDir == MJL_queue_entry_dir && entry->MJL_checkFunctional(pkt)) {
                 pkt->popLabel();
                 return true;
@@ -236,6 +307,22 @@ class Queue : public Drainable
     /* MJL_Begin */
     Entry* MJL_findPending(Addr blk_addr, QueueEntry::MJL_QEntryDir MJL_queue_entry_dir, bool is_secure) const
     {
+        // Entries not in service are exactly the ones on the readyList,
+        // so the readyList order only matters with several candidates
+        const std::vector<Entry*>* tile_entries = MJL_getTileEntries(blk_addr);
+        Entry* candidate = nullptr;
+        int num_candidates = 0;
+        if (tile_entries) {
+            for (const auto& entry : *tile_entries) {
+                if (!entry->inService && entry->blkAddr == blk_addr && entry->isSecure == is_secure && entry->MJL_qEntryDir == MJL_queue_entry_dir) {
+                    candidate = entry;
+                    ++num_candidates;
+                }
+            }
+        }
+        if (num_candidates <= 1) {
+            return candidate;
+        }
         for (const auto& entry : readyList) {
             if (entry->blkAddr == blk_addr && entry->isSecure == is_secure && entry->MJL_qEntryDir == MJL_queue_entry_dir) {
                 return entry;
@@ -246,6 +333,21 @@ class Queue : public Drainable
 
     Entry* MJL_findPendingTile(Addr blk_addr, bool is_secure, Addr tilemask) const
     {
+        assert(!(MJL_tileMask & ~tilemask));
+        const std::vector<Entry*>* tile_entries = MJL_getTileEntries(blk_addr);
+        Entry* candidate = nullptr;
+        int num_candidates = 0;
+        if (tile_entries) {
+            for (const auto& entry : *tile_entries) {
+                if (!entry->inService && (entry->blkAddr & tilemask) == (blk_addr & tilemask) && entry->isSecure == is_secure) {
+                    candidate = entry;
+                    ++num_candidates;
+                }
+            }
+        }
+        if (num_candidates <= 1) {
+            return candidate;
+        }
         for (const auto& entry : readyList) {
             if ((entry->blkAddr & tilemask) == (blk_addr & tilemask) && entry->isSecure == is_secure) {
                 return entry;
@@ -257,15 +359,13 @@ class Queue : public Drainable
     Entry* MJL_findMatchCrossing(Addr blk_addr, QueueEntry::MJL_QEntryDir MJL_queue_entry_dir, bool is_secure, Addr tilemask) const
     {
         Entry* matchCrossing_entry = nullptr;
-        QueueEntry::MJL_QEntryDir MJL_cross_queue_entry_dir = MJL_queue_entry_dir;
-        if (MJL_queue_entry_dir == QueueEntry::MJL_QEntryDir::MJL_IsRow) {
-            MJL_cross_queue_entry_dir = QueueEntry::MJL_QEntryDir::MJL_IsColumn;
-        } else if (MJL_queue_entry_dir == QueueEntry::MJL_QEntryDir::MJL_IsColumn) {
-            MJL_cross_queue_entry_dir = QueueEntry::MJL_QEntryDir::MJL_IsRow;
-        } else {
-            assert(MJL_queue_entry_dir == QueueEntry::MJL_QEntryDir::MJL_IsRow || MJL_queue_entry_dir == QueueEntry::MJL_QEntryDir::MJL_IsColumn);
+        QueueEntry::MJL_QEntryDir MJL_cross_queue_entry_dir = MJL_crossDir(MJL_queue_entry_dir);
+        assert(!(MJL_tileMask & ~tilemask));
+        const std::vector<Entry*>* tile_entries = MJL_getTileEntries(blk_addr);
+        if (!tile_entries) {
+            return nullptr;
         }
-        for (const auto& entry : allocatedList) {
+        for (const auto& entry : *tile_entries) {
             if (!entry->isUncacheable() && (entry->blkAddr & tilemask) == (blk_addr & tilemask) && entry->isSecure == is_secure && entry->MJL_qEntryDir == MJL_cross_queue_entry_dir) {
                 matchCrossing_entry = entry;
             }
@@ -275,21 +375,38 @@ class Queue : public Drainable
 
     bool MJL_hasCrossing(Addr blk_addr, QueueEntry::MJL_QEntryDir MJL_queue_entry_dir, bool is_secure, Addr tilemask) const
     {
-        QueueEntry::MJL_QEntryDir MJL_cross_queue_entry_dir = MJL_queue_entry_dir;
-        if (MJL_queue_entry_dir == QueueEntry::MJL_QEntryDir::MJL_IsRow) {
-            MJL_cross_queue_entry_dir = QueueEntry::MJL_QEntryDir::MJL_IsColumn;
-        } else if (MJL_queue_entry_dir == QueueEntry::MJL_QEntryDir::MJL_IsColumn) {
-            MJL_cross_queue_entry_dir = QueueEntry::MJL_QEntryDir::MJL_IsRow;
-        } else {
-            assert(MJL_queue_entry_dir == QueueEntry::MJL_QEntryDir::MJL_IsRow || MJL_queue_entry_dir == QueueEntry::MJL_QEntryDir::MJL_IsColumn);
+        QueueEntry::MJL_QEntryDir MJL_cross_queue_entry_dir = MJL_crossDir(MJL_queue_entry_dir);
+        assert(!(MJL_tileMask & ~tilemask));
+        const std::vector<Entry*>* tile_entries = MJL_getTileEntries(blk_addr);
+        if (!tile_entries) {
+            return false;
         }
-        for (const auto& entry : allocatedList) {
+        for (const auto& entry : *tile_entries) {
             if ((entry->blkAddr & tilemask) == (blk_addr & tilemask) && entry->isSecure == is_secure && entry->MJL_qEntryDir == MJL_cross_queue_entry_dir) {
                 return true;
             }
         }
         return false;
     }
+
+    /**
+     * Collect the entries that can go with entry in one tile packet: the
+     * other entries of its tile and direction that are ready and not in
+     * service.
+     */
+    void MJL_getTileMates(const Entry* entry, Addr tilemask, std::vector<Entry*> &mates) const
+    {
+        assert(!(MJL_tileMask & ~tilemask));
+        const std::vector<Entry*>* tile_entries = MJL_getTileEntries(entry->blkAddr);
+        if (!tile_entries) {
+            return;
+        }
+        for (const auto& other : *tile_entries) {
+            if (other != entry && !other->inService && other->readyTime <= curTick() && !other->isUncacheable() && (other->blkAddr & tilemask) == (entry->blkAddr & tilemask) && other->isSecure == entry->isSecure && other->MJL_qEntryDir == entry->MJL_qEntryDir) {
+                mates.push_back(other);
+            }
+        }
+    }
     /* MJL_End */
 
     /**
@@ -317,6 +434,9 @@ class Queue : public Drainable
      */
     void deallocate(Entry *entry)
     {
+        /* MJL_Begin */
+        MJL_unindexEntry(entry);
+        /* MJL_End */
         allocatedList.erase(entry->allocIter);
         freeList.push_front(entry);
         allocated--;
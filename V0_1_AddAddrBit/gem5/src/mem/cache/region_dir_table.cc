@@ -0,0 +1,171 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Definition of the region to direction preference table.
+ */
+
+#include "mem/cache/region_dir_table.hh"
+
+#include <algorithm>
+
+#include "base/misc.hh"
+#include "cpu/thread_context.hh"
+#include "sim/process.hh"
+#include "sim/system.hh"
+
+std::vector<MJL_RegionDirTable *> MJL_RegionDirTable::MJL_tables;
+
+MJL_RegionDirTable::MJL_RegionDirTable(const Params *p)
+    : SimObject(p), system(p->system)
+{
+    fatal_if(MJL_find(system), "%s: %s already has a region table\n",
+             name(), MJL_find(system)->name());
+    MJL_tables.push_back(this);
+}
+
+MJL_RegionDirTable::~MJL_RegionDirTable()
+{
+    MJL_tables.erase(std::find(MJL_tables.begin(), MJL_tables.end(), this));
+}
+
+void
+MJL_RegionDirTable::regStats()
+{
+    SimObject::regStats();
+
+    numSetRegions
+        .name(name() + ".numSetRegions")
+        .desc("number of regions registered with a direction")
+        ;
+
+    numClearRegions
+        .name(name() + ".numClearRegions")
+        .desc("number of ranges whose direction was dropped")
+        ;
+
+    numRegionHits
+        .name(name() + ".numRegionHits")
+        .desc("number of accesses directed by a region")
+        ;
+}
+
+MJL_RegionDirTable*
+MJL_RegionDirTable::MJL_find(const System *system)
+{
+    for (MJL_RegionDirTable *table : MJL_tables) {
+        if (table->system == system) {
+            return table;
+        }
+    }
+    return nullptr;
+}
+
+uint64_t
+MJL_RegionDirTable::MJL_owner(ThreadContext *tc)
+{
+    Process *process = tc->getProcessPtr();
+    return process ? process->pid() : tc->contextId();
+}
+
+MemCmd::MJL_DirAttribute
+MJL_RegionDirTable::MJL_lookup(ContextID cid, Addr vaddr)
+{
+    auto owner = regions.find(MJL_owner(system->getThreadContext(cid)));
+    if (owner == regions.end()) {
+        return MemCmd::MJL_DirAttribute::MJL_IsInvalid;
+    }
+    auto it = owner->second.find(vaddr);
+    if (it == owner->second.end()) {
+        return MemCmd::MJL_DirAttribute::MJL_IsInvalid;
+    }
+    numRegionHits++;
+    return it->second;
+}
+
+void
+MJL_RegionDirTable::MJL_setRegion(ThreadContext *tc, Addr addr, Addr len,
+                                  MemCmd::MJL_DirAttribute dir)
+{
+    if (len == 0) {
+        return;
+    }
+    if (dir != MemCmd::MJL_DirAttribute::MJL_IsRow &&
+        dir != MemCmd::MJL_DirAttribute::MJL_IsColumn) {
+        warn("%s: region %#x+%#x has no direction (%d), ignored\n", name(),
+             addr, len, (int)dir);
+        return;
+    }
+    // Clamp a range running past the end of the address space
+    AddrRange range(addr, addr + std::min(len - 1, MaxAddr - addr));
+    AddrRangeMap<MemCmd::MJL_DirAttribute> &owned = regions[MJL_owner(tc)];
+    owned.MJL_cut(range);
+    owned.insert(range, dir);
+    numSetRegions++;
+}
+
+void
+MJL_RegionDirTable::MJL_clearRegion(ThreadContext *tc, Addr addr, Addr len)
+{
+    auto owner = regions.find(MJL_owner(tc));
+    if (len == 0 || owner == regions.end()) {
+        return;
+    }
+    owner->second.MJL_cut(AddrRange(addr,
+                                    addr + std::min(len - 1, MaxAddr - addr)));
+    if (owner->second.empty()) {
+        regions.erase(owner);
+    }
+    numClearRegions++;
+}
+
+void
+MJL_RegionDirTable::serialize(CheckpointOut &cp) const
+{
+    std::vector<uint64_t> owners;
+    std::vector<Addr> starts;
+    std::vector<Addr> ends;
+    std::vector<int> dirs;
+    for (const auto &owner : regions) {
+        for (const auto &region : owner.second) {
+            owners.push_back(owner.first);
+            starts.push_back(region.first.start());
+            ends.push_back(region.first.end());
+            dirs.push_back((int)region.second);
+        }
+    }
+    SERIALIZE_CONTAINER(owners);
+    SERIALIZE_CONTAINER(starts);
+    SERIALIZE_CONTAINER(ends);
+    SERIALIZE_CONTAINER(dirs);
+}
+
+void
+MJL_RegionDirTable::unserialize(CheckpointIn &cp)
+{
+    std::vector<uint64_t> owners;
+    std::vector<Addr> starts;
+    std::vector<Addr> ends;
+    std::vector<int> dirs;
+    UNSERIALIZE_CONTAINER(owners);
+    UNSERIALIZE_CONTAINER(starts);
+    UNSERIALIZE_CONTAINER(ends);
+    UNSERIALIZE_CONTAINER(dirs);
+    fatal_if(starts.size() != owners.size() || ends.size() != owners.size() ||
+             dirs.size() != owners.size(),
+             "%s: inconsistent regions in the checkpoint\n", name());
+
+    regions.clear();
+    for (int i = 0; i < owners.size(); ++i) {
+        regions[owners[i]].insert(AddrRange(starts[i], ends[i]),
+                                  (MemCmd::MJL_DirAttribute)dirs[i]);
+    }
+}
+
+MJL_RegionDirTable*
+MJL_RegionDirTableParams::create()
+{
+    return new MJL_RegionDirTable(this);
+}
+
+/* MJL_End */
@@ -0,0 +1,98 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Declaration of the region to direction preference table. The workload
+ * registers virtual address ranges with a preferred direction through the
+ * m5_mjl_region_dir pseudo-op, e.g. for a column-major matrix, and the L1
+ * data caches look the virtual address of every request up in it. Unlike
+ * the PC to direction table it needs no profiling of the binary.
+ */
+
+#ifndef __MEM_CACHE_REGION_DIR_TABLE_HH__
+#define __MEM_CACHE_REGION_DIR_TABLE_HH__
+
+#include <map>
+#include <vector>
+
+#include "base/addr_range_map.hh"
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/packet.hh"
+#include "params/MJL_RegionDirTable.hh"
+#include "sim/sim_object.hh"
+
+class System;
+class ThreadContext;
+
+/**
+ * System-wide SimObject holding the regions of the workload, referenced by
+ * the MJL_regionDirTable parameter of the L1 data caches. The regions of
+ * each process are kept apart, as the processes of a multi-programmed run
+ * use the same virtual addresses.
+ */
+class MJL_RegionDirTable : public SimObject
+{
+  public:
+    typedef MJL_RegionDirTableParams Params;
+    MJL_RegionDirTable(const Params *p);
+    ~MJL_RegionDirTable();
+
+    void regStats() override;
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
+    /**
+     * Prefer dir for [addr, addr + len) of the process running on tc. The
+     * parts of its older regions it overlaps are dropped, so a reused
+     * allocation takes the latest hint.
+     */
+    void MJL_setRegion(ThreadContext *tc, Addr addr, Addr len,
+                       MemCmd::MJL_DirAttribute dir);
+
+    /** Drop the preference of [addr, addr + len) of the process of tc */
+    void MJL_clearRegion(ThreadContext *tc, Addr addr, Addr len);
+
+    /**
+     * Preferred direction of the virtual address of req, MJL_IsInvalid if
+     * it is in no region of the process that made req
+     */
+    MemCmd::MJL_DirAttribute MJL_lookup(const RequestPtr &req)
+    {
+        if (regions.empty() || !req->hasVaddr() || !req->hasContextId()) {
+            return MemCmd::MJL_DirAttribute::MJL_IsInvalid;
+        }
+        return MJL_lookup(req->contextId(), req->getVaddr());
+    }
+
+    /** The table of system, nullptr if it has none */
+    static MJL_RegionDirTable *MJL_find(const System *system);
+
+  private:
+    /** Direction of vaddr in the regions of the process on context cid */
+    MemCmd::MJL_DirAttribute MJL_lookup(ContextID cid, Addr vaddr);
+
+    /**
+     * The process a region belongs to: its pid, or in full system, where
+     * the processes are not known, the hardware context
+     */
+    static uint64_t MJL_owner(ThreadContext *tc);
+
+    /** The system the workload registering the regions runs in */
+    System *system;
+
+    /** The regions of each owner, owners without one are removed */
+    std::map<uint64_t, AddrRangeMap<MemCmd::MJL_DirAttribute>> regions;
+
+    /** Every table, to find the one of a system from a pseudo-op */
+    static std::vector<MJL_RegionDirTable *> MJL_tables;
+
+    Stats::Scalar numSetRegions;
+    Stats::Scalar numClearRegions;
+    Stats::Scalar numRegionHits;
+};
+
+#endif // __MEM_CACHE_REGION_DIR_TABLE_HH__
+
+/* MJL_End */
@@ -56,22 +56,18 @@ using namespace std;
 
 BaseTags::BaseTags(const Params *p)
     : ClockedObject(p), blkSize(p->block_size)/* MJL_Begin */, 
-      MJL_rowWidth(p->MJL_rowWidth), MJL_timeStep(p->MJL_timeStep), 
-      MJL_timeStepScheduled(false), MJL_sameSetMapping(p->MJL_sameSetMapping), MJL_oracleProxy(false)/* MJL_End */, size(p->size),
+      MJL_rowWidth(p->MJL_rowWidth), MJL_sameSetMapping(p->MJL_sameSetMapping), MJL_oracleProxy(false)/* MJL_End */, size(p->size),
       lookupLatency(p->tag_latency),
       accessLatency(p->sequential_access ?
                     p->tag_latency + p->data_latency :
                     std::max(p->tag_latency, p->data_latency)),
       cache(nullptr), warmupBound(0),
-      warmedUp(false), numBlocks(0)/* MJL_Begin */, MJL_tagsInUse(0), MJL_printUtilizationEvent(this)/* MJL_End */
+      warmedUp(false), numBlocks(0)/* MJL_Begin */, MJL_tagsInUse(0)/* MJL_End */
 {
     /* MJL_Begin */
     /* MJL_Test */ // Test to see if the parameter of MJL_rowWidth has been passed in correctly
     std::cout << this->name() << "::MJL_rowWidth = " << MJL_rowWidth << "\n";
     /* */
-    /* MJL_Test */ // Test to see if the parameter of MJL_timeStep has been passed in correctly
-    std::cout << this->name() << "::MJL_timeStep = " << MJL_timeStep << std::endl;
-    /* */
     /* MJL_Test */ // Test to see if the parameter of MJL_sameSetMapping has been passed in correctly
     std::cout << this->name() << "::MJL_sameSetMapping = " << MJL_sameSetMapping << std::endl;
     /* */
@@ -143,7 +139,32 @@ BaseTags::regStats()
         .desc("Number of duplicate words in the cache")
         ;
     
-    MJL_DuplicatePercentage = MJL_Duplicates/(8 * (MJL_rowInUse + MJL_colInUse));
+    MJL_DuplicatePercentage
+        .name(name() + ".MJL_DuplicatePercentage")
+        .desc("Fraction of the words in valid cache blocks that are duplicates")
+        .flags(nozero | nonan)
+        ;
+    MJL_DuplicatePercentage = MJL_Duplicates/(constant(blkSize/sizeof(uint64_t)) * (MJL_rowInUse + MJL_colInUse));
+
+    MJL_tilesInUse
+        .name(name() + ".MJL_tilesInUse")
+        .desc("Number of tiles with a valid cache block")
+        .flags(nozero)
+        ;
+
+    MJL_duplicatesPerTile
+        .name(name() + ".MJL_duplicatesPerTile")
+        .desc("Average number of duplicate words per tile in use")
+        .flags(nozero | nonan)
+        ;
+    MJL_duplicatesPerTile = MJL_Duplicates / MJL_tilesInUse;
+
+    MJL_tileDuplicates
+        .init(0, (blkSize/sizeof(uint64_t)) * (blkSize/sizeof(uint64_t)), blkSize/sizeof(uint64_t))
+        .name(name() + ".MJL_tileDuplicates")
+        .desc("Duplicate words in the tile of each filled block")
+        .flags(nozero | nonan)
+        ;
     /* MJL_End */
 
     totalRefs
@@ -70,8 +70,6 @@ class BaseTags : public ClockedObject
     /* MJL_Begin */
     /** The size of a row in the memory system (how many cachelines) */
     const unsigned MJL_rowWidth;
-    const Cycles MJL_timeStep;
-    bool MJL_timeStepScheduled;
     const bool MJL_sameSetMapping;
     const bool MJL_oracleProxy;
     /* MJL_End */
@@ -118,6 +116,11 @@ class BaseTags : public ClockedObject
     Stats::Formula MJL_utilization;
     Stats::Scalar MJL_Duplicates;
     Stats::Formula MJL_DuplicatePercentage;
+    /** Number of tiles with a block in the cache */
+    Stats::Scalar MJL_tilesInUse;
+    Stats::Formula MJL_duplicatesPerTile;
+    /** Duplicate words in the tile of each filled block */
+    Stats::Distribution MJL_tileDuplicates;
     /* MJL_End */
 
     /** The total number of references to a block before it is replaced. */
@@ -210,6 +213,14 @@ class BaseTags : public ClockedObject
     virtual bool MJL_hasCrossingDirtyOrWritable(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, bool is_secure) const = 0;
     virtual bool MJL_hasCrossingDirty(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, bool is_secure) const = 0;
     virtual bool MJL_hasCrossingWritableRevoked(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, bool is_secure) = 0;
+    /**
+     * Find the valid blocks of the other direction crossing a block
+     * @param addr An address in the block
+     * @param MJL_cacheBlkDir The direction of the block
+     * @param MJL_crossBlks If not null, gets the crossing block of word i at index i
+     * @return Bit i set if the block crossing word i is in the cache
+     */
+    virtual unsigned MJL_findCrossBlocks(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, bool is_secure, CacheBlk **MJL_crossBlks) const = 0;
     /* MJL_End */
 
     /**
@@ -316,46 +327,6 @@ class BaseTags : public ClockedObject
     virtual Addr MJL_movColRight(Addr addr) const = 0;
     virtual Addr MJL_movColLeft(Addr addr) const = 0;
 
-    uint64_t MJL_tempUtilizationRow;
-    uint64_t MJL_tempUtilizationColumn;
-
-    class MJL_UtilizationVisitor : public CacheBlkVisitor
-    {
-      public:
-        MJL_UtilizationVisitor(BaseTags* tags): _tags(tags) {}
-
-        bool operator()(CacheBlk &blk) override {
-            if (blk.isValid()) {
-                if (blk.MJL_isRow()) {
-                    _tags->MJL_tempUtilizationRow++;
-                } else {
-                    _tags->MJL_tempUtilizationColumn++;
-                }
-            }
-            return true;
-        }
-      private:
-        BaseTags* _tags;
-    };
-
-    void MJL_printUtilization() {
-        /* MJL_Test: see if utilization calculation is correct
-        MJL_tempUtilizationRow = 0;
-        MJL_tempUtilizationColumn = 0;
-        MJL_UtilizationVisitor MJL_utilizationVisitor(this);
-        forEachBlk(MJL_utilizationVisitor);
-        std::cout << this->name() << "::MJL_Test: Utilization(Row) foreach[" << MJL_tempUtilizationRow << "]/inuse[" << MJL_rowInUse.value() << "], Utilization(Col) foreach[" << MJL_tempUtilizationColumn << "]/inuse[" << MJL_colInUse.value() << "]" << std::endl;
-        assert(MJL_tempUtilizationRow == MJL_rowInUse.value());
-        assert(MJL_tempUtilizationColumn == MJL_colInUse.value());
-         */
-        std::cout << this->name() << "::MJL_intermOutput: Cycle[" << ticksToCycles(curTick()) << "], ";
-        std::cout << "Utilization(Row) " << (MJL_rowInUse.value() / float(numBlocks)) << "[" << MJL_rowInUse.value() << "/" << numBlocks << "], ";
-        std::cout << "Utilization(Col) " << (MJL_colInUse.value() / float(numBlocks)) << "[" << MJL_colInUse.value() << "/" << numBlocks << "], ";
-        std::cout << "Utilization(All) " << ((MJL_rowInUse.value() + MJL_colInUse.value()) / float(numBlocks)) << "[" << MJL_rowInUse.value() + MJL_colInUse.value() << "/" << numBlocks << "], ";
-        std::cout << "Duplicate " << (MJL_Duplicates.value()/8/(MJL_rowInUse.value() + MJL_colInUse.value())) << "[" << MJL_Duplicates.value() << "/" << 8*(MJL_rowInUse.value() + MJL_colInUse.value()) << "]" << std::endl;
-        schedule(MJL_printUtilizationEvent, curTick() + cyclesToTicks(MJL_timeStep));
-    }
-    EventWrapper<BaseTags, &BaseTags::MJL_printUtilization> MJL_printUtilizationEvent;
     /* MJL_End */
     
     virtual void forEachBlk(CacheBlkVisitor &visitor) = 0;
@@ -94,6 +94,10 @@ BaseSetAssoc::BaseSetAssoc(const Params *p)
 
     sets = new SetType[numSets];
     blks = new BlkType[numSets * assoc];
+    /* MJL_Begin */
+    MJL_tagKeys = new uint64_t[numSets * assoc];
+    MJL_tileDir.MJL_reserve(numSets * assoc);
+    /* MJL_End */
     // allocate data storage in one big chunk
     numBlocks = numSets * assoc;
     dataBlks = new uint8_t[numBlocks * blkSize];
@@ -134,6 +138,10 @@ BaseSetAssoc::BaseSetAssoc(const Params *p)
             blk->set = i;
             blk->way = j;
         }
+        /* MJL_Begin */
+        sets[i].MJL_keys = &MJL_tagKeys[i * assoc];
+        sets[i].MJL_syncKeys();
+        /* MJL_End */
     }
 }
 
@@ -142,6 +150,9 @@ BaseSetAssoc::~BaseSetAssoc()
     delete [] dataBlks;
     delete [] blks;
     delete [] sets;
+    /* MJL_Begin */
+    delete [] MJL_tagKeys;
+    /* MJL_End */
 }
 
 CacheBlk*
@@ -156,7 +167,7 @@ BaseSetAssoc::findBlock(Addr addr, bool is_secure) const
 CacheBlk* 
 BaseSetAssoc::MJL_findBlock(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, bool is_secure) const
 {
-    if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+    if (cache->MJL_isDataCache()) {
         Addr tag = MJL_extractTag(addr, MJL_cacheBlkDir);
         unsigned set = MJL_extractSet(addr, MJL_cacheBlkDir);
         BlkType *blk = sets[set].MJL_findBlk(tag, MJL_cacheBlkDir, is_secure);
@@ -175,136 +186,120 @@ BaseSetAssoc::MJL_findCrossBlock(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheB
     return blk;
 }
 
-bool 
-BaseSetAssoc::MJL_hasCrossing(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, bool is_secure) const
+unsigned
+BaseSetAssoc::MJL_findCrossBlocks(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, bool is_secure, CacheBlk **MJL_crossBlks) const
 {
-    assert(this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos);
-    uint64_t MJL_wordMask = blkSize/sizeof(uint64_t) - 1;
-    int MJL_colShift = floorLog2(MJL_rowWidth) + floorLog2(blkSize);
-    Addr tileMask = ~((Addr)(blkSize-1) | (MJL_wordMask << MJL_colShift));
-    Addr blkaddr = addr;
-    for (unsigned offset = 0; offset < blkSize/sizeof(uint64_t); ++offset) {
-        if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow) {
-            blkaddr = (addr & tileMask) | ((Addr)offset*sizeof(uint64_t)) ;
-            Addr tag = MJL_extractTag(blkaddr, CacheBlk::MJL_CacheBlkDir::MJL_IsColumn);
-            unsigned set = MJL_extractSet(blkaddr, CacheBlk::MJL_CacheBlkDir::MJL_IsColumn);
-            BlkType *blk = sets[set].MJL_findBlk(tag, CacheBlk::MJL_CacheBlkDir::MJL_IsColumn, is_secure);
-            if (blk) {
-                return true;
+    assert(MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow || MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn);
+    if (!cache->MJL_isDataCache()) {
+        return 0;
+    }
+    unsigned crossMask = 0;
+    if (cache->MJL_is2DCache()) {
+        // The directory only has the tiles here, look the blocks up one by one
+        Addr tileAddr = addr & ~((Addr)blkMask | (MJL_wordMask << MJL_colShift));
+        for (unsigned offset = 0; offset < blkSize/sizeof(uint64_t); ++offset) {
+            BlkType *blk = nullptr;
+            if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow) {
+                blk = MJL_findBlock(tileAddr | ((Addr)offset*sizeof(uint64_t)), CacheBlk::MJL_CacheBlkDir::MJL_IsColumn, is_secure);
+            } else {
+                blk = MJL_findBlock(tileAddr | ((Addr)offset << MJL_colShift), CacheBlk::MJL_CacheBlkDir::MJL_IsRow, is_secure);
             }
-        } else if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn) {
-            blkaddr = (addr & tileMask) | ((Addr)offset << MJL_colShift);
-            Addr tag = MJL_extractTag(blkaddr, CacheBlk::MJL_CacheBlkDir::MJL_IsRow);
-            unsigned set = MJL_extractSet(blkaddr, CacheBlk::MJL_CacheBlkDir::MJL_IsRow);
-            BlkType *blk = sets[set].MJL_findBlk(tag, CacheBlk::MJL_CacheBlkDir::MJL_IsRow, is_secure);
             if (blk) {
-                return true;
+                crossMask |= 1 << offset;
+                if (MJL_crossBlks) {
+                    MJL_crossBlks[offset] = blk;
+                }
             }
-        } else {
-            assert(MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow || MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn);
         }
-    } 
-    return false;
+        return crossMask;
+    }
+    const MJL_TileDirectory::MJL_Tile *tile = MJL_tileDir.MJL_find(MJL_tileKey(addr, is_secure));
+    if (!tile) {
+        return 0;
+    }
+    unsigned mask = tile->rowMask;
+    CacheBlk * const *blks = tile->rows;
+    if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow) {
+        mask = tile->colMask;
+        blks = tile->cols;
+    }
+    while (mask) {
+        int i = __builtin_ctz(mask);
+        mask &= mask - 1;
+        if (blks[i]->isValid() && blks[i]->isSecure() == is_secure) {
+            crossMask |= 1 << i;
+            if (MJL_crossBlks) {
+                MJL_crossBlks[i] = blks[i];
+            }
+        }
+    }
+    /* MJL_Test: directory consistency
+    for (unsigned offset = 0; offset < blkSize/sizeof(uint64_t); ++offset) {
+        Addr tileAddr = addr & ~((Addr)blkMask | (MJL_wordMask << MJL_colShift));
+        BlkType *blk = (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow) ?
+            MJL_findBlock(tileAddr | ((Addr)offset*sizeof(uint64_t)), CacheBlk::MJL_CacheBlkDir::MJL_IsColumn, is_secure) :
+            MJL_findBlock(tileAddr | ((Addr)offset << MJL_colShift), CacheBlk::MJL_CacheBlkDir::MJL_IsRow, is_secure);
+        assert((blk != nullptr) == (bool)(crossMask & (1 << offset)));
+    }
+     */
+    return crossMask;
+}
+
+bool 
+BaseSetAssoc::MJL_hasCrossing(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, bool is_secure) const
+{
+    assert(cache->MJL_isDataCache());
+    return MJL_findCrossBlocks(addr, MJL_cacheBlkDir, is_secure, nullptr) != 0;
 }
 
 bool 
 BaseSetAssoc::MJL_hasCrossingDirtyOrWritable(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, bool is_secure) const
 {
-    assert(this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos);
-    uint64_t MJL_wordMask = blkSize/sizeof(uint64_t) - 1;
-    int MJL_colShift = floorLog2(MJL_rowWidth) + floorLog2(blkSize);
-    Addr tileMask = ~((Addr)(blkSize-1) | (MJL_wordMask << MJL_colShift));
-    Addr blkaddr = addr;
-    for (unsigned offset = 0; offset < blkSize/sizeof(uint64_t); ++offset) {
-        if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow) {
-            blkaddr = (addr & tileMask) | ((Addr)offset*sizeof(uint64_t)) ;
-            Addr tag = MJL_extractTag(blkaddr, CacheBlk::MJL_CacheBlkDir::MJL_IsColumn);
-            unsigned set = MJL_extractSet(blkaddr, CacheBlk::MJL_CacheBlkDir::MJL_IsColumn);
-            BlkType *blk = sets[set].MJL_findBlk(tag, CacheBlk::MJL_CacheBlkDir::MJL_IsColumn, is_secure);
-            if (blk && (blk->isDirty() || blk->MJL_wasDirty || blk->isWritable() || !blk->isReadable())) {
-                return true;
-            }
-        } else if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn) {
-            blkaddr = (addr & tileMask) | ((Addr)offset << MJL_colShift);
-            Addr tag = MJL_extractTag(blkaddr, CacheBlk::MJL_CacheBlkDir::MJL_IsRow);
-            unsigned set = MJL_extractSet(blkaddr, CacheBlk::MJL_CacheBlkDir::MJL_IsRow);
-            BlkType *blk = sets[set].MJL_findBlk(tag, CacheBlk::MJL_CacheBlkDir::MJL_IsRow, is_secure);
-            if (blk && (blk->isDirty() || blk->MJL_wasDirty || blk->isWritable() || !blk->isReadable())) {
-                return true;
-            }
-        } else {
-            assert(MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow || MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn);
+    assert(cache->MJL_isDataCache());
+    CacheBlk *crossBlks[MJL_TileDirectory::MJL_maxWords];
+    unsigned crossMask = MJL_findCrossBlocks(addr, MJL_cacheBlkDir, is_secure, crossBlks);
+    while (crossMask) {
+        BlkType *blk = crossBlks[__builtin_ctz(crossMask)];
+        crossMask &= crossMask - 1;
+        if (blk->isDirty() || blk->MJL_wasDirty || blk->isWritable() || !blk->isReadable()) {
+            return true;
         }
-    } 
+    }
     return false;
 }
 
 bool 
 BaseSetAssoc::MJL_hasCrossingDirty(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, bool is_secure) const
 {
-    assert(this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos);
-    uint64_t MJL_wordMask = blkSize/sizeof(uint64_t) - 1;
-    int MJL_colShift = floorLog2(MJL_rowWidth) + floorLog2(blkSize);
-    Addr tileMask = ~((Addr)(blkSize-1) | (MJL_wordMask << MJL_colShift));
-    Addr blkaddr = addr;
-    for (unsigned offset = 0; offset < blkSize/sizeof(uint64_t); ++offset) {
-        if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow) {
-            blkaddr = (addr & tileMask) | ((Addr)offset*sizeof(uint64_t)) ;
-            Addr tag = MJL_extractTag(blkaddr, CacheBlk::MJL_CacheBlkDir::MJL_IsColumn);
-            unsigned set = MJL_extractSet(blkaddr, CacheBlk::MJL_CacheBlkDir::MJL_IsColumn);
-            BlkType *blk = sets[set].MJL_findBlk(tag, CacheBlk::MJL_CacheBlkDir::MJL_IsColumn, is_secure);
-            if (blk && (blk->isDirty() || blk->MJL_wasDirty || !blk->isReadable())) {
-                return true;
-            }
-        } else if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn) {
-            blkaddr = (addr & tileMask) | ((Addr)offset << MJL_colShift);
-            Addr tag = MJL_extractTag(blkaddr, CacheBlk::MJL_CacheBlkDir::MJL_IsRow);
-            unsigned set = MJL_extractSet(blkaddr, CacheBlk::MJL_CacheBlkDir::MJL_IsRow);
-            BlkType *blk = sets[set].MJL_findBlk(tag, CacheBlk::MJL_CacheBlkDir::MJL_IsRow, is_secure);
-            if (blk && (blk->isDirty() || blk->MJL_wasDirty || !blk->isReadable())) {
-                return true;
-            }
-        } else {
-            assert(MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow || MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn);
+    assert(cache->MJL_isDataCache());
+    CacheBlk *crossBlks[MJL_TileDirectory::MJL_maxWords];
+    unsigned crossMask = MJL_findCrossBlocks(addr, MJL_cacheBlkDir, is_secure, crossBlks);
+    while (crossMask) {
+        BlkType *blk = crossBlks[__builtin_ctz(crossMask)];
+        crossMask &= crossMask - 1;
+        if (blk->isDirty() || blk->MJL_wasDirty || !blk->isReadable()) {
+            return true;
         }
-    } 
+    }
     return false;
 }
 
 bool 
 BaseSetAssoc::MJL_hasCrossingWritableRevoked(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, bool is_secure)
 {
-    assert(this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos);
-    uint64_t MJL_wordMask = blkSize/sizeof(uint64_t) - 1;
-    int MJL_colShift = floorLog2(MJL_rowWidth) + floorLog2(blkSize);
-    Addr tileMask = ~((Addr)(blkSize-1) | (MJL_wordMask << MJL_colShift));
-    Addr blkaddr = addr;
+    assert(cache->MJL_isDataCache());
     bool has_crossing_writable = false;
-    for (unsigned offset = 0; offset < blkSize/sizeof(uint64_t); ++offset) {
-        if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow) {
-            blkaddr = (addr & tileMask) | ((Addr)offset*sizeof(uint64_t)) ;
-            Addr tag = MJL_extractTag(blkaddr, CacheBlk::MJL_CacheBlkDir::MJL_IsColumn);
-            unsigned set = MJL_extractSet(blkaddr, CacheBlk::MJL_CacheBlkDir::MJL_IsColumn);
-            BlkType *blk = sets[set].MJL_findBlk(tag, CacheBlk::MJL_CacheBlkDir::MJL_IsColumn, is_secure);
-            if (blk && blk->isWritable()) {
-                blk->status &= ~BlkWritable;
-                has_crossing_writable |= true;
-                assert(!(blk->isDirty() || blk->MJL_wasDirty || !blk->isReadable()));
-            }
-        } else if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn) {
-            blkaddr = (addr & tileMask) | ((Addr)offset << MJL_colShift);
-            Addr tag = MJL_extractTag(blkaddr, CacheBlk::MJL_CacheBlkDir::MJL_IsRow);
-            unsigned set = MJL_extractSet(blkaddr, CacheBlk::MJL_CacheBlkDir::MJL_IsRow);
-            BlkType *blk = sets[set].MJL_findBlk(tag, CacheBlk::MJL_CacheBlkDir::MJL_IsRow, is_secure);
-            if (blk && blk->isWritable()) {
-                blk->status &= ~BlkWritable;
-                has_crossing_writable |= true;
-                assert(!(blk->isDirty() || blk->MJL_wasDirty || !blk->isReadable()));
-            }
-        } else {
-            assert(MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow || MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn);
+    CacheBlk *crossBlks[MJL_TileDirectory::MJL_maxWords];
+    unsigned crossMask = MJL_findCrossBlocks(addr, MJL_cacheBlkDir, is_secure, crossBlks);
+    while (crossMask) {
+        BlkType *blk = crossBlks[__builtin_ctz(crossMask)];
+        crossMask &= crossMask - 1;
+        if (blk->isWritable()) {
+            blk->status &= ~BlkWritable;
+            has_crossing_writable |= true;
+            assert(!(blk->isDirty() || blk->MJL_wasDirty || !blk->isReadable()));
         }
-    } 
+    }
     return has_crossing_writable;
 }
 /* MJL_End */
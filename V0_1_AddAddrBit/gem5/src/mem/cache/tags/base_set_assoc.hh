@@ -56,6 +56,10 @@
 #include "mem/cache/blk.hh"
 #include "mem/cache/tags/base.hh"
 #include "mem/cache/tags/cacheset.hh"
+/* MJL_Begin */
+#include "base/bitfield.hh"
+#include "mem/cache/tags/tile_directory.hh"
+/* MJL_End */
 #include "mem/packet.hh"
 #include "params/BaseSetAssoc.hh"
 
@@ -101,6 +105,12 @@ class BaseSetAssoc : public BaseTags
     BlkType *blks;
     /** The data blocks, 1 per cache block. */
     uint8_t *dataBlks;
+    /* MJL_Begin */
+    /** The packed tag keys of all the sets, assoc per set. */
+    uint64_t *MJL_tagKeys;
+    /** The blocks of each tile, see MJL_useTileDir for what is tracked. */
+    MJL_TileDirectory MJL_tileDir;
+    /* MJL_End */
 
     /** The amount to shift the address to get the set. */
     int setShift;
@@ -206,6 +216,94 @@ public:
         int MJL_startOffset = set % (blkSize/sizeof(uint64_t));
         return sets[set - MJL_startOffset + i].blks[way];
     }
+
+    /**
+     * The tile directory holds the row and column blocks of a data cache,
+     * and in a physically 2D cache the row blocks of each tile, which
+     * share a way.
+     */
+    bool MJL_useTileDir() const
+    {
+        return cache->MJL_isDataCache();
+    }
+
+    /** Key of the tile holding an address in the tile directory */
+    Addr MJL_tileKey(Addr addr, bool is_secure) const
+    {
+        return (addr & ~((Addr)blkMask | (MJL_wordMask << MJL_colShift))) | (Addr)is_secure;
+    }
+
+    /** Row of a row block or column of a column block within its tile */
+    int MJL_tileIndex(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir) const
+    {
+        if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn) {
+            return (addr >> MJL_rowShift) & MJL_wordMask;
+        } else {
+            return (addr >> MJL_colShift) & MJL_wordMask;
+        }
+    }
+
+    /**
+     * Put a block in the tile directory. Outside a physically 2D cache
+     * every crossing block already in the tile makes one duplicate word.
+     */
+    void MJL_tileDirAdd(CacheBlk *blk, bool is_secure)
+    {
+        Addr blkAddr = MJL_regenerateBlkAddr(blk->tag, blk->MJL_blkDir, blk->set);
+        const MJL_TileDirectory::MJL_Tile &tile = MJL_tileDir.MJL_add(MJL_tileKey(blkAddr, is_secure), blk->MJL_blkDir, MJL_tileIndex(blkAddr, blk->MJL_blkDir), blk);
+        MJL_tilesInUse = MJL_tileDir.MJL_size();
+        if (!cache->MJL_is2DCache()) {
+            MJL_Duplicates += popCount(blk->MJL_isRow() ? tile.colMask : tile.rowMask);
+            MJL_tileDuplicates.sample(popCount(tile.rowMask) * popCount(tile.colMask));
+        }
+    }
+
+    /**
+     * Take a block out of the tile directory. The status of the block may
+     * already be cleared, so both secure keys are tried.
+     */
+    void MJL_tileDirRemove(CacheBlk *blk)
+    {
+        if (!blk->MJL_isRow() && !blk->MJL_isColumn()) {
+            return;
+        }
+        Addr blkAddr = MJL_regenerateBlkAddr(blk->tag, blk->MJL_blkDir, blk->set);
+        int i = MJL_tileIndex(blkAddr, blk->MJL_blkDir);
+        unsigned crossMask = 0;
+        if (MJL_tileDir.MJL_remove(MJL_tileKey(blkAddr, false), blk->MJL_blkDir, i, blk, &crossMask) ||
+            MJL_tileDir.MJL_remove(MJL_tileKey(blkAddr, true), blk->MJL_blkDir, i, blk, &crossMask)) {
+            MJL_tilesInUse = MJL_tileDir.MJL_size();
+            if (!cache->MJL_is2DCache()) {
+                MJL_Duplicates -= popCount(crossMask);
+            }
+        }
+    }
+
+    /**
+     * Find the way holding a tile in a physically 2D cache
+     * @return The way, assoc if the tile is not in the cache
+     */
+    int MJL_findTileWay(Addr addr, bool is_secure) const
+    {
+        const MJL_TileDirectory::MJL_Tile *tile = MJL_tileDir.MJL_find(MJL_tileKey(addr, is_secure));
+        if (!tile || !tile->rowMask) {
+            return assoc;
+        }
+        Addr tag = MJL_extractTag(addr, CacheBlk::MJL_CacheBlkDir::MJL_IsRow);
+        int set = MJL_extractSet(addr, CacheBlk::MJL_CacheBlkDir::MJL_IsRow);
+        int MJL_startOffset = set%sizeof(uint64_t);
+        int way = tile->rows[__builtin_ctz(tile->rowMask)]->way;
+        for (int i = 0; i < blkSize/sizeof(uint64_t); ++i) {
+            CacheBlk *blk = findBlockBySetAndWay(set + i - MJL_startOffset, way);
+            if (blk->tag == tag &&
+                blk->MJL_blkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow &&
+                blk->isSecure() == is_secure &&
+                (blk->isValid() || blk->MJL_hasCrossValid())) {
+                return way;
+            }
+        }
+        return assoc;
+    }
     /* MJL_End */
 
     /**
@@ -239,27 +337,15 @@ public:
             cache->MJL_get_Test_rowColBloomFilters()->test_remove(MJL_regenerateBlkAddr(blk->tag, blk->MJL_blkDir, blk->set), blk->MJL_blkDir);
         }
         /* */
-        if (MJL_oracleProxy) {
+        if (blk->MJL_accessPCList) {
             cache->MJL_collect_stats(blk->MJL_accessPCList, blk->MJL_accessAddrList, blk->MJL_blkDir);
         }
         if (cache->MJL_get_rowColBloomFilter()) {
             cache->MJL_get_rowColBloomFilter()->remove(MJL_regenerateBlkAddr(blk->tag, blk->MJL_blkDir, blk->set), blk->MJL_blkDir);
         }
-        if (!cache->MJL_is2DCache()) {
-            CacheBlk * MJL_dupBlk = nullptr;
-            Addr baseAddr = MJL_regenerateBlkAddr(blk->tag, blk->MJL_blkDir, blk->set);
-            for (int i = 0; i < blkSize; i += sizeof(uint64_t)) {
-                MJL_dupBlk = nullptr;
-                Addr wordAddr = cache->MJL_addOffsetAddr(baseAddr, blk->MJL_blkDir, i);
-                if (blk->MJL_isRow()) {
-                    MJL_dupBlk = MJL_findBlock(wordAddr, CacheBlk::MJL_CacheBlkDir::MJL_IsColumn, blk->isSecure());
-                } else if (blk->MJL_isColumn()) {
-                    MJL_dupBlk = MJL_findBlock(wordAddr, CacheBlk::MJL_CacheBlkDir::MJL_IsRow, blk->isSecure());
-                }
-                if (MJL_dupBlk) {
-                    MJL_Duplicates--;
-                }
-            }
+        // A tile of a physically 2D cache stays until its way is refilled
+        if (MJL_useTileDir() && !cache->MJL_is2DCache()) {
+            MJL_tileDirRemove(blk);
         }
         /* MJL_End */
         assert(blk->srcMasterId < cache->system->maxMasters());
@@ -283,12 +369,6 @@ public:
     CacheBlk* accessBlock(Addr addr, bool is_secure, Cycles &lat,
                           int context_src) override
     {
-        /* MJL_Begin */
-        if (!MJL_timeStepScheduled && MJL_timeStep > 0) {
-            schedule(MJL_printUtilizationEvent, curTick() + 1);
-            MJL_timeStepScheduled = true;
-        }
-        /* MJL_End */
         Addr tag = extractTag(addr);
         int set = extractSet(addr);
         BlkType *blk = sets[set].findBlk(tag, is_secure);
@@ -328,11 +408,7 @@ public:
     CacheBlk* MJL_accessBlock(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, bool is_secure, Cycles &lat,
                           int context_src) override
     {
-        if (!MJL_timeStepScheduled && MJL_timeStep > 0) {
-            schedule(MJL_printUtilizationEvent, curTick() + 1);
-            MJL_timeStepScheduled = true;
-        }
-        if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+        if (cache->MJL_isDataCache()) {
             Addr tag = MJL_extractTag(addr, MJL_cacheBlkDir);
             int set = MJL_extractSet(addr, MJL_cacheBlkDir);
             BlkType *blk = sets[set].MJL_findBlk(tag, MJL_cacheBlkDir, is_secure);
@@ -429,7 +505,7 @@ public:
     {
         BlkType *blk = MJL_accessBlock(addr, MJL_cacheBlkDir, is_secure, lat, context_src);
         Cycles templat = lat;
-        if (blk == nullptr && (cache->name().find("dcache") != std::string::npos || cache->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos)) {
+        if (blk == nullptr && cache->MJL_isDataCache()) {
             if ( MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow ) {
                 blk = MJL_accessBlock(addr, CacheBlk::MJL_CacheBlkDir::MJL_IsColumn, is_secure, lat, context_src);
             } else if ( MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn ) {
@@ -454,31 +530,17 @@ public:
      * @return Pointer to the blk that is not valid but the tile is
      */
     CacheBlk* MJL_findWritebackBlk(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, bool is_secure, int MJL_offset) {
-        Addr tag = MJL_extractTag(addr, CacheBlk::MJL_CacheBlkDir::MJL_IsRow);
         int set = MJL_extractSet(addr, CacheBlk::MJL_CacheBlkDir::MJL_IsRow);
-        CacheBlk* blk = nullptr;
         CacheBlk* retBlk = nullptr;
         int MJL_startOffset = set%sizeof(uint64_t);
-        int way = 0;
-        for (way = 0; way < assoc; ++way) {
-            for (int i = 0; i < blkSize/sizeof(uint64_t); ++i) {
-                blk = findBlockBySetAndWay(set + i - MJL_startOffset, way);
-                if (blk->tag == tag && 
-                    blk->MJL_blkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow && 
-                    blk->isSecure() == is_secure && 
-                    (blk->isValid() || blk->MJL_hasCrossValid())) {
-                    if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn) {
-                        retBlk = findBlockBySetAndWay(set - MJL_startOffset, way);
-                    } else if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow) {
-                        retBlk = findBlockBySetAndWay(set, way);
-                    }
-                    assert((MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow && !retBlk->isValid())|| (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn && !retBlk->MJL_crossValid[MJL_offset/sizeof(uint64_t)]));
-                    break;
-                }
-            }
-            if (retBlk) {
-                break;
+        int way = MJL_findTileWay(addr, is_secure);
+        if (way != (int)assoc) {
+            if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn) {
+                retBlk = findBlockBySetAndWay(set - MJL_startOffset, way);
+            } else if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow) {
+                retBlk = findBlockBySetAndWay(set, way);
             }
+            assert((MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow && !retBlk->isValid())|| (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn && !retBlk->MJL_crossValid[MJL_offset/sizeof(uint64_t)]));
         }
         if (retBlk && MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn) {
             for (int i = 0; i < blkSize/sizeof(uint64_t); ++i) {
@@ -504,28 +566,7 @@ public:
     }
 
     int MJL_tileExists(Addr addr, bool is_secure) {
-        int tileExists = assoc;
-        Addr tag = MJL_extractTag(addr, CacheBlk::MJL_CacheBlkDir::MJL_IsRow);
-        int set = MJL_extractSet(addr, CacheBlk::MJL_CacheBlkDir::MJL_IsRow);
-        CacheBlk* blk = nullptr;
-        int MJL_startOffset = set%sizeof(uint64_t);
-        for (int way = 0; way < assoc; ++way) {
-            for (int i = 0; i < blkSize/sizeof(uint64_t); ++i) {
-                blk = findBlockBySetAndWay(set + i - MJL_startOffset, way);
-                if (blk->tag == tag && 
-                    blk->MJL_blkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow && 
-                    blk->isSecure() == is_secure && 
-                    (blk->isValid() || blk->MJL_hasCrossValid())) {
-                    tileExists = way;
-                    break;
-                }
-            }
-            if (tileExists != assoc) {
-                break;
-            }
-        }
-        
-        return tileExists;
+        return MJL_findTileWay(addr, is_secure);
     }
     /* MJL_End */
 
@@ -545,6 +586,7 @@ public:
     bool MJL_hasCrossingDirtyOrWritable(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, bool is_secure) const override;
     bool MJL_hasCrossingDirty(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, bool is_secure) const override;
     bool MJL_hasCrossingWritableRevoked(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, bool is_secure) override;
+    unsigned MJL_findCrossBlocks(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, bool is_secure, CacheBlk **MJL_crossBlks) const override;
     /* MJL_End */
 
     /**
@@ -571,7 +613,7 @@ public:
     /* MJL_Begin */
     CacheBlk* MJL_findVictim(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir) override
     {
-        if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+        if (cache->MJL_isDataCache()) {
             BlkType *blk = nullptr;
             int set = MJL_extractSet(addr, MJL_cacheBlkDir);
 
@@ -667,8 +709,11 @@ public:
              for (int i = 0; i < blkSize/sizeof(uint64_t); ++i) {
                 CacheBlk* tile_blk =  MJL_findBlockByTile(blk, i);
                 tile_blk->isTouched = true;
+                MJL_tileDirRemove(tile_blk);
                 tile_blk->tag = MJL_extractTag(addr, CacheBlk::MJL_CacheBlkDir::MJL_IsRow);
                 tile_blk->MJL_blkDir = CacheBlk::MJL_CacheBlkDir::MJL_IsRow;
+                sets[tile_blk->set].MJL_syncKey(tile_blk->way);
+                MJL_tileDirAdd(tile_blk, pkt->isSecure());
 
                 tile_blk->srcMasterId = master_id;
                 tile_blk->task_id = task_id;
@@ -713,28 +758,12 @@ public:
                  cache->MJL_get_Test_rowColBloomFilters()->test_remove(MJL_regenerateBlkAddr(blk->tag, blk->MJL_blkDir, blk->set), blk->MJL_blkDir);
              }
              /* */
-             if (MJL_oracleProxy) {
+             if (blk->MJL_accessPCList) {
                  cache->MJL_collect_stats(blk->MJL_accessPCList, blk->MJL_accessAddrList, blk->MJL_blkDir);
              }
              if (cache->MJL_get_rowColBloomFilter()) {
                  cache->MJL_get_rowColBloomFilter()->remove(MJL_regenerateBlkAddr(blk->tag, blk->MJL_blkDir, blk->set), blk->MJL_blkDir);
              }
-             if (!cache->MJL_is2DCache()) {
-                 CacheBlk * MJL_dupBlk = nullptr;
-                 Addr baseAddr = MJL_regenerateBlkAddr(blk->tag, blk->MJL_blkDir, blk->set);
-                 for (int i = 0; i < blkSize; i += sizeof(uint64_t)) {
-                     MJL_dupBlk = nullptr;
-                     Addr wordAddr = cache->MJL_addOffsetAddr(baseAddr, blk->MJL_blkDir, i);
-                     if (blk->MJL_isRow()) {
-                         MJL_dupBlk = MJL_findBlock(wordAddr, CacheBlk::MJL_CacheBlkDir::MJL_IsColumn, blk->isSecure());
-                     } else if (blk->MJL_isColumn()) {
-                         MJL_dupBlk = MJL_findBlock(wordAddr, CacheBlk::MJL_CacheBlkDir::MJL_IsRow, blk->isSecure());
-                     }
-                     if (MJL_dupBlk) {
-                         MJL_Duplicates--;
-                     }
-                 }
-             }
              /* MJL_End */
              replacements[0]++;
              totalRefs += blk->refCount;
@@ -755,7 +784,12 @@ public:
          blk->tag = extractTag(addr);
          */
          /* MJL_Begin */
-         if (this->name().find("dcache") != std::string::npos || this->name().find("l2") != std::string::npos || this->name().find("l3") != std::string::npos) {
+         // Drops the duplicates of the evicted block, which may also have
+         // been invalidated without the tags seeing it
+         if (MJL_useTileDir()) {
+             MJL_tileDirRemove(blk);
+         }
+         if (cache->MJL_isDataCache()) {
              blk->tag = MJL_extractTag(addr, pkt->MJL_getDataDir());
              // Add to bloom filter 
              /* MJL_Test */
@@ -770,27 +804,16 @@ public:
              blk->tag = extractTag(addr);
          }
          blk->MJL_blkDir = pkt->MJL_getDataDir();
+         sets[blk->set].MJL_syncKey(blk->way);
          if (blk->MJL_isRow()) {
              MJL_rowInUse++;
          } else if (blk->MJL_isColumn()) {
              MJL_colInUse++;
              //std::cout << "MJL_Test: colInUse++(" << MJL_colInUse.value() << ")" << std::endl;
          }
-         if (!cache->MJL_is2DCache()) {
-            CacheBlk * MJL_dupBlk = nullptr;
-            for (int i = 0; i < blkSize; i += sizeof(uint64_t)) {
-                MJL_dupBlk = nullptr;
-                Addr wordAddr = cache->MJL_addOffsetAddr(addr, blk->MJL_blkDir, i);
-                if (blk->MJL_isRow()) {
-                    MJL_dupBlk = MJL_findBlock(wordAddr, CacheBlk::MJL_CacheBlkDir::MJL_IsColumn, pkt->isSecure());
-                } else if (blk->MJL_isColumn()) {
-                    MJL_dupBlk = MJL_findBlock(wordAddr, CacheBlk::MJL_CacheBlkDir::MJL_IsRow, pkt->isSecure());
-                }
-                if (MJL_dupBlk) {
-                    MJL_Duplicates++;
-                }
-            }
-        }
+         if (MJL_useTileDir() && (blk->MJL_isRow() || blk->MJL_isColumn())) {
+             MJL_tileDirAdd(blk, pkt->isSecure());
+         }
          /* MJL_End */
 
          // deal with what we are bringing in
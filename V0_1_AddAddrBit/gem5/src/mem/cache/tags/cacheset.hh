@@ -49,6 +49,11 @@
 #define __MEM_CACHE_TAGS_CACHESET_HH__
 
 #include <cassert>
+/* MJL_Begin */
+#include <cstdint>
+
+#include "mem/cache/tags/tag_match.hh"
+/* MJL_End */
 
 /**
  * An associative set of cache blocks.
@@ -63,6 +68,30 @@ class CacheSet
     /** Cache blocks in this set, maintained in LRU order 0 = MRU. */
     Blktype **blks;
 
+    /* MJL_Begin */
+    /**
+     * Packed tag and direction of blks[i], in the same order as blks. The
+     * tags must call MJL_syncKey whenever they change the tag or the
+     * direction of a block of the set.
+     */
+    uint64_t *MJL_keys;
+
+    static uint64_t MJL_makeKey(Addr tag, enum Blktype::MJL_CacheBlkDir MJL_cacheBlkDir)
+    {
+        return (tag << 2) | (uint64_t)MJL_cacheBlkDir;
+    }
+    void MJL_syncKey(int way)
+    {
+        MJL_keys[way] = MJL_makeKey(blks[way]->tag, blks[way]->MJL_blkDir);
+    }
+    void MJL_syncKeys()
+    {
+        for (int i = 0; i < assoc; ++i) {
+            MJL_syncKey(i);
+        }
+    }
+    /* MJL_End */
+
     /**
      * Find a block matching the tag in this set.
      * @param way_id The id of the way that matches the tag.
@@ -102,6 +131,22 @@ CacheSet<Blktype>::findBlk(Addr tag, bool is_secure, int& way_id) const
      * If no block is found way_id is set to assoc.
      */
     way_id = assoc;
+    /* MJL_Begin */
+    if (assoc <= 64) {
+        // Match the tag only, the direction bits are masked out
+        uint64_t matches = MJL_matchKeys(MJL_keys, assoc, tag << 2, ~(uint64_t)0x3);
+        while (matches) {
+            int i = __builtin_ctzll(matches);
+            matches &= matches - 1;
+            if (blks[i]->isValid() &&
+                blks[i]->isSecure() == is_secure) {
+                way_id = i;
+                return blks[i];
+            }
+        }
+        return nullptr;
+    }
+    /* MJL_End */
     for (int i = 0; i < assoc; ++i) {
         if (blks[i]->tag == tag && blks[i]->isValid() &&
             blks[i]->isSecure() == is_secure) {
@@ -121,6 +166,22 @@ CacheSet<Blktype>::MJL_findBlk(Addr tag, enum Blktype::MJL_CacheBlkDir MJL_cache
      * If no block is found way_id is set to assoc.
      */
     way_id = assoc;
+    if (assoc <= 64) {
+        uint64_t matches = MJL_matchKeys(MJL_keys, assoc, MJL_makeKey(tag, MJL_cacheBlkDir), ~(uint64_t)0);
+        while (matches) {
+            int i = __builtin_ctzll(matches);
+            matches &= matches - 1;
+            /* MJL_Test: key consistency
+            assert(MJL_keys[i] == MJL_makeKey(blks[i]->tag, blks[i]->MJL_blkDir));
+             */
+            if (blks[i]->isValid() &&
+                blks[i]->isSecure() == is_secure) {
+                way_id = i;
+                return blks[i];
+            }
+        }
+        return nullptr;
+    }
     for (int i = 0; i < assoc; ++i) {
         if (blks[i]->tag == tag && 
             blks[i]->MJL_blkDir == MJL_cacheBlkDir && 
@@ -142,6 +203,19 @@ CacheSet<Blktype>::MJL_findCrossBlk(Addr tag, enum Blktype::MJL_CacheBlkDir MJL_
      * If no block is found way_id is set to assoc.
      */
     way_id = assoc;
+    if (assoc <= 64) {
+        uint64_t matches = MJL_matchKeys(MJL_keys, assoc, MJL_makeKey(tag, MJL_cacheBlkDir), ~(uint64_t)0);
+        while (matches) {
+            int i = __builtin_ctzll(matches);
+            matches &= matches - 1;
+            if (blks[i]->MJL_crossValid[MJL_offset/sizeof(uint64_t)] &&
+                blks[i]->isSecure() == is_secure) {
+                way_id = i;
+                return blks[i];
+            }
+        }
+        return nullptr;
+    }
     for (int i = 0; i < assoc; ++i) {
         if (blks[i]->tag == tag && 
             blks[i]->MJL_blkDir == MJL_cacheBlkDir && 
@@ -210,6 +284,7 @@ CacheSet<Blktype>::moveToHead(Blktype *blk)
     /* MJL_Begin */
     for (int i = 0; i < assoc; ++i) {
         blks[i]->way = i;
+        MJL_syncKey(i);
     }
     /* MJL_End */
     /* MJL_Test: way */
@@ -243,6 +318,7 @@ CacheSet<Blktype>::moveToTail(Blktype *blk)
     /* MJL_Begin */
     for (int i = 0; i < assoc; ++i) {
         blks[i]->way = i;
+        MJL_syncKey(i);
     }
     /* MJL_End */
     
@@ -254,6 +254,9 @@ public:
     bool MJL_hasCrossingWritableRevoked(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, bool is_secure) override {
         return false;
     }
+    unsigned MJL_findCrossBlocks(Addr addr, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir, bool is_secure, CacheBlk **MJL_crossBlks) const override {
+        return 0;
+    }
     /* MJL_End */
 
     /**
@@ -0,0 +1,124 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Tag match kernel over the packed per-way keys of a cache set. A key
+ * packs the tag and the direction of a block, see CacheSet::MJL_makeKey.
+ * The kernel is chosen at compile time: AVX2 when the build targets it,
+ * SSE2 on any other x86-64 build, and a scalar loop elsewhere. A second
+ * kernel matches the 16-bit partial tags of the direction predictor table.
+ */
+
+#ifndef __MEM_CACHE_TAGS_TAG_MATCH_HH__
+#define __MEM_CACHE_TAGS_TAG_MATCH_HH__
+
+#include <cassert>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * Scalar reference of MJL_matchKeys.
+ * @return Bit i set if (keys[i] & mask) == key, for the first n keys
+ */
+inline uint64_t
+MJL_matchKeysScalar(const uint64_t *keys, int n, uint64_t key, uint64_t mask)
+{
+    uint64_t matches = 0;
+    for (int i = 0; i < n; ++i) {
+        matches |= (uint64_t)((keys[i] & mask) == key) << i;
+    }
+    return matches;
+}
+
+/**
+ * Compare up to 64 keys against one key.
+ * @return Bit i set if (keys[i] & mask) == key, for the first n keys
+ */
+inline uint64_t
+MJL_matchKeys(const uint64_t *keys, int n, uint64_t key, uint64_t mask)
+{
+    assert(n <= 64);
+    uint64_t matches = 0;
+    int i = 0;
+#if defined(__AVX2__)
+    const __m256i key_v = _mm256_set1_epi64x(key);
+    const __m256i mask_v = _mm256_set1_epi64x(mask);
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(keys + i));
+        __m256i eq = _mm256_cmpeq_epi64(_mm256_and_si256(v, mask_v), key_v);
+        matches |= (uint64_t)_mm256_movemask_pd(_mm256_castsi256_pd(eq)) << i;
+    }
+#elif defined(__SSE2__)
+    const __m128i key_v = _mm_set1_epi64x(key);
+    const __m128i mask_v = _mm_set1_epi64x(mask);
+    for (; i + 2 <= n; i += 2) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(keys + i));
+        // SSE2 has no 64-bit compare, both 32-bit halves have to match
+        __m128i eq = _mm_cmpeq_epi32(_mm_and_si128(v, mask_v), key_v);
+        eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+        matches |= (uint64_t)_mm_movemask_pd(_mm_castsi128_pd(eq)) << i;
+    }
+#endif
+    if (i < n) {
+        matches |= MJL_matchKeysScalar(keys + i, n - i, key, mask) << i;
+    }
+    return matches;
+}
+
+/**
+ * Scalar reference of MJL_matchTags16.
+ * @return Bit i set if tags[i] == tag, for the first n tags
+ */
+inline uint64_t
+MJL_matchTags16Scalar(const uint16_t *tags, int n, uint16_t tag)
+{
+    uint64_t matches = 0;
+    for (int i = 0; i < n; ++i) {
+        matches |= (uint64_t)(tags[i] == tag) << i;
+    }
+    return matches;
+}
+
+/**
+ * Compare up to 64 16-bit partial tags against one tag.
+ * @return Bit i set if tags[i] == tag, for the first n tags
+ */
+inline uint64_t
+MJL_matchTags16(const uint16_t *tags, int n, uint16_t tag)
+{
+    assert(n <= 64);
+    uint64_t matches = 0;
+    int i = 0;
+#if defined(__AVX2__)
+    const __m256i tag_v = _mm256_set1_epi16(tag);
+    for (; i + 16 <= n; i += 16) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(tags + i));
+        __m256i eq = _mm256_cmpeq_epi16(v, tag_v);
+        // Narrow each 16-bit lane to a byte, packs works within 128-bit halves
+        eq = _mm256_permute4x64_epi64(_mm256_packs_epi16(eq, eq),
+                                      _MM_SHUFFLE(3, 1, 2, 0));
+        matches |= (uint64_t)(uint16_t)_mm256_movemask_epi8(eq) << i;
+    }
+#endif
+#if defined(__AVX2__) || defined(__SSE2__)
+    const __m128i tag_x = _mm_set1_epi16(tag);
+    for (; i + 8 <= n; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(tags + i));
+        __m128i eq = _mm_cmpeq_epi16(v, tag_x);
+        // Narrow each 16-bit lane to a byte so movemask gives one bit a tag
+        eq = _mm_packs_epi16(eq, _mm_setzero_si128());
+        matches |= (uint64_t)_mm_movemask_epi8(eq) << i;
+    }
+#endif
+    if (i < n) {
+        matches |= MJL_matchTags16Scalar(tags + i, n - i, tag) << i;
+    }
+    return matches;
+}
+
+#endif // __MEM_CACHE_TAGS_TAG_MATCH_HH__
+
+/* MJL_End */
@@ -0,0 +1,119 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Directory of the row and column blocks cached for each tile, so the
+ * blocks crossing a block can be found with one probe instead of one set
+ * lookup per word.
+ */
+
+#ifndef __MEM_CACHE_TAGS_TILE_DIRECTORY_HH__
+#define __MEM_CACHE_TAGS_TILE_DIRECTORY_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include "base/types.hh"
+#include "mem/cache/blk.hh"
+
+/**
+ * A tile is keyed by its address with the secure bit in bit 0. Row i of
+ * the tile is in rows[i] when bit i of rowMask is set, and column i is in
+ * cols[i] when bit i of colMask is set. The slots are only cleared by the
+ * tags, so the block in a slot may have been invalidated since; callers
+ * check the block status.
+ */
+class MJL_TileDirectory
+{
+  public:
+    /** Most words per block, one bit per word in the masks */
+    static const int MJL_maxWords = Packet::MJL_maxBlkWords;
+    static_assert(MJL_maxWords <= 8, "Tile masks are 8 bits wide");
+
+    struct MJL_Tile
+    {
+        uint8_t rowMask;
+        uint8_t colMask;
+        CacheBlk *rows[MJL_maxWords];
+        CacheBlk *cols[MJL_maxWords];
+    };
+
+    void MJL_reserve(size_t n) { tiles.reserve(n); }
+
+    /** @return The tile, nullptr if nothing of it is in the directory */
+    const MJL_Tile *MJL_find(Addr key) const
+    {
+        auto it = tiles.find(key);
+        return it == tiles.end() ? nullptr : &it->second;
+    }
+
+    /**
+     * Put a block in its slot, replacing what was there
+     * @return The tile after the update
+     */
+    const MJL_Tile &MJL_add(Addr key, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir,
+                            int i, CacheBlk *blk)
+    {
+        assert(i < MJL_maxWords);
+        MJL_Tile &tile = tiles[key];
+        if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn) {
+            tile.colMask |= 1 << i;
+            tile.cols[i] = blk;
+        } else {
+            assert(MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsRow);
+            tile.rowMask |= 1 << i;
+            tile.rows[i] = blk;
+        }
+        return tile;
+    }
+
+    /**
+     * Clear the slot if it still holds the block.
+     * @param MJL_crossMask If not null, gets the mask of the other
+     *                      direction at the time of the removal
+     * @return Whether the block was in the slot
+     */
+    bool MJL_remove(Addr key, CacheBlk::MJL_CacheBlkDir MJL_cacheBlkDir,
+                    int i, const CacheBlk *blk,
+                    unsigned *MJL_crossMask = nullptr)
+    {
+        assert(i < MJL_maxWords);
+        auto it = tiles.find(key);
+        if (it == tiles.end()) {
+            return false;
+        }
+        MJL_Tile &tile = it->second;
+        if (MJL_cacheBlkDir == CacheBlk::MJL_CacheBlkDir::MJL_IsColumn) {
+            if (!(tile.colMask & (1 << i)) || tile.cols[i] != blk) {
+                return false;
+            }
+            tile.colMask &= ~(1 << i);
+            if (MJL_crossMask) {
+                *MJL_crossMask = tile.rowMask;
+            }
+        } else {
+            if (!(tile.rowMask & (1 << i)) || tile.rows[i] != blk) {
+                return false;
+            }
+            tile.rowMask &= ~(1 << i);
+            if (MJL_crossMask) {
+                *MJL_crossMask = tile.colMask;
+            }
+        }
+        if (!tile.rowMask && !tile.colMask) {
+            tiles.erase(it);
+        }
+        return true;
+    }
+
+    size_t MJL_size() const { return tiles.size(); }
+
+  private:
+    std::unordered_map<Addr, MJL_Tile> tiles;
+};
+
+#endif // __MEM_CACHE_TAGS_TILE_DIRECTORY_HH__
+
+/* MJL_End */
@@ -66,6 +66,9 @@ WriteQueue::allocate(Addr blk_addr, unsigned blk_size, PacketPtr pkt,
 
     entry->allocate(blk_addr, blk_size, pkt, when_ready, order);
     entry->allocIter = allocatedList.insert(allocatedList.end(), entry);
+    /* MJL_Begin */
+    MJL_indexEntry(entry);
+    /* MJL_End */
     entry->readyIter = addToReadyList(entry);
 
     allocated += 1;
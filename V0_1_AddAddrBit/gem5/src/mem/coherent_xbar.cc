@@ -152,6 +152,16 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID slave_port_id)
 
     // determine the destination based on the address
     PortID master_port_id = findPort(pkt->getAddr());
+    /* MJL_Begin */
+    // the lines of a tile packet have to be behind the same port
+    if (pkt->MJL_isTile()) {
+        for (unsigned k = 0; k < pkt->MJL_tileLineCount(); ++k) {
+            panic_if(findPort(pkt->MJL_getTileLine(k)->getAddr()) !=
+                     master_port_id, "%s: lines of tile packet %s are "
+                     "behind different ports\n", name(), pkt->print());
+        }
+    }
+    /* MJL_End */
 
     // test if the crossbar should be considered occupied for the current
     // port, and exclude express snoops from the check
@@ -188,7 +198,14 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID slave_port_id)
         // broadcasted to our snoopers but the source
         if (snoopFilter) {
             // check with the snoop filter where to forward this packet
+            /* MJL_Begin */
+            auto sf_res = pkt->MJL_isTile() ?
+                snoopFilter->MJL_lookupTileRequest(pkt, *src_port) :
+                snoopFilter->lookupRequest(pkt, *src_port);
+            /* MJL_End */
+            /* MJL_Comment
             auto sf_res = snoopFilter->lookupRequest(pkt, *src_port);
+            */
             // the time required by a packet to be delivered through
             // the xbar has to be charged also with to lookup latency
             // of the snoop filter
@@ -206,9 +223,22 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID slave_port_id)
                 if (!sf_res.first.empty())
                     pkt->setBlockCached();
             } else {
+                /* MJL_Begin */
+                // the caches above only take snoops of single lines
+                fatal_if(pkt->MJL_isTile() && !sf_res.first.empty(),
+                         "%s: tile packet %s needs snooping, tile packets "
+                         "need a single cache above the crossbar\n",
+                         name(), pkt->print());
+                /* MJL_End */
                 forwardTiming(pkt, slave_port_id, sf_res.first);
             }
         } else {
+            /* MJL_Begin */
+            fatal_if(pkt->MJL_isTile() && snoopPorts.size() > 1,
+                     "%s: tile packet %s needs snooping, tile packets need "
+                     "a single cache above the crossbar\n", name(),
+                     pkt->print());
+            /* MJL_End */
             forwardTiming(pkt, slave_port_id);
         }
 
@@ -270,7 +300,11 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID slave_port_id)
         // Let the snoop filter know about the success of the send operation
         // MJL_TODO: might need to be changed
         /* MJL_Begin */
-        snoopFilter->MJL_finishRequest(!success, addr, pkt->MJL_getCmdDir(), pkt->isSecure());
+        if (pkt->MJL_isTile()) {
+            snoopFilter->MJL_finishTileRequest(!success);
+        } else {
+            snoopFilter->MJL_finishRequest(!success, addr, pkt->MJL_getCmdDir(), pkt->isSecure());
+        }
         /* MJL_End */
         /* MJL_Comment
         snoopFilter->finishRequest(!success, addr, pkt->isSecure());
@@ -395,7 +429,16 @@ CoherentXBar::recvTimingResp(PacketPtr pkt, PortID master_port_id)
 
     if (snoopFilter && !system->bypassCaches()) {
         // let the snoop filter inspect the response and update its state
+        /* MJL_Begin */
+        if (pkt->MJL_isTile()) {
+            snoopFilter->MJL_updateTileResponse(pkt, *slavePorts[slave_port_id]);
+        } else {
+            snoopFilter->updateResponse(pkt, *slavePorts[slave_port_id]);
+        }
+        /* MJL_End */
+        /* MJL_Comment
         snoopFilter->updateResponse(pkt, *slavePorts[slave_port_id]);
+        */
     }
 
     // send the packet through the destination slave port and pay for
@@ -0,0 +1,75 @@
+/* MJL_Begin */
+
+#include "mem/col_access.hh"
+
+#include <cstring>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define MJL_HAS_AVX2_GATHER 1
+#endif
+
+void
+MJL_gatherColumnScalar(uint8_t *dst, const uint8_t *src, uint64_t stride,
+                       unsigned size)
+{
+    unsigned offset = 0;
+    for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t)) {
+        std::memcpy(dst + offset, src, sizeof(uint64_t));
+        src += stride;
+    }
+    if (offset < size) {
+        std::memcpy(dst + offset, src, size - offset);
+    }
+}
+
+#ifdef MJL_HAS_AVX2_GATHER
+/** Four words per gather, the byte offsets of the words are the indices */
+__attribute__((target("avx2"))) static void
+MJL_gatherColumnAVX2(uint8_t *dst, const uint8_t *src, uint64_t stride,
+                     unsigned size)
+{
+    const __m256i index = _mm256_set_epi64x(3 * stride, 2 * stride,
+                                            stride, 0);
+    unsigned offset = 0;
+    for (; offset + 4 * sizeof(uint64_t) <= size;
+         offset += 4 * sizeof(uint64_t)) {
+        __m256i v = _mm256_i64gather_epi64((const long long *)src, index, 1);
+        _mm256_storeu_si256((__m256i *)(dst + offset), v);
+        src += 4 * stride;
+    }
+    MJL_gatherColumnScalar(dst + offset, src, stride, size - offset);
+}
+#endif
+
+static MJL_GatherColumnFn
+MJL_selectGatherColumn()
+{
+#ifdef MJL_HAS_AVX2_GATHER
+    if (__builtin_cpu_supports("avx2")) {
+        return MJL_gatherColumnAVX2;
+    }
+#endif
+    return MJL_gatherColumnScalar;
+}
+
+/** First call of MJL_gatherColumn, swaps itself for the selected kernel */
+static void
+MJL_gatherColumnResolve(uint8_t *dst, const uint8_t *src, uint64_t stride,
+                        unsigned size)
+{
+    MJL_gatherColumnImpl = MJL_selectGatherColumn();
+    MJL_gatherColumnImpl(dst, src, stride, size);
+}
+
+// Constant initialized, so it is usable from other static initializers
+MJL_GatherColumnFn MJL_gatherColumnImpl = MJL_gatherColumnResolve;
+
+const char *
+MJL_colAccessKernel()
+{
+    return MJL_selectGatherColumn() == MJL_gatherColumnScalar ?
+        "scalar" : "AVX2";
+}
+
+/* MJL_End */
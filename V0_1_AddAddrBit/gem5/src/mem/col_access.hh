@@ -0,0 +1,65 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Column access kernels of the backing store. A column block is made of
+ * 8 byte words that are a fixed stride apart in the host memory, so a
+ * column read is a strided gather and a column write a strided scatter.
+ * The gather kernel is chosen once, on the first call: the AVX2 gather
+ * when the host CPU has it, a scalar loop otherwise. AVX2 has no scatter,
+ * so writes always use the scalar loop.
+ */
+
+#ifndef __MEM_COL_ACCESS_HH__
+#define __MEM_COL_ACCESS_HH__
+
+#include <cstdint>
+#include <cstring>
+
+typedef void (*MJL_GatherColumnFn)(uint8_t *dst, const uint8_t *src,
+                                   uint64_t stride, unsigned size);
+
+/** Gather kernel in use, resolved on the first call */
+extern MJL_GatherColumnFn MJL_gatherColumnImpl;
+
+/**
+ * Copy a column to a contiguous buffer. Word i of dst is read from
+ * src + i * stride; the last word is partial when size is not a multiple
+ * of 8.
+ */
+inline void
+MJL_gatherColumn(uint8_t *dst, const uint8_t *src, uint64_t stride,
+                 unsigned size)
+{
+    MJL_gatherColumnImpl(dst, src, stride, size);
+}
+
+/**
+ * Copy a contiguous buffer to a column. Word i of src is written to
+ * dst + i * stride; the last word is partial when size is not a multiple
+ * of 8.
+ */
+inline void
+MJL_scatterColumn(uint8_t *dst, const uint8_t *src, uint64_t stride,
+                  unsigned size)
+{
+    unsigned offset = 0;
+    for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t)) {
+        std::memcpy(dst, src + offset, sizeof(uint64_t));
+        dst += stride;
+    }
+    if (offset < size) {
+        std::memcpy(dst, src + offset, size - offset);
+    }
+}
+
+/** Scalar reference of MJL_gatherColumn */
+void MJL_gatherColumnScalar(uint8_t *dst, const uint8_t *src,
+                            uint64_t stride, unsigned size);
+
+/** @return The name of the gather kernel in use, for reports */
+const char *MJL_colAccessKernel();
+
+#endif // __MEM_COL_ACCESS_HH__
+
+/* MJL_End */
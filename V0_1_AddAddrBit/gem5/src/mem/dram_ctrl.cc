@@ -62,6 +62,9 @@ DRAMCtrl::DRAMCtrl(const DRAMCtrlParams* p) :
     retryRdReq(false), retryWrReq(false),
     busState(READ),
     busStateNext(READ),
+    /* MJL_Begin */
+    MJL_busColumn(false), MJL_burstsThisDir(0),
+    /* MJL_End */
     nextReqEvent(this), respondEvent(this),
     deviceSize(p->device_size),
     deviceBusWidth(p->device_bus_width), burstLength(p->burst_length),
@@ -85,6 +88,18 @@ DRAMCtrl::DRAMCtrl(const DRAMCtrlParams* p) :
     tCCD_L(p->tCCD_L), tRCD(p->tRCD), tCL(p->tCL), tRP(p->tRP), tRAS(p->tRAS),
     tWR(p->tWR), tRTP(p->tRTP), tRFC(p->tRFC), tREFI(p->tREFI), tRRD(p->tRRD),
     tRRD_L(p->tRRD_L), tXAW(p->tXAW), tXP(p->tXP), tXS(p->tXS),
+    /* MJL_Begin */
+    MJL_2D(p->MJL_2D),
+    MJL_geometry(MJL_AddrGeometry::MJL_get(p->MJL_tile_blk_size,
+                                           p->MJL_row_width)),
+    MJL_tRCDColumn(p->MJL_tRCD_column), MJL_tCLColumn(p->MJL_tCL_column),
+    MJL_tBURSTColumn(p->MJL_tBURST_column),
+    MJL_dirBatching(p->MJL_dir_batching),
+    MJL_dirHighThreshPerc(p->MJL_dir_high_thresh_perc),
+    MJL_dirLowThreshPerc(p->MJL_dir_low_thresh_perc),
+    MJL_minBurstsPerDirSwitch(p->MJL_min_bursts_per_dir_switch),
+    MJL_tDS(p->MJL_tDS),
+    /* MJL_End */
     activationLimit(p->activation_limit),
     memSchedPolicy(p->mem_sched_policy), addrMapping(p->addr_mapping),
     pageMgmt(p->page_policy),
@@ -102,6 +117,30 @@ DRAMCtrl::DRAMCtrl(const DRAMCtrlParams* p) :
     fatal_if(!isPowerOf2(burstSize), "DRAM burst size %d is not allowed, "
              "must be a power of two\n", burstSize);
 
+    /* MJL_Begin */
+    // a column block is one burst, and a whole tile has to fit in a row
+    fatal_if(MJL_2D && MJL_geometry.MJL_blkSize != burstSize,
+             "2D DRAM needs the %d byte blocks to be one burst, but the burst "
+             "size is %d\n", MJL_geometry.MJL_blkSize, burstSize);
+    fatal_if(MJL_2D && rowBufferSize < MJL_geometry.MJL_blkSize *
+             (MJL_geometry.MJL_wordMask + 1),
+             "2D DRAM needs a row buffer of at least one tile, but it is "
+             "%d bytes\n", rowBufferSize);
+    // the blocks of a tile only stay in one row when the column bits are
+    // the lowest bits above the burst, and no channel bits sit among them
+    fatal_if(MJL_2D && addrMapping != Enums::RoRaBaChCo &&
+             addrMapping != Enums::RoRaBaCoCh,
+             "2D DRAM needs the RoRaBaChCo or RoRaBaCoCh address mapping\n");
+    fatal_if(MJL_2D && range.interleaved(),
+             "2D DRAM does not support a channel interleaved range %s\n",
+             range.to_string());
+
+    if (MJL_dirLowThreshPerc >= MJL_dirHighThreshPerc)
+        fatal("Direction low threshold %d must be smaller than the "
+              "high threshold %d\n", MJL_dirLowThreshPerc,
+              MJL_dirHighThreshPerc);
+    /* MJL_End */
+
     for (int i = 0; i < ranksPerChannel; i++) {
         Rank* rank = new Rank(*this, p);
         ranks.push_back(rank);
@@ -325,7 +364,17 @@ DRAMCtrl::decodeAddr(PacketPtr pkt, Addr dramPktAddr, unsigned size,
 
     // truncate the address to a DRAM burst, which makes it unique to
     // a specific column, row, bank, rank and channel
+    /* MJL_Begin */
+    // A 2D DRAM keeps the blocks of a tile next to each other, so with
+    // the column bits lowest and no channel interleaving, checked in the
+    // constructor, both views of a tile decode to the same rank, bank and
+    // row
+    Addr addr = (MJL_2D ? MJL_geometry.MJL_movColRight(dramPktAddr) :
+                 dramPktAddr) / burstSize;
+    /* MJL_End */
+    /* MJL_Comment
     Addr addr = dramPktAddr / burstSize;
+    */
 
     // we have removed the lowest order address bits that denote the
     // position within the column
@@ -412,8 +461,15 @@ DRAMCtrl::decodeAddr(PacketPtr pkt, Addr dramPktAddr, unsigned size,
     // ready time set to the current tick, the latter will be updated
     // later
     uint16_t bank_id = banksPerRank * rank + bank;
+    /* MJL_Begin */
+    return new DRAMPacket(pkt, isRead, rank, bank, row, bank_id, dramPktAddr,
+                          size, ranks[rank]->banks[bank], *ranks[rank],
+                          MJL_isColumnPkt(pkt));
+    /* MJL_End */
+    /* MJL_Comment
     return new DRAMPacket(pkt, isRead, rank, bank, row, bank_id, dramPktAddr,
                           size, ranks[rank]->banks[bank], *ranks[rank]);
+    */
 }
 
 void
@@ -435,23 +491,51 @@ DRAMCtrl::addToReadQueue(PacketPtr pkt, unsigned int pktCount)
     Addr addr = pkt->getAddr();
     unsigned pktsServicedByWrQ = 0;
     BurstHelper* burst_helper = NULL;
+    /* MJL_Begin */
+    const bool MJL_column = MJL_isColumnPkt(pkt);
+    /* MJL_End */
     for (int cnt = 0; cnt < pktCount; ++cnt) {
+        /* MJL_Begin */
+        // a column packet is a single column burst, and a tile packet a
+        // burst per line
+        if (pkt->MJL_isTile()) {
+            addr = pkt->MJL_getTileLine(cnt)->getAddr();
+        }
+        unsigned size = pkt->MJL_isTile() ?
+                        pkt->MJL_getTileLine(cnt)->getSize() :
+                        MJL_column ? pkt->getSize() :
+                        std::min((addr | (burstSize - 1)) + 1,
+                        pkt->getAddr() + pkt->getSize()) - addr;
+        /* MJL_End */
+        /* MJL_Comment
         unsigned size = std::min((addr | (burstSize - 1)) + 1,
                         pkt->getAddr() + pkt->getSize()) - addr;
+        */
         readPktSize[ceilLog2(size)]++;
         readBursts++;
 
         // First check write buffer to see if the data is already at
         // the controller
         bool foundInWrQ = false;
+        /* MJL_Begin */
+        Addr burst_addr = MJL_burstKey(addr, MJL_column);
+        /* MJL_End */
+        /* MJL_Comment
         Addr burst_addr = burstAlign(addr);
+        */
         // if the burst address is not present then there is no need
         // looking any further
         if (isInWriteQueue.find(burst_addr) != isInWriteQueue.end()) {
             for (const auto& p : writeQueue) {
                 // check if the read is subsumed in the write queue
                 // packet we are looking at
+                /* MJL_Begin */
+                if (p->MJL_isColumn == MJL_column &&
+                    p->addr <= addr && (addr + size) <= (p->addr + p->size)) {
+                /* MJL_End */
+                /* MJL_Comment
                 if (p->addr <= addr && (addr + size) <= (p->addr + p->size)) {
+                */
                     foundInWrQ = true;
                     servicedByWrQ++;
                     pktsServicedByWrQ++;
@@ -524,16 +608,37 @@ DRAMCtrl::addToWriteQueue(PacketPtr pkt, unsigned int pktCount)
     // if the request size is larger than burst size, the pkt is split into
     // multiple DRAM packets
     Addr addr = pkt->getAddr();
+    /* MJL_Begin */
+    const bool MJL_column = MJL_isColumnPkt(pkt);
+    /* MJL_End */
     for (int cnt = 0; cnt < pktCount; ++cnt) {
+        /* MJL_Begin */
+        if (pkt->MJL_isTile()) {
+            addr = pkt->MJL_getTileLine(cnt)->getAddr();
+        }
+        unsigned size = pkt->MJL_isTile() ?
+                        pkt->MJL_getTileLine(cnt)->getSize() :
+                        MJL_column ? pkt->getSize() :
+                        std::min((addr | (burstSize - 1)) + 1,
+                        pkt->getAddr() + pkt->getSize()) - addr;
+        /* MJL_End */
+        /* MJL_Comment
         unsigned size = std::min((addr | (burstSize - 1)) + 1,
                         pkt->getAddr() + pkt->getSize()) - addr;
+        */
         writePktSize[ceilLog2(size)]++;
         writeBursts++;
 
         // see if we can merge with an existing item in the write
         // queue and keep track of whether we have merged or not
+        /* MJL_Begin */
+        bool merged = isInWriteQueue.find(MJL_burstKey(addr, MJL_column)) !=
+            isInWriteQueue.end();
+        /* MJL_End */
+        /* MJL_Comment
         bool merged = isInWriteQueue.find(burstAlign(addr)) !=
             isInWriteQueue.end();
+        */
 
         // if the item was not merged we need to create a new write
         // and enqueue it
@@ -546,7 +651,12 @@ DRAMCtrl::addToWriteQueue(PacketPtr pkt, unsigned int pktCount)
             DPRINTF(DRAM, "Adding to write queue\n");
 
             writeQueue.push_back(dram_pkt);
+            /* MJL_Begin */
+            isInWriteQueue.insert(MJL_burstKey(addr, MJL_column));
+            /* MJL_End */
+            /* MJL_Comment
             isInWriteQueue.insert(burstAlign(addr));
+            */
             assert(writeQueue.size() == isInWriteQueue.size());
 
             // Update stats
@@ -623,7 +733,20 @@ DRAMCtrl::recvTimingReq(PacketPtr pkt)
     // multiple dram packets
     unsigned size = pkt->getSize();
     unsigned offset = pkt->getAddr() & (burstSize - 1);
+    /* MJL_Begin */
+    // a column block is one column burst wherever its first word is, and
+    // each line of a tile packet is one burst
+    assert(!MJL_isColumnPkt(pkt) || pkt->MJL_isTile() || size <= burstSize);
+    panic_if(pkt->MJL_isTile() &&
+             pkt->MJL_getTileLine(0)->getSize() > burstSize,
+             "Tile packet %s has lines larger than a burst\n", pkt->print());
+    unsigned int dram_pkt_count = pkt->MJL_isTile() ?
+        pkt->MJL_tileLineCount() : MJL_isColumnPkt(pkt) ? 1 :
+        divCeil(offset + size, burstSize);
+    /* MJL_End */
+    /* MJL_Comment
     unsigned int dram_pkt_count = divCeil(offset + size, burstSize);
+    */
 
     // check local buffers and do not accept if full
     if (pkt->isRead()) {
@@ -785,14 +908,65 @@ DRAMCtrl::chooseNext(std::deque<DRAMPacket*>& queue, Tick extra_col_delay)
             }
         }
     } else if (memSchedPolicy == Enums::frfcfs) {
+        /* MJL_Begin */
+        if (MJL_2D && MJL_dirBatching) {
+            // stay in the batch, unless none of its bursts go to an
+            // available rank
+            uint32_t queue_size = &queue == &writeQueue ? writeBufferSize :
+                readBufferSize;
+            found_packet = reorderQueue(queue, extra_col_delay,
+                                        MJL_chooseDir(queue, queue_size)) ||
+                reorderQueue(queue, extra_col_delay);
+        } else {
+            found_packet = reorderQueue(queue, extra_col_delay);
+        }
+        /* MJL_End */
+        /* MJL_Comment
         found_packet = reorderQueue(queue, extra_col_delay);
+        */
     } else
         panic("No scheduling policy chosen\n");
     return found_packet;
 }
 
+/* MJL_Begin */
+DRAMCtrl::MJL_DirFilter
+DRAMCtrl::MJL_chooseDir(const std::deque<DRAMPacket*>& queue,
+                        uint32_t queue_size) const
+{
+    uint32_t MJL_column = 0;
+    for (const auto& p : queue) {
+        if (p->MJL_isColumn)
+            ++MJL_column;
+    }
+    const uint32_t same = MJL_busColumn ? MJL_column :
+        queue.size() - MJL_column;
+    const uint32_t other = queue.size() - same;
+
+    bool switch_dir = false;
+    if (same == 0) {
+        switch_dir = true;
+    } else if (other != 0 && MJL_burstsThisDir >= MJL_minBurstsPerDirSwitch) {
+        switch_dir = same <= queue_size * MJL_dirLowThreshPerc / 100 ||
+            other >= queue_size * MJL_dirHighThreshPerc / 100;
+    }
+
+    if (switch_dir) {
+        DPRINTF(DRAM, "Switching to %s bursts after %d bursts with %d "
+                "waiting\n", MJL_busColumn ? "row" : "column",
+                MJL_burstsThisDir, other);
+    }
+    return MJL_busColumn != switch_dir ? MJL_columnDir : MJL_rowDir;
+}
+
+bool
+DRAMCtrl::reorderQueue(std::deque<DRAMPacket*>& queue, Tick extra_col_delay,
+                       MJL_DirFilter MJL_dir)
+/* MJL_End */
+/* MJL_Comment
 bool
 DRAMCtrl::reorderQueue(std::deque<DRAMPacket*>& queue, Tick extra_col_delay)
+*/
 {
     // Only determine this if needed
     uint64_t earliest_banks = 0;
@@ -823,10 +997,20 @@ DRAMCtrl::reorderQueue(std::deque<DRAMPacket*>& queue, Tick extra_col_delay)
         DRAMPacket* dram_pkt = *i;
         const Bank& bank = dram_pkt->bankRef;
 
+        /* MJL_Begin */
+        if (!MJL_inDir(dram_pkt, MJL_dir))
+            continue;
+        /* MJL_End */
+
         // check if rank is available, if not, jump to the next packet
         if (dram_pkt->rankRef.isAvailable()) {
             // check if it is a row hit
+            /* MJL_Begin */
+            if (bank.MJL_isOpen(dram_pkt->row, dram_pkt->MJL_isColumn)) {
+            /* MJL_End */
+            /* MJL_Comment
             if (bank.openRow == dram_pkt->row) {
+            */
                 // no additional rank-to-rank or same bank-group
                 // delays, or we switched read/write and might as well
                 // go for the row hit
@@ -853,8 +1037,14 @@ DRAMCtrl::reorderQueue(std::deque<DRAMPacket*>& queue, Tick extra_col_delay)
                 // now, and only once per scheduling decisions
                 if (earliest_banks == 0) {
                     // determine entries with earliest bank delay
+                    /* MJL_Begin */
+                    pair<uint64_t, bool> bankStatus =
+                        minBankPrep(queue, min_col_at, MJL_dir);
+                    /* MJL_End */
+                    /* MJL_Comment
                     pair<uint64_t, bool> bankStatus =
                         minBankPrep(queue, min_col_at);
+                    */
                     earliest_banks = bankStatus.first;
                     hidden_bank_prep = bankStatus.second;
                 }
@@ -924,9 +1114,16 @@ DRAMCtrl::accessAndRespond(PacketPtr pkt, Tick static_latency)
     return;
 }
 
+/* MJL_Begin */
+void
+DRAMCtrl::activateBank(Rank& rank_ref, Bank& bank_ref,
+                       Tick act_tick, uint32_t row, bool MJL_column)
+/* MJL_End */
+/* MJL_Comment
 void
 DRAMCtrl::activateBank(Rank& rank_ref, Bank& bank_ref,
                        Tick act_tick, uint32_t row)
+*/
 {
     assert(rank_ref.actTicks.size() == activationLimit);
 
@@ -935,6 +1132,9 @@ DRAMCtrl::activateBank(Rank& rank_ref, Bank& bank_ref,
     // update the open row
     assert(bank_ref.openRow == Bank::NO_ROW);
     bank_ref.openRow = row;
+    /* MJL_Begin */
+    bank_ref.MJL_openColumn = MJL_column;
+    /* MJL_End */
 
     // start counting anew, this covers both the case when we
     // auto-precharged, and when this access is forced to
@@ -959,7 +1159,14 @@ DRAMCtrl::activateBank(Rank& rank_ref, Bank& bank_ref,
     bank_ref.preAllowedAt = act_tick + tRAS;
 
     // Respect the row-to-column command delay
+    /* MJL_Begin */
+    bank_ref.colAllowedAt = std::max(act_tick + (MJL_column ? MJL_tRCDColumn :
+                                                 tRCD),
+                                     bank_ref.colAllowedAt);
+    /* MJL_End */
+    /* MJL_Comment
     bank_ref.colAllowedAt = std::max(act_tick + tRCD, bank_ref.colAllowedAt);
+    */
 
     // start by enforcing tRRD
     for (int i = 0; i < banksPerRank; i++) {
@@ -1098,11 +1305,38 @@ DRAMCtrl::doDRAMAccess(DRAMPacket* dram_pkt)
     // respect any constraints on the command (e.g. tRCD or tCCD)
     Tick cmd_at = std::max(bank.colAllowedAt, curTick());
 
+    /* MJL_Begin */
+    const bool MJL_column = dram_pkt->MJL_isColumn;
+    const Tick MJL_tCL = MJL_getTCL(MJL_column);
+    const Tick MJL_tBURST = MJL_getTBURST(MJL_column);
+
+    // add a bubble to the data bus when the burst direction changes
+    if (MJL_2D && MJL_column != MJL_busColumn) {
+        ++MJL_dirSwitches;
+        MJL_burstsPerDirSwitch.sample(MJL_burstsThisDir);
+        MJL_burstsThisDir = 0;
+        MJL_busColumn = MJL_column;
+        busBusyUntil += MJL_tDS;
+    }
+    ++MJL_burstsThisDir;
+    /* MJL_End */
+
     // Determine the access latency and update the bank state
+    /* MJL_Begin */
+    if (bank.MJL_isOpen(dram_pkt->row, MJL_column)) {
+    /* MJL_End */
+    /* MJL_Comment
     if (bank.openRow == dram_pkt->row) {
+    */
         // nothing to do
     } else {
         row_hit = false;
+        /* MJL_Begin */
+        // the row is open, but in the other view
+        if (bank.openRow == dram_pkt->row) {
+            ++MJL_viewSwitches;
+        }
+        /* MJL_End */
 
         // If there is a page open, precharge it.
         if (bank.openRow != Bank::NO_ROW) {
@@ -1115,7 +1349,12 @@ DRAMCtrl::doDRAMAccess(DRAMPacket* dram_pkt)
 
         // Record the activation and deal with all the global timing
         // constraints caused be a new activation (tRRD and tXAW)
+        /* MJL_Begin */
+        activateBank(rank, bank, act_tick, dram_pkt->row, MJL_column);
+        /* MJL_End */
+        /* MJL_Comment
         activateBank(rank, bank, act_tick, dram_pkt->row);
+        */
 
         // issue the command as early as possible
         cmd_at = bank.colAllowedAt;
@@ -1123,6 +1362,16 @@ DRAMCtrl::doDRAMAccess(DRAMPacket* dram_pkt)
 
     // we need to wait until the bus is available before we can issue
     // the command
+    /* MJL_Begin */
+    cmd_at = std::max(cmd_at, busBusyUntil - MJL_tCL);
+
+    // update the packet ready time
+    dram_pkt->readyTime = cmd_at + MJL_tCL + MJL_tBURST;
+
+    // only one burst can use the bus at any one point in time
+    assert(dram_pkt->readyTime - busBusyUntil >= MJL_tBURST);
+    /* MJL_End */
+    /* MJL_Comment
     cmd_at = std::max(cmd_at, busBusyUntil - tCL);
 
     // update the packet ready time
@@ -1130,6 +1379,7 @@ DRAMCtrl::doDRAMAccess(DRAMPacket* dram_pkt)
 
     // only one burst can use the bus at any one point in time
     assert(dram_pkt->readyTime - busBusyUntil >= tBURST);
+    */
 
     // update the time for the next read/write burst for each
     // bank (add a max with tCCD/tCCD_L here)
@@ -1151,14 +1401,24 @@ DRAMCtrl::doDRAMAccess(DRAMPacket* dram_pkt)
                     // cas-to-cas delay value, when either:
                     // 1) bank group architecture is not supportted
                     // 2) bank is in a different bank group
+                    /* MJL_Begin */
+                    cmd_dly = MJL_tBURST;
+                    /* MJL_End */
+                    /* MJL_Comment
                     cmd_dly = tBURST;
+                    */
                 }
             } else {
                 // different rank is by default in a different bank group
                 // use tBURST (equivalent to tCCD_S), which is the shorter
                 // cas-to-cas delay in this case
                 // Add tCS to account for rank-to-rank bus delay requirements
+                /* MJL_Begin */
+                cmd_dly = MJL_tBURST + tCS;
+                /* MJL_End */
+                /* MJL_Comment
                 cmd_dly = tBURST + tCS;
+                */
             }
             ranks[j]->banks[i].colAllowedAt = std::max(cmd_at + cmd_dly,
                                              ranks[j]->banks[i].colAllowedAt);
@@ -1215,7 +1475,13 @@ DRAMCtrl::doDRAMAccess(DRAMPacket* dram_pkt)
         while (!got_more_hits && p != queue.end()) {
             bool same_rank_bank = (dram_pkt->rank == (*p)->rank) &&
                 (dram_pkt->bank == (*p)->bank);
+            /* MJL_Begin */
+            bool same_row = dram_pkt->row == (*p)->row &&
+                MJL_column == (*p)->MJL_isColumn;
+            /* MJL_End */
+            /* MJL_Comment
             bool same_row = dram_pkt->row == (*p)->row;
+            */
             got_more_hits |= same_rank_bank && same_row;
             got_bank_conflict |= same_rank_bank && !same_row;
             ++p;
@@ -1271,17 +1537,52 @@ DRAMCtrl::doDRAMAccess(DRAMPacket* dram_pkt)
             readRowHits++;
         bytesReadDRAM += burstSize;
         perBankRdBursts[dram_pkt->bankId]++;
+        /* MJL_Begin */
+        if (MJL_column) {
+            ++MJL_readBurstsColumn;
+            if (row_hit)
+                ++MJL_readRowHitsColumn;
+        } else {
+            ++MJL_readBurstsRow;
+            if (row_hit)
+                ++MJL_readRowHitsRow;
+        }
+        /* MJL_End */
 
         // Update latency stats
         totMemAccLat += dram_pkt->readyTime - dram_pkt->entryTime;
+        /* MJL_Begin */
+        totBusLat += MJL_tBURST;
+        /* MJL_End */
+        /* MJL_Comment
         totBusLat += tBURST;
+        */
         totQLat += cmd_at - dram_pkt->entryTime;
+        /* MJL_Begin */
+        if (MJL_column)
+            MJL_totQLatColumn += cmd_at - dram_pkt->entryTime;
+        else
+            MJL_totQLatRow += cmd_at - dram_pkt->entryTime;
+        /* MJL_End */
     } else {
         ++writesThisTime;
         if (row_hit)
             writeRowHits++;
         bytesWritten += burstSize;
         perBankWrBursts[dram_pkt->bankId]++;
+        /* MJL_Begin */
+        if (MJL_column) {
+            ++MJL_writeBurstsColumn;
+            if (row_hit)
+                ++MJL_writeRowHitsColumn;
+            MJL_totWrQLatColumn += cmd_at - dram_pkt->entryTime;
+        } else {
+            ++MJL_writeBurstsRow;
+            if (row_hit)
+                ++MJL_writeRowHitsRow;
+            MJL_totWrQLatRow += cmd_at - dram_pkt->entryTime;
+        }
+        /* MJL_End */
     }
 }
 
@@ -1507,7 +1808,13 @@ DRAMCtrl::processNextReqEvent()
             reschedule(dram_pkt->rankRef.writeDoneEvent, dram_pkt->readyTime);
         }
 
+        /* MJL_Begin */
+        isInWriteQueue.erase(MJL_burstKey(dram_pkt->addr,
+                                          dram_pkt->MJL_isColumn));
+        /* MJL_End */
+        /* MJL_Comment
         isInWriteQueue.erase(burstAlign(dram_pkt->addr));
+        */
         delete dram_pkt;
 
         // If we emptied the write queue, or got sufficiently below the
@@ -1543,8 +1850,14 @@ DRAMCtrl::processNextReqEvent()
 }
 
 pair<uint64_t, bool>
+/* MJL_Begin */
+DRAMCtrl::minBankPrep(const deque<DRAMPacket*>& queue,
+                      Tick min_col_at, MJL_DirFilter MJL_dir) const
+/* MJL_End */
+/* MJL_Comment
 DRAMCtrl::minBankPrep(const deque<DRAMPacket*>& queue,
                       Tick min_col_at) const
+*/
 {
     uint64_t bank_mask = 0;
     Tick min_act_at = MaxTick;
@@ -1564,8 +1877,14 @@ DRAMCtrl::minBankPrep(const deque<DRAMPacket*>& queue,
     // bank in question
     vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
     for (const auto& p : queue) {
+        /* MJL_Begin */
+        if (p->rankRef.isAvailable() && MJL_inDir(p, MJL_dir))
+            got_waiting[p->bankId] = true;
+        /* MJL_End */
+        /* MJL_Comment
         if (p->rankRef.isAvailable())
             got_waiting[p->bankId] = true;
+        */
     }
 
     // Find command with optimal bank timing
@@ -2478,6 +2797,129 @@ DRAMCtrl::regStats()
 
     writeRowHitRate = (writeRowHits / (writeBursts - mergedWrBursts)) * 100;
 
+    /* MJL_Begin */
+    MJL_readBurstsRow
+        .name(name() + ".MJL_readBurstsRow")
+        .desc("Number of row DRAM read bursts");
+
+    MJL_readBurstsColumn
+        .name(name() + ".MJL_readBurstsColumn")
+        .desc("Number of column DRAM read bursts");
+
+    MJL_writeBurstsRow
+        .name(name() + ".MJL_writeBurstsRow")
+        .desc("Number of row DRAM write bursts");
+
+    MJL_writeBurstsColumn
+        .name(name() + ".MJL_writeBurstsColumn")
+        .desc("Number of column DRAM write bursts");
+
+    MJL_readRowHitsRow
+        .name(name() + ".MJL_readRowHitsRow")
+        .desc("Number of row buffer hits during row reads");
+
+    MJL_readRowHitsColumn
+        .name(name() + ".MJL_readRowHitsColumn")
+        .desc("Number of row buffer hits during column reads");
+
+    MJL_writeRowHitsRow
+        .name(name() + ".MJL_writeRowHitsRow")
+        .desc("Number of row buffer hits during row writes");
+
+    MJL_writeRowHitsColumn
+        .name(name() + ".MJL_writeRowHitsColumn")
+        .desc("Number of row buffer hits during column writes");
+
+    MJL_readRowHitRateRow
+        .name(name() + ".MJL_readRowHitRateRow")
+        .desc("Row buffer hit rate for row reads")
+        .precision(2);
+
+    MJL_readRowHitRateRow = (MJL_readRowHitsRow / MJL_readBurstsRow) * 100;
+
+    MJL_readRowHitRateColumn
+        .name(name() + ".MJL_readRowHitRateColumn")
+        .desc("Row buffer hit rate for column reads")
+        .precision(2);
+
+    MJL_readRowHitRateColumn =
+        (MJL_readRowHitsColumn / MJL_readBurstsColumn) * 100;
+
+    MJL_writeRowHitRateRow
+        .name(name() + ".MJL_writeRowHitRateRow")
+        .desc("Row buffer hit rate for row writes")
+        .precision(2);
+
+    MJL_writeRowHitRateRow = (MJL_writeRowHitsRow / MJL_writeBurstsRow) * 100;
+
+    MJL_writeRowHitRateColumn
+        .name(name() + ".MJL_writeRowHitRateColumn")
+        .desc("Row buffer hit rate for column writes")
+        .precision(2);
+
+    MJL_writeRowHitRateColumn =
+        (MJL_writeRowHitsColumn / MJL_writeBurstsColumn) * 100;
+
+    MJL_viewSwitches
+        .name(name() + ".MJL_viewSwitches")
+        .desc("Number of row misses where the row was open in the other "
+              "view");
+
+    MJL_dirSwitches
+        .name(name() + ".MJL_dirSwitches")
+        .desc("Number of switches between row and column bursts");
+
+    MJL_burstsPerDirSwitch
+        .init(readBufferSize + writeBufferSize)
+        .name(name() + ".MJL_burstsPerDirSwitch")
+        .desc("Bursts before switching between row and column bursts")
+        .flags(nozero);
+
+    MJL_totQLatRow
+        .name(name() + ".MJL_totQLatRow")
+        .desc("Total ticks spent queuing by row reads");
+
+    MJL_totQLatColumn
+        .name(name() + ".MJL_totQLatColumn")
+        .desc("Total ticks spent queuing by column reads");
+
+    MJL_totWrQLatRow
+        .name(name() + ".MJL_totWrQLatRow")
+        .desc("Total ticks spent queuing by row writes");
+
+    MJL_totWrQLatColumn
+        .name(name() + ".MJL_totWrQLatColumn")
+        .desc("Total ticks spent queuing by column writes");
+
+    MJL_avgQLatRow
+        .name(name() + ".MJL_avgQLatRow")
+        .desc("Average queueing delay per row read burst")
+        .precision(2);
+
+    MJL_avgQLatRow = MJL_totQLatRow / MJL_readBurstsRow;
+
+    MJL_avgQLatColumn
+        .name(name() + ".MJL_avgQLatColumn")
+        .desc("Average queueing delay per column read burst")
+        .precision(2);
+
+    MJL_avgQLatColumn = MJL_totQLatColumn / MJL_readBurstsColumn;
+
+    MJL_avgWrQLatRow
+        .name(name() + ".MJL_avgWrQLatRow")
+        .desc("Average queueing delay per row write burst")
+        .precision(2);
+
+    MJL_avgWrQLatRow = MJL_totWrQLatRow / MJL_writeBurstsRow;
+
+    MJL_avgWrQLatColumn
+        .name(name() + ".MJL_avgWrQLatColumn")
+        .desc("Average queueing delay per column write burst")
+        .precision(2);
+
+    MJL_avgWrQLatColumn = MJL_totWrQLatColumn / MJL_writeBurstsColumn;
+    /* MJL_End */
+
     readPktSize
         .init(ceilLog2(burstSize) + 1)
         .name(name() + ".readPktSize")
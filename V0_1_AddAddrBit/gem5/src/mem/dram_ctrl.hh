@@ -63,6 +63,9 @@
 #include "enums/MemSched.hh"
 #include "enums/PageManage.hh"
 #include "mem/abstract_mem.hh"
+/* MJL_Begin */
+#include "mem/addr_geometry.hh"
+/* MJL_End */
 #include "mem/qport.hh"
 #include "params/DRAMCtrl.hh"
 #include "sim/eventq.hh"
@@ -153,6 +156,22 @@ class DRAMCtrl : public AbstractMemory
     /* bus state for next request event triggered */
     BusState busStateNext;
 
+    /* MJL_Begin */
+    /**
+     * Bursts the FR-FCFS scheduler picks from when batching row and
+     * column bursts.
+     */
+    enum MJL_DirFilter {
+        MJL_anyDir = 0,
+        MJL_rowDir,
+        MJL_columnDir,
+    };
+
+    /* direction of the last burst, and bursts since the direction changed */
+    bool MJL_busColumn;
+    uint32_t MJL_burstsThisDir;
+    /* MJL_End */
+
     /**
      * Simple structure to hold the values needed to keep track of
      * commands for DRAMPower
@@ -195,11 +214,29 @@ class DRAMCtrl : public AbstractMemory
         uint32_t rowAccesses;
         uint32_t bytesAccessed;
 
+        /* MJL_Begin */
+        /** Whether the open row is open as a column view */
+        bool MJL_openColumn;
+
+        /** @return Whether the row is open in the view of the direction */
+        bool MJL_isOpen(uint32_t row, bool MJL_column) const
+        {
+            return openRow == row && MJL_openColumn == MJL_column;
+        }
+
+        Bank() :
+            openRow(NO_ROW), bank(0), bankgr(0),
+            colAllowedAt(0), preAllowedAt(0), actAllowedAt(0),
+            rowAccesses(0), bytesAccessed(0), MJL_openColumn(false)
+        { }
+        /* MJL_End */
+        /* MJL_Comment
         Bank() :
             openRow(NO_ROW), bank(0), bankgr(0),
             colAllowedAt(0), preAllowedAt(0), actAllowedAt(0),
             rowAccesses(0), bytesAccessed(0)
         { }
+        */
     };
 
 
@@ -667,6 +704,22 @@ class DRAMCtrl : public AbstractMemory
         Bank& bankRef;
         Rank& rankRef;
 
+        /* MJL_Begin */
+        /** Whether this is a column burst of a 2D controller */
+        const bool MJL_isColumn;
+
+        DRAMPacket(PacketPtr _pkt, bool is_read, uint8_t _rank, uint8_t _bank,
+                   uint32_t _row, uint16_t bank_id, Addr _addr,
+                   unsigned int _size, Bank& bank_ref, Rank& rank_ref,
+                   bool MJL_is_column = false)
+            : entryTime(curTick()), readyTime(curTick()),
+              pkt(_pkt), isRead(is_read), rank(_rank), bank(_bank), row(_row),
+              bankId(bank_id), addr(_addr), size(_size), burstHelper(NULL),
+              bankRef(bank_ref), rankRef(rank_ref),
+              MJL_isColumn(MJL_is_column)
+        { }
+        /* MJL_End */
+        /* MJL_Comment
         DRAMPacket(PacketPtr _pkt, bool is_read, uint8_t _rank, uint8_t _bank,
                    uint32_t _row, uint16_t bank_id, Addr _addr,
                    unsigned int _size, Bank& bank_ref, Rank& rank_ref)
@@ -675,6 +728,7 @@ class DRAMCtrl : public AbstractMemory
               bankId(bank_id), addr(_addr), size(_size), burstHelper(NULL),
               bankRef(bank_ref), rankRef(rank_ref)
         { }
+        */
 
     };
 
@@ -793,10 +847,41 @@ class DRAMCtrl : public AbstractMemory
      *
      * @param queue Queued requests to consider
      * @param extra_col_delay Any extra delay due to a read/write switch
+     * @param MJL_dir Direction of the bursts to consider
      * @return true if a packet is scheduled to a rank which is available else
      * false
      */
+    /* MJL_Begin */
+    bool reorderQueue(std::deque<DRAMPacket*>& queue, Tick extra_col_delay,
+                      MJL_DirFilter MJL_dir = MJL_anyDir);
+    /* MJL_End */
+    /* MJL_Comment
     bool reorderQueue(std::deque<DRAMPacket*>& queue, Tick extra_col_delay);
+    */
+
+    /* MJL_Begin */
+    /**
+     * Pick the direction of the next burst when batching row and column
+     * bursts. A batch carries on until the bursts left in its direction
+     * drop to the low threshold, or the bursts waiting in the other
+     * direction reach the high threshold, but it is never cut short
+     * before the minimum number of bursts.
+     *
+     * @param queue Queued requests to consider
+     * @param queue_size Capacity of the queue, the thresholds are a share
+     *                   of it
+     * @return Direction to schedule from
+     */
+    MJL_DirFilter MJL_chooseDir(const std::deque<DRAMPacket*>& queue,
+                                uint32_t queue_size) const;
+
+    /** @return Whether the packet goes in the direction */
+    static bool MJL_inDir(const DRAMPacket* dram_pkt, MJL_DirFilter MJL_dir)
+    {
+        return MJL_dir == MJL_anyDir ||
+            dram_pkt->MJL_isColumn == (MJL_dir == MJL_columnDir);
+    }
+    /* MJL_End */
 
     /**
      * Find which are the earliest banks ready to issue an activate
@@ -805,11 +890,20 @@ class DRAMCtrl : public AbstractMemory
      *
      * @param queue Queued requests to consider
      * @param time of seamless burst command
+     * @param MJL_dir Direction of the bursts to consider
      * @return One-hot encoded mask of bank indices
      * @return boolean indicating burst can issue seamlessly, with no gaps
      */
+    /* MJL_Begin */
+    std::pair<uint64_t, bool> minBankPrep(const std::deque<DRAMPacket*>& queue,
+                                          Tick min_col_at,
+                                          MJL_DirFilter MJL_dir =
+                                          MJL_anyDir) const;
+    /* MJL_End */
+    /* MJL_Comment
     std::pair<uint64_t, bool> minBankPrep(const std::deque<DRAMPacket*>& queue,
                                           Tick min_col_at) const;
+    */
 
     /**
      * Keep track of when row activations happen, in order to enforce
@@ -821,9 +915,16 @@ class DRAMCtrl : public AbstractMemory
      * @param bank_ref Reference to the bank
      * @param act_tick Time when the activation takes place
      * @param row Index of the row
+     * @param MJL_column Whether the row is opened as a column view
      */
+    /* MJL_Begin */
+    void activateBank(Rank& rank_ref, Bank& bank_ref, Tick act_tick,
+                      uint32_t row, bool MJL_column = false);
+    /* MJL_End */
+    /* MJL_Comment
     void activateBank(Rank& rank_ref, Bank& bank_ref, Tick act_tick,
                       uint32_t row);
+    */
 
     /**
      * Precharge a given bank and also update when the precharge is
@@ -852,6 +953,41 @@ class DRAMCtrl : public AbstractMemory
      */
     Addr burstAlign(Addr addr) const { return (addr & ~(Addr(burstSize - 1))); }
 
+    /* MJL_Begin */
+    /**
+     * @return Whether the packet is served as column bursts, only column
+     *         packets of a 2D controller are
+     */
+    bool MJL_isColumnPkt(const PacketPtr pkt) const
+    {
+        return MJL_2D && pkt->MJL_dataIsColumn();
+    }
+
+    /**
+     * Key of a burst in isInWriteQueue. A column burst is keyed by the
+     * row burst it would be in the transposed tile, with bit 0 set so the
+     * two directions never share a key.
+     */
+    Addr MJL_burstKey(Addr addr, bool MJL_column) const
+    {
+        return MJL_column ?
+            burstAlign(MJL_geometry.MJL_swapRowColBits(addr)) | 1 :
+            burstAlign(addr);
+    }
+
+    /** @return CAS latency of the burst direction */
+    Tick MJL_getTCL(bool MJL_column) const
+    {
+        return MJL_column ? MJL_tCLColumn : tCL;
+    }
+
+    /** @return Burst duration of the burst direction */
+    Tick MJL_getTBURST(bool MJL_column) const
+    {
+        return MJL_column ? MJL_tBURSTColumn : tBURST;
+    }
+    /* MJL_End */
+
     /**
      * The controller's main read and write queues
      */
@@ -934,6 +1070,27 @@ class DRAMCtrl : public AbstractMemory
     const Tick tXAW;
     const Tick tXP;
     const Tick tXS;
+    /* MJL_Begin */
+    /**
+     * Multi-view DRAM, each tile is kept in one row that opens as a row
+     * or a column view, and column packets are single column bursts
+     */
+    const bool MJL_2D;
+    const MJL_AddrGeometry &MJL_geometry;
+    const Tick MJL_tRCDColumn;
+    const Tick MJL_tCLColumn;
+    const Tick MJL_tBURSTColumn;
+    /**
+     * Batching of row and column bursts, the thresholds are percentages
+     * of the queue capacity, and tDS is the bus turnaround between the
+     * directions
+     */
+    const bool MJL_dirBatching;
+    const uint32_t MJL_dirHighThreshPerc;
+    const uint32_t MJL_dirLowThreshPerc;
+    const uint32_t MJL_minBurstsPerDirSwitch;
+    const Tick MJL_tDS;
+    /* MJL_End */
     const uint32_t activationLimit;
 
     /**
@@ -1036,6 +1193,37 @@ class DRAMCtrl : public AbstractMemory
     Stats::Formula writeRowHitRate;
     Stats::Formula avgGap;
 
+    /* MJL_Begin */
+    // Bursts and row hits per direction, and row misses where the row
+    // was open in the other view
+    Stats::Scalar MJL_readBurstsRow;
+    Stats::Scalar MJL_readBurstsColumn;
+    Stats::Scalar MJL_writeBurstsRow;
+    Stats::Scalar MJL_writeBurstsColumn;
+    Stats::Scalar MJL_readRowHitsRow;
+    Stats::Scalar MJL_readRowHitsColumn;
+    Stats::Scalar MJL_writeRowHitsRow;
+    Stats::Scalar MJL_writeRowHitsColumn;
+    Stats::Formula MJL_readRowHitRateRow;
+    Stats::Formula MJL_readRowHitRateColumn;
+    Stats::Formula MJL_writeRowHitRateRow;
+    Stats::Formula MJL_writeRowHitRateColumn;
+    Stats::Scalar MJL_viewSwitches;
+
+    // Switches between row and column bursts, and queueing latency per
+    // direction
+    Stats::Scalar MJL_dirSwitches;
+    Stats::Histogram MJL_burstsPerDirSwitch;
+    Stats::Scalar MJL_totQLatRow;
+    Stats::Scalar MJL_totQLatColumn;
+    Stats::Scalar MJL_totWrQLatRow;
+    Stats::Scalar MJL_totWrQLatColumn;
+    Stats::Formula MJL_avgQLatRow;
+    Stats::Formula MJL_avgQLatColumn;
+    Stats::Formula MJL_avgWrQLatRow;
+    Stats::Formula MJL_avgWrQLatColumn;
+    /* MJL_End */
+
     // DRAM Power Calculation
     Stats::Formula pageHitRate;
 
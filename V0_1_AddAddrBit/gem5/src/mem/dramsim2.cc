@@ -52,7 +52,13 @@ DRAMSim2::DRAMSim2(const Params* p) :
             p->traceFile, p->range.size() / 1024 / 1024, p->enableDebug/* MJL_Begin */, p->MJL_row_width/* MJL_End */),
     retryReq(false), retryResp(false), startTick(0),
     nbrOutstandingReads(0), nbrOutstandingWrites(0),
+    /* MJL_Begin */
+    sendResponseEvent(this), tickEvent(this),
+    MJL_idleSkip(p->MJL_idle_skip), MJL_clockPeriod(0), MJL_lastTick(0)
+    /* MJL_End */
+    /* MJL_Comment
     sendResponseEvent(this), tickEvent(this)
+    */
 {
     DPRINTF(DRAMSim2,
             "Instantiated DRAMSim2 with clock %d ns and queue size %d\n",
@@ -76,10 +82,19 @@ DRAMSim2::DRAMSim2(const Params* p) :
     */
     wrapper.setCallbacks(read_cb, write_cb);
 
+    /* MJL_Begin */
+    MJL_outstandingReads.reserve(wrapper.queueSize());
+    MJL_outstandingWrites.reserve(wrapper.queueSize());
+
     // Register a callback to compensate for the destructor not
     // being called. The callback prints the DRAMSim2 stats.
+    Callback* cb = new MakeCallback<DRAMSim2,
+        &DRAMSim2::MJL_printStats>(this);
+    /* MJL_End */
+    /* MJL_Comment
     Callback* cb = new MakeCallback<DRAMSim2Wrapper,
         &DRAMSim2Wrapper::printStats>(wrapper);
+    */
     registerExitCallback(cb);
 }
 
@@ -103,11 +118,52 @@ void
 DRAMSim2::startup()
 {
     startTick = curTick();
+    /* MJL_Begin */
+    MJL_clockPeriod = wrapper.clockPeriod() * SimClock::Int::ns;
+    /* MJL_End */
 
     // kick off the clock ticks
     schedule(tickEvent, clockEdge());
 }
 
+/* MJL_Begin */
+void
+DRAMSim2::MJL_catchUp()
+{
+    assert(!tickEvent.scheduled());
+
+    // the cycles that would have been ticked before now
+    const Tick next_tick = MJL_lastTick + MJL_clockPeriod;
+    if (curTick() <= next_tick)
+        return;
+    const uint64_t cycles = divCeil(curTick() - next_tick, MJL_clockPeriod);
+
+    // nothing is outstanding, so no transaction completes on the way,
+    // and only the refreshes need to be ticked through
+    uint64_t left = cycles;
+    while (left != 0) {
+        uint64_t skipped = wrapper.MJL_skipIdle(left);
+        if (skipped == 0) {
+            wrapper.tick();
+            skipped = 1;
+        }
+        left -= skipped;
+    }
+
+    MJL_lastTick = next_tick + (cycles - 1) * MJL_clockPeriod;
+
+    DPRINTF(DRAMSim2, "Caught up %d idle cycles\n", cycles);
+}
+
+void
+DRAMSim2::MJL_printStats()
+{
+    if (MJL_clockPeriod != 0 && !tickEvent.scheduled())
+        MJL_catchUp();
+    wrapper.printStats();
+}
+/* MJL_End */
+
 void
 DRAMSim2::sendResponse()
 {
@@ -156,6 +212,17 @@ DRAMSim2::tick()
         port.sendRetryReq();
     }
 
+    /* MJL_Begin */
+    // with nothing outstanding DRAMSim2 only counts down to the next
+    // refresh, so stop ticking and catch up on the next request
+    if (MJL_idleSkip && nbrOutstandingReads == 0 &&
+        nbrOutstandingWrites == 0 && !retryReq) {
+        MJL_lastTick = curTick();
+        DPRINTF(DRAMSim2, "Idle, stopping the clock ticks\n");
+        return;
+    }
+    /* MJL_End */
+
     schedule(tickEvent, curTick() + wrapper.clockPeriod() * SimClock::Int::ns);
 }
 
@@ -202,6 +269,19 @@ DRAMSim2::recvTimingReq(PacketPtr pkt)
     if (retryReq)
         return false;
 
+    /* MJL_Begin */
+    // DRAMSim2 takes one transaction per burst
+    fatal_if(pkt->MJL_isTile(), "%s does not take tile packets, set "
+             "MJL_tile_packets to False in the physically 2D cache\n",
+             name());
+
+    // restart the clock ticks on the DRAMSim2 cycle grid
+    if (!tickEvent.scheduled()) {
+        MJL_catchUp();
+        schedule(tickEvent, MJL_lastTick + MJL_clockPeriod);
+    }
+    /* MJL_End */
+
     // if we cannot accept we need to send a retry once progress can
     // be made
     bool can_accept = nbrOutstanding() < wrapper.queueSize();
@@ -210,7 +290,8 @@ DRAMSim2::recvTimingReq(PacketPtr pkt)
     if (pkt->isRead()) {
         if (can_accept) {
             /* MJL_Begin */
-            MJL_outstandingReads[pkt->MJL_getDataDir()][pkt->getAddr()].push(pkt);
+            MJL_outstandingReads.push_back({MJL_outstandingKey(
+                pkt->MJL_getDataDir(), pkt->getAddr()), pkt});
             /* MJL_End */
             /* MJL_Comment
             outstandingReads[pkt->getAddr()].push(pkt);
@@ -224,7 +305,8 @@ DRAMSim2::recvTimingReq(PacketPtr pkt)
     } else if (pkt->isWrite()) {
         if (can_accept) {
             /* MJL_Begin */
-            MJL_outstandingWrites[pkt->MJL_getDataDir()][pkt->getAddr()].push(pkt);
+            MJL_outstandingWrites.push_back({MJL_outstandingKey(
+                pkt->MJL_getDataDir(), pkt->getAddr()), pkt});
             /* MJL_End */
             /* MJL_Comment
             outstandingWrites[pkt->getAddr()].push(pkt);
@@ -347,17 +429,11 @@ void DRAMSim2::MJL_readComplete(unsigned id, uint64_t addr, uint64_t cycle, unsi
 
     DPRINTF(DRAMSim2, "Read to address %lld complete\n", addr);
 
-    // get the outstanding reads for the address in question
-    auto p = MJL_outstandingReads[MJL_dataDir].find(addr);
-    assert(p != MJL_outstandingReads[MJL_dataDir].end());
-
+    // get the oldest outstanding read for the address in question,
     // first in first out, which is not necessarily true, but it is
     // the best we can do at this point
-    PacketPtr pkt = p->second.front();
-    p->second.pop();
-
-    if (p->second.empty())
-        MJL_outstandingReads[MJL_dataDir].erase(p);
+    PacketPtr pkt = MJL_popOutstanding(MJL_outstandingReads, MJL_dataDir,
+                                       addr);
 
     // no need to check for drain here as the next call will add a
     // response to the response queue straight away
@@ -400,15 +476,9 @@ void DRAMSim2::MJL_writeComplete(unsigned id, uint64_t addr, uint64_t cycle, uns
 
     DPRINTF(DRAMSim2, "Write to address %lld complete\n", addr);
 
-    // get the outstanding reads for the address in question
-    auto p = MJL_outstandingWrites[MJL_dataDir].find(addr);
-    assert(p != MJL_outstandingWrites[MJL_dataDir].end());
-
     // we have already responded, and this is only to keep track of
     // what is outstanding
-    p->second.pop();
-    if (p->second.empty())
-        MJL_outstandingWrites[MJL_dataDir].erase(p);
+    MJL_popOutstanding(MJL_outstandingWrites, MJL_dataDir, addr);
 
     assert(nbrOutstandingWrites != 0);
     --nbrOutstandingWrites;
@@ -418,6 +488,23 @@ void DRAMSim2::MJL_writeComplete(unsigned id, uint64_t addr, uint64_t cycle, uns
 }
 /* MJL_End */
 
+/* MJL_Begin */
+PacketPtr
+DRAMSim2::MJL_popOutstanding(std::vector<MJL_Outstanding>& table,
+                             unsigned MJL_dataDir, Addr addr)
+{
+    const Addr key = MJL_outstandingKey(MJL_dataDir, addr);
+    auto p = table.begin();
+    while (p != table.end() && p->MJL_key != key)
+        ++p;
+    assert(p != table.end());
+
+    PacketPtr pkt = p->pkt;
+    table.erase(p);
+    return pkt;
+}
+/* MJL_End */
+
 BaseSlavePort&
 DRAMSim2::getSlavePort(const std::string &if_name, PortID idx)
 {
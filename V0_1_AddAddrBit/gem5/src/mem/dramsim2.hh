@@ -46,6 +46,9 @@
 
 #include <queue>
 #include <unordered_map>
+/* MJL_Begin */
+#include <vector>
+/* MJL_End */
 
 #include "mem/abstract_mem.hh"
 #include "mem/dramsim2_wrapper.hh"
@@ -117,8 +120,32 @@ class DRAMSim2 : public AbstractMemory
     std::unordered_map<Addr, std::queue<PacketPtr> > outstandingReads;
     std::unordered_map<Addr, std::queue<PacketPtr> > outstandingWrites;
     /* MJL_Begin */
-    std::map<unsigned, std::unordered_map<Addr, std::queue<PacketPtr> > > MJL_outstandingReads;
-    std::map<unsigned, std::unordered_map<Addr, std::queue<PacketPtr> > > MJL_outstandingWrites;
+    /**
+     * Outstanding transactions in arrival order, keyed by direction and
+     * address. There are at most as many as the DRAMSim2 queue holds, so
+     * a flat table that is searched from the oldest end is cheaper than
+     * a map of queues, and gives the same first in first out order.
+     */
+    struct MJL_Outstanding
+    {
+        Addr MJL_key;
+        PacketPtr pkt;
+    };
+    std::vector<MJL_Outstanding> MJL_outstandingReads;
+    std::vector<MJL_Outstanding> MJL_outstandingWrites;
+
+    static Addr MJL_outstandingKey(unsigned MJL_dataDir, Addr addr)
+    {
+        return (addr << 2) | MJL_dataDir;
+    }
+
+    /**
+     * Remove the oldest transaction with the direction and address.
+     *
+     * @return The packet of the transaction
+     */
+    PacketPtr MJL_popOutstanding(std::vector<MJL_Outstanding>& table,
+                                 unsigned MJL_dataDir, Addr addr);
     /* MJL_End */
 
     /**
@@ -164,6 +191,26 @@ class DRAMSim2 : public AbstractMemory
      */
     EventWrapper<DRAMSim2, &DRAMSim2::tick> tickEvent;
 
+    /* MJL_Begin */
+    /** Stop the clock ticks while nothing is outstanding */
+    const bool MJL_idleSkip;
+
+    /** DRAMSim2 clock period in ticks */
+    Tick MJL_clockPeriod;
+
+    /** Time of the last DRAMSim2 cycle, kept when the ticks stop */
+    Tick MJL_lastTick;
+
+    /**
+     * Bring DRAMSim2 to the cycles the stopped clock ticks missed, up
+     * to but not including the current tick.
+     */
+    void MJL_catchUp();
+
+    /** Catch up before printing the DRAMSim2 stats at exit */
+    void MJL_printStats();
+    /* MJL_End */
+
     /**
      * Upstream caches need this packet until true is returned, so
      * hold it for deletion until a subsequent call
@@ -208,3 +208,11 @@ DRAMSim2Wrapper::tick()
 {
     dramsim->update();
 }
+
+/* MJL_Begin */
+uint64_t
+DRAMSim2Wrapper::MJL_skipIdle(uint64_t cycles)
+{
+    return dramsim->MJL_skipIdle(cycles);
+}
+/* MJL_End */
@@ -161,6 +161,18 @@ class DRAMSim2Wrapper
      * Progress the memory controller one cycle
      */
     void tick();
+
+    /* MJL_Begin */
+    /**
+     * Fast-forward the memory controller over cycles where nothing
+     * happens, with the same outcome as ticking it for them. It stops
+     * short of refreshes and stats epochs.
+     *
+     * @param cycles Most cycles to skip
+     * @return The cycles skipped, 0 if the next cycle has to be ticked
+     */
+    uint64_t MJL_skipIdle(uint64_t cycles);
+    /* MJL_End */
 };
 
 #endif //__MEM_DRAMSIM2_WRAPPER_HH__
@@ -325,18 +325,22 @@ Packet::checkFunctional(Printable *obj, Addr addr, bool is_secure, int size,
 }
 
 /* MJL_Begin */
+const unsigned Packet::MJL_maxBlkSize;
+const unsigned Packet::MJL_maxBlkWords;
+
 bool
 Packet::MJL_checkFunctional(Printable *obj, Addr addr, MemCmd::MJL_DirAttribute MJL_cmdDir, bool is_secure, int size,
                         uint8_t *_data)
 {
+    const MJL_AddrGeometry &MJL_geometry = *req->MJL_geometry;
     // Assuming direction for this packet is always row
     assert(MJL_getCmdDir() == MemCmd::MJL_DirAttribute::MJL_IsRow);
     // Assuming that do not go over a cache line size 
-    assert((getAddr() & Addr(req->MJL_cachelineSize - 1)) + getSize() <= req->MJL_cachelineSize);
+    assert((getAddr() & Addr(MJL_geometry.MJL_blkSize - 1)) + getSize() <= MJL_geometry.MJL_blkSize);
     if (MJL_cmdDir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-        assert((addr & Addr(req->MJL_cachelineSize - 1)) + size <= req->MJL_cachelineSize);
+        assert((addr & Addr(MJL_geometry.MJL_blkSize - 1)) + size <= MJL_geometry.MJL_blkSize);
     } else if (MJL_cmdDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-        assert((MJL_swapRowColBits(addr, req->MJL_cachelineSize, req->MJL_rowWidth) & Addr(req->MJL_cachelineSize - 1)) + size <= req->MJL_cachelineSize);
+        assert((MJL_geometry.MJL_swapRowColBits(addr) & Addr(MJL_geometry.MJL_blkSize - 1)) + size <= MJL_geometry.MJL_blkSize);
     } else {
         assert((MJL_cmdDir == MemCmd::MJL_DirAttribute::MJL_IsRow) || (MJL_cmdDir == MemCmd::MJL_DirAttribute::MJL_IsColumn));
     }
@@ -345,13 +349,13 @@ Packet::MJL_checkFunctional(Printable *obj, Addr addr, MemCmd::MJL_DirAttribute
     Addr val_start  = addr;
     Addr val_end    = val_start + size - 1;
     if (MJL_cmdDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-        val_end = MJL_swapRowColBits(MJL_swapRowColBits(val_start, req->MJL_cachelineSize, req->MJL_rowWidth) + size - 1, req->MJL_cachelineSize, req->MJL_rowWidth);
+        val_end = MJL_geometry.MJL_swapRowColBits(MJL_geometry.MJL_swapRowColBits(val_start) + size - 1);
     }
 
     if (is_secure != _isSecure || 
         ((MJL_getCmdDir() == MJL_cmdDir) && (func_start > val_end)) || // same direction, but do not overlap
         ((MJL_getCmdDir() == MJL_cmdDir) && (val_start > func_end)) ||
-        ((MJL_getCmdDir() != MJL_cmdDir) && ((val_start & ~MJL_commonMask(req->MJL_cachelineSize, req->MJL_rowWidth)) != (func_start & ~MJL_commonMask(req->MJL_cachelineSize, req->MJL_rowWidth))))) { // different direction, but not the same tile
+        ((MJL_getCmdDir() != MJL_cmdDir) && (MJL_geometry.MJL_commonBits(val_start) != MJL_geometry.MJL_commonBits(func_start)))) { // different direction, but not the same tile
         // no intersection
         return false;
     }
@@ -462,11 +466,11 @@ Packet::MJL_checkFunctional(Printable *obj, Addr addr, MemCmd::MJL_DirAttribute
             panic("Don't know how to handle command %s\n", cmdString());
         }
     } else { // Different direction, at most 1 word overlap
-        Addr MJL_thisBlkAddr = getBlockAddr(req->MJL_cachelineSize);
-        Addr MJL_inBlkAddr = addr & ~(Addr(MJL_blkMaskColumn(req->MJL_cachelineSize, req->MJL_rowWidth)));
-        Addr MJL_thisWordOffset = (val_start & Addr(req->MJL_cachelineSize - 1)) >> floorLog2(sizeof(uint64_t));
-        Addr MJL_inWordOffset = (MJL_swapRowColBits(func_start, req->MJL_cachelineSize, req->MJL_rowWidth) & Addr(req->MJL_cachelineSize - 1)) >> floorLog2(sizeof(uint64_t));
-        Addr MJL_rowSize = req->MJL_cachelineSize * req->MJL_rowWidth;
+        Addr MJL_thisBlkAddr = getBlockAddr(MJL_geometry.MJL_blkSize);
+        Addr MJL_inBlkAddr = MJL_geometry.MJL_colBlockAlign(addr);
+        Addr MJL_thisWordOffset = (val_start & Addr(MJL_geometry.MJL_blkSize - 1)) >> MJL_geometry.MJL_rowShift;
+        Addr MJL_inWordOffset = (MJL_geometry.MJL_swapRowColBits(func_start) & Addr(MJL_geometry.MJL_blkSize - 1)) >> MJL_geometry.MJL_rowShift;
+        Addr MJL_rowSize = MJL_geometry.MJL_blkSize * MJL_geometry.MJL_rowWidth;
         Addr MJL_func_wordStart = MJL_thisBlkAddr +  (Addr)MJL_thisWordOffset * sizeof(uint64_t);
         Addr MJL_val_wordStart = MJL_inBlkAddr + (Addr)MJL_inWordOffset * MJL_rowSize;
         int MJL_size = min(min(sizeof(uint64_t), func_end - MJL_func_wordStart + 1), val_end - MJL_func_wordStart + 1);
@@ -475,7 +479,7 @@ Packet::MJL_checkFunctional(Printable *obj, Addr addr, MemCmd::MJL_DirAttribute
         if ((MJL_func_wordStart > func_end) || (MJL_func_wordStart + MJL_size - 1 < func_start) || (MJL_val_wordStart > val_end) || (MJL_val_wordStart + MJL_size - 1 < val_start)) { // Crossing word is out of range, actually no intersection
             return false;
         } else {
-            Addr MJL_inDataOffset = MJL_swapRowColBits(MJL_val_wordStart, req->MJL_cachelineSize, req->MJL_rowWidth) - MJL_swapRowColBits(val_start, req->MJL_cachelineSize, req->MJL_rowWidth);
+            Addr MJL_inDataOffset = MJL_geometry.MJL_swapRowColBits(MJL_val_wordStart) - MJL_geometry.MJL_swapRowColBits(val_start);
             Addr MJL_thisDataOffset = MJL_val_wordStart - func_start;
             if (val_start > MJL_func_wordStart || func_start > MJL_func_wordStart) {
                 if (val_start >= func_start) {
@@ -500,13 +504,9 @@ Packet::MJL_checkFunctional(Printable *obj, Addr addr, MemCmd::MJL_DirAttribute
 
                 int MJL_i = 0;
                 
-                bool MJL_word_dirty = true;
-                if (!MJL_bytesDirty.empty()) {
-                    for (int i = MJL_thisDataOffset; i < MJL_thisDataOffset + MJL_size; ++i) {
-                        MJL_word_dirty &= MJL_bytesDirty[i];
-                    }
-                } else {
-                    MJL_word_dirty = false;
+                bool MJL_word_dirty = !MJL_bytesDirty.empty();
+                for (int i = MJL_thisDataOffset; MJL_word_dirty && i < MJL_thisDataOffset + MJL_size; ++i) {
+                    MJL_word_dirty &= MJL_bytesDirty[i];
                 }
           
                 if (!MJL_word_dirty) {
@@ -546,19 +546,20 @@ Packet::MJL_checkFunctional(Printable *obj, Addr addr, MemCmd::MJL_DirAttribute
 
 bool Packet::MJL_setHaveDirty(Addr addr, MemCmd::MJL_DirAttribute MJL_cmdDir, bool is_secure, int size,
                         uint8_t *_data) {
+    const MJL_AddrGeometry &MJL_geometry = *req->MJL_geometry;
     Addr func_start = getAddr();
     Addr func_end   = getAddr() + getSize() - 1;
     Addr val_start  = addr;
-    Addr val_end    = MJL_swapRowColBits(MJL_swapRowColBits(val_start, req->MJL_cachelineSize, req->MJL_rowWidth) + size - 1, req->MJL_cachelineSize, req->MJL_rowWidth);
+    Addr val_end    = MJL_geometry.MJL_swapRowColBits(MJL_geometry.MJL_swapRowColBits(val_start) + size - 1);
     // Should only be used when checking for different directions
     assert(MJL_getCmdDir() != MJL_cmdDir);
-    if (((val_start & ~MJL_commonMask(req->MJL_cachelineSize, req->MJL_rowWidth)) != (func_start & ~MJL_commonMask(req->MJL_cachelineSize, req->MJL_rowWidth))) || isPrint() || (is_secure != _isSecure) || (!_data)) {
+    if ((MJL_geometry.MJL_commonBits(val_start) != MJL_geometry.MJL_commonBits(func_start)) || isPrint() || (is_secure != _isSecure) || (!_data)) {
         return false;
     }
 
     if (isRead()) {
-        Addr MJL_thisBlkAddr = getBlockAddr(req->MJL_cachelineSize);
-        Addr MJL_thisWordOffset = (val_start & Addr(req->MJL_cachelineSize - 1)) >> floorLog2(sizeof(uint64_t));
+        Addr MJL_thisBlkAddr = getBlockAddr(MJL_geometry.MJL_blkSize);
+        Addr MJL_thisWordOffset = (val_start & Addr(MJL_geometry.MJL_blkSize - 1)) >> MJL_geometry.MJL_rowShift;
         Addr MJL_func_wordStart = MJL_thisBlkAddr +  (Addr)MJL_thisWordOffset * sizeof(uint64_t);
         int MJL_size = min(min(sizeof(uint64_t), func_end - MJL_func_wordStart + 1), val_end - MJL_func_wordStart + 1);
         // Should be pinpointing the same word
@@ -59,6 +59,10 @@
 #include "base/cast.hh"
 #include "base/compiler.hh"
 #include "base/flags.hh"
+/* MJL_Begin */
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+/* MJL_End */
 #include "base/misc.hh"
 #include "base/printable.hh"
 #include "base/types.hh"
@@ -290,6 +294,12 @@ class Packet : public Printable
   public:
     typedef uint32_t FlagsType;
     typedef ::Flags<FlagsType> Flags;
+    /* MJL_Begin */
+    /** Largest block size the per word masks can cover */
+    static const unsigned MJL_maxBlkSize = 64;
+    static const unsigned MJL_maxBlkWords = MJL_maxBlkSize/sizeof(uint64_t);
+    typedef std::bitset<MJL_maxBlkWords> MJL_WordMask;
+    /* MJL_End */
 
   private:
 
@@ -375,6 +385,11 @@ class Packet : public Printable
      */
     std::vector<bool> bytesValid;
     /* MJL_Begin */
+    /**
+     * Bytes of a functional read found in a crossing block, sized to the
+     * packet on first use, so a functional access of any size works and
+     * one that never meets a crossing block does not allocate
+     */
     std::vector<bool> MJL_bytesValid;
     std::vector<bool> MJL_bytesDirty;
     /* MJL_End */
@@ -554,59 +569,65 @@ class Packet : public Printable
     int MJL_testSeq; // Used to identify packet during test
     bool MJL_hasOrder;
     Counter MJL_order;
-    bool MJL_wordDirty[8]; // Used to identify dirty words for cross direction checks
-    bool MJL_crossBlocksCached[8]; // Used to identify whether the crossing blocks are cached in above caches in physicaly 2D L2 cache mode
-    bool MJL_wordDemanded[8]; // Used to identify words demanded
-    bool MJL_isStale[8]; // Used to identify whether the response data will have stale data due to modification on crossing block on miss
+    MJL_WordMask MJL_wordDirty; // Used to identify dirty words for cross direction checks
+    MJL_WordMask MJL_crossBlocksCached; // Used to identify whether the crossing blocks are cached in above caches in physicaly 2D L2 cache mode
+    MJL_WordMask MJL_wordDemanded; // Used to identify words demanded
+    MJL_WordMask MJL_isStale; // Used to identify whether the response data will have stale data due to modification on crossing block on miss
     bool MJL_hasSharersFlag; // Used to prevent illegal passing of writable
-    void MJL_copyWordDemanded( bool in_MJL_wordDemanded[8] ) {
-        for (int i = 0; i < 8; ++i) {
-            MJL_wordDemanded[i] = in_MJL_wordDemanded[i];
+    /**
+     * Lines of a tile packet. Bit i of MJL_tileMask is set when line i of
+     * the tile is carried, and the carried lines are in MJL_tileLines in
+     * tile order. The line packets keep their headers for the snoop
+     * filters and memory controllers, and the payload of the tile packet
+     * holds their data back to back. A packet with an empty mask is not a
+     * tile packet.
+     */
+    uint8_t MJL_tileMask;
+    PacketPtr MJL_tileLines[MJL_maxBlkWords];
+    /** @return Mask of n words starting from word first */
+    static MJL_WordMask MJL_wordRangeMask(unsigned first, unsigned n) {
+        assert(first + n <= MJL_maxBlkWords);
+        MJL_WordMask MJL_mask;
+        if (n > 0) {
+            MJL_mask.set();
+            MJL_mask >>= MJL_maxBlkWords - n;
+            MJL_mask <<= first;
         }
+        return MJL_mask;
     }
-    void MJL_copyCrossBlocksCached( bool in_MJL_crossBlocksCached[8] ) {
-        for (int i = 0; i < 8; ++i) {
-            MJL_crossBlocksCached[i] |= in_MJL_crossBlocksCached[i];
-        }
+    /** @return Mask of the words covered by the packet data */
+    MJL_WordMask MJL_getSizeWordMask() const {
+        return MJL_wordRangeMask(0, divCeil(getSize(), sizeof(uint64_t)));
     }
-    void MJL_setWordDirtyFromBlk( bool MJL_blkWordDirty[8], unsigned blkSize) {
+    void MJL_copyWordDemanded( const MJL_WordMask &in_MJL_wordDemanded ) {
+        MJL_wordDemanded = in_MJL_wordDemanded;
+    }
+    void MJL_copyCrossBlocksCached( const MJL_WordMask &in_MJL_crossBlocksCached ) {
+        MJL_crossBlocksCached |= in_MJL_crossBlocksCached;
+    }
+    void MJL_setWordDirtyFromBlk( const bool *MJL_blkWordDirty, unsigned blkSize) {
         for (int i = 0; i < getSize(); i = i + sizeof(uint64_t)) {
             MJL_wordDirty[i/sizeof(uint64_t)] = MJL_blkWordDirty[(i + getOffset(blkSize))/sizeof(uint64_t)];
         }
     }
-    void MJL_copyWordDirty( bool MJL_otherWordDirty[]) {
-        for (int i = 0; i < size/sizeof(uint64_t); ++i) {
-            MJL_wordDirty[i] = MJL_otherWordDirty[i];
-        }
+    void MJL_copyWordDirty( const MJL_WordMask &MJL_otherWordDirty ) {
+        MJL_WordMask MJL_mask = MJL_wordRangeMask(0, size/sizeof(uint64_t));
+        MJL_wordDirty = (MJL_otherWordDirty & MJL_mask) | (MJL_wordDirty & ~MJL_mask);
     }
     void MJL_setAllDirty() {
-        for (int i = 0; i < getSize(); i = i + sizeof(uint64_t)) {
-            MJL_wordDirty[i/sizeof(uint64_t)] = true;
-        }
+        MJL_wordDirty |= MJL_getSizeWordMask();
     }
     bool MJL_hasStale() const {
-        bool MJL_hasStaleWord = false;
-        for (int i = 0; i < getSize(); i = i + sizeof(uint64_t)) {
-            MJL_hasStaleWord |= MJL_isStale[i/sizeof(uint64_t)];
-        }
-        return MJL_hasStaleWord;
+        return (MJL_isStale & MJL_getSizeWordMask()).any();
     }
-    void MJL_copyIsStale( bool in_MJL_isStale[8] ) {
-        for (int i = 0; i < 8; ++i) {
-            MJL_isStale[i] = in_MJL_isStale[i];
-        }
+    void MJL_copyIsStale( const MJL_WordMask &in_MJL_isStale ) {
+        MJL_isStale = in_MJL_isStale;
     }
-    void MJL_setIsStaleFromResp( bool in_MJL_isStale[8], MemCmd::MJL_DirAttribute in_pkt_dir, unsigned blkSize ) {
-        for (int i = 0; i < getSize(); i = i + sizeof(uint64_t)) {
-            MJL_isStale[i/sizeof(uint64_t)] |= in_MJL_isStale[(i + MJL_getDirOffset(blkSize, in_pkt_dir))/sizeof(uint64_t)];
-        }
+    void MJL_setIsStaleFromResp( const MJL_WordMask &in_MJL_isStale, MemCmd::MJL_DirAttribute in_pkt_dir, unsigned blkSize ) {
+        MJL_isStale |= (in_MJL_isStale >> (MJL_getDirOffset(blkSize, in_pkt_dir)/sizeof(uint64_t))) & MJL_getSizeWordMask();
     }
-    bool MJL_checkIsStaleFromResp( bool in_MJL_isStale[8], MemCmd::MJL_DirAttribute in_pkt_dir, unsigned blkSize ) const {
-        bool MJL_willHaveStale = false;
-        for (int i = 0; i < getSize(); i = i + sizeof(uint64_t)) {
-            MJL_willHaveStale |= in_MJL_isStale[(i + MJL_getDirOffset(blkSize, in_pkt_dir))/sizeof(uint64_t)];
-        }
-        return MJL_willHaveStale;
+    bool MJL_checkIsStaleFromResp( const MJL_WordMask &in_MJL_isStale, MemCmd::MJL_DirAttribute in_pkt_dir, unsigned blkSize ) const {
+        return ((in_MJL_isStale >> (MJL_getDirOffset(blkSize, in_pkt_dir)/sizeof(uint64_t))) & MJL_getSizeWordMask()).any();
     }
     void MJL_setHasSharers() {
         MJL_hasSharersFlag = true;
@@ -614,6 +635,36 @@ class Packet : public Printable
     bool MJL_hasSharers() const {
         return MJL_hasSharersFlag;
     }
+    /** @return Whether this is a tile packet */
+    bool MJL_isTile() const { return MJL_tileMask != 0; }
+    /** @return The number of lines carried by a tile packet */
+    unsigned MJL_tileLineCount() const { return popCount(MJL_tileMask); }
+    /** @return The k-th line carried by a tile packet */
+    PacketPtr MJL_getTileLine(unsigned k) const {
+        assert(k < MJL_tileLineCount());
+        return MJL_tileLines[k];
+    }
+    /**
+     * Carry line i of the tile, lines have to be added in tile order. The
+     * tile packet owns its lines until they are released.
+     */
+    void MJL_addTileLine(unsigned i, PacketPtr line) {
+        assert(i < MJL_maxBlkWords && (MJL_tileMask >> i) == 0);
+        MJL_tileLines[MJL_tileLineCount()] = line;
+        MJL_tileMask |= 1 << i;
+    }
+    /**
+     * Hand the lines back, after which this is not a tile packet any more.
+     * @return The number of lines written to lines
+     */
+    unsigned MJL_releaseTileLines(PacketPtr *lines) {
+        unsigned n = MJL_tileLineCount();
+        for (unsigned k = 0; k < n; ++k) {
+            lines[k] = MJL_tileLines[k];
+        }
+        MJL_tileMask = 0;
+        return n;
+    }
     MemCmd::MJL_DirAttribute MJL_getCmdDir() const { return cmd.MJL_getCmdDir(); }
     MemCmd::MJL_DirAttribute MJL_getCrossCmdDir() const {
         if (cmd.MJL_isRow()) {
@@ -633,11 +684,11 @@ class Packet : public Printable
     void MJL_setDataDir( MemCmd::MJL_DirAttribute in_MJL_dataDir ) { MJL_dataDir = in_MJL_dataDir; }
     MemCmd::MJL_DirAttribute MJL_getPfPredDir() const { return MJL_pfPredDir; }
     void MJL_setPfPredDir( MemCmd::MJL_DirAttribute in_MJL_pfPredDir ) { MJL_pfPredDir = in_MJL_pfPredDir; }
-    bool MJL_hasDirty(int MJL_byte) {
-        if (MJL_bytesDirty.empty())
-            MJL_bytesDirty.resize(getSize(), false);
-        return MJL_bytesDirty[MJL_byte];
+    bool MJL_hasDirty(int MJL_byte) const {
+        return (unsigned)MJL_byte < MJL_bytesDirty.size() && MJL_bytesDirty[MJL_byte];
     }
+    /** Whether a functional read already holds bytes newer than memory */
+    bool MJL_hasAnyDirty() const { return !MJL_bytesDirty.empty(); }
     /* MJL_End */
     bool isRead() const              { return cmd.isRead(); }
     bool isWrite() const             { return cmd.isWrite(); }
@@ -794,49 +845,16 @@ class Packet : public Printable
     unsigned getSize() const  { assert(flags.isSet(VALID_SIZE)); return size; }
 
     /* MJL_Begin */
-    inline int
-    floorLog2(unsigned long x) const
-    {
-        assert(x > 0);
-
-        int y = 0;
-
-#if defined(__LP64__)
-        if (x & ULL(0xffffffff00000000)) { y += 32; x >>= 32; }
-#endif
-        if (x & 0xffff0000) { y += 16; x >>= 16; }
-        if (x & 0x0000ff00) { y +=  8; x >>=  8; }
-        if (x & 0x000000f0) { y +=  4; x >>=  4; }
-        if (x & 0x0000000c) { y +=  2; x >>=  2; }
-        if (x & 0x00000002) { y +=  1; }
-
-        return y;
-    } 
-    Addr MJL_swapRowColBits(Addr addr, unsigned blkSize, unsigned MJL_rowWidth) const 
-    {
-        int MJL_rowShift = floorLog2(sizeof(uint64_t));
-        uint64_t MJL_wordMask = blkSize/sizeof(uint64_t) - 1;
-        int MJL_colShift = floorLog2(MJL_rowWidth) + floorLog2(blkSize);
-
-        Addr new_row = (addr >> MJL_colShift) & (Addr)MJL_wordMask;
-        Addr new_col = (addr >> MJL_rowShift) & (Addr)MJL_wordMask;
-        return ((addr & ~(((Addr)MJL_wordMask << MJL_colShift) | ((Addr)MJL_wordMask << MJL_rowShift))) | (new_row << MJL_rowShift) | (new_col << MJL_colShift));
-    }
-    uint64_t MJL_blkMaskColumn(unsigned blkSize, unsigned MJL_rowWidth) const
-    {
-        uint64_t MJL_byteMask = sizeof(uint64_t) - 1;
-        uint64_t MJL_wordMask = blkSize/sizeof(uint64_t) - 1;
-        int MJL_colShift = floorLog2(MJL_rowWidth) + floorLog2(blkSize);
-        return (MJL_wordMask << MJL_colShift) | MJL_byteMask;
-    }
-    // Mask out the bits that are common for both row and column
-    uint64_t MJL_commonMask(unsigned blkSize, unsigned MJL_rowWidth) const 
+    /**
+     * @return The request's geometry, or the one for blk_size if the
+     *         caller works with other blocks than the request
+     */
+    const MJL_AddrGeometry &MJL_getGeometry(unsigned blk_size) const
     {
-        int MJL_rowShift = floorLog2(sizeof(uint64_t));
-        uint64_t MJL_wordMask = blkSize/sizeof(uint64_t) - 1;
-        int MJL_colShift = floorLog2(MJL_rowWidth) + floorLog2(blkSize);
-
-        return ((Addr)MJL_wordMask << MJL_colShift) | ((Addr)MJL_wordMask << MJL_rowShift);
+        if (blk_size == req->MJL_geometry->MJL_blkSize) {
+            return *req->MJL_geometry;
+        }
+        return MJL_AddrGeometry::MJL_get(blk_size, req->MJL_geometry->MJL_rowWidth);
     }
 
     Addr MJL_getColOffset(unsigned int blk_size) const
@@ -846,7 +864,7 @@ class Packet : public Printable
 
     Addr MJL_getRowOffset(unsigned int blk_size) const
     {
-        return MJL_swapRowColBits(getAddr(), blk_size, req->MJL_rowWidth) & Addr(blk_size - 1);
+        return MJL_getGeometry(blk_size).MJL_swapRowColBits(getAddr()) & Addr(blk_size - 1);
     }
 
     Addr MJL_getDirOffset(unsigned int blk_size, MemCmd::MJL_DirAttribute blk_dir) const
@@ -859,7 +877,7 @@ class Packet : public Printable
             return getAddr() & Addr(blk_size - 1);
         } else if ( blk_dir == MemCmd::MJL_DirAttribute::MJL_IsColumn ) {
             // MJL_temp: temporary fix for column offset calculation, maybe should use data direction? check use cases
-            return MJL_swapRowColBits(getAddr(), blk_size, req->MJL_rowWidth) & Addr(blk_size - 1);
+            return MJL_getGeometry(blk_size).MJL_swapRowColBits(getAddr()) & Addr(blk_size - 1);
         } else {
             return getAddr() & Addr(blk_size - 1);
         }
@@ -878,7 +896,7 @@ class Packet : public Printable
             return getAddr() & Addr(blk_size - 1);
         } else if ( MJL_dataIsColumn() ) {
             // MJL_temp: temporary fix for column offset calculation, maybe should use data direction? check use cases
-            return MJL_swapRowColBits(getAddr(), blk_size, req->MJL_rowWidth) & Addr(blk_size - 1);
+            return MJL_getGeometry(blk_size).MJL_swapRowColBits(getAddr()) & Addr(blk_size - 1);
         } else {
             return getAddr() & Addr(blk_size - 1);
         }
@@ -896,7 +914,7 @@ class Packet : public Printable
             return getAddr() & ~(Addr(blk_size - 1));
         } else if ( MJL_cmdIsColumn() ) {
             // MJL_temp: temporary fix for column block address calculation
-            return getAddr() & ~(Addr(MJL_blkMaskColumn(blk_size, req->MJL_rowWidth)));
+            return MJL_getGeometry(blk_size).MJL_colBlockAlign(getAddr());
         } else {
             return getAddr() & ~(Addr(blk_size - 1));
         }
@@ -914,7 +932,7 @@ class Packet : public Printable
             return getAddr() & ~(Addr(blk_size - 1));
         } else if ( MJL_cmdIsRow() ) {
             // MJL_temp: temporary fix for column block address calculation
-            return getAddr() & ~(Addr(MJL_blkMaskColumn(blk_size, req->MJL_rowWidth)));
+            return MJL_getGeometry(blk_size).MJL_colBlockAlign(getAddr());
         } else {
             return getAddr() & ~(Addr(blk_size - 1));
         }
@@ -932,7 +950,7 @@ class Packet : public Printable
             return getAddr() & ~(Addr(blk_size - 1));
         } else if ( blk_dir == MemCmd::MJL_DirAttribute::MJL_IsColumn ) {
             // MJL_temp: temporary fix for column block address calculation
-            return getAddr() & ~(Addr(MJL_blkMaskColumn(blk_size, req->MJL_rowWidth)));
+            return MJL_getGeometry(blk_size).MJL_colBlockAlign(getAddr());
         } else {
             return getAddr() & ~(Addr(blk_size - 1));
         }
@@ -944,11 +962,11 @@ class Packet : public Printable
     Addr MJL_getBlockAddrs(unsigned int blk_size, int offset) const
     {
         assert(offset < blk_size/sizeof(uint64_t));
-        Addr baseAddr = (getAddr() & ~(Addr(MJL_blkMaskColumn(blk_size, req->MJL_rowWidth)))) & ~(Addr(blk_size - 1));
+        Addr baseAddr = MJL_getGeometry(blk_size).MJL_colBlockAlign(getAddr()) & ~(Addr(blk_size - 1));
         if ( MJL_cmdIsColumn() ) {
             return baseAddr + offset * sizeof(uint64_t);
         } else if ( MJL_cmdIsRow() ) {
-            return baseAddr + offset * req->MJL_rowWidth * blk_size;
+            return baseAddr + offset * req->MJL_geometry->MJL_rowWidth * blk_size;
         } else {
             return getAddr() & ~(Addr(blk_size - 1));
         };
@@ -957,11 +975,11 @@ class Packet : public Printable
     Addr MJL_getCrossBlockAddrs(unsigned int blk_size, int offset) const
     {
         assert(offset < blk_size/sizeof(uint64_t));
-        Addr baseAddr = (getAddr() & ~(Addr(MJL_blkMaskColumn(blk_size, req->MJL_rowWidth)))) & ~(Addr(blk_size - 1));
+        Addr baseAddr = MJL_getGeometry(blk_size).MJL_colBlockAlign(getAddr()) & ~(Addr(blk_size - 1));
         if ( MJL_cmdIsRow() ) {
             return baseAddr + offset * sizeof(uint64_t);
         } else if ( MJL_cmdIsColumn() ) {
-            return baseAddr + offset * req->MJL_rowWidth * blk_size;
+            return baseAddr + offset * req->MJL_geometry->MJL_rowWidth * blk_size;
         } else {
             return getAddr() & ~(Addr(blk_size - 1));
         };
@@ -1012,7 +1030,7 @@ class Packet : public Printable
     Packet(const RequestPtr _req, MemCmd _cmd)
         :  cmd(_cmd), req(_req), data(nullptr), addr(0),/* MJL_Begin */ MJL_dataDir(_cmd.MJL_getCmdDir()), MJL_pfPredDir(MemCmd::MJL_DirAttribute::MJL_IsInvalid),/* MJL_End*/ _isSecure(false),
            size(0), headerDelay(0), snoopDelay(0), payloadDelay(0),
-           senderState(NULL)/* MJL_Begin */, MJL_hasOrder(false), MJL_order(0), MJL_wordDirty{false, false, false, false, false, false, false, false}, MJL_crossBlocksCached{false, false, false, false, false, false, false, false}, MJL_wordDemanded{false, false, false, false, false, false, false, false}, MJL_isStale{false, false, false, false, false, false, false, false}, MJL_hasSharersFlag(false)/* MJL_End */
+           senderState(NULL)/* MJL_Begin */, MJL_hasOrder(false), MJL_order(0), MJL_hasSharersFlag(false), MJL_tileMask(0)/* MJL_End */
     {
         if (req->hasPaddr()) {
             addr = req->getPaddr();
@@ -1033,7 +1051,7 @@ class Packet : public Printable
     Packet(const RequestPtr _req, MemCmd _cmd, int _blkSize)
         :  cmd(_cmd), req(_req), data(nullptr), addr(0),/* MJL_Begin */ MJL_dataDir(_cmd.MJL_getCmdDir()), MJL_pfPredDir(MemCmd::MJL_DirAttribute::MJL_IsInvalid),/* MJL_End*/ _isSecure(false),
            headerDelay(0), snoopDelay(0), payloadDelay(0),
-           senderState(NULL)/* MJL_Begin */, MJL_hasOrder(false), MJL_order(0), MJL_wordDirty{false, false, false, false, false, false, false, false}, MJL_crossBlocksCached{false, false, false, false, false, false, false, false}, MJL_wordDemanded{false, false, false, false, false, false, false, false}, MJL_isStale{false, false, false, false, false, false, false, false}, MJL_hasSharersFlag(false)/* MJL_End */
+           senderState(NULL)/* MJL_Begin */, MJL_hasOrder(false), MJL_order(0), MJL_hasSharersFlag(false), MJL_tileMask(0)/* MJL_End */
     {
         if (req->hasPaddr()) {
             /* MJL_Begin */
@@ -1043,7 +1061,7 @@ class Packet : public Printable
                 addr = req->getPaddr() & ~(_blkSize - 1);
             } else if ( MJL_cmdIsColumn() ) {
                 // MJL_temp: temporary fix for column block address calculation
-                addr = req->getPaddr() &  ~(Addr(MJL_blkMaskColumn(req->MJL_cachelineSize, req->MJL_rowWidth)));
+                addr = MJL_getGeometry(_blkSize).MJL_colBlockAlign(req->getPaddr());
             } else {
                 addr = req->getPaddr() & ~(_blkSize - 1);
             }
@@ -1074,7 +1092,7 @@ class Packet : public Printable
            headerDelay(pkt->headerDelay),
            snoopDelay(0),
            payloadDelay(pkt->payloadDelay),
-           senderState(pkt->senderState)/* MJL_Begin */, MJL_hasOrder(false), MJL_order(0), MJL_wordDirty{pkt->MJL_wordDirty[0], pkt->MJL_wordDirty[1], pkt->MJL_wordDirty[2], pkt->MJL_wordDirty[3], pkt->MJL_wordDirty[4], pkt->MJL_wordDirty[5], pkt->MJL_wordDirty[6], pkt->MJL_wordDirty[7]}, MJL_crossBlocksCached{false, false, false, false, false, false, false, false}, MJL_wordDemanded{pkt->MJL_wordDemanded[0], pkt->MJL_wordDemanded[1], pkt->MJL_wordDemanded[2], pkt->MJL_wordDemanded[3], pkt->MJL_wordDemanded[4], pkt->MJL_wordDemanded[5], pkt->MJL_wordDemanded[6], pkt->MJL_wordDemanded[7]}, MJL_isStale{pkt->MJL_isStale[0], pkt->MJL_isStale[1], pkt->MJL_isStale[2], pkt->MJL_isStale[3], pkt->MJL_isStale[4], pkt->MJL_isStale[5], pkt->MJL_isStale[6], pkt->MJL_isStale[7]}, MJL_hasSharersFlag(false)/* MJL_End */
+           senderState(pkt->senderState)/* MJL_Begin */, MJL_hasOrder(false), MJL_order(0), MJL_wordDirty(pkt->MJL_wordDirty), MJL_wordDemanded(pkt->MJL_wordDemanded), MJL_isStale(pkt->MJL_isStale), MJL_hasSharersFlag(false), MJL_tileMask(0)/* MJL_End */
     {
         if (!clear_flags)
             flags.set(pkt->flags & COPY_FLAGS);
@@ -1170,6 +1188,11 @@ class Packet : public Printable
             delete req;
         }
         deleteData();
+        /* MJL_Begin */
+        for (unsigned k = 0; k < MJL_tileLineCount(); ++k) {
+            delete MJL_tileLines[k];
+        }
+        /* MJL_End */
     }
 
     /**
@@ -1186,6 +1209,13 @@ class Packet : public Printable
         // responses are never express, even if the snoop that
         // triggered them was
         flags.clear(EXPRESS_SNOOP);
+
+        /* MJL_Begin */
+        // the lines of a tile packet are answered with it
+        for (unsigned k = 0; k < MJL_tileLineCount(); ++k) {
+            MJL_tileLines[k]->makeResponse();
+        }
+        /* MJL_End */
     }
 
     void
@@ -1518,6 +1548,11 @@ class Packet : public Printable
     bool
     checkFunctional(PacketPtr other)
     {
+        /* MJL_Begin */
+        if (other->MJL_isTile()) {
+            return MJL_checkTileFunctional(other);
+        }
+        /* MJL_End */
         // all packets that are carrying a payload should have a valid
         // data pointer
         return checkFunctional(other, other->getAddr(), other->isSecure(),
@@ -1530,6 +1565,9 @@ class Packet : public Printable
     bool
     MJL_checkFunctional(PacketPtr other)
     {
+        if (other->MJL_isTile()) {
+            return MJL_checkTileFunctional(other);
+        }
         // all packets that are carrying a payload should have a valid
         // data pointer
         return MJL_checkFunctional(other, other->getAddr(), other->MJL_getDataDir(), other->isSecure(),
@@ -1537,6 +1575,28 @@ class Packet : public Printable
                                other->hasData() ?
                                other->getPtr<uint8_t>() : NULL);
     }
+
+    /**
+     * Check against each line of a tile packet, as the address range of
+     * the tile packet itself is not where its lines are.
+     */
+    bool
+    MJL_checkTileFunctional(PacketPtr other)
+    {
+        uint8_t *other_data = other->hasData() ?
+            other->getPtr<uint8_t>() : NULL;
+        for (unsigned k = 0; k < other->MJL_tileLineCount(); ++k) {
+            PacketPtr line = other->MJL_getTileLine(k);
+            if (MJL_checkFunctional(other, line->getAddr(),
+                                    line->MJL_getDataDir(), line->isSecure(),
+                                    line->getSize(), other_data ?
+                                    other_data + k * line->getSize() :
+                                    NULL)) {
+                return true;
+            }
+        }
+        return false;
+    }
     /* MJL_End */
 
     /**
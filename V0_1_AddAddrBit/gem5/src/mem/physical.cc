@@ -49,6 +49,9 @@
 #include <cstdio>
 #include <iostream>
 #include <string>
+/* MJL_Begin */
+#include <vector>
+/* MJL_End */
 
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
@@ -212,10 +215,36 @@ PhysicalMemory::createBackingStore(AddrRange range,
               range.to_string());
     }
 
+    /* MJL_Begin */
+    // All memories of a store have to agree on its layout, and a tiled
+    // store has to hold whole tiles
+    const MJL_AddrGeometry *MJL_tile_geometry =
+        _memories.front()->MJL_getTileGeometry();
+    for (const auto& m : _memories) {
+        fatal_if(m->MJL_getTileGeometry() != MJL_tile_geometry,
+                 "Inconsistent backing store layouts in range %s\n",
+                 range.to_string());
+    }
+    if (MJL_tile_geometry) {
+        Addr MJL_tileSpan = Addr(1) << (MJL_tile_geometry->MJL_colShift +
+                                        MJL_tile_geometry->MJL_wordShift);
+        fatal_if(range.start() % MJL_tileSpan || range.size() % MJL_tileSpan,
+                 "Range %s of a tiled backing store is not aligned to the "
+                 "%d byte tile rows\n", range.to_string(), MJL_tileSpan);
+    }
+
+    // remember this backing store so we can checkpoint it and unmap
+    // it appropriately
+    backingStore.emplace_back(range, pmem,
+                              conf_table_reported, in_addr_map, kvm_map,
+                              MJL_tile_geometry);
+    /* MJL_End */
+    /* MJL_Comment
     // remember this backing store so we can checkpoint it and unmap
     // it appropriately
     backingStore.emplace_back(range, pmem,
                               conf_table_reported, in_addr_map, kvm_map);
+    */
 
     // point the memories to their backing store
     for (const auto& m : _memories) {
@@ -345,13 +374,26 @@ PhysicalMemory::serialize(CheckpointOut &cp) const
     // store each backing store memory segment in a file
     for (auto& s : backingStore) {
         ScopedCheckpointSection sec(cp, csprintf("store%d", store_id));
+        /* MJL_Begin */
+        serializeStore(cp, store_id++, s.range, s.pmem, s.MJL_tileGeometry);
+        /* MJL_End */
+        /* MJL_Comment
         serializeStore(cp, store_id++, s.range, s.pmem);
+        */
     }
 }
 
+/* MJL_Begin */
+void
+PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
+                               AddrRange range, uint8_t* pmem,
+                               const MJL_AddrGeometry *MJL_tile_geometry) const
+/* MJL_End */
+/* MJL_Comment
 void
 PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
                                AddrRange range, uint8_t* pmem) const
+*/
 {
     // we cannot use the address range for the name as the
     // memories that are not part of the address map can overlap
@@ -372,6 +414,34 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
         fatal("Can't open physical memory checkpoint file '%s'\n",
               filename);
 
+    /* MJL_Begin */
+    // A tiled store is written a tile row at a time in address order, so
+    // the checkpoint does not depend on the layout
+    if (MJL_tile_geometry) {
+        Addr MJL_tileSpan = Addr(1) << (MJL_tile_geometry->MJL_colShift +
+                                        MJL_tile_geometry->MJL_wordShift);
+        std::vector<uint8_t> MJL_rowData(MJL_tileSpan);
+        for (Addr written = 0; written < range.size();
+             written += MJL_tileSpan) {
+            for (Addr offset = 0; offset < MJL_tileSpan;
+                 offset += sizeof(uint64_t)) {
+                memcpy(&MJL_rowData[offset], pmem + written +
+                       MJL_tile_geometry->MJL_movColRight(offset),
+                       sizeof(uint64_t));
+            }
+            if (gzwrite(compressed_mem, &MJL_rowData[0],
+                        (unsigned int) MJL_tileSpan) != (int) MJL_tileSpan) {
+                fatal("Write failed on physical memory checkpoint file '%s'\n",
+                      filename);
+            }
+        }
+        if (gzclose(compressed_mem))
+            fatal("Close failed on physical memory checkpoint file '%s'\n",
+                  filename);
+        return;
+    }
+    /* MJL_End */
+
     uint64_t pass_size = 0;
 
     // gzwrite fails if (int)len < 0 (gzwrite returns int)
@@ -466,7 +536,14 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
             // Only copy bytes that are non-zero, so we don't give
             // the VM system hell
             if (*(temp_page + x) != 0) {
+                /* MJL_Begin */
+                pmem_current = (long*)(pmem + backingStore[store_id].
+                                       MJL_hostOffset(curr_size +
+                                                      x * sizeof(long)));
+                /* MJL_End */
+                /* MJL_Comment
                 pmem_current = (long*)(pmem + curr_size + x * sizeof(long));
+                */
                 *pmem_current = *(temp_page + x);
             }
         }
@@ -41,6 +41,9 @@
 #define __MEM_PHYSICAL_HH__
 
 #include "base/addr_range_map.hh"
+/* MJL_Begin */
+#include "mem/addr_geometry.hh"
+/* MJL_End */
 #include "mem/packet.hh"
 
 /**
@@ -59,11 +62,22 @@ class BackingStoreEntry
      * Create a backing store entry. Don't worry about managing the memory
      * pointers, because PhysicalMemory is responsible for that.
      */
+    /* MJL_Begin */
+    BackingStoreEntry(AddrRange range, uint8_t* pmem,
+                      bool conf_table_reported, bool in_addr_map, bool kvm_map,
+                      const MJL_AddrGeometry *MJL_tile_geometry = nullptr)
+        : range(range), pmem(pmem), confTableReported(conf_table_reported),
+          inAddrMap(in_addr_map), kvmMap(kvm_map),
+          MJL_tileGeometry(MJL_tile_geometry)
+        {}
+    /* MJL_End */
+    /* MJL_Comment
     BackingStoreEntry(AddrRange range, uint8_t* pmem,
                       bool conf_table_reported, bool in_addr_map, bool kvm_map)
         : range(range), pmem(pmem), confTableReported(conf_table_reported),
           inAddrMap(in_addr_map), kvmMap(kvm_map)
         {}
+    */
 
     /**
      * The address range covered in the guest.
@@ -91,6 +105,21 @@ class BackingStoreEntry
       * acceleration.
       */
      bool kvmMap;
+
+     /* MJL_Begin */
+     /**
+      * Geometry of the tiles if each tile is contiguous in the host
+      * memory, nullptr if the host memory is in address order.
+      */
+     const MJL_AddrGeometry *MJL_tileGeometry;
+
+     /** @return Host offset of an offset in the range */
+     Addr MJL_hostOffset(Addr offset) const
+     {
+         return MJL_tileGeometry ?
+             MJL_tileGeometry->MJL_movColRight(offset) : offset;
+     }
+     /* MJL_End */
 };
 
 /**
@@ -253,9 +282,19 @@ class PhysicalMemory : public Serializable
      * @param store_id Unique identifier of this backing store
      * @param range The address range of this backing store
      * @param pmem The host pointer to this backing store
+     * @param MJL_tile_geometry Tile geometry of a tiled backing store,
+     *                          which is written in address order
      */
+    /* MJL_Begin */
+    void serializeStore(CheckpointOut &cp, unsigned int store_id,
+                        AddrRange range, uint8_t* pmem,
+                        const MJL_AddrGeometry *MJL_tile_geometry =
+                        nullptr) const;
+    /* MJL_End */
+    /* MJL_Comment
     void serializeStore(CheckpointOut &cp, unsigned int store_id,
                         AddrRange range, uint8_t* pmem) const;
+    */
 
     /**
      * Unserialize the memories in the system. As with the
@@ -59,6 +59,9 @@
 #include "base/misc.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
+/* MJL_Begin */
+#include "mem/addr_geometry.hh"
+/* MJL_End */
 #include "sim/core.hh"
 
 /**
@@ -310,6 +313,8 @@ class Request
     // MJL_TODO: only used for Lock in cache blocks right now. Check to see if anything else needs this.
     MJL_DirAttribute MJL_reqDir;
     bool MJL_Vec;
+    /** Direction hint decoded from the instruction, MJL_IsInvalid if none */
+    MJL_DirAttribute MJL_dirHint;
     /* MJL_End */
 
     /**
@@ -376,7 +381,7 @@ class Request
      *  constructor.)
      */
     Request()
-        : _paddr(0),/* MJL_Begin */ MJL_reqDir(MJL_IsRow), MJL_Vec(false),/* MJL_End */ _size(0), _masterId(invldMasterId), _time(0),
+        : _paddr(0),/* MJL_Begin */ MJL_reqDir(MJL_IsRow), MJL_Vec(false), MJL_dirHint(MJL_IsInvalid),/* MJL_End */ _size(0), _masterId(invldMasterId), _time(0),
           _taskId(ContextSwitchTaskId::Unknown), _asid(0), _vaddr(0),
           _extraData(0), _contextId(0), _pc(0),
           _reqInstSeqNum(0), atomicOpFunctor(nullptr), translateDelta(0),
@@ -385,7 +390,7 @@ class Request
 
     Request(Addr paddr, unsigned size, Flags flags, MasterID mid,
             InstSeqNum seq_num, ContextID cid)
-        : _paddr(0),/* MJL_Begin */ MJL_reqDir(MJL_IsRow), MJL_Vec(false),/* MJL_End */ _size(0), _masterId(invldMasterId), _time(0),
+        : _paddr(0),/* MJL_Begin */ MJL_reqDir(MJL_IsRow), MJL_Vec(false), MJL_dirHint(MJL_IsInvalid),/* MJL_End */ _size(0), _masterId(invldMasterId), _time(0),
           _taskId(ContextSwitchTaskId::Unknown), _asid(0), _vaddr(0),
           _extraData(0), _contextId(0), _pc(0),
           _reqInstSeqNum(seq_num), atomicOpFunctor(nullptr), translateDelta(0),
@@ -402,7 +407,7 @@ class Request
      * These fields are adequate to perform a request.
      */
     Request(Addr paddr, unsigned size, Flags flags, MasterID mid)
-        : _paddr(0),/* MJL_Begin */ MJL_reqDir(MJL_IsRow), MJL_Vec(false),/* MJL_End */ _size(0), _masterId(invldMasterId), _time(0),
+        : _paddr(0),/* MJL_Begin */ MJL_reqDir(MJL_IsRow), MJL_Vec(false), MJL_dirHint(MJL_IsInvalid),/* MJL_End */ _size(0), _masterId(invldMasterId), _time(0),
           _taskId(ContextSwitchTaskId::Unknown), _asid(0), _vaddr(0),
           _extraData(0), _contextId(0), _pc(0),
           _reqInstSeqNum(0), atomicOpFunctor(nullptr), translateDelta(0),
@@ -412,7 +417,7 @@ class Request
     }
 
     Request(Addr paddr, unsigned size, Flags flags, MasterID mid, Tick time)
-        : _paddr(0),/* MJL_Begin */ MJL_reqDir(MJL_IsRow), MJL_Vec(false),/* MJL_End */ _size(0), _masterId(invldMasterId), _time(0),
+        : _paddr(0),/* MJL_Begin */ MJL_reqDir(MJL_IsRow), MJL_Vec(false), MJL_dirHint(MJL_IsInvalid),/* MJL_End */ _size(0), _masterId(invldMasterId), _time(0),
           _taskId(ContextSwitchTaskId::Unknown), _asid(0), _vaddr(0),
           _extraData(0), _contextId(0), _pc(0),
           _reqInstSeqNum(0), atomicOpFunctor(nullptr), translateDelta(0),
@@ -423,7 +428,7 @@ class Request
 
     Request(Addr paddr, unsigned size, Flags flags, MasterID mid, Tick time,
             Addr pc)
-        : _paddr(0),/* MJL_Begin */ MJL_reqDir(MJL_IsRow), MJL_Vec(false),/* MJL_End */ _size(0), _masterId(invldMasterId), _time(0),
+        : _paddr(0),/* MJL_Begin */ MJL_reqDir(MJL_IsRow), MJL_Vec(false), MJL_dirHint(MJL_IsInvalid),/* MJL_End */ _size(0), _masterId(invldMasterId), _time(0),
           _taskId(ContextSwitchTaskId::Unknown), _asid(0), _vaddr(0),
           _extraData(0), _contextId(0), _pc(pc),
           _reqInstSeqNum(0), atomicOpFunctor(nullptr), translateDelta(0),
@@ -435,7 +440,7 @@ class Request
 
     Request(int asid, Addr vaddr, unsigned size, Flags flags, MasterID mid,
             Addr pc, ContextID cid)
-        : _paddr(0),/* MJL_Begin */ MJL_reqDir(MJL_IsRow), MJL_Vec(false),/* MJL_End */ _size(0), _masterId(invldMasterId), _time(0),
+        : _paddr(0),/* MJL_Begin */ MJL_reqDir(MJL_IsRow), MJL_Vec(false), MJL_dirHint(MJL_IsInvalid),/* MJL_End */ _size(0), _masterId(invldMasterId), _time(0),
           _taskId(ContextSwitchTaskId::Unknown), _asid(0), _vaddr(0),
           _extraData(0), _contextId(0), _pc(0),
           _reqInstSeqNum(0), atomicOpFunctor(nullptr), translateDelta(0),
@@ -492,6 +497,12 @@ class Request
         depth = 0;
         accessDelta = 0;
         translateDelta = 0;
+        /* MJL_Begin */
+        // Reused requests (e.g. AtomicSimpleCPU) must not inherit the
+        // instruction annotations of the previous access
+        MJL_Vec = false;
+        MJL_dirHint = MJL_IsInvalid;
+        /* MJL_End */
     }
 
     /**
@@ -556,9 +567,24 @@ class Request
         return MJL_Vec;
     }
     void
-    MJL_setVec() 
+    MJL_setVec(bool in_MJL_Vec = true)
     {
-        MJL_Vec = true;
+        MJL_Vec = in_MJL_Vec;
+    }
+    MJL_DirAttribute
+    MJL_getDirHint() const
+    {
+        return MJL_dirHint;
+    }
+    void
+    MJL_setDirHint( MJL_DirAttribute in_MJL_dirHint )
+    {
+        MJL_dirHint = in_MJL_dirHint;
+    }
+    bool
+    MJL_hasDirHint() const
+    {
+        return MJL_dirHint != MJL_IsInvalid;
     }
     bool
     MJL_reqIsRow() const
@@ -570,9 +596,9 @@ class Request
     {
         return MJL_reqDir == MJL_IsColumn;
     }
-    // MJL_temp quick fix to pass the values to Lock in blk.hh and packet, set at the L1DCache's recvTimingReq
-    unsigned MJL_cachelineSize;
-    unsigned MJL_rowWidth;
+    /** Row/column geometry of the address, the System's unless a cache sets its own */
+    const MJL_AddrGeometry *MJL_geometry =
+        &MJL_AddrGeometry::MJL_getSystemGeometry();
     /* MJL_End */
     /**
      * Time for the TLB/table walker to successfully translate this request.
@@ -59,15 +59,34 @@ SnoopFilter::eraseIfNullEntry(SnoopFilterCache::iterator& sf_it)
     }
 }
 /* MJL_Begin */
-void
-SnoopFilter::MJL_eraseIfNullEntry(SnoopFilterCache::iterator& sf_it, MemCmd::MJL_DirAttribute MJL_cmdDir)
+bool
+SnoopFilter::MJL_eraseIfNullEntry(MJL_SnoopFilterCache::iterator& tile_it, int side, int i)
 {
-    SnoopItem& sf_item = sf_it->second;
-    if (!(sf_item.requested | sf_item.holder)) {
-        MJL_cachedLocations[MJL_cmdDir].erase(sf_it);
-        DPRINTF(SnoopFilter, "%s:   Removed SF entry.\n",
-                __func__);
+    MJL_SnoopTile& tile = tile_it->second;
+    SnoopItem& sf_item = tile.items[side][i];
+    if (!tile.MJL_has(side, i) || (sf_item.requested | sf_item.holder)) {
+        return false;
+    }
+    tile.mask[side] &= ~(1 << i);
+    --MJL_entryCount;
+    DPRINTF(SnoopFilter, "%s:   Removed SF entry.\n",
+            __func__);
+    if (tile.mask[0] | tile.mask[1]) {
+        return false;
+    }
+    MJL_cachedLocations.erase(tile_it);
+    return true;
+}
+
+SnoopFilter::SnoopItem&
+SnoopFilter::MJL_addItem(MJL_SnoopTile& tile, int side, int i)
+{
+    if (!tile.MJL_has(side, i)) {
+        tile.mask[side] |= 1 << i;
+        tile.items[side][i] = SnoopItem{0, 0};
+        ++MJL_entryCount;
     }
+    return tile.items[side][i];
 }
 /* MJL_End */
 
@@ -91,8 +110,15 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const SlavePort& slave_port)
     }
     SnoopMask req_port = portToMask(slave_port);
     /* MJL_Begin */
-    reqLookupResult = MJL_cachedLocations[cpkt->MJL_getCmdDir()].find(line_addr);
-    bool is_hit = (reqLookupResult != MJL_cachedLocations[cpkt->MJL_getCmdDir()].end());
+    // The line and the lines crossing it are all in the same tile
+    const int MJL_side = MJL_dirSide(cpkt->MJL_getCmdDir());
+    const int MJL_crossSide = 1 - MJL_side;
+    const int MJL_words = linesize/sizeof(uint64_t);
+    MJL_reqSide = MJL_side;
+    MJL_reqIndex = MJL_tileIndex(line_addr, MJL_side);
+    MJL_reqTile = MJL_cachedLocations.find(MJL_tileAddr(line_addr));
+    bool is_hit = (MJL_reqTile != MJL_cachedLocations.end()) &&
+                  MJL_reqTile->second.MJL_has(MJL_side, MJL_reqIndex);
     /* MJL_End */
     /* MJL_Comment
     reqLookupResult = cachedLocations.find(line_addr);
@@ -102,18 +128,29 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const SlavePort& slave_port)
     // If the snoop filter has no entry, and we should not allocate,
     // do not create a new snoop filter entry, simply return a NULL
     // portlist.
+    /* MJL_Begin */
+    if (!is_hit && !allocate) {
+        MJL_reqTile = MJL_cachedLocations.end();
+        return snoopDown(lookupLatency);
+    }
+    /* MJL_End */
+    /* MJL_Comment
     if (!is_hit && !allocate)
         return snoopDown(lookupLatency);
+    */
 
     // If no hit in snoop filter create a new element and update iterator
+    /* MJL_Begin */
+    if (MJL_reqTile == MJL_cachedLocations.end())
+        MJL_reqTile = MJL_cachedLocations.emplace(MJL_tileAddr(line_addr), MJL_SnoopTile()).first;
+    MJL_SnoopTile& MJL_tile = MJL_reqTile->second;
+    SnoopItem& sf_item = MJL_addItem(MJL_tile, MJL_side, MJL_reqIndex);
+    /* MJL_End */
+    /* MJL_Comment
     if (!is_hit)
-        /* MJL_Begin */
-        reqLookupResult = MJL_cachedLocations[cpkt->MJL_getCmdDir()].emplace(line_addr, SnoopItem()).first;
-        /* MJL_End */
-        /* MJL_Comment
         reqLookupResult = cachedLocations.emplace(line_addr, SnoopItem()).first;
-        */
     SnoopItem& sf_item = reqLookupResult->second;
+    */
     SnoopMask interested = sf_item.holder | sf_item.requested;
 
     // Store unmodified value of snoop filter item in temp storage in
@@ -122,20 +159,15 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const SlavePort& slave_port)
     retryItem = sf_item;
     /* MJL_Begin */
     if (slave_port.getMasterPort().MJL_is2DCache()) {
-        for (int i = 0; i < linesize/sizeof(uint64_t); ++i) {
-            auto MJL_temp_it = MJL_cachedLocations[cpkt->MJL_getCrossCmdDir()].find(cpkt->MJL_getCrossBlockAddrs(linesize, i));
-            if (MJL_temp_it != MJL_cachedLocations[cpkt->MJL_getCrossCmdDir()].end()) {
-                    SnoopItem& MJL_temp_item = MJL_temp_it->second;
-                    MJL_retryItems[i] = MJL_temp_item;
-                    MJL_retrySet[i] = true;
-            }
+        MJL_retryMask = MJL_tile.mask[MJL_crossSide];
+        for (int i = 0; i < MJL_words; ++i) {
+            MJL_retryItems[i] = MJL_tile.items[MJL_crossSide][i];
         }
     } else {
-        for (int i = 0; i < linesize/sizeof(uint64_t); ++i) {
-            /* MJL_Begin */
-            auto MJL_temp_it = MJL_cachedLocations[cpkt->MJL_getCrossCmdDir()].find(cpkt->MJL_getCrossBlockAddrs(linesize, i));
-            if (MJL_temp_it != MJL_cachedLocations[cpkt->MJL_getCrossCmdDir()].end()) {
-                    SnoopItem& MJL_temp_item = MJL_temp_it->second;
+        MJL_retryMask = 0;
+        for (int i = 0; i < MJL_words; ++i) {
+            if (MJL_tile.MJL_has(MJL_crossSide, i)) {
+                    SnoopItem& MJL_temp_item = MJL_tile.items[MJL_crossSide][i];
                     if (((MJL_temp_item.holder | MJL_temp_item.requested) & ~req_port) != 0) {
                         MJL_crossSnoopHits++;
                     }
@@ -143,8 +175,6 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const SlavePort& slave_port)
                     interested = interested | MJL_temp_item.holder | MJL_temp_item.requested;
                     */
             }
-            /* MJL_End */
-            MJL_retrySet[i] = false;
         }
     } 
     /* MJL_End */
@@ -241,32 +271,14 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const SlavePort& slave_port)
         // For physically 2D cache, also need the is cached above information for the other direction as well, so that we can correctly determine whether it is still a holder for the other direction
         if (slave_port.getMasterPort().MJL_is2DCache() && !cpkt->isBlockCached()) {
             // In this case, whenever there is 1 cache line evicted, the whole tile is evicted, hence we only rely on the is block cached information on passed from the upper level cache
-            bool MJL_wholeTilePresent = true;
-            auto MJL_temp_it = MJL_cachedLocations[cpkt->MJL_getCmdDir()].find(line_addr);
-            for (int i = 0; i < linesize/sizeof(uint64_t); ++i) {
-                MJL_temp_it = MJL_cachedLocations[cpkt->MJL_getCmdDir()].find(cpkt->MJL_getBlockAddrs(linesize, i));
-                if (MJL_temp_it != MJL_cachedLocations[cpkt->MJL_getCmdDir()].end()) {
-                    MJL_wholeTilePresent &= (bool)(MJL_temp_it->second.holder & req_port);
-                    /* MJL_Test 
-                    if (cpkt->getAddr() == 1576960 || cpkt->getAddr() == 1577216 || cpkt->getAddr() == 1577472 || cpkt->getAddr() == 1577728 || cpkt->getAddr() == 1577984 || cpkt->getAddr() == 1578240 || cpkt->getAddr() == 1578496 || cpkt->getAddr() == 1578752) {
-                        std::cout << this->name() << "::MJL_Debug: point D snoop_filter " << MJL_wholeTilePresent << " " << i << std::endl;
-                    }
-                    */
-                } else {
-                    MJL_wholeTilePresent = false;
-                    break;
-                }
+            bool MJL_wholeTilePresent = (MJL_tile.mask[MJL_side] == MJL_fullMask());
+            for (int i = 0; MJL_wholeTilePresent && i < MJL_words; ++i) {
+                MJL_wholeTilePresent &= (bool)(MJL_tile.items[MJL_side][i].holder & req_port);
             }
             if (MJL_wholeTilePresent) {
-                for (int i = 0; i < linesize/sizeof(uint64_t); ++i) {
-                    auto MJL_temp_it = MJL_cachedLocations[cpkt->MJL_getCrossCmdDir()].find(cpkt->MJL_getCrossBlockAddrs(linesize, i));
-                    /* MJL_Test 
-                    if (cpkt->getAddr() == 1576960 && MJL_temp_it != MJL_cachedLocations[cpkt->MJL_getCrossCmdDir()].end()) {
-                        std::cout << this->name() << "::MJL_Debug: point A snoop_filter " << i << " " << MJL_temp_it->second.holder << std::endl;
-                    }
-                    */
-                    if (!cpkt->MJL_crossBlocksCached[i] && MJL_temp_it != MJL_cachedLocations[cpkt->MJL_getCrossCmdDir()].end()) {
-                        SnoopItem& MJL_temp_item = MJL_temp_it->second;
+                for (int i = 0; i < MJL_words; ++i) {
+                    if (!cpkt->MJL_crossBlocksCached[i] && MJL_tile.MJL_has(MJL_crossSide, i)) {
+                        SnoopItem& MJL_temp_item = MJL_tile.items[MJL_crossSide][i];
                         /* MJL_Test  
                         if (MJL_Debug_Out) {
                             std::clog << ", old holder" << i << " = " << MJL_temp_item.holder;
@@ -331,14 +343,14 @@ SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
 void
 SnoopFilter::MJL_finishRequest(bool will_retry, Addr addr, MemCmd::MJL_DirAttribute MJL_cmdDir, bool is_secure)
 {
-    if (reqLookupResult != MJL_cachedLocations[MJL_cmdDir].end()) {
+    if (MJL_reqTile != MJL_cachedLocations.end()) {
         // since we rely on the caller, do a basic check to ensure
         // that finishRequest is being called following lookupRequest
         Addr line_addr;
         if (MJL_cmdDir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
             line_addr = (addr & ~(Addr(linesize - 1)));
         } else if (MJL_cmdDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-            line_addr = (addr & ~(Addr(MJL_blkMaskColumn)));
+            line_addr = MJL_geometry.MJL_colBlockAlign(addr);
         } else {
             line_addr = (addr & ~(Addr(linesize - 1)));
         }
@@ -346,36 +358,24 @@ SnoopFilter::MJL_finishRequest(bool will_retry, Addr addr, MemCmd::MJL_DirAttrib
         if (is_secure) {
             line_addr |= LineSecure;
         }
-        assert(reqLookupResult->first == line_addr);
+        assert(MJL_reqTile->first == MJL_tileAddr(line_addr));
+        assert(MJL_reqSide == MJL_dirSide(MJL_cmdDir));
+        assert(MJL_reqIndex == MJL_tileIndex(line_addr, MJL_reqSide));
+        MJL_SnoopTile& MJL_tile = MJL_reqTile->second;
+        assert(MJL_tile.MJL_has(MJL_reqSide, MJL_reqIndex));
         if (will_retry) {
             // Undo any changes made in lookupRequest to the snoop filter
             // entry if the request will come again. retryItem holds
             // the previous value of the snoopfilter entry.
-            reqLookupResult->second = retryItem;
-            /* MJL_Test 
-            //if (addr == 1576960) {
-                    std::cout << this->name() << "::MJL_Debug: point retry snoop_filter " << addr << " " << MJL_retrySet << std::endl;
-            //}
-             */
-            MemCmd::MJL_DirAttribute MJL_crossCmdDir = MJL_cmdDir;
-            if (MJL_cmdDir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                MJL_crossCmdDir = MemCmd::MJL_DirAttribute::MJL_IsColumn;
-            } else if (MJL_cmdDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                MJL_crossCmdDir = MemCmd::MJL_DirAttribute::MJL_IsRow;
-            }
-            Addr MJL_crossBaseLineAddr = (addr & ~(Addr(MJL_blkMaskColumn))) & ~(Addr(linesize - 1));
+            MJL_tile.items[MJL_reqSide][MJL_reqIndex] = retryItem;
+            // The crossing lines saved by lookupRequest are in the other
+            // side of the same tile
+            const int MJL_crossSide = 1 - MJL_reqSide;
             for (int i = 0; i < linesize/sizeof(uint64_t); ++i) {
-                Addr MJL_crossLineAddr = MJL_crossBaseLineAddr;
-                if (MJL_cmdDir == MemCmd::MJL_DirAttribute::MJL_IsRow) {
-                    MJL_crossLineAddr = MJL_crossBaseLineAddr + i * sizeof(uint64_t);
-                } else if (MJL_cmdDir == MemCmd::MJL_DirAttribute::MJL_IsColumn) {
-                    MJL_crossLineAddr = MJL_crossBaseLineAddr + i * MJL_rowWidth * linesize;
-                }
-                auto MJL_temp_it = MJL_cachedLocations[MJL_crossCmdDir].find(MJL_crossLineAddr);
-                if (MJL_retrySet[i] && MJL_temp_it != MJL_cachedLocations[MJL_crossCmdDir].end()) {
-                    MJL_temp_it->second = MJL_retryItems[i];
+                if ((MJL_retryMask & (1 << i)) && MJL_tile.MJL_has(MJL_crossSide, i)) {
+                    MJL_tile.items[MJL_crossSide][i] = MJL_retryItems[i];
 
-                    MJL_eraseIfNullEntry(MJL_temp_it, MJL_crossCmdDir);
+                    MJL_eraseIfNullEntry(MJL_reqTile, MJL_crossSide, i);
                 }
             }
             
@@ -384,7 +384,72 @@ SnoopFilter::MJL_finishRequest(bool will_retry, Addr addr, MemCmd::MJL_DirAttrib
                     __func__,  retryItem.requested, retryItem.holder);
         }
 
-        MJL_eraseIfNullEntry(reqLookupResult, MJL_cmdDir);
+        MJL_eraseIfNullEntry(MJL_reqTile, MJL_reqSide, MJL_reqIndex);
+        MJL_reqTile = MJL_cachedLocations.end();
+    }
+}
+
+std::pair<SnoopFilter::SnoopList, Cycles>
+SnoopFilter::MJL_lookupTileRequest(const Packet* cpkt, const SlavePort& slave_port)
+{
+    assert(cpkt->MJL_isTile());
+    const Packet* first = cpkt->MJL_getTileLine(0);
+    MJL_tileRetryAddr = MJL_tileAddr(first->getAddr() |
+                                     (first->isSecure() ? LineSecure : 0));
+    auto tile_it = MJL_cachedLocations.find(MJL_tileRetryAddr);
+    MJL_tileRetryFound = (tile_it != MJL_cachedLocations.end());
+    if (MJL_tileRetryFound) {
+        MJL_tileRetry = tile_it->second;
+    }
+
+    SnoopMask interested = 0;
+    for (unsigned k = 0; k < cpkt->MJL_tileLineCount(); ++k) {
+        const Packet* line = cpkt->MJL_getTileLine(k);
+        assert(MJL_tileAddr(line->getAddr() | (line->isSecure() ? LineSecure : 0)) ==
+               MJL_tileRetryAddr);
+        auto sf_res = lookupRequest(line, slave_port);
+        MJL_finishRequest(false, line->getAddr(), line->MJL_getCmdDir(),
+                          line->isSecure());
+        for (const auto& p : sf_res.first) {
+            interested |= portToMask(*p);
+        }
+    }
+    return snoopSelected(maskToPortList(interested), lookupLatency);
+}
+
+void
+SnoopFilter::MJL_finishTileRequest(bool will_retry)
+{
+    if (!will_retry) {
+        return;
+    }
+    // Put the tile entry back as it was before the lines were looked up
+    auto tile_it = MJL_cachedLocations.find(MJL_tileRetryAddr);
+    if (tile_it != MJL_cachedLocations.end()) {
+        MJL_entryCount -= popCount(tile_it->second.mask[0]) +
+                          popCount(tile_it->second.mask[1]);
+        if (MJL_tileRetryFound) {
+            tile_it->second = MJL_tileRetry;
+        } else {
+            MJL_cachedLocations.erase(tile_it);
+        }
+    } else if (MJL_tileRetryFound) {
+        MJL_cachedLocations.emplace(MJL_tileRetryAddr, MJL_tileRetry);
+    }
+    if (MJL_tileRetryFound) {
+        MJL_entryCount += popCount(MJL_tileRetry.mask[0]) +
+                          popCount(MJL_tileRetry.mask[1]);
+    }
+    DPRINTF(SnoopFilter, "%s:   restored SF tile %#llx\n", __func__,
+            MJL_tileRetryAddr);
+}
+
+void
+SnoopFilter::MJL_updateTileResponse(const Packet* cpkt, const SlavePort& slave_port)
+{
+    assert(cpkt->MJL_isTile());
+    for (unsigned k = 0; k < cpkt->MJL_tileLineCount(); ++k) {
+        updateResponse(cpkt->MJL_getTileLine(k), slave_port);
     }
 }
 /* MJL_End */
@@ -401,24 +466,20 @@ SnoopFilter::lookupSnoop(const Packet* cpkt/* MJL_Begin */, bool MJL_has2DLLC/*
         line_addr |= LineSecure;
     }
     /* MJL_Begin */
-    auto sf_it = MJL_cachedLocations[cpkt->MJL_getCmdDir()].find(line_addr);
-    bool is_hit = (sf_it != MJL_cachedLocations[cpkt->MJL_getCmdDir()].end());
+    const int MJL_side = MJL_dirSide(cpkt->MJL_getCmdDir());
+    const int MJL_crossSide = 1 - MJL_side;
+    const int MJL_index = MJL_tileIndex(line_addr, MJL_side);
+    auto MJL_tile_it = MJL_cachedLocations.find(MJL_tileAddr(line_addr));
+    bool MJL_lineHit = (MJL_tile_it != MJL_cachedLocations.end()) &&
+                       MJL_tile_it->second.MJL_has(MJL_side, MJL_index);
+    bool is_hit = MJL_lineHit;
     // For physically 2D cache, a check on the cross direction is also needed 
     if (MJL_has2DLLC && !is_hit) {
-        bool MJL_isHit = false;
-        for (int i = 0; i < linesize/sizeof(uint64_t); ++i) {
-            auto MJL_temp_it = MJL_cachedLocations[cpkt->MJL_getCrossCmdDir()].find(cpkt->MJL_getCrossBlockAddrs(linesize, i));
-            MJL_isHit |= (MJL_temp_it != MJL_cachedLocations[cpkt->MJL_getCrossCmdDir()].end());
-        }
-        is_hit |= MJL_isHit;
-    }
-    
-    size_t MJL_size = 0;
-    for (auto MJL_it = MJL_cachedLocations.begin(); MJL_it != MJL_cachedLocations.end(); ++MJL_it) {
-        MJL_size = MJL_size + MJL_it->second.size();
+        is_hit = (MJL_tile_it != MJL_cachedLocations.end()) &&
+                 MJL_tile_it->second.mask[MJL_crossSide];
     }
 
-    panic_if(!is_hit && (MJL_size >= maxEntryCount),
+    panic_if(!is_hit && (MJL_entryCount >= maxEntryCount),
              "snoop filter exceeded capacity of %d cache blocks\n",
              maxEntryCount);
     /* MJL_End */
@@ -438,9 +499,10 @@ SnoopFilter::lookupSnoop(const Packet* cpkt/* MJL_Begin */, bool MJL_has2DLLC/*
         return snoopDown(lookupLatency);
 
     /* MJL_Begin */
-    SnoopItem& sf_item = sf_it->second; // MJL_TODO: is this safe?
+    MJL_SnoopTile& MJL_tile = MJL_tile_it->second;
+    SnoopItem& sf_item = MJL_tile.items[MJL_side][MJL_index];
     SnoopMask interested = 0;
-    if (sf_it != MJL_cachedLocations[cpkt->MJL_getCmdDir()].end()) {
+    if (MJL_lineHit) {
         DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__, sf_item.requested, sf_item.holder);
 
@@ -467,9 +529,8 @@ SnoopFilter::lookupSnoop(const Packet* cpkt/* MJL_Begin */, bool MJL_has2DLLC/*
         SnoopMask MJL_holder = 0;
         SnoopMask MJL_requested = 0;
         for (int i = 0; i < linesize/sizeof(uint64_t); ++i) {
-            auto MJL_temp_it = MJL_cachedLocations[cpkt->MJL_getCrossCmdDir()].find(cpkt->MJL_getCrossBlockAddrs(linesize, i));
-            if (MJL_temp_it != MJL_cachedLocations[cpkt->MJL_getCrossCmdDir()].end()) {
-                SnoopItem& MJL_temp_item = MJL_temp_it->second;
+            if (MJL_tile.MJL_has(MJL_crossSide, i)) {
+                SnoopItem& MJL_temp_item = MJL_tile.items[MJL_crossSide][i];
                 MJL_holder |= MJL_temp_item.holder;
                 MJL_requested |= MJL_temp_item.requested;
             }
@@ -495,7 +556,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt/* MJL_Begin */, bool MJL_has2DLLC/*
     /* MJL_Begin */
     bool MJL_sfitemHasChanged = false;
     /* MJL_End */
-    if (cpkt->isInvalidate()/* MJL_Begin */ && (sf_it != MJL_cachedLocations[cpkt->MJL_getCmdDir()].end())/* MJL_End */ && !sf_item.requested) {
+    if (cpkt->isInvalidate()/* MJL_Begin */ && MJL_lineHit/* MJL_End */ && !sf_item.requested) {
         // Early clear of the holder, if no other request is currently going on
         // @todo: This should possibly be updated even though we do not filter
         // upward snoops
@@ -506,12 +567,11 @@ SnoopFilter::lookupSnoop(const Packet* cpkt/* MJL_Begin */, bool MJL_has2DLLC/*
     }
 
     /* MJL_Begin */
-    if (MJL_sfitemHasChanged && sf_it != MJL_cachedLocations[cpkt->MJL_getCmdDir()].end()) {
-
-        MJL_eraseIfNullEntry(sf_it, cpkt->MJL_getCmdDir());
-
+    if (MJL_sfitemHasChanged) {
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x interest: %x \n",
             __func__, sf_item.requested, sf_item.holder, interested);
+
+        MJL_eraseIfNullEntry(MJL_tile_it, MJL_side, MJL_index);
     }
     /* MJL_End */
     /* MJL_Comment
@@ -555,7 +615,9 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
     SnoopMask rsp_mask = portToMask(rsp_port);
     SnoopMask req_mask = portToMask(req_port);
     /* MJL_Begin */
-    SnoopItem& sf_item = MJL_cachedLocations[cpkt->MJL_getCmdDir()][line_addr];
+    const int MJL_side = MJL_dirSide(cpkt->MJL_getCmdDir());
+    SnoopItem& sf_item = MJL_addItem(MJL_cachedLocations[MJL_tileAddr(line_addr)],
+                                     MJL_side, MJL_tileIndex(line_addr, MJL_side));
     /* MJL_End */
     /* MJL_Comment 
     SnoopItem& sf_item = cachedLocations[line_addr];
@@ -659,8 +721,11 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
         line_addr |= LineSecure;
     }
     /* MJL_Begin */
-    auto sf_it = MJL_cachedLocations[cpkt->MJL_getCmdDir()].find(line_addr);
-    bool is_hit = sf_it != MJL_cachedLocations[cpkt->MJL_getCmdDir()].end();
+    const int MJL_side = MJL_dirSide(cpkt->MJL_getCmdDir());
+    const int MJL_index = MJL_tileIndex(line_addr, MJL_side);
+    auto MJL_tile_it = MJL_cachedLocations.find(MJL_tileAddr(line_addr));
+    bool is_hit = MJL_tile_it != MJL_cachedLocations.end() &&
+                  MJL_tile_it->second.MJL_has(MJL_side, MJL_index);
     /* MJL_End */
     /* MJL_Comment 
     auto sf_it = cachedLocations.find(line_addr);
@@ -671,7 +736,12 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     if (!is_hit)
         return;
 
+    /* MJL_Begin */
+    SnoopItem& sf_item = MJL_tile_it->second.items[MJL_side][MJL_index];
+    /* MJL_End */
+    /* MJL_Comment
     SnoopItem& sf_item = sf_it->second;
+    */
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -685,7 +755,7 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
             __func__, sf_item.requested, sf_item.holder);
     /* MJL_Begin */ 
-    MJL_eraseIfNullEntry(sf_it, cpkt->MJL_getCmdDir());
+    MJL_eraseIfNullEntry(MJL_tile_it, MJL_side, MJL_index);
     /* MJL_End */
     /* MJL_Comment 
     eraseIfNullEntry(sf_it);
@@ -717,8 +787,11 @@ SnoopFilter::updateResponse(const Packet* cpkt, const SlavePort& slave_port)
         line_addr |= LineSecure;
     }
     /* MJL_Begin */
-    auto sf_it = MJL_cachedLocations[cpkt->MJL_getCmdDir()].find(line_addr);
-    if (sf_it == MJL_cachedLocations[cpkt->MJL_getCmdDir()].end())
+    const int MJL_side = MJL_dirSide(cpkt->MJL_getCmdDir());
+    const int MJL_index = MJL_tileIndex(line_addr, MJL_side);
+    auto MJL_tile_it = MJL_cachedLocations.find(MJL_tileAddr(line_addr));
+    if (MJL_tile_it == MJL_cachedLocations.end() ||
+        !MJL_tile_it->second.MJL_has(MJL_side, MJL_index))
     /* MJL_End */
     /* MJL_Comment
     auto sf_it = cachedLocations.find(line_addr);
@@ -727,7 +800,13 @@ SnoopFilter::updateResponse(const Packet* cpkt, const SlavePort& slave_port)
         return;
 
     SnoopMask slave_mask = portToMask(slave_port);
+    /* MJL_Begin */
+    MJL_SnoopTile& MJL_tile = MJL_tile_it->second;
+    SnoopItem& sf_item = MJL_tile.items[MJL_side][MJL_index];
+    /* MJL_End */
+    /* MJL_Comment
     SnoopItem& sf_item = sf_it->second;
+    */
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -756,32 +835,16 @@ SnoopFilter::updateResponse(const Packet* cpkt, const SlavePort& slave_port)
     /* MJL_Begin */
     // For physically 2D cache, if the cache is a holder for all rows, it is also a holder for all columns, and vice versa
     if (slave_port.getMasterPort().MJL_is2DCache()) {
-        bool MJL_wholeTilePresent = true;
-        auto MJL_temp_it = MJL_cachedLocations[cpkt->MJL_getCmdDir()].find(line_addr);
-        for (int i = 0; i < linesize/sizeof(uint64_t); ++i) {
-            MJL_temp_it = MJL_cachedLocations[cpkt->MJL_getCmdDir()].find(cpkt->MJL_getBlockAddrs(linesize, i));
-            if (MJL_temp_it != MJL_cachedLocations[cpkt->MJL_getCmdDir()].end()) {
-                MJL_wholeTilePresent &= (bool)(MJL_temp_it->second.holder & slave_mask);
-                /* MJL_Test 
-                if (cpkt->getAddr() == 1576960 || cpkt->getAddr() == 1577216 || cpkt->getAddr() == 1577472 || cpkt->getAddr() == 1577728 || cpkt->getAddr() == 1577984 || cpkt->getAddr() == 1578240 || cpkt->getAddr() == 1578496 || cpkt->getAddr() == 1578752) {
-                    std::cout << this->name() << "::MJL_Debug: point D snoop_filter " << MJL_wholeTilePresent << " " << i << std::endl;
-                }
-                 */
-            } else {
-                MJL_wholeTilePresent = false;
-                break;
-            }
+        bool MJL_wholeTilePresent = (MJL_tile.mask[MJL_side] == MJL_fullMask());
+        for (int i = 0; MJL_wholeTilePresent && i < linesize/sizeof(uint64_t); ++i) {
+            MJL_wholeTilePresent &= (bool)(MJL_tile.items[MJL_side][i].holder & slave_mask);
         }
         /* MJL_Test 
         std::cout << ", wholeTilePresent? " << MJL_wholeTilePresent;
          */
         if (MJL_wholeTilePresent) {
             for (int i = 0; i < linesize/sizeof(uint64_t); ++i) {
-                MJL_temp_it = MJL_cachedLocations[cpkt->MJL_getCrossCmdDir()].find(cpkt->MJL_getCrossBlockAddrs(linesize, i));
-                if (MJL_temp_it == MJL_cachedLocations[cpkt->MJL_getCrossCmdDir()].end()) {
-                     MJL_temp_it = MJL_cachedLocations[cpkt->MJL_getCrossCmdDir()].emplace(cpkt->MJL_getCrossBlockAddrs(linesize, i), SnoopItem()).first;
-                }
-                SnoopItem& MJL_temp_item = MJL_temp_it->second;
+                SnoopItem& MJL_temp_item = MJL_addItem(MJL_tile, 1 - MJL_side, i);
                 /* MJL_Test 
                 std::cout << ", old holder" << i << " = " << MJL_temp_item.holder;
                  */
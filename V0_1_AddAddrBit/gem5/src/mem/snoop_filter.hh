@@ -47,9 +47,6 @@
 
 #include <unordered_map>
 #include <utility>
-/* MJL_Begin */
-#include <map>
-/* MJL_End */
 
 #include "mem/packet.hh"
 #include "mem/port.hh"
@@ -92,17 +89,18 @@ class SnoopFilter : public SimObject {
     typedef std::vector<QueuedSlavePort*> SnoopList;
 
     SnoopFilter (const SnoopFilterParams *p) :
-        SimObject(p), reqLookupResult(/* MJL_Begin */MJL_cachedLocations[MemCmd::MJL_DirAttribute::MJL_IsRow]/* MJL_End *//* MJL_Comment cachedLocations*/.end()), retryItem{0, 0},/* MJL_Begin */ MJL_retryItems{{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}}, MJL_retrySet{false, false, false, false, false, false, false, false},/* MJL_End */
+        SimObject(p), reqLookupResult(cachedLocations.end()), retryItem{0, 0},/* MJL_Begin */ MJL_reqTile(MJL_cachedLocations.end()), MJL_reqSide(0), MJL_reqIndex(0), MJL_retryItems{}, MJL_retryMask(0), MJL_tileRetryAddr(0), MJL_tileRetryFound(false), MJL_tileRetry{},/* MJL_End */
         linesize(p->system->cacheLineSize()), /* MJL_Begin */
-        MJL_rowWidth(p->MJL_row_width), MJL_Debug_Out(false), 
+        MJL_rowWidth(p->MJL_row_width),
+        MJL_geometry(MJL_AddrGeometry::MJL_get(linesize, MJL_rowWidth)),
+        MJL_Debug_Out(false), 
         /* MJL_End */lookupLatency(p->lookup_latency),
         maxEntryCount(p->max_capacity / p->system->cacheLineSize())
     {
         /* MJL_Begin */
-        uint64_t MJL_byteMask = sizeof(uint64_t) - 1;
-        uint64_t MJL_wordMask = linesize/sizeof(uint64_t) - 1;
-        int MJL_colShift = floorLog2(MJL_rowWidth) + floorLog2(linesize);
-        MJL_blkMaskColumn = (MJL_wordMask << MJL_colShift) | MJL_byteMask;
+        fatal_if(linesize / sizeof(uint64_t) > MJL_maxWords,
+                 "Snoop filter tiles hold at most %d lines, got %d\n",
+                 MJL_maxWords, linesize / sizeof(uint64_t));
         /* MJL_End */
     }
 
@@ -157,16 +155,28 @@ class SnoopFilter : public SimObject {
     void finishRequest(bool will_retry, Addr addr, bool is_secure);
     /* MJL_Begin */
     void MJL_finishRequest(bool will_retry, Addr addr, MemCmd::MJL_DirAttribute MJL_cmdDir, bool is_secure);
-    uint64_t MJL_blkMaskColumn;
+    /**
+     * Lookup the lines of a tile packet as lookupRequest does, and return
+     * the ports to snoop for any of them. All lines of a tile are in one
+     * entry, which is kept until MJL_finishTileRequest so that a retry
+     * undoes every line.
+     */
+    std::pair<SnoopList, Cycles> MJL_lookupTileRequest(const Packet* cpkt,
+                                                       const SlavePort& slave_port);
+    /** finishRequest of a tile packet */
+    void MJL_finishTileRequest(bool will_retry);
+    /** updateResponse of each line of a tile packet */
+    void MJL_updateTileResponse(const Packet *cpkt, const SlavePort& slave_port);
     // MJL_Test for test use
     bool MJL_test_reqLookupResult(MemCmd::MJL_DirAttribute MJL_cmdDir) {
-        assert(reqLookupResult != MJL_cachedLocations[MJL_cmdDir].end());
+        assert(MJL_reqTile != MJL_cachedLocations.end());
         bool MJL_inCachedLocations = false;
-        for (auto MJL_it = MJL_cachedLocations[MJL_cmdDir].begin(); MJL_it != MJL_cachedLocations[MJL_cmdDir].end(); ++MJL_it) {
-            if (MJL_it == reqLookupResult)
+        for (auto MJL_it = MJL_cachedLocations.begin(); MJL_it != MJL_cachedLocations.end(); ++MJL_it) {
+            if (MJL_it == MJL_reqTile)
                 MJL_inCachedLocations = true;
             }
-        return MJL_inCachedLocations;
+        return MJL_inCachedLocations && MJL_reqSide == MJL_dirSide(MJL_cmdDir) &&
+               MJL_reqTile->second.MJL_has(MJL_reqSide, MJL_reqIndex);
     }
     /* MJL_End */
 
@@ -245,7 +255,26 @@ class SnoopFilter : public SimObject {
      */
     typedef std::unordered_map<Addr, SnoopItem> SnoopFilterCache;
     /* MJL_Begin */
-    typedef std::map< MemCmd::MJL_DirAttribute, SnoopFilterCache > MJL_SnoopFilterCache;
+    /** Most lines per tile, one bit per line in the tile masks */
+    static const int MJL_maxWords = Packet::MJL_maxBlkWords;
+    static_assert(MJL_maxWords <= 8, "Tile masks are 8 bits wide");
+
+    /**
+     * The row lines (side 0) and column lines (side 1) of a tile. Line i
+     * of a side is tracked in items[side][i] when bit i of mask[side] is
+     * set, so a line and all the lines crossing it are found with one
+     * probe of the tile address.
+     */
+    struct MJL_SnoopTile {
+        uint8_t mask[2];
+        SnoopItem items[2][MJL_maxWords];
+
+        bool MJL_has(int side, int i) const { return mask[side] & (1 << i); }
+    };
+    /**
+     * HashMap of tiles indexed by tile address, with the secure bit
+     */
+    typedef std::unordered_map<Addr, MJL_SnoopTile> MJL_SnoopFilterCache;
     /* MJL_End */
     
 
@@ -287,13 +316,47 @@ class SnoopFilter : public SimObject {
      */
     void eraseIfNullEntry(SnoopFilterCache::iterator& sf_it);
     /* MJL_Begin */
-    void MJL_eraseIfNullEntry(SnoopFilterCache::iterator& sf_it, MemCmd::MJL_DirAttribute MJL_cmdDir);
+    /**
+     * Removes the line from the tile if it has no requesters and no
+     * holders, and the tile if it has no lines left, which invalidates
+     * tile_it.
+     * @return Whether the tile was removed
+     */
+    bool MJL_eraseIfNullEntry(MJL_SnoopFilterCache::iterator& tile_it, int side, int i);
+    /** @return The item of the line, added empty if not tracked yet */
+    SnoopItem& MJL_addItem(MJL_SnoopTile& tile, int side, int i);
+
+    /** @return The tile side of the direction, 0 for rows, 1 for columns */
+    static int MJL_dirSide(MemCmd::MJL_DirAttribute MJL_cmdDir)
+    {
+        return MJL_cmdDir == MemCmd::MJL_DirAttribute::MJL_IsColumn ? 1 : 0;
+    }
+    /** @return The address of the tile holding the line, with the secure bit */
+    Addr MJL_tileAddr(Addr line_addr) const
+    {
+        return (MJL_geometry.MJL_colBlockAlign(line_addr) & ~Addr(linesize - 1)) |
+               (line_addr & LineSecure);
+    }
+    /** @return The index of the line within its side of the tile */
+    int MJL_tileIndex(Addr line_addr, int side) const
+    {
+        return (line_addr >> (side ? MJL_geometry.MJL_rowShift :
+                                     MJL_geometry.MJL_colShift)) &
+               MJL_geometry.MJL_wordMask;
+    }
+    /** @return The tile mask with a bit for every line of a side */
+    uint8_t MJL_fullMask() const
+    {
+        return (1 << (linesize / sizeof(uint64_t))) - 1;
+    }
     /* MJL_End */
 
     /** Simple hash set of cached addresses. */
     SnoopFilterCache cachedLocations;
     /* MJL_Begin */
     MJL_SnoopFilterCache MJL_cachedLocations;
+    /** Lines tracked over all tiles, for the capacity check */
+    size_t MJL_entryCount = 0;
     /* MJL_End */
     /**
      * Iterator used to store the result from lookupRequest until we
@@ -307,8 +370,17 @@ class SnoopFilter : public SimObject {
      */
     SnoopItem retryItem;
     /* MJL_Begin */
-    SnoopItem MJL_retryItems[8];
-    bool MJL_retrySet[8];
+    /** Tile and line of the last lookupRequest, until MJL_finishRequest */
+    MJL_SnoopFilterCache::iterator MJL_reqTile;
+    int MJL_reqSide;
+    int MJL_reqIndex;
+    /** Crossing lines saved by lookupRequest, bit i of the mask for line i */
+    SnoopItem MJL_retryItems[MJL_maxWords];
+    uint8_t MJL_retryMask;
+    /** Tile entry before the last MJL_lookupTileRequest, if there was one */
+    Addr MJL_tileRetryAddr;
+    bool MJL_tileRetryFound;
+    MJL_SnoopTile MJL_tileRetry;
     /* MJL_End */
     /** List of all attached snooping slave ports. */
     SnoopList slavePorts;
@@ -318,6 +390,8 @@ class SnoopFilter : public SimObject {
     const unsigned linesize;
     /* MJL_Begin */
     const unsigned MJL_rowWidth;
+    /** Row/column address geometry of the lines */
+    const MJL_AddrGeometry &MJL_geometry;
     bool MJL_Debug_Out;
     /* MJL_End */
     /** Latency for doing a lookup in the filter */
@@ -0,0 +1,19 @@
+# MJL_Begin
+# Periodic sampler of a set of stats into a binary columnar file, read back
+# with util/mjl_stat_sample_read.py
+
+from m5.params import *
+from ClockedObject import ClockedObject
+
+class MJL_StatSampler(ClockedObject):
+    type = 'MJL_StatSampler'
+    cxx_header = "sim/stat_sampler.hh"
+
+    period = Param.Cycles("Cycles between samples")
+    stats = VectorParam.String("Names of the stats to sample, as fnmatch "
+                               "patterns such as '*.tags.MJL_rowInUse'")
+    file = Param.String("stat_samples.bin",
+                        "Output file, in the output directory")
+    block_rows = Param.Unsigned(1024, "Samples in a block handed to the "
+                                "writer thread")
+# MJL_End
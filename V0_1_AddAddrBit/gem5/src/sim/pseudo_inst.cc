@@ -64,6 +64,9 @@
 #include "debug/Quiesce.hh"
 #include "debug/WorkItems.hh"
 #include "dev/net/dist_iface.hh"
+/* MJL_Begin */
+#include "mem/cache/region_dir_table.hh"
+/* MJL_End */
 #include "params/BaseCPU.hh"
 #include "sim/full_system.hh"
 #include "sim/initparam_keys.hh"
@@ -194,9 +197,21 @@ pseudoInst(ThreadContext *tc, uint8_t func, uint8_t subfunc)
         workend(tc, args[0], args[1]);
         break;
 
+      /* MJL_Begin */
+      case 0x56: // mjl_regiondir_func
+        MJL_regionDir(tc, args[0], args[1], args[2]);
+        break;
+
+      case 0x57: // mjl_regionclear_func
+        MJL_regionClear(tc, args[0], args[1]);
+        break;
+      /* MJL_End */
+
       case 0x55: // annotate_func
+      /* MJL_Comment
       case 0x56: // reserved2_func
       case 0x57: // reserved3_func
+       */
       case 0x58: // reserved4_func
       case 0x59: // reserved5_func
         warn("Unimplemented m5 op (0x%x)\n", func);
@@ -586,6 +601,34 @@ togglesync(ThreadContext *tc)
     DistIface::toggleSync(tc);
 }
 
+/* MJL_Begin */
+void
+MJL_regionDir(ThreadContext *tc, Addr addr, uint64_t len, uint64_t dir)
+{
+    DPRINTF(PseudoInst, "PseudoInst::MJL_regionDir(%#x, %#x, %d)\n",
+            addr, len, dir);
+    MJL_RegionDirTable *table =
+        MJL_RegionDirTable::MJL_find(tc->getSystemPtr());
+    if (!table) {
+        warn_once("Direction regions registered without a region table, "
+                  "ignored\n");
+        return;
+    }
+    table->MJL_setRegion(tc, addr, len, (MemCmd::MJL_DirAttribute)dir);
+}
+
+void
+MJL_regionClear(ThreadContext *tc, Addr addr, uint64_t len)
+{
+    DPRINTF(PseudoInst, "PseudoInst::MJL_regionClear(%#x, %#x)\n", addr, len);
+    MJL_RegionDirTable *table =
+        MJL_RegionDirTable::MJL_find(tc->getSystemPtr());
+    if (table) {
+        table->MJL_clearRegion(tc, addr, len);
+    }
+}
+/* MJL_End */
+
 //
 // This function is executed when annotated work items begin.  Depending on
 // what the user specified at the command line, the simulation may exit and/or
@@ -89,6 +89,10 @@ void switchcpu(ThreadContext *tc);
 void workbegin(ThreadContext *tc, uint64_t workid, uint64_t threadid);
 void workend(ThreadContext *tc, uint64_t workid, uint64_t threadid);
 void togglesync(ThreadContext *tc);
+/* MJL_Begin */
+void MJL_regionDir(ThreadContext *tc, Addr addr, uint64_t len, uint64_t dir);
+void MJL_regionClear(ThreadContext *tc, Addr addr, uint64_t len);
+/* MJL_End */
 
 } // namespace PseudoInst
 
@@ -0,0 +1,267 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Definition of the periodic stat sampler.
+ */
+
+#include "sim/stat_sampler.hh"
+
+#include <fnmatch.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+
+#include "base/callback.hh"
+#include "base/misc.hh"
+#include "base/output.hh"
+#include "base/statistics.hh"
+#include "sim/core.hh"
+
+const char MJL_SampleWriter::MJL_magic[8] = {'M', 'J', 'L', 'S', 'M', 'P',
+                                             'L', '\0'};
+const uint32_t MJL_SampleWriter::MJL_version;
+const size_t MJL_SampleWriter::MJL_maxPending;
+
+MJL_SampleWriter::MJL_SampleWriter(const std::string &filename,
+                                   const std::vector<std::string> &names,
+                                   uint64_t frequency, uint64_t period,
+                                   unsigned block_rows)
+    : filename(filename), numColumns(names.size()), blockRows(block_rows),
+      row(names.size()), rowOpen(false), closing(false),
+      writeFailed(false), writeErrno(0), file(nullptr)
+{
+    if (blockRows == 0) {
+        fatal("Stat sample file '%s' needs at least one row per block\n",
+              filename);
+    }
+    file = fopen(filename.c_str(), "wb");
+    if (file == NULL) {
+        fatal("Could not open stat sample file '%s'\n", filename);
+    }
+    uint32_t num_columns = numColumns;
+    MJL_write(MJL_magic, sizeof(MJL_magic));
+    MJL_write(&MJL_version, sizeof(MJL_version));
+    MJL_write(&num_columns, sizeof(num_columns));
+    MJL_write(&frequency, sizeof(frequency));
+    MJL_write(&period, sizeof(period));
+    for (const std::string &name : names) {
+        uint32_t size = name.size();
+        MJL_write(&size, sizeof(size));
+        MJL_write(name.data(), size);
+    }
+    MJL_checkWriter();
+    MJL_newBlock();
+    writer = std::thread(&MJL_SampleWriter::MJL_writerLoop, this);
+}
+
+MJL_SampleWriter::~MJL_SampleWriter()
+{
+    MJL_close();
+}
+
+void
+MJL_SampleWriter::MJL_newBlock()
+{
+    block.ticks.clear();
+    block.ticks.reserve(blockRows);
+    block.values.assign(numColumns * blockRows, 0.0);
+}
+
+double *
+MJL_SampleWriter::MJL_beginRow(Tick when)
+{
+    assert(!closing);
+    if (rowOpen) {
+        MJL_storeRow();
+    }
+    block.ticks.push_back(when);
+    rowOpen = true;
+    return row.data();
+}
+
+void
+MJL_SampleWriter::MJL_storeRow()
+{
+    size_t r = block.ticks.size() - 1;
+    for (size_t c = 0; c < numColumns; ++c) {
+        block.values[c * blockRows + r] = row[c];
+    }
+    rowOpen = false;
+    if (block.ticks.size() == blockRows) {
+        MJL_seal();
+    }
+}
+
+void
+MJL_SampleWriter::MJL_seal()
+{
+    MJL_checkWriter();
+    std::unique_lock<std::mutex> lock(queueLock);
+    // Back-pressure when the writer falls behind
+    queueCond.wait(lock, [this] { return pending.size() < MJL_maxPending; });
+    pending.push_back(std::move(block));
+    queueCond.notify_all();
+    lock.unlock();
+    MJL_newBlock();
+}
+
+void
+MJL_SampleWriter::MJL_write(const void *data, size_t size)
+{
+    // fatal() is not safe off the main thread, the error is raised there
+    // on the next seal or at close
+    if (!size || writeFailed.load(std::memory_order_relaxed)) {
+        return;
+    }
+    errno = 0;
+    if (fwrite(data, size, 1, file) != 1) {
+        writeErrno = errno;
+        writeFailed.store(true, std::memory_order_release);
+    }
+}
+
+void
+MJL_SampleWriter::MJL_checkWriter() const
+{
+    if (writeFailed.load(std::memory_order_acquire)) {
+        fatal("Write failed on stat sample file '%s': %s\n", filename,
+              writeErrno ? std::strerror(writeErrno) : "unknown error");
+    }
+}
+
+void
+MJL_SampleWriter::MJL_writerLoop()
+{
+    std::unique_lock<std::mutex> lock(queueLock);
+    while (true) {
+        queueCond.wait(lock, [this] { return closing || !pending.empty(); });
+        if (pending.empty()) {
+            return;
+        }
+        MJL_Block full = std::move(pending.front());
+        pending.pop_front();
+        queueCond.notify_all();
+        lock.unlock();
+
+        uint32_t rows = full.ticks.size();
+        MJL_write(&rows, sizeof(rows));
+        MJL_write(full.ticks.data(), rows * sizeof(uint64_t));
+        for (size_t c = 0; c < numColumns; ++c) {
+            MJL_write(&full.values[c * blockRows], rows * sizeof(double));
+        }
+
+        lock.lock();
+    }
+}
+
+void
+MJL_SampleWriter::MJL_close()
+{
+    if (!file) {
+        return;
+    }
+    if (rowOpen) {
+        MJL_storeRow();
+    }
+    if (!block.ticks.empty()) {
+        MJL_seal();
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueLock);
+        closing = true;
+        queueCond.notify_all();
+    }
+    writer.join();
+    MJL_checkWriter();
+    if (fclose(file) != 0) {
+        fatal("Close failed on stat sample file '%s'\n", filename);
+    }
+    file = nullptr;
+}
+
+MJL_StatSampler::MJL_StatSampler(const Params *p)
+    : ClockedObject(p), period(p->period), filename(p->file),
+      patterns(p->stats), blockRows(p->block_rows), writer(nullptr),
+      sampleEvent(this, false, Event::Stat_Event_Pri)
+{
+    if (period == 0) {
+        fatal("%s: the sample period must not be 0\n", name());
+    }
+}
+
+MJL_StatSampler::~MJL_StatSampler()
+{
+    delete writer;
+}
+
+void
+MJL_StatSampler::startup()
+{
+    std::vector<std::string> names;
+    for (const Stats::Info *info : Stats::statsList()) {
+        bool match = false;
+        for (const std::string &pattern : patterns) {
+            match |= fnmatch(pattern.c_str(), info->name.c_str(), 0) == 0;
+        }
+        if (!match) {
+            continue;
+        }
+        if (!dynamic_cast<const Stats::ScalarInfo *>(info) &&
+            !dynamic_cast<const Stats::VectorInfo *>(info)) {
+            warn("%s: %s is not a scalar, vector or formula, not sampled\n",
+                 name(), info->name);
+            continue;
+        }
+        columns.push_back(info);
+    }
+    std::sort(columns.begin(), columns.end(),
+              [](const Stats::Info *a, const Stats::Info *b) {
+                  return a->name < b->name;
+              });
+    for (const Stats::Info *info : columns) {
+        names.push_back(info->name);
+    }
+    if (columns.empty()) {
+        warn("%s: no stat matches the sample patterns\n", name());
+    }
+
+    writer = new MJL_SampleWriter(simout.resolve(filename), names,
+                                  SimClock::Frequency,
+                                  cyclesToTicks(period), blockRows);
+    registerExitCallback(
+        new MakeCallback<MJL_StatSampler, &MJL_StatSampler::MJL_close>(this));
+    schedule(sampleEvent, clockEdge(period));
+}
+
+void
+MJL_StatSampler::MJL_sample()
+{
+    double *values = writer->MJL_beginRow(curTick());
+    for (size_t c = 0; c < columns.size(); ++c) {
+        const Stats::Info *info = columns[c];
+        auto scalar = dynamic_cast<const Stats::ScalarInfo *>(info);
+        values[c] = scalar ? scalar->result() :
+            static_cast<const Stats::VectorInfo *>(info)->total();
+    }
+    schedule(sampleEvent, clockEdge(period));
+}
+
+void
+MJL_StatSampler::MJL_close()
+{
+    if (sampleEvent.scheduled()) {
+        deschedule(sampleEvent);
+    }
+    writer->MJL_close();
+}
+
+MJL_StatSampler *
+MJL_StatSamplerParams::create()
+{
+    return new MJL_StatSampler(this);
+}
+
+/* MJL_End */
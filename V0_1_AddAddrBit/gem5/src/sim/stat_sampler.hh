@@ -0,0 +1,144 @@
+/* MJL_Begin */
+
+/**
+ * @file
+ * Declaration of the periodic stat sampler. Every period it snapshots a
+ * set of stats, picked by name patterns, into a binary columnar file that
+ * a background thread writes. util/mjl_stat_sample_read.py reads the file
+ * back.
+ */
+
+#ifndef __SIM_STAT_SAMPLER_HH__
+#define __SIM_STAT_SAMPLER_HH__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/stats/info.hh"
+#include "base/types.hh"
+#include "params/MJL_StatSampler.hh"
+#include "sim/clocked_object.hh"
+
+/**
+ * File layout: an 8 byte magic, a 32-bit version, the 32-bit column
+ * count, the 64-bit tick frequency and the 64-bit sample period in ticks,
+ * then per column the 32-bit name length and the name. Blocks follow,
+ * each the 32-bit row count n, n 64-bit sample ticks and, column after
+ * column, n doubles.
+ */
+class MJL_SampleWriter
+{
+  public:
+    static const char MJL_magic[8];
+    static const uint32_t MJL_version = 1;
+    /** Full blocks that may wait for the writer thread */
+    static const size_t MJL_maxPending = 4;
+
+    /**
+     * @param filename Output file
+     * @param names Column names
+     * @param frequency Ticks per second
+     * @param period Ticks between samples
+     * @param block_rows Rows in a block
+     */
+    MJL_SampleWriter(const std::string &filename,
+                     const std::vector<std::string> &names,
+                     uint64_t frequency, uint64_t period,
+                     unsigned block_rows);
+    ~MJL_SampleWriter();
+
+    MJL_SampleWriter(const MJL_SampleWriter &) = delete;
+    MJL_SampleWriter &operator=(const MJL_SampleWriter &) = delete;
+
+    /**
+     * Start a row, the values of the columns are then written through the
+     * returned pointer until the next row starts
+     */
+    double *MJL_beginRow(Tick when);
+
+    /** Write the partial block out and close the file */
+    void MJL_close();
+
+  private:
+    struct MJL_Block
+    {
+        std::vector<uint64_t> ticks;
+        /** Column major, column c starts at c * blockRows */
+        std::vector<double> values;
+    };
+
+    void MJL_newBlock();
+    void MJL_storeRow();
+    void MJL_seal();
+    /** Write to the file, recording a failure for MJL_checkWriter */
+    void MJL_write(const void *data, size_t size);
+    void MJL_writerLoop();
+    /** Raise a write error of the writer thread, on the main thread */
+    void MJL_checkWriter() const;
+
+    const std::string filename;
+    const size_t numColumns;
+    const unsigned blockRows;
+
+    MJL_Block block;
+    /** Values of the row being written, in row order */
+    std::vector<double> row;
+    /** True when the last tick of the block has its values in row */
+    bool rowOpen;
+
+    /** Blocks handed to the writer thread */
+    std::mutex queueLock;
+    std::condition_variable queueCond;
+    std::deque<MJL_Block> pending;
+    bool closing;
+
+    /**
+     * Set when a write failed, with the errno of the failure in
+     * writeErrno. Nothing is written after it.
+     */
+    std::atomic<bool> writeFailed;
+    int writeErrno;
+
+    FILE *file;
+    std::thread writer;
+};
+
+/**
+ * Samples the scalar, vector and formula stats whose names match one of
+ * the patterns. A vector or formula is sampled as its total.
+ */
+class MJL_StatSampler : public ClockedObject
+{
+  public:
+    typedef MJL_StatSamplerParams Params;
+    MJL_StatSampler(const Params *p);
+    ~MJL_StatSampler();
+
+    /** Pick the columns, open the file and schedule the first sample */
+    void startup() override;
+
+  private:
+    void MJL_sample();
+    void MJL_close();
+
+    const Cycles period;
+    const std::string filename;
+    const std::vector<std::string> patterns;
+    const unsigned blockRows;
+
+    std::vector<const Stats::Info *> columns;
+    MJL_SampleWriter *writer;
+
+    EventWrapper<MJL_StatSampler, &MJL_StatSampler::MJL_sample> sampleEvent;
+};
+
+#endif // __SIM_STAT_SAMPLER_HH__
+
+/* MJL_End */
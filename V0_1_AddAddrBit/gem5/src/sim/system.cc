@@ -92,6 +92,10 @@ System::System(Params *p)
       physmem(name() + ".physmem", p->memories, p->mmap_using_noreserve),
       memoryMode(p->mem_mode),
       _cacheLineSize(p->cache_line_size),
+      /* MJL_Begin */
+      MJL_geometry(MJL_AddrGeometry::MJL_get(p->cache_line_size,
+                                             p->MJL_row_width)),
+      /* MJL_End */
       workItemsBegin(0),
       workItemsEnd(0),
       numWorkIds(p->num_work_ids),
@@ -114,6 +118,11 @@ System::System(Params *p)
           _cacheLineSize == 64 || _cacheLineSize == 128))
         warn_once("Cache line size is neither 16, 32, 64 nor 128 bytes.\n");
 
+    /* MJL_Begin */
+    // Requests made from now on take the geometry of this system
+    MJL_AddrGeometry::MJL_setSystemGeometry(MJL_geometry);
+    /* MJL_End */
+
     // Get the generic system master IDs
     MasterID tmp_id M5_VAR_USED;
     tmp_id = getMasterId("writebacks");
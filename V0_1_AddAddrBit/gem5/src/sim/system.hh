@@ -57,6 +57,9 @@
 #include "base/statistics.hh"
 #include "config/the_isa.hh"
 #include "enums/MemoryMode.hh"
+/* MJL_Begin */
+#include "mem/addr_geometry.hh"
+/* MJL_End */
 #include "mem/mem_object.hh"
 #include "mem/port.hh"
 #include "mem/port_proxy.hh"
@@ -190,6 +193,14 @@ class System : public MemObject
      */
     unsigned int cacheLineSize() const { return _cacheLineSize; }
 
+    /* MJL_Begin */
+    /**
+     * Get the row/column address geometry of the system, which requests
+     * carry from their construction.
+     */
+    const MJL_AddrGeometry &MJL_getGeometry() const { return MJL_geometry; }
+    /* MJL_End */
+
 #if THE_ISA != NULL_ISA
     PCEventQueue pcEventQueue;
 #endif
@@ -306,6 +317,10 @@ class System : public MemObject
 
     const unsigned int _cacheLineSize;
 
+    /* MJL_Begin */
+    const MJL_AddrGeometry &MJL_geometry;
+    /* MJL_End */
+
     uint64_t workItemsBegin;
     uint64_t workItemsEnd;
     uint32_t numWorkIds;
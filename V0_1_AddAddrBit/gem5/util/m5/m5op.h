@@ -62,6 +62,16 @@ void m5_addsymbol(uint64_t addr, char *symbol);
 void m5_panic(void);
 void m5_work_begin(uint64_t workid, uint64_t threadid);
 void m5_work_end(uint64_t workid, uint64_t threadid);
+/* MJL_Begin */
+/*
+ * Prefer dir for the accesses to [addr, addr + len) of this process, e.g.
+ * M5_MJL_DIR_COLUMN for a column-major matrix. A later region replaces the
+ * overlapped parts of the earlier ones.
+ */
+void m5_mjl_region_dir(const void *addr, uint64_t len, uint64_t dir);
+/* Drop the preferred direction of [addr, addr + len), e.g. before free() */
+void m5_mjl_region_clear(const void *addr, uint64_t len);
+/* MJL_End */
 
 // These operations are for critical path annotation
 void m5a_bsm(char *sm, const void *id, int flags);
@@ -85,6 +95,12 @@ uint64_t m5a_getid(void);
 #define M5_AN_FL_LINK   0x10
 #define M5_AN_FL_RESET  0x20
 
+/* MJL_Begin */
+/* Directions of m5_mjl_region_dir, as MemCmd::MJL_DirAttribute */
+#define M5_MJL_DIR_ROW      1
+#define M5_MJL_DIR_COLUMN   2
+/* MJL_End */
+
 #ifdef __cplusplus
 }
 #endif
@@ -67,8 +67,14 @@
 #define addsymbol_func          0x53
 #define panic_func              0x54
 
+/* MJL_Comment
 #define reserved2_func          0x56 // Reserved for user
 #define reserved3_func          0x57 // Reserved for user
+ */
+/* MJL_Begin */
+#define mjl_regiondir_func      0x56 // Register a direction region
+#define mjl_regionclear_func    0x57 // Drop the direction of a range
+/* MJL_End */
 #define reserved4_func          0x58 // Reserved for user
 #define reserved5_func          0x59 // Reserved for user
 
@@ -123,7 +129,9 @@
     M5OP(m5_panic, panic_func, 0);                      \
     M5OP(m5_work_begin, work_begin_func, 0);            \
     M5OP(m5_work_end, work_end_func, 0);                \
-    M5OP(m5_togglesync, togglesync_func, 0);
+    M5OP(m5_togglesync, togglesync_func, 0);            \
+    M5OP(m5_mjl_region_dir, mjl_regiondir_func, 0);     \
+    M5OP(m5_mjl_region_clear, mjl_regionclear_func, 0);
 
 #define FOREACH_M5_ANNOTATION                   \
     M5_ANNOTATION(m5a_bsm, an_bsm);             \
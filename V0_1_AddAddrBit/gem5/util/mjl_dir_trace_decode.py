@@ -0,0 +1,68 @@
+#! /usr/bin/env python
+
+# MJL_Begin
+# Decode a per-PC direction trace written by MJL_DirTraceSink
+# (mem/cache/dir_trace.hh) into the text format MJL_printAccess used to
+# print: "PC d*n d*n ..." with d 0 for row and 1 for column. By default only
+# the PCs accessed in both directions are printed, as before.
+#
+# Usage: mjl_dir_trace_decode.py [--all] <cache>_dirTrace.gz
+
+import gzip
+import struct
+import sys
+
+MAGIC = b'MJLDTRC\0'
+VERSION = 1
+
+def read_varints(data):
+    value = 0
+    shift = 0
+    for byte in bytearray(data):
+        value |= (byte & 0x7f) << shift
+        shift += 7
+        if not byte & 0x80:
+            yield value
+            value = 0
+            shift = 0
+
+def decode(filename):
+    runs = {}
+    with gzip.open(filename, 'rb') as f:
+        magic, version = struct.unpack('<8sI', f.read(12))
+        if magic != MAGIC or version != VERSION:
+            sys.exit("%s is not a version %d direction trace" %
+                     (filename, VERSION))
+        while True:
+            header = f.read(12)
+            if len(header) < 12:
+                break
+            pc, size = struct.unpack('<QI', header)
+            pc_runs = runs.setdefault(pc, [])
+            for value in read_varints(f.read(size)):
+                is_column = value & 1
+                length = value >> 1
+                if pc_runs and pc_runs[-1][0] == is_column:
+                    pc_runs[-1][1] += length
+                else:
+                    pc_runs.append([is_column, length])
+    return runs
+
+def main():
+    args = sys.argv[1:]
+    print_all = '--all' in args
+    args = [a for a in args if a != '--all']
+    if len(args) != 1:
+        sys.exit("Usage: %s [--all] <dirTrace.gz>" % sys.argv[0])
+
+    runs = decode(args[0])
+    print("PC Trace(0 for row, 1 for column)")
+    for pc in sorted(runs):
+        pc_runs = runs[pc]
+        if not print_all and len(set(r[0] for r in pc_runs)) < 2:
+            continue
+        print("%x %s" % (pc, " ".join("%d*%d" % (d, n) for d, n in pc_runs)))
+
+if __name__ == '__main__':
+    main()
+# MJL_End
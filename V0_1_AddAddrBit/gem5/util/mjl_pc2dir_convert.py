@@ -0,0 +1,101 @@
+#! /usr/bin/env python
+
+# MJL_Begin
+# Convert a text PC to direction file ("PC Dir Pos OtherPC [Confidence]" per
+# line, PCs in hexadecimal, the confidence within [0, 1]) and an optional
+# vector instruction list (one hexadecimal PC per line) into the binary table
+# read by MJL_PC2DirTable (mem/cache/pc2dir_table.hh). The profile columns
+# MJL_PC2DirProfiler writes after the confidence are ignored. The binary
+# table is mmapped by the simulator, so many simulations on the same host
+# share one copy of it.
+#
+# Usage: mjl_pc2dir_convert.py <PC2Dir.txt> <out.bin> [VecList.txt]
+
+import struct
+import sys
+
+MAGIC = b'MJLPC2D\0'
+VERSION = 1
+HEADER_FORMAT = '<8sIIQ'
+ENTRY_FORMAT = '<QQBBBB4x'
+
+# Values of Request::MJL_DirAttribute
+DIR_INVALID = 0
+DIR_ROW = 1
+DIR_COLUMN = 2
+
+IS_VEC_FLAG = 0x1
+
+def read_pc2dir(filename, table):
+    with open(filename) as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) < 2:
+                continue
+            pc = int(fields[0], 16)
+            if fields[1] == 'R':
+                direction = DIR_ROW
+            elif fields[1] == 'C':
+                direction = DIR_COLUMN
+            else:
+                sys.exit("Invalid direction annotation '%s'" % fields[1])
+            pos = int(fields[2]) if len(fields) > 2 else 0
+            other_pc = int(fields[3], 16) if len(fields) > 3 and pos > 0 else 0
+            confidence = float(fields[4]) if len(fields) > 4 else 0.0
+            confidence = min(max(confidence, 0.0), 1.0)
+            # 0 means unknown, a low but nonzero confidence rounds up to 1
+            confidence = max(1, int(round(confidence * 255))) \
+                if confidence > 0 else 0
+            if pos not in (0, 1, 2):
+                sys.exit("Invalid column vector position %d" % pos)
+            if pc in table and table[pc][0] != DIR_INVALID:
+                print("Redefinition of instruction direction for %x" % pc)
+            flags = table[pc][3] if pc in table else 0
+            table[pc] = [direction, pos, other_pc, flags, confidence]
+
+def read_vec_list(filename, table):
+    with open(filename) as f:
+        for line in f:
+            fields = line.split()
+            if not fields:
+                continue
+            pc = int(fields[0], 16)
+            if pc not in table:
+                table[pc] = [DIR_INVALID, 0, 0, 0, 0]
+            table[pc][3] |= IS_VEC_FLAG
+
+def eytzinger(sorted_keys):
+    # Node k (1 based) has children 2k and 2k+1, fill it by an in-order walk
+    out = [None] * len(sorted_keys)
+    it = iter(sorted_keys)
+    def fill(k):
+        if k <= len(sorted_keys):
+            fill(2 * k)
+            out[k - 1] = next(it)
+            fill(2 * k + 1)
+    fill(1)
+    return out
+
+def main():
+    if len(sys.argv) not in (3, 4):
+        sys.exit("Usage: %s <PC2Dir.txt> <out.bin> [VecList.txt]" %
+                 sys.argv[0])
+
+    table = {}
+    read_pc2dir(sys.argv[1], table)
+    if len(sys.argv) == 4:
+        read_vec_list(sys.argv[3], table)
+
+    with open(sys.argv[2], 'wb') as out:
+        out.write(struct.pack(HEADER_FORMAT, MAGIC, VERSION,
+                              struct.calcsize(ENTRY_FORMAT), len(table)))
+        for pc in eytzinger(sorted(table)):
+            direction, pos, other_pc, flags, confidence = table[pc]
+            out.write(struct.pack(ENTRY_FORMAT, pc, other_pc, direction,
+                                  pos, flags, confidence))
+
+    print("%d entries written to %s" % (len(table), sys.argv[2]))
+
+if __name__ == '__main__':
+    main()
+# MJL_End
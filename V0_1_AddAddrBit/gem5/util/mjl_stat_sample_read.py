@@ -0,0 +1,76 @@
+#! /usr/bin/env python
+
+# MJL_Begin
+# Read a stat sample file written by MJL_StatSampler (sim/stat_sampler.hh)
+# and print it as CSV, one row per sample and one column per stat. The
+# columns can be narrowed down with fnmatch patterns. read() can also be
+# imported by analysis scripts.
+#
+# Usage: mjl_stat_sample_read.py [--seconds] <samples.bin> [pattern ...]
+
+import fnmatch
+import struct
+import sys
+
+MAGIC = b'MJLSMPL\0'
+VERSION = 1
+
+def _read_exact(f, size, filename):
+    data = f.read(size)
+    if len(data) != size:
+        sys.exit("%s is truncated" % filename)
+    return data
+
+def read(filename):
+    """Return (names, frequency, period, ticks, columns), where columns
+    maps a stat name to its list of samples."""
+    with open(filename, 'rb') as f:
+        magic, version, num_columns, frequency, period = \
+            struct.unpack('<8sIIQQ', _read_exact(f, 32, filename))
+        if magic != MAGIC or version != VERSION:
+            sys.exit("%s is not a version %d stat sample file" %
+                     (filename, VERSION))
+        names = []
+        for _ in range(num_columns):
+            size, = struct.unpack('<I', _read_exact(f, 4, filename))
+            names.append(_read_exact(f, size, filename).decode())
+
+        ticks = []
+        columns = [[] for _ in names]
+        while True:
+            header = f.read(4)
+            if not header:
+                break
+            if len(header) < 4:
+                sys.exit("%s is truncated" % filename)
+            rows, = struct.unpack('<I', header)
+            ticks.extend(struct.unpack('<%dQ' % rows,
+                                       _read_exact(f, 8 * rows, filename)))
+            for column in columns:
+                column.extend(struct.unpack('<%dd' % rows,
+                                            _read_exact(f, 8 * rows,
+                                                        filename)))
+    return names, frequency, period, ticks, dict(zip(names, columns))
+
+def main():
+    args = sys.argv[1:]
+    seconds = '--seconds' in args
+    args = [a for a in args if a != '--seconds']
+    if not args:
+        sys.exit("Usage: %s [--seconds] <samples.bin> [pattern ...]" %
+                 sys.argv[0])
+
+    names, frequency, period, ticks, columns = read(args[0])
+    patterns = args[1:]
+    if patterns:
+        names = [n for n in names
+                 if any(fnmatch.fnmatchcase(n, p) for p in patterns)]
+
+    print(",".join(["seconds" if seconds else "tick"] + names))
+    for row, tick in enumerate(ticks):
+        when = "%.9f" % (float(tick) / frequency) if seconds else str(tick)
+        print(",".join([when] + ["%g" % columns[n][row] for n in names]))
+
+if __name__ == '__main__':
+    main()
+# MJL_End